@@ -5,6 +5,9 @@
 #include "Codecs/RAW_RuntimeCodec.h"
 #include "HAL/PlatformProperties.h"
 #include "HAL/UnrealMemory.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+#include "Misc/FileHelper.h"
 
 #if WITH_RUNTIMEAUDIOIMPORTER_BINK_DECODE_SUPPORT
 #include "BinkAudioInfo.h"
@@ -207,6 +210,146 @@ bool FBINK_RuntimeCodec::Encode(FDecodedAudioStruct DecodedData, FEncodedAudioSt
 #endif
 }
 
+#if WITH_RUNTIMEAUDIOIMPORTER_BINK_ENCODE_SUPPORT
+namespace
+{
+	/**
+	 * BINK encoder session
+	 * The Bink encoder only compresses the whole buffer at once, so the pushed data is spooled to a temporary file as 16-bit PCM (keeping the memory flat while pushing)
+	 * and compressed into the file handle on finish
+	 */
+	class FBINK_RuntimeEncoderSession : public FBaseRuntimeEncoderSession
+	{
+	public:
+		virtual ~FBINK_RuntimeEncoderSession() override
+		{
+			Release_Internal();
+		}
+
+		virtual ERuntimeAudioFormat GetAudioFormat() const override { return ERuntimeAudioFormat::Bink; }
+
+	protected:
+		virtual bool Begin_Internal() override
+		{
+			SpoolFilePath = FPaths::CreateTempFilename(*FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("RuntimeAudioImporter")), TEXT("BinkEncoderSession"), TEXT(".pcm"));
+
+			IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+			PlatformFile.CreateDirectoryTree(*FPaths::GetPath(SpoolFilePath));
+
+			SpoolFileHandle.Reset(PlatformFile.OpenWrite(*SpoolFilePath));
+			if (!SpoolFileHandle.IsValid())
+			{
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to open the temporary file '%s' for BINK encoding"), *SpoolFilePath);
+				return false;
+			}
+
+			return true;
+		}
+
+		virtual bool PushFrames_Internal(const float* PCMData, int64 NumOfFrames) override
+		{
+			const int64 NumOfSamples = NumOfFrames * NumOfChannels;
+
+			int16* TempInt16Buffer;
+			FRAW_RuntimeCodec::TranscodeRAWData<float, int16>(PCMData, NumOfSamples, TempInt16Buffer);
+
+			const bool bWritten = SpoolFileHandle->Write(reinterpret_cast<const uint8*>(TempInt16Buffer), NumOfSamples * sizeof(int16));
+			FMemory::Free(TempInt16Buffer);
+
+			if (!bWritten)
+			{
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to write PCM data to the temporary file '%s' for BINK encoding"), *SpoolFilePath);
+				return false;
+			}
+
+			return true;
+		}
+
+		virtual bool Finish_Internal() override
+		{
+			SpoolFileHandle.Reset();
+
+			TArray64<uint8> Int16PCMData;
+			if (!FFileHelper::LoadFileToArray(Int16PCMData, *SpoolFilePath))
+			{
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to read PCM data from the temporary file '%s' for BINK encoding"), *SpoolFilePath);
+				return false;
+			}
+
+			if (Int16PCMData.Num() <= 0)
+			{
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to finish BINK encoding as no audio data has been pushed"));
+				return false;
+			}
+
+			if (Int16PCMData.Num() > TNumericLimits<uint32>::Max())
+			{
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to finish BINK encoding as the pushed audio data is too large (%lld bytes)"), Int16PCMData.Num());
+				return false;
+			}
+
+#if UE_VERSION_NEWER_THAN(5, 2, 9)
+			FSoundWaveBasicStruct SoundWaveBasicInfo;
+			{
+				SoundWaveBasicInfo.NumOfChannels = NumOfChannels;
+				SoundWaveBasicInfo.SampleRate = SampleRate;
+			}
+
+			// If we're going to embed the seek-table in the stream, use -1 to give the largest table we can produce
+			const uint16 MaxSeektableSize = GetMaxSeekTableEntries(static_cast<uint32>(Int16PCMData.Num()), SoundWaveBasicInfo);
+#endif
+
+			void* CompressedData = nullptr;
+			uint32_t CompressedDataLen = 0;
+
+			UECompressBinkAudio(Int16PCMData.GetData(), static_cast<uint32>(Int16PCMData.Num()), SampleRate, NumOfChannels, GetCompressionLevelFromQualityIndex(Quality), 1,
+#if UE_VERSION_NEWER_THAN(5, 2, 9)
+				MaxSeektableSize,
+#endif
+				BinkAlloc, BinkFree, &CompressedData, &CompressedDataLen);
+
+			if (CompressedDataLen <= 0)
+			{
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to encode BINK audio data"));
+				return false;
+			}
+
+			const bool bWritten = Write(CompressedData, CompressedDataLen);
+			BinkFree(CompressedData);
+			return bWritten;
+		}
+
+		virtual void Release_Internal() override
+		{
+			SpoolFileHandle.Reset();
+
+			if (!SpoolFilePath.IsEmpty())
+			{
+				FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*SpoolFilePath);
+				SpoolFilePath.Empty();
+			}
+		}
+
+	private:
+		/** Path to the temporary file with the pushed 16-bit PCM data */
+		FString SpoolFilePath;
+
+		/** Handle of the temporary file with the pushed 16-bit PCM data */
+		TUniquePtr<IFileHandle> SpoolFileHandle;
+	};
+}
+#endif
+
+TUniquePtr<FBaseRuntimeEncoderSession> FBINK_RuntimeCodec::CreateEncoderSession()
+{
+#if WITH_RUNTIMEAUDIOIMPORTER_BINK_ENCODE_SUPPORT
+	return MakeUnique<FBINK_RuntimeEncoderSession>();
+#else
+	UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Your platform (%hs) does not support BINK encoding"), FPlatformProperties::IniPlatformName());
+	return nullptr;
+#endif
+}
+
 bool FBINK_RuntimeCodec::Decode(FEncodedAudioStruct EncodedData, FDecodedAudioStruct& DecodedData)
 {
 	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Decoding BINK audio data to uncompressed audio format.\nEncoded audio info: %s"), *EncodedData.ToString());
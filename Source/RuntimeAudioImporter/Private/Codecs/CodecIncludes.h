@@ -73,6 +73,10 @@ THIRD_PARTY_INCLUDES_START
 #include "internal_opusfile.c"
 #endif
 
+#ifdef INCLUDE_OPUS_PACKET
+#include "opus.h"
+#endif
+
 THIRD_PARTY_INCLUDES_END
 
 #undef calloc
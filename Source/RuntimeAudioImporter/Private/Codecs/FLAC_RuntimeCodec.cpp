@@ -77,7 +77,7 @@ bool FFLAC_RuntimeCodec::Decode(FEncodedAudioStruct EncodedData, FDecodedAudioSt
 	if (!TempPCMData)
 	{
 		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to allocate memory for FLAC Decoder"));
-		
+		drflac_close(FLAC_Decoder);
 		return false;
 	}
 
@@ -97,7 +97,48 @@ bool FFLAC_RuntimeCodec::Decode(FEncodedAudioStruct EncodedData, FDecodedAudioSt
 		DecodedData.SoundWaveBasicInfo.AudioFormat = GetAudioFormat();
 	}
 
-	
+	drflac_close(FLAC_Decoder);
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully decoded FLAC audio data to uncompressed audio format.\nDecoded audio info: %s"), *DecodedData.ToString());
+	return true;
+}
+
+bool FFLAC_RuntimeCodec::DecodeToFormat(FEncodedAudioStruct EncodedData, FDecodedAudioStruct& DecodedData, uint32 TargetSampleRate, uint32 TargetNumOfChannels)
+{
+	drflac* FLAC_Decoder = drflac_open_memory(EncodedData.AudioData.GetView().GetData(), EncodedData.AudioData.GetView().Num(), nullptr);
+	if (!FLAC_Decoder)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to initialize FLAC Decoder"));
+		return false;
+	}
+
+	FRuntimePCMFormatConverter Converter(FLAC_Decoder->sampleRate, FLAC_Decoder->channels, TargetSampleRate, TargetNumOfChannels);
+	if (!Converter.IsValid() || Converter.IsPassthrough())
+	{
+		drflac_close(FLAC_Decoder);
+		return Decode(MoveTemp(EncodedData), DecodedData);
+	}
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Decoding FLAC audio data to sample rate '%d' and number of channels '%d'.\nEncoded audio info: %s"), Converter.GetTargetSampleRate(), Converter.GetTargetNumOfChannels(), *EncodedData.ToString());
+
+	// Converting the PCM data block by block as it is decoded
+	Converter.Reserve(FLAC_Decoder->totalPCMFrameCount);
+	const bool bSucceeded = Converter.PushFramesFrom([FLAC_Decoder](float* OutPCMData, int64 MaxNumOfFrames)
+	{
+		return static_cast<int64>(drflac_read_pcm_frames_f32(FLAC_Decoder, MaxNumOfFrames, OutPCMData));
+	}) && Converter.Finish();
+
+	drflac_close(FLAC_Decoder);
+
+	if (!bSucceeded)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to convert decoded FLAC audio data"));
+		return false;
+	}
+
+	Converter.ReleaseDecodedAudio(DecodedData);
+	DecodedData.SoundWaveBasicInfo.AudioFormat = GetAudioFormat();
+
 	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully decoded FLAC audio data to uncompressed audio format.\nDecoded audio info: %s"), *DecodedData.ToString());
 	return true;
 }
@@ -1,6 +1,7 @@
 ﻿// Georgy Treshchev 2024.
 
 #include "Codecs/MP3_RuntimeCodec.h"
+#include "Codecs/RAW_RuntimeCodec.h"
 #include "RuntimeAudioImporterDefines.h"
 #include "RuntimeAudioImporterTypes.h"
 #include "HAL/UnrealMemory.h"
@@ -83,6 +84,127 @@ bool FMP3_RuntimeCodec::Encode(FDecodedAudioStruct DecodedData, FEncodedAudioStr
 	return false;
 }
 
+namespace
+{
+	/**
+	 * Convert the samples produced by the MP3 decoder, which are 16-bit integer unless it is configured to output 32-bit float, to 32-bit float
+	 */
+	void ConvertMP3Samples(const int16* From, float* To, int64 NumOfSamples)
+	{
+		FRAW_RuntimeCodec::ConvertInt16ToFloat(From, To, NumOfSamples);
+	}
+
+	void ConvertMP3Samples(const float* From, float* To, int64 NumOfSamples)
+	{
+		FMemory::Memcpy(To, From, NumOfSamples * sizeof(float));
+	}
+
+	/**
+	 * Incremental MP3 decoder session. Decodes the pushed data frame by frame with the low-level decoder, which keeps the bit reservoir between frames
+	 */
+	class FMP3_RuntimeDecoderSession : public FBaseRuntimeDecoderSession
+	{
+	public:
+		FMP3_RuntimeDecoderSession()
+			: bSynchronized(false)
+		{
+#if DR_MP3_IMPLEMENTATION
+			drmp3dec_init(&Decoder);
+#elif MINIMP3_IMPLEMENTATION
+			mp3dec_init(&Decoder);
+#endif
+		}
+
+		virtual ERuntimeAudioFormat GetAudioFormat() const override { return ERuntimeAudioFormat::Mp3; }
+
+	protected:
+		virtual bool Decode_Internal(bool bEndOfStream) override
+		{
+#if DR_MP3_IMPLEMENTATION || MINIMP3_IMPLEMENTATION
+			while (GetNumOfPendingBytes() > 0)
+			{
+				// Finding the first frame requires several consecutive frames to be validated, while the following frames only need to be complete
+				const int64 NumOfBytesRequired = bSynchronized ? NumOfBytesRequiredPerFrame : NumOfBytesRequiredToSynchronize;
+				if (!bEndOfStream && GetNumOfPendingBytes() < NumOfBytesRequired)
+				{
+					break;
+				}
+
+				const int32 NumOfBytesToDecode = static_cast<int32>(FMath::Min<int64>(GetNumOfPendingBytes(), MAX_int32));
+#if DR_MP3_IMPLEMENTATION
+				drmp3dec_frame_info FrameInfo;
+				const int32 NumOfFrames = drmp3dec_decode_frame(&Decoder, GetPendingData(), NumOfBytesToDecode, Samples, &FrameInfo);
+#else
+				mp3dec_frame_info_t FrameInfo;
+				const int32 NumOfFrames = mp3dec_decode_frame(&Decoder, GetPendingData(), NumOfBytesToDecode, Samples, &FrameInfo);
+#endif
+
+				// No complete frame in the pending data. Waiting for more data, or dropping the trailing garbage at the end of the stream
+				if (FrameInfo.frame_bytes <= 0)
+				{
+					if (bEndOfStream)
+					{
+						ConsumePendingData(GetNumOfPendingBytes());
+					}
+					break;
+				}
+
+				ConsumePendingData(FrameInfo.frame_bytes);
+
+				// Skipped data or a frame without audio (e.g. the Xing/LAME info frame)
+				if (NumOfFrames <= 0)
+				{
+					continue;
+				}
+
+				bSynchronized = true;
+
+				if (!SetFormat(FrameInfo.hz, FrameInfo.channels))
+				{
+					return false;
+				}
+
+				const int32 NumOfSamples = NumOfFrames * FrameInfo.channels;
+				ConvertMP3Samples(Samples, FloatSamples, NumOfSamples);
+				if (!EmitFrames(FloatSamples, NumOfFrames))
+				{
+					return false;
+				}
+			}
+			return true;
+#else
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("No MP3 codec implementation found"));
+			return false;
+#endif
+		}
+
+	private:
+		/** The number of bytes that always contain a complete frame (the largest free-format frame) and the header of the next one */
+		static constexpr int64 NumOfBytesRequiredPerFrame = 2304 + 4;
+
+		/** The number of bytes the decoder needs to reliably find the first frame */
+		static constexpr int64 NumOfBytesRequiredToSynchronize = 16 * 1024;
+
+#if DR_MP3_IMPLEMENTATION
+		drmp3dec Decoder;
+		drmp3d_sample_t Samples[DRMP3_MAX_SAMPLES_PER_FRAME];
+		float FloatSamples[DRMP3_MAX_SAMPLES_PER_FRAME];
+#elif MINIMP3_IMPLEMENTATION
+		mp3dec_t Decoder;
+		mp3d_sample_t Samples[MINIMP3_MAX_SAMPLES_PER_FRAME];
+		float FloatSamples[MINIMP3_MAX_SAMPLES_PER_FRAME];
+#endif
+
+		/** Whether the first frame has been found */
+		bool bSynchronized;
+	};
+}
+
+TUniquePtr<FBaseRuntimeDecoderSession> FMP3_RuntimeCodec::CreateDecoderSession()
+{
+	return MakeUnique<FMP3_RuntimeDecoderSession>();
+}
+
 bool FMP3_RuntimeCodec::Decode(FEncodedAudioStruct EncodedData, FDecodedAudioStruct& DecodedData)
 {
 	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Decoding MP3 audio data to uncompressed audio format.\nEncoded audio info: %s"), *EncodedData.ToString());
@@ -165,3 +287,89 @@ bool FMP3_RuntimeCodec::Decode(FEncodedAudioStruct EncodedData, FDecodedAudioStr
 	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully decoded MP3 audio data to uncompressed audio format.\nDecoded audio info: %s"), *DecodedData.ToString());
 	return true;
 }
+
+bool FMP3_RuntimeCodec::DecodeToFormat(FEncodedAudioStruct EncodedData, FDecodedAudioStruct& DecodedData, uint32 TargetSampleRate, uint32 TargetNumOfChannels)
+{
+#if DR_MP3_IMPLEMENTATION
+	drmp3 MP3_Decoder;
+	if (!drmp3_init_memory(&MP3_Decoder, EncodedData.AudioData.GetView().GetData(), EncodedData.AudioData.GetView().Num(), nullptr))
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to initialize MP3 Decoder"));
+		return false;
+	}
+
+	FRuntimePCMFormatConverter Converter(MP3_Decoder.sampleRate, MP3_Decoder.channels, TargetSampleRate, TargetNumOfChannels);
+	if (!Converter.IsValid() || Converter.IsPassthrough())
+	{
+		drmp3_uninit(&MP3_Decoder);
+		return Decode(MoveTemp(EncodedData), DecodedData);
+	}
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Decoding MP3 audio data to sample rate '%d' and number of channels '%d'.\nEncoded audio info: %s"), Converter.GetTargetSampleRate(), Converter.GetTargetNumOfChannels(), *EncodedData.ToString());
+
+	// Converting the PCM data block by block as it is decoded
+	Converter.Reserve(drmp3_get_pcm_frame_count(&MP3_Decoder));
+	const bool bSucceeded = Converter.PushFramesFrom([&MP3_Decoder](float* OutPCMData, int64 MaxNumOfFrames)
+	{
+		return static_cast<int64>(drmp3_read_pcm_frames_f32(&MP3_Decoder, MaxNumOfFrames, OutPCMData));
+	}) && Converter.Finish();
+
+	drmp3_uninit(&MP3_Decoder);
+
+	if (!bSucceeded)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to convert decoded MP3 audio data"));
+		return false;
+	}
+
+	Converter.ReleaseDecodedAudio(DecodedData);
+	DecodedData.SoundWaveBasicInfo.AudioFormat = GetAudioFormat();
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully decoded MP3 audio data to uncompressed audio format.\nDecoded audio info: %s"), *DecodedData.ToString());
+	return true;
+#elif MINIMP3_IMPLEMENTATION
+	mp3dec_ex_t MP3_Decoder;
+	if (mp3dec_ex_open_buf(&MP3_Decoder, EncodedData.AudioData.GetView().GetData(), EncodedData.AudioData.GetView().Num(), MP3D_SEEK_TO_SAMPLE) != 0)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to initialize MP3 Decoder"));
+		return false;
+	}
+
+	const int32 NumOfChannels = MP3_Decoder.info.channels;
+	FRuntimePCMFormatConverter Converter(MP3_Decoder.info.hz, NumOfChannels, TargetSampleRate, TargetNumOfChannels);
+	if (NumOfChannels <= 0 || !Converter.IsValid() || Converter.IsPassthrough())
+	{
+		mp3dec_ex_close(&MP3_Decoder);
+		return Decode(MoveTemp(EncodedData), DecodedData);
+	}
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Decoding MP3 audio data to sample rate '%d' and number of channels '%d'.\nEncoded audio info: %s"), Converter.GetTargetSampleRate(), Converter.GetTargetNumOfChannels(), *EncodedData.ToString());
+
+	// Reading the samples in the format the decoder produces (16-bit integer by default) block by block, and converting each block as it is decoded
+	Converter.Reserve(static_cast<int64>(MP3_Decoder.samples / NumOfChannels));
+	TArray<mp3d_sample_t> BlockPCMData;
+	const bool bSucceeded = Converter.PushFramesFrom([&MP3_Decoder, &BlockPCMData, NumOfChannels](float* OutPCMData, int64 MaxNumOfFrames)
+	{
+		BlockPCMData.SetNumUninitialized(MaxNumOfFrames * NumOfChannels);
+		const int64 NumOfSamples = static_cast<int64>(mp3dec_ex_read(&MP3_Decoder, BlockPCMData.GetData(), BlockPCMData.Num()));
+		ConvertMP3Samples(BlockPCMData.GetData(), OutPCMData, NumOfSamples);
+		return NumOfSamples / NumOfChannels;
+	}) && MP3_Decoder.last_error == 0 && Converter.Finish();
+
+	mp3dec_ex_close(&MP3_Decoder);
+
+	if (!bSucceeded)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to convert decoded MP3 audio data"));
+		return false;
+	}
+
+	Converter.ReleaseDecodedAudio(DecodedData);
+	DecodedData.SoundWaveBasicInfo.AudioFormat = GetAudioFormat();
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully decoded MP3 audio data to uncompressed audio format.\nDecoded audio info: %s"), *DecodedData.ToString());
+	return true;
+#else
+	return FBaseRuntimeCodec::DecodeToFormat(MoveTemp(EncodedData), DecodedData, TargetSampleRate, TargetNumOfChannels);
+#endif
+}
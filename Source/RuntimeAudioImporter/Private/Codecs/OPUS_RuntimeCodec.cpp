@@ -63,29 +63,194 @@ bool FOPUS_RuntimeCodec::GetHeaderInfo(FEncodedAudioStruct EncodedData, FRuntime
 	return true;
 }
 
-bool FOPUS_RuntimeCodec::Encode(FDecodedAudioStruct DecodedData, FEncodedAudioStruct& EncodedData, uint8 Quality)
+namespace
 {
-	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Encoding uncompressed audio data to OPUS audio format.\nDecoded audio info: %s.\nQuality: %d"), *DecodedData.ToString(), Quality);
+	/** Preskip duration recommended for .opus files */
+	constexpr float PreskipDuration = 0.08f;
 
-	// Preskip duration recommended for .opus files
-	static constexpr float PreskipDuration = 0.08f;
+	/** Sample rate the audio data is encoded at */
+	constexpr uint32 OpusEncodingSampleRate = 48000;
 
-	// Channel layout mapping based on number of channels
-	static const struct ChannelLayout
+	/**
+	 * Get the number of channels and the sample rate the audio data must be converted to before OPUS encoding, warning if a conversion is needed
+	 */
+	void GetOpusEncodingFormat(uint32 NumOfChannels, uint32 SampleRate, uint32& OutNumOfChannels, uint32& OutSampleRate)
 	{
-		int32 StreamCount;
-		int32 CoupledStreamCount;
-		uint8 Mapping[8];
-	} ChannelLayouts[8] = {
-			{1, 0, {0}}, // 1: mono
-			{1, 1, {0, 1}}, // 2: stereo
-			{2, 1, {0, 1, 2}}, // 3: 1-d surround
-			{2, 2, {0, 1, 2, 3}}, // 4: quadraphonic surround
-			{3, 2, {0, 1, 4, 2, 3}}, // 5: 5-channel surround
-			{4, 2, {0, 1, 4, 5, 2, 3}}, // 6: 5.1 surround
-			{4, 3, {0, 1, 4, 6, 2, 3, 5}}, // 7: 6.1 surround
-			{5, 3, {0, 1, 6, 7, 2, 3, 4, 5}} // 8: 7.1 surround
-		};
+		// Mix channels if more than 2
+		// TODO: Support more than 2 channels
+		OutNumOfChannels = FMath::Min<uint32>(NumOfChannels, 2);
+		if (NumOfChannels > 2)
+		{
+			UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("More than 2 channels detected (%d) which is not supported for OPUS encoding at the moment. Mixing to stereo"), NumOfChannels);
+		}
+
+		// Resample to 48kHz if not
+		// TODO: Support other sample rates
+		OutSampleRate = OpusEncodingSampleRate;
+		if (SampleRate != OpusEncodingSampleRate)
+		{
+			UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Sample rate is not 48kHz (%d) which is not supported for OPUS encoding at the moment. Resampling to 48kHz"), SampleRate);
+		}
+	}
+
+	/**
+	 * Create and configure an OPUS encoder for the specified format and quality
+	 *
+	 * @return The created encoder, or nullptr if the creation failed
+	 */
+	OpusEncoder* CreateOpusEncoder(uint32 SampleRate, uint32 NumOfChannels, uint8 Quality)
+	{
+		// Opus encoder initialization
+		OpusEncoder* OpusEnc = nullptr;
+		int OpusError;
+
+		OpusEnc = opus_encoder_create(
+			SampleRate,
+			NumOfChannels,
+			OPUS_APPLICATION_AUDIO,
+			&OpusError
+		);
+
+		if (OpusError != OPUS_OK)
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to create OPUS encoder: %d"), static_cast<int32>(OpusError));
+			return nullptr;
+		}
+
+		// Configure encoder
+		{
+			// Variable bit rate encoding
+			int32 UseVbr = 1;
+			opus_encoder_ctl(OpusEnc, OPUS_SET_VBR(UseVbr));
+
+			// Disable constrained VBR
+			int32 UseCVbr = 0;
+			opus_encoder_ctl(OpusEnc, OPUS_SET_VBR_CONSTRAINT(UseCVbr));
+
+			// Complexity (1-10)
+			int32 Complexity = FMath::Clamp(static_cast<int32>(Quality / 10), 0, 10);
+			opus_encoder_ctl(OpusEnc, OPUS_SET_COMPLEXITY(Complexity));
+
+			// Disable forward error correction for this use case
+			int32 InbandFEC = 0;
+			opus_encoder_ctl(OpusEnc, OPUS_SET_INBAND_FEC(InbandFEC));
+
+			// Set bitrate
+			int BitrateKbps = FMath::Clamp(
+				static_cast<int>((Quality / 100.0f) * 320), // Max 320 kbps
+				12, // Minimum 12 kbps
+				320 // Maximum 320 kbps
+			);
+			opus_encoder_ctl(OpusEnc, OPUS_SET_BITRATE(BitrateKbps * 1000));
+		}
+
+		return OpusEnc;
+	}
+
+	/**
+	 * Submit the OpusHead and OpusTags header packets to the Ogg stream
+	 */
+	void SubmitOpusHeaderPackets(ogg_stream_state& OggStreamState, uint32 SampleRate, uint32 NumOfChannels)
+	{
+		// Channel layout mapping based on number of channels
+		static const struct ChannelLayout
+		{
+			int32 StreamCount;
+			int32 CoupledStreamCount;
+			uint8 Mapping[8];
+		} ChannelLayouts[8] = {
+				{1, 0, {0}}, // 1: mono
+				{1, 1, {0, 1}}, // 2: stereo
+				{2, 1, {0, 1, 2}}, // 3: 1-d surround
+				{2, 2, {0, 1, 2, 3}}, // 4: quadraphonic surround
+				{3, 2, {0, 1, 4, 2, 3}}, // 5: 5-channel surround
+				{4, 2, {0, 1, 4, 5, 2, 3}}, // 6: 5.1 surround
+				{4, 3, {0, 1, 4, 6, 2, 3, 5}}, // 7: 6.1 surround
+				{5, 3, {0, 1, 6, 7, 2, 3, 4, 5}} // 8: 7.1 surround
+			};
+
+		// Generate Opus header packet
+		{
+			TArray<uint8> HeaderPacket;
+
+			// Magic number
+			uint8 MagicNumber[8] = {'O', 'p', 'u', 's', 'H', 'e', 'a', 'd'};
+			HeaderPacket.Append(MagicNumber, 8);
+
+			uint8 Version = 1;
+			HeaderPacket.Add(Version);
+
+			uint8 ChannelCount = static_cast<uint8>(NumOfChannels);
+			HeaderPacket.Add(ChannelCount);
+
+			// Preskip (fixed at 10ms, about 480 samples at 48kHz)
+			uint16 Preskip = static_cast<uint16>(FMath::FloorToInt(PreskipDuration * SampleRate));
+			HeaderPacket.Append(reinterpret_cast<uint8*>(&Preskip), sizeof(uint16));
+
+			// Sample rate
+			HeaderPacket.Append((uint8*)(&SampleRate), sizeof(uint32));
+
+			// Output gain (0 for now)
+			int16 OutputGain = 0;
+			HeaderPacket.Append(reinterpret_cast<uint8*>(&OutputGain), sizeof(int16));
+
+			// Channel mapping
+			uint8 ChannelMapping = NumOfChannels > 2 ? 1 : 0;
+			HeaderPacket.Add(ChannelMapping);
+
+			if (ChannelMapping > 0)
+			{
+				const ChannelLayout& Layout = ChannelLayouts[NumOfChannels - 1];
+				HeaderPacket.Add(static_cast<uint8>(Layout.StreamCount));
+				HeaderPacket.Add(static_cast<uint8>(Layout.CoupledStreamCount));
+				HeaderPacket.Append(Layout.Mapping, NumOfChannels);
+			}
+
+			// Create Ogg packet
+			ogg_packet HeaderOggPacket;
+			HeaderOggPacket.packet = HeaderPacket.GetData();
+			HeaderOggPacket.bytes = HeaderPacket.Num();
+			HeaderOggPacket.b_o_s = 1; // Beginning of stream
+			HeaderOggPacket.e_o_s = 0;
+			HeaderOggPacket.granulepos = 0;
+			HeaderOggPacket.packetno = 0;
+
+			ogg_stream_packetin(&OggStreamState, &HeaderOggPacket);
+		}
+
+		// Generate comment packet
+		{
+			TArray<uint8> CommentPacket;
+			uint8 MagicNumber[8] = {'O', 'p', 'u', 's', 'T', 'a', 'g', 's'};
+			CommentPacket.Append(MagicNumber, 8);
+
+			// Vendor string
+			const char* VendorString = "RuntimeAudioImporter";
+			uint32 VendorStringLength = strlen(VendorString);
+			CommentPacket.Append(reinterpret_cast<uint8*>(&VendorStringLength), sizeof(uint32));
+			CommentPacket.Append(reinterpret_cast<const uint8*>(VendorString), VendorStringLength);
+
+			// No user comments
+			uint32 CommentListLength = 0;
+			CommentPacket.Append(reinterpret_cast<uint8*>(&CommentListLength), sizeof(uint32));
+
+			// Create Ogg packet
+			ogg_packet CommentOggPacket;
+			CommentOggPacket.packet = CommentPacket.GetData();
+			CommentOggPacket.bytes = CommentPacket.Num();
+			CommentOggPacket.b_o_s = 0;
+			CommentOggPacket.e_o_s = 0;
+			CommentOggPacket.granulepos = 0;
+			CommentOggPacket.packetno = 1;
+
+			ogg_stream_packetin(&OggStreamState, &CommentOggPacket);
+		}
+	}
+}
+
+bool FOPUS_RuntimeCodec::Encode(FDecodedAudioStruct DecodedData, FEncodedAudioStruct& EncodedData, uint8 Quality)
+{
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Encoding uncompressed audio data to OPUS audio format.\nDecoded audio info: %s.\nQuality: %d"), *DecodedData.ToString(), Quality);
 
 	// Supported Opus sample rates
 	//static const TArray<uint32> SupportedSampleRates = { 8000, 12000, 16000, 24000, 48000 };
@@ -94,32 +259,27 @@ bool FOPUS_RuntimeCodec::Encode(FDecodedAudioStruct DecodedData, FEncodedAudioSt
 	uint32 SampleRate = DecodedData.SoundWaveBasicInfo.SampleRate;
 	Audio::FAlignedFloatBuffer ProcessedPCMData = Audio::FAlignedFloatBuffer(DecodedData.PCMInfo.PCMData.GetView().GetData(), DecodedData.PCMInfo.PCMData.GetView().Num());
 
-	// Mix channels if more than 2
-	// TODO: Support more than 2 channels
-	if (NumOfChannels > 2)
-	{
-		UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("More than 2 channels detected (%d) which is not supported for OPUS encoding at the moment. Mixing to stereo"), NumOfChannels);
+	uint32 EncoderNumOfChannels, EncoderSampleRate;
+	GetOpusEncodingFormat(NumOfChannels, SampleRate, EncoderNumOfChannels, EncoderSampleRate);
 
+	if (NumOfChannels != EncoderNumOfChannels)
+	{
 		Audio::FAlignedFloatBuffer RemixedPCMData;
-		if (!FRAW_RuntimeCodec::MixChannelsRAWData(ProcessedPCMData, SampleRate, NumOfChannels, 2, RemixedPCMData))
+		if (!FRAW_RuntimeCodec::MixChannelsRAWData(ProcessedPCMData, SampleRate, NumOfChannels, EncoderNumOfChannels, RemixedPCMData))
 		{
-			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to mix channels for OPUS encoding (%d -> 2)"), NumOfChannels);
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to mix channels for OPUS encoding (%d -> %d)"), NumOfChannels, EncoderNumOfChannels);
 			return false;
 		}
 
 		ProcessedPCMData = MoveTemp(RemixedPCMData);
-		NumOfChannels = 2;
+		NumOfChannels = EncoderNumOfChannels;
 
 		UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Audio data has been mixed to stereo for OPUS encoding"));
 	}
 
-	// Resample to 48kHz if not
-	// TODO: Support other sample rates
-	if (SampleRate != 48000)
+	if (SampleRate != EncoderSampleRate)
 	{
-		UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Sample rate is not 48kHz (%d) which is not supported for OPUS encoding at the moment. Resampling to 48kHz"), SampleRate);
-
-		constexpr uint32 DestinationSampleRate = 48000;
+		const uint32 DestinationSampleRate = EncoderSampleRate;
 		Audio::FAlignedFloatBuffer ResampledPCMData;
 		if (!FRAW_RuntimeCodec::ResampleRAWData(ProcessedPCMData, NumOfChannels, SampleRate, DestinationSampleRate, ResampledPCMData))
 		{
@@ -138,130 +298,18 @@ bool FOPUS_RuntimeCodec::Encode(FDecodedAudioStruct DecodedData, FEncodedAudioSt
 	TArray<uint8> EncodedAudioData;
 
 	// Opus encoder initialization
-	OpusEncoder* OpusEnc = nullptr;
-	int OpusError;
-
-	OpusEnc = opus_encoder_create(
-		SampleRate,
-		NumOfChannels,
-		OPUS_APPLICATION_AUDIO,
-		&OpusError
-	);
-
-	if (OpusError != OPUS_OK)
+	OpusEncoder* OpusEnc = CreateOpusEncoder(SampleRate, NumOfChannels, Quality);
+	if (!OpusEnc)
 	{
-		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to create OPUS encoder: %d"), static_cast<int32>(OpusError));
 		return false;
 	}
 
-	// Configure encoder
-	{
-		// Variable bit rate encoding
-		int32 UseVbr = 1;
-		opus_encoder_ctl(OpusEnc, OPUS_SET_VBR(UseVbr));
-
-		// Disable constrained VBR
-		int32 UseCVbr = 0;
-		opus_encoder_ctl(OpusEnc, OPUS_SET_VBR_CONSTRAINT(UseCVbr));
-
-		// Complexity (1-10)
-		int32 Complexity = FMath::Clamp(static_cast<int32>(Quality / 10), 0, 10);
-		opus_encoder_ctl(OpusEnc, OPUS_SET_COMPLEXITY(Complexity));
-
-		// Disable forward error correction for this use case
-		int32 InbandFEC = 0;
-		opus_encoder_ctl(OpusEnc, OPUS_SET_INBAND_FEC(InbandFEC));
-
-		// Set bitrate
-		int BitrateKbps = FMath::Clamp(
-			static_cast<int>((Quality / 100.0f) * 320), // Max 320 kbps
-			12, // Minimum 12 kbps
-			320 // Maximum 320 kbps
-		);
-		opus_encoder_ctl(OpusEnc, OPUS_SET_BITRATE(BitrateKbps * 1000));
-	}
-
 	// Ogg stream initialization
 	ogg_stream_state OggStreamState;
 	uint32_t SerialNumber = FMath::Rand();
 	ogg_stream_init(&OggStreamState, SerialNumber);
 
-	// Generate Opus header packet
-	{
-		TArray<uint8> HeaderPacket;
-
-		// Magic number
-		uint8 MagicNumber[8] = {'O', 'p', 'u', 's', 'H', 'e', 'a', 'd'};
-		HeaderPacket.Append(MagicNumber, 8);
-
-		uint8 Version = 1;
-		HeaderPacket.Add(Version);
-
-		uint8 ChannelCount = static_cast<uint8>(NumOfChannels);
-		HeaderPacket.Add(ChannelCount);
-
-		// Preskip (fixed at 10ms, about 480 samples at 48kHz)
-		uint16 Preskip = static_cast<uint16>(FMath::FloorToInt(PreskipDuration * SampleRate));
-		HeaderPacket.Append(reinterpret_cast<uint8*>(&Preskip), sizeof(uint16));
-
-		// Sample rate
-		HeaderPacket.Append((uint8*)(&SampleRate), sizeof(uint32));
-
-		// Output gain (0 for now)
-		int16 OutputGain = 0;
-		HeaderPacket.Append(reinterpret_cast<uint8*>(&OutputGain), sizeof(int16));
-
-		// Channel mapping
-		uint8 ChannelMapping = NumOfChannels > 2 ? 1 : 0;
-		HeaderPacket.Add(ChannelMapping);
-
-		if (ChannelMapping > 0)
-		{
-			const ChannelLayout& Layout = ChannelLayouts[NumOfChannels - 1];
-			HeaderPacket.Add(static_cast<uint8>(Layout.StreamCount));
-			HeaderPacket.Add(static_cast<uint8>(Layout.CoupledStreamCount));
-			HeaderPacket.Append(Layout.Mapping, NumOfChannels);
-		}
-
-		// Create Ogg packet
-		ogg_packet HeaderOggPacket;
-		HeaderOggPacket.packet = HeaderPacket.GetData();
-		HeaderOggPacket.bytes = HeaderPacket.Num();
-		HeaderOggPacket.b_o_s = 1; // Beginning of stream
-		HeaderOggPacket.e_o_s = 0;
-		HeaderOggPacket.granulepos = 0;
-		HeaderOggPacket.packetno = 0;
-
-		ogg_stream_packetin(&OggStreamState, &HeaderOggPacket);
-	}
-
-	// Generate comment packet
-	{
-		TArray<uint8> CommentPacket;
-		uint8 MagicNumber[8] = {'O', 'p', 'u', 's', 'T', 'a', 'g', 's'};
-		CommentPacket.Append(MagicNumber, 8);
-
-		// Vendor string
-		const char* VendorString = "RuntimeAudioImporter";
-		uint32 VendorStringLength = strlen(VendorString);
-		CommentPacket.Append(reinterpret_cast<uint8*>(&VendorStringLength), sizeof(uint32));
-		CommentPacket.Append(reinterpret_cast<const uint8*>(VendorString), VendorStringLength);
-
-		// No user comments
-		uint32 CommentListLength = 0;
-		CommentPacket.Append(reinterpret_cast<uint8*>(&CommentListLength), sizeof(uint32));
-
-		// Create Ogg packet
-		ogg_packet CommentOggPacket;
-		CommentOggPacket.packet = CommentPacket.GetData();
-		CommentOggPacket.bytes = CommentPacket.Num();
-		CommentOggPacket.b_o_s = 0;
-		CommentOggPacket.e_o_s = 0;
-		CommentOggPacket.granulepos = 0;
-		CommentOggPacket.packetno = 1;
-
-		ogg_stream_packetin(&OggStreamState, &CommentOggPacket);
-	}
+	SubmitOpusHeaderPackets(OggStreamState, SampleRate, NumOfChannels);
 
 	// Flush initial headers
 	ogg_page OggPage;
@@ -380,6 +428,469 @@ bool FOPUS_RuntimeCodec::Encode(FDecodedAudioStruct DecodedData, FEncodedAudioSt
 	return true;
 }
 
+namespace
+{
+	/**
+	 * Incremental OPUS encoder session. Keeps the encoder and the Ogg stream alive between pushes and writes the pages as soon as they are produced
+	 * As with the regular encoding, the audio data is mixed to stereo if it has more than 2 channels and resampled to 48kHz (using a streaming resampler)
+	 */
+	class FOPUS_RuntimeEncoderSession : public FBaseRuntimeEncoderSession
+	{
+	public:
+		FOPUS_RuntimeEncoderSession()
+			: OpusEnc(nullptr)
+		  , bOggStreamInitialized(false)
+		  , EncoderNumOfChannels(0)
+		  , GranulePos(0)
+		  , PacketIndex(0)
+		{
+		}
+
+		virtual ~FOPUS_RuntimeEncoderSession() override
+		{
+			Release_Internal();
+		}
+
+		virtual ERuntimeAudioFormat GetAudioFormat() const override { return ERuntimeAudioFormat::OggOpus; }
+
+	protected:
+		virtual bool Begin_Internal() override
+		{
+			uint32 EncoderSampleRate;
+			GetOpusEncodingFormat(NumOfChannels, SampleRate, EncoderNumOfChannels, EncoderSampleRate);
+			check(EncoderSampleRate == EncodingSampleRate);
+
+			if (SampleRate != EncodingSampleRate)
+			{
+				Resampler = MakeUnique<Audio::FResampler>();
+				Resampler->Init(Audio::EResamplingMethod::BestSinc, static_cast<float>(EncodingSampleRate) / SampleRate, EncoderNumOfChannels);
+			}
+
+			OpusEnc = CreateOpusEncoder(EncodingSampleRate, EncoderNumOfChannels, Quality);
+			if (!OpusEnc)
+			{
+				return false;
+			}
+
+			ogg_stream_init(&OggStreamState, FMath::Rand());
+			bOggStreamInitialized = true;
+
+			SubmitOpusHeaderPackets(OggStreamState, EncodingSampleRate, EncoderNumOfChannels);
+
+			// The headers must be on separate pages before the audio data
+			ogg_page OggPage;
+			while (ogg_stream_flush(&OggStreamState, &OggPage))
+			{
+				if (!WritePage(OggPage))
+				{
+					return false;
+				}
+			}
+
+			EncodingBuffer.SetNumZeroed(FrameSize * EncoderNumOfChannels);
+			PendingPCMData.Reset();
+			GranulePos = 0;
+			PacketIndex = 2; // Start at 2 after header and comment packets
+			return true;
+		}
+
+		virtual bool PushFrames_Internal(const float* PCMData, int64 NumOfFrames) override
+		{
+			const float* ProcessedPCMData = PCMData;
+			int64 NumOfProcessedFrames = NumOfFrames;
+
+			Audio::FAlignedFloatBuffer RemixedPCMData;
+			if (NumOfChannels > 2)
+			{
+				Audio::FAlignedFloatBuffer SourcePCMData(PCMData, static_cast<int32>(NumOfFrames * NumOfChannels));
+				if (!FRAW_RuntimeCodec::MixChannelsRAWData(SourcePCMData, SampleRate, NumOfChannels, EncoderNumOfChannels, RemixedPCMData))
+				{
+					UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to mix channels for OPUS encoding (%d -> %d)"), NumOfChannels, EncoderNumOfChannels);
+					return false;
+				}
+				ProcessedPCMData = RemixedPCMData.GetData();
+			}
+
+			if (Resampler.IsValid())
+			{
+				const int32 NumOfResampledFrames = Resample(const_cast<float*>(ProcessedPCMData), static_cast<int32>(NumOfProcessedFrames), false);
+				if (NumOfResampledFrames < 0)
+				{
+					return false;
+				}
+				ProcessedPCMData = ResampledPCMData.GetData();
+				NumOfProcessedFrames = NumOfResampledFrames;
+			}
+
+			PendingPCMData.Append(ProcessedPCMData, NumOfProcessedFrames * EncoderNumOfChannels);
+			return EncodePendingFrames(false);
+		}
+
+		virtual bool Finish_Internal() override
+		{
+			// Collect the frames still held by the resampler
+			if (Resampler.IsValid())
+			{
+				float EmptyInput = 0;
+				const int32 NumOfResampledFrames = Resample(&EmptyInput, 0, true);
+				if (NumOfResampledFrames < 0)
+				{
+					return false;
+				}
+				PendingPCMData.Append(ResampledPCMData.GetData(), NumOfResampledFrames * EncoderNumOfChannels);
+			}
+
+			if (!EncodePendingFrames(true))
+			{
+				return false;
+			}
+
+			// Final flush
+			ogg_page OggPage;
+			while (ogg_stream_flush(&OggStreamState, &OggPage))
+			{
+				if (!WritePage(OggPage))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		virtual void Release_Internal() override
+		{
+			if (OpusEnc)
+			{
+				opus_encoder_destroy(OpusEnc);
+				OpusEnc = nullptr;
+			}
+
+			if (bOggStreamInitialized)
+			{
+				ogg_stream_clear(&OggStreamState);
+				bOggStreamInitialized = false;
+			}
+
+			Resampler.Reset();
+			PendingPCMData.Empty();
+			ResampledPCMData.Empty();
+			EncodingBuffer.Empty();
+		}
+
+	private:
+		/**
+		 * Resample the specified frames to the encoding sample rate into ResampledPCMData
+		 *
+		 * @return The number of resampled frames, or -1 if resampling failed
+		 */
+		int32 Resample(float* PCMData, int32 NumOfFrames, bool bEndOfInput)
+		{
+			const float SampleRateRatio = static_cast<float>(EncodingSampleRate) / SampleRate;
+
+			// Leaving room for the frames held back by the resampler filter
+			const int32 MaxOutputFrames = FMath::CeilToInt(NumOfFrames * SampleRateRatio) + FrameSize;
+			ResampledPCMData.SetNumUninitialized(MaxOutputFrames * EncoderNumOfChannels);
+
+			int32 NumOfResampledFrames = 0;
+			const int32 ErrorCode = Resampler->ProcessAudio(PCMData, NumOfFrames, bEndOfInput, ResampledPCMData.GetData(), MaxOutputFrames, NumOfResampledFrames);
+			if (ErrorCode != 0)
+			{
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to resample audio data for OPUS encoding (%d -> %d), error code: %d"), SampleRate, EncodingSampleRate, ErrorCode);
+				return -1;
+			}
+
+			return NumOfResampledFrames;
+		}
+
+		/**
+		 * Encode the complete 20ms frames accumulated so far. The remaining frames are kept for the next push, or padded and encoded as the last packet if finishing
+		 */
+		bool EncodePendingFrames(bool bEndOfStream)
+		{
+			const int64 NumOfPendingFrames = PendingPCMData.Num() / EncoderNumOfChannels;
+			int64 FramesProcessed = 0;
+
+			// When finishing, the last frame is always encoded separately to mark the end of the stream
+			while (NumOfPendingFrames - FramesProcessed > (bEndOfStream ? FrameSize : FrameSize - 1))
+			{
+				if (!EncodeFrame(PendingPCMData.GetData() + FramesProcessed * EncoderNumOfChannels, FrameSize, false))
+				{
+					return false;
+				}
+				FramesProcessed += FrameSize;
+			}
+
+			if (bEndOfStream)
+			{
+				if (!EncodeFrame(PendingPCMData.GetData() + FramesProcessed * EncoderNumOfChannels, static_cast<int32>(NumOfPendingFrames - FramesProcessed), true))
+				{
+					return false;
+				}
+				PendingPCMData.Reset();
+				return true;
+			}
+
+			PendingPCMData.RemoveAt(0, FramesProcessed * EncoderNumOfChannels);
+			return true;
+		}
+
+		/**
+		 * Encode a single 20ms frame, padding it with silence if necessary, and write the complete pages
+		 */
+		bool EncodeFrame(const float* PCMData, int32 NumOfFrames, bool bEndOfStream)
+		{
+			if (NumOfFrames > 0)
+			{
+				FMemory::Memcpy(EncodingBuffer.GetData(), PCMData, NumOfFrames * EncoderNumOfChannels * sizeof(float));
+			}
+
+			// Ensure buffer is filled if last chunk is smaller
+			if (NumOfFrames < FrameSize)
+			{
+				FMemory::Memzero(EncodingBuffer.GetData() + NumOfFrames * EncoderNumOfChannels, (FrameSize - NumOfFrames) * EncoderNumOfChannels * sizeof(float));
+			}
+
+			uint8 CompressedBuffer[4096]; // Large enough buffer for compressed data
+			const int32 CompressedSize = opus_encode_float(OpusEnc, EncodingBuffer.GetData(), FrameSize, CompressedBuffer, sizeof(CompressedBuffer));
+			if (CompressedSize < 0)
+			{
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Opus encoding failed: error %d: %s"), CompressedSize, *FString(ANSI_TO_TCHAR(opus_strerror(CompressedSize))));
+				return false;
+			}
+
+			GranulePos += NumOfFrames;
+
+			ogg_packet OpusPacket;
+			OpusPacket.packet = CompressedBuffer;
+			OpusPacket.bytes = CompressedSize;
+			OpusPacket.b_o_s = 0;
+			OpusPacket.e_o_s = bEndOfStream ? 1 : 0;
+			OpusPacket.granulepos = GranulePos;
+			OpusPacket.packetno = PacketIndex++;
+
+			ogg_stream_packetin(&OggStreamState, &OpusPacket);
+
+			ogg_page OggPage;
+			while (ogg_stream_pageout(&OggStreamState, &OggPage))
+			{
+				if (!WritePage(OggPage))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		bool WritePage(const ogg_page& OggPage)
+		{
+			return Write(OggPage.header, OggPage.header_len) && Write(OggPage.body, OggPage.body_len);
+		}
+
+		/** The sample rate the data is encoded at */
+		static constexpr uint32 EncodingSampleRate = OpusEncodingSampleRate;
+
+		/** The number of frames in a single 20ms Opus frame */
+		static constexpr int32 FrameSize = EncodingSampleRate / 50;
+
+		OpusEncoder* OpusEnc;
+		ogg_stream_state OggStreamState;
+		bool bOggStreamInitialized;
+
+		/** Streaming resampler, valid only if the pushed data is not at the encoding sample rate */
+		TUniquePtr<Audio::FResampler> Resampler;
+
+		/** The number of channels the data is encoded with */
+		uint32 EncoderNumOfChannels;
+
+		/** Processed frames not yet forming a complete Opus frame */
+		TArray<float> PendingPCMData;
+
+		/** Reused output of the resampler */
+		Audio::FAlignedFloatBuffer ResampledPCMData;
+
+		/** Reused input of the encoder */
+		TArray<float> EncodingBuffer;
+
+		int64 GranulePos;
+		int64 PacketIndex;
+	};
+}
+
+TUniquePtr<FBaseRuntimeEncoderSession> FOPUS_RuntimeCodec::CreateEncoderSession()
+{
+	return MakeUnique<FOPUS_RuntimeEncoderSession>();
+}
+
+namespace
+{
+	/**
+	 * Incremental OPUS decoder session. Keeps the Ogg sync and stream state and the decoder state between pushes, so the pushed data may end in the middle of a page
+	 * OPUS is always decoded at 48 kHz, the original sample rate stored in the header is informational only
+	 */
+	class FOPUS_RuntimeDecoderSession : public FBaseRuntimeDecoderSession
+	{
+	public:
+		FOPUS_RuntimeDecoderSession()
+			: bOggStreamInitialized(false)
+		  , Decoder(nullptr)
+		  , NumOfHeaderPackets(0)
+		  , NumOfChannels(0)
+		  , NumOfFramesToSkip(0)
+		{
+			ogg_sync_init(&OggSyncState);
+		}
+
+		virtual ~FOPUS_RuntimeDecoderSession() override
+		{
+			Release_Internal();
+		}
+
+		virtual ERuntimeAudioFormat GetAudioFormat() const override { return ERuntimeAudioFormat::OggOpus; }
+
+	protected:
+		virtual bool Decode_Internal(bool bEndOfStream) override
+		{
+			// The Ogg sync layer keeps the incomplete page until the rest of it is pushed
+			const int64 NumOfPendingBytes = GetNumOfPendingBytes();
+			if (NumOfPendingBytes > 0)
+			{
+				char* SyncBuffer = ogg_sync_buffer(&OggSyncState, static_cast<long>(NumOfPendingBytes));
+				FMemory::Memcpy(SyncBuffer, GetPendingData(), NumOfPendingBytes);
+				ogg_sync_wrote(&OggSyncState, static_cast<long>(NumOfPendingBytes));
+				ConsumePendingData(NumOfPendingBytes);
+			}
+
+			ogg_page OggPage;
+			while (ogg_sync_pageout(&OggSyncState, &OggPage) == 1)
+			{
+				if (!bOggStreamInitialized)
+				{
+					ogg_stream_init(&OggStreamState, ogg_page_serialno(&OggPage));
+					bOggStreamInitialized = true;
+				}
+
+				// Only the first logical stream is decoded
+				if (ogg_stream_pagein(&OggStreamState, &OggPage) != 0)
+				{
+					continue;
+				}
+
+				ogg_packet OggPacket;
+				int32 PacketResult;
+				while ((PacketResult = ogg_stream_packetout(&OggStreamState, &OggPacket)) != 0)
+				{
+					// A gap in the data, the next packet is decoded as usual
+					if (PacketResult < 0)
+					{
+						continue;
+					}
+
+					if (!DecodePacket(OggPacket))
+					{
+						return false;
+					}
+				}
+			}
+
+			return true;
+		}
+
+		virtual void Release_Internal() override
+		{
+			if (Decoder)
+			{
+				opus_multistream_decoder_destroy(Decoder);
+				Decoder = nullptr;
+			}
+			if (bOggStreamInitialized)
+			{
+				ogg_stream_clear(&OggStreamState);
+				bOggStreamInitialized = false;
+			}
+			ogg_sync_clear(&OggSyncState);
+		}
+
+	private:
+		bool DecodePacket(const ogg_packet& OggPacket)
+		{
+			// The identification header comes first, followed by the comment header
+			if (NumOfHeaderPackets == 0)
+			{
+				OpusHead Head;
+				if (opus_head_parse(&Head, OggPacket.packet, static_cast<size_t>(OggPacket.bytes)) != 0)
+				{
+					UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to parse OPUS header"));
+					return false;
+				}
+
+				int ErrorCode;
+				Decoder = opus_multistream_decoder_create(OpusSampleRate, Head.channel_count, Head.stream_count, Head.coupled_count, Head.mapping, &ErrorCode);
+				if (!Decoder || ErrorCode != OPUS_OK)
+				{
+					UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to create OPUS decoder, error code: %d (%s)"), static_cast<int32>(ErrorCode), *FString(ANSI_TO_TCHAR(opus_strerror(ErrorCode))));
+					return false;
+				}
+				opus_multistream_decoder_ctl(Decoder, OPUS_SET_GAIN(Head.output_gain));
+
+				NumOfChannels = Head.channel_count;
+				NumOfFramesToSkip = Head.pre_skip;
+				++NumOfHeaderPackets;
+				return SetFormat(OpusSampleRate, static_cast<uint32>(NumOfChannels));
+			}
+			if (NumOfHeaderPackets == 1)
+			{
+				++NumOfHeaderPackets;
+				return true;
+			}
+
+			// The maximum packet duration is 120 ms
+			DecodedPCMData.SetNumUninitialized(MaxNumOfFramesPerPacket * NumOfChannels);
+			const int32 NumOfFrames = opus_multistream_decode_float(Decoder, OggPacket.packet, static_cast<opus_int32>(OggPacket.bytes), DecodedPCMData.GetData(), MaxNumOfFramesPerPacket, 0);
+			if (NumOfFrames < 0)
+			{
+				UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Failed to decode OPUS packet, error code: %d (%s). Skipping it"), NumOfFrames, *FString(ANSI_TO_TCHAR(opus_strerror(NumOfFrames))));
+				return true;
+			}
+
+			// Dropping the encoder delay at the start of the stream
+			const int32 NumOfFramesSkipped = FMath::Min(NumOfFrames, NumOfFramesToSkip);
+			NumOfFramesToSkip -= NumOfFramesSkipped;
+			if (NumOfFrames == NumOfFramesSkipped)
+			{
+				return true;
+			}
+
+			return EmitFrames(DecodedPCMData.GetData() + NumOfFramesSkipped * NumOfChannels, NumOfFrames - NumOfFramesSkipped);
+		}
+
+		static constexpr int32 OpusSampleRate = 48000;
+		static constexpr int32 MaxNumOfFramesPerPacket = 5760;
+
+		ogg_sync_state OggSyncState;
+		ogg_stream_state OggStreamState;
+		bool bOggStreamInitialized;
+		OpusMSDecoder* Decoder;
+
+		/** The number of header packets decoded so far */
+		int32 NumOfHeaderPackets;
+
+		int32 NumOfChannels;
+
+		/** The number of frames left to skip at the start of the stream (pre-skip) */
+		int32 NumOfFramesToSkip;
+
+		/** Reused buffer for the decoded PCM data */
+		TArray<float> DecodedPCMData;
+	};
+}
+
+TUniquePtr<FBaseRuntimeDecoderSession> FOPUS_RuntimeCodec::CreateDecoderSession()
+{
+	return MakeUnique<FOPUS_RuntimeDecoderSession>();
+}
+
 bool FOPUS_RuntimeCodec::Decode(FEncodedAudioStruct EncodedData, FDecodedAudioStruct& DecodedData)
 {
 	int ErrorCode;
@@ -0,0 +1,337 @@
+﻿// Georgy Treshchev 2024.
+
+#include "Codecs/OPUS_RuntimePacketCodec.h"
+#include "RuntimeAudioImporterDefines.h"
+#include "HAL/UnrealMemory.h"
+
+#define INCLUDE_OPUS_PACKET
+#include "CodecIncludes.h"
+#undef INCLUDE_OPUS_PACKET
+
+namespace
+{
+	/** The duration of the longest Opus packet, in milliseconds */
+	constexpr int32 MaxPacketDurationMs = 120;
+
+	bool IsOpusFormatSupported(uint32 SampleRate, uint32 NumOfChannels)
+	{
+		const bool bSampleRateSupported = SampleRate == 8000 || SampleRate == 12000 || SampleRate == 16000 || SampleRate == 24000 || SampleRate == 48000;
+		return bSampleRateSupported && (NumOfChannels == 1 || NumOfChannels == 2);
+	}
+}
+
+FOPUS_RuntimePacketEncoder::FOPUS_RuntimePacketEncoder()
+	: Encoder(nullptr)
+  , NumOfChannels(0)
+  , NumOfFramesPerPacket(0)
+  , NumOfPendingFrames(0)
+{
+}
+
+FOPUS_RuntimePacketEncoder::~FOPUS_RuntimePacketEncoder()
+{
+	Release();
+}
+
+bool FOPUS_RuntimePacketEncoder::Initialize(uint32 InSampleRate, uint32 InNumOfChannels, int32 Bitrate, int32 ExpectedPacketLossPercentage)
+{
+	Release();
+
+	if (!IsOpusFormatSupported(InSampleRate, InNumOfChannels))
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to initialize OPUS packet encoder as the format is not supported (sample rate: %d, number of channels: %d)"), InSampleRate, InNumOfChannels);
+		return false;
+	}
+
+	int ErrorCode;
+	Encoder = opus_encoder_create(static_cast<opus_int32>(InSampleRate), static_cast<int>(InNumOfChannels), OPUS_APPLICATION_VOIP, &ErrorCode);
+	if (ErrorCode != OPUS_OK || !Encoder)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to create OPUS packet encoder: %d: %s"), ErrorCode, *FString(ANSI_TO_TCHAR(opus_strerror(ErrorCode))));
+		Encoder = nullptr;
+		return false;
+	}
+
+	opus_encoder_ctl(Encoder, OPUS_SET_BITRATE(Bitrate));
+	opus_encoder_ctl(Encoder, OPUS_SET_INBAND_FEC(ExpectedPacketLossPercentage > 0 ? 1 : 0));
+	opus_encoder_ctl(Encoder, OPUS_SET_PACKET_LOSS_PERC(FMath::Clamp(ExpectedPacketLossPercentage, 0, 100)));
+
+	NumOfChannels = InNumOfChannels;
+	NumOfFramesPerPacket = static_cast<int32>(InSampleRate / 50);
+	PendingPCMData.SetNumZeroed(NumOfFramesPerPacket * NumOfChannels);
+	NumOfPendingFrames = 0;
+	return true;
+}
+
+bool FOPUS_RuntimePacketEncoder::PushFrames(const float* PCMData, int64 NumOfFrames, TArray<TArray<uint8>>& OutPackets)
+{
+	if (!Encoder)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to push frames to OPUS packet encoder as it is not initialized"));
+		return false;
+	}
+
+	while (NumOfFrames > 0)
+	{
+		const int32 NumOfFramesToCopy = static_cast<int32>(FMath::Min<int64>(NumOfFrames, NumOfFramesPerPacket - NumOfPendingFrames));
+		FMemory::Memcpy(PendingPCMData.GetData() + NumOfPendingFrames * NumOfChannels, PCMData, NumOfFramesToCopy * NumOfChannels * sizeof(float));
+		NumOfPendingFrames += NumOfFramesToCopy;
+		PCMData += NumOfFramesToCopy * NumOfChannels;
+		NumOfFrames -= NumOfFramesToCopy;
+
+		if (NumOfPendingFrames == NumOfFramesPerPacket && !EncodePacket(OutPackets))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FOPUS_RuntimePacketEncoder::Flush(TArray<TArray<uint8>>& OutPackets)
+{
+	if (!Encoder || NumOfPendingFrames == 0)
+	{
+		return Encoder != nullptr;
+	}
+
+	FMemory::Memzero(PendingPCMData.GetData() + NumOfPendingFrames * NumOfChannels, (NumOfFramesPerPacket - NumOfPendingFrames) * NumOfChannels * sizeof(float));
+	return EncodePacket(OutPackets);
+}
+
+bool FOPUS_RuntimePacketEncoder::EncodePacket(TArray<TArray<uint8>>& OutPackets)
+{
+	// The largest packet Opus recommends to allocate for
+	constexpr int32 MaxPacketSize = 4000;
+
+	TArray<uint8>& Packet = OutPackets.AddDefaulted_GetRef();
+	Packet.SetNumUninitialized(MaxPacketSize);
+
+	const int32 PacketSize = opus_encode_float(Encoder, PendingPCMData.GetData(), NumOfFramesPerPacket, Packet.GetData(), MaxPacketSize);
+	NumOfPendingFrames = 0;
+	if (PacketSize < 0)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("OPUS packet encoding failed: error %d: %s"), PacketSize, *FString(ANSI_TO_TCHAR(opus_strerror(PacketSize))));
+		OutPackets.Pop();
+		return false;
+	}
+
+	Packet.SetNum(PacketSize);
+	return true;
+}
+
+void FOPUS_RuntimePacketEncoder::Release()
+{
+	if (Encoder)
+	{
+		opus_encoder_destroy(Encoder);
+		Encoder = nullptr;
+	}
+}
+
+FOPUS_RuntimePacketDecoder::FOPUS_RuntimePacketDecoder()
+	: Decoder(nullptr)
+  , SampleRate(0)
+  , NumOfChannels(0)
+  , NumOfFramesPerPacket(0)
+{
+}
+
+FOPUS_RuntimePacketDecoder::~FOPUS_RuntimePacketDecoder()
+{
+	Release();
+}
+
+bool FOPUS_RuntimePacketDecoder::Initialize(uint32 InSampleRate, uint32 InNumOfChannels)
+{
+	Release();
+
+	if (!IsOpusFormatSupported(InSampleRate, InNumOfChannels))
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to initialize OPUS packet decoder as the format is not supported (sample rate: %d, number of channels: %d)"), InSampleRate, InNumOfChannels);
+		return false;
+	}
+
+	int ErrorCode;
+	Decoder = opus_decoder_create(static_cast<opus_int32>(InSampleRate), static_cast<int>(InNumOfChannels), &ErrorCode);
+	if (ErrorCode != OPUS_OK || !Decoder)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to create OPUS packet decoder: %d: %s"), ErrorCode, *FString(ANSI_TO_TCHAR(opus_strerror(ErrorCode))));
+		Decoder = nullptr;
+		return false;
+	}
+
+	SampleRate = InSampleRate;
+	NumOfChannels = InNumOfChannels;
+
+	// 20ms until the first packet tells otherwise
+	NumOfFramesPerPacket = static_cast<int32>(SampleRate / 50);
+	return true;
+}
+
+int32 FOPUS_RuntimePacketDecoder::DecodePacket(const uint8* PacketData, int32 PacketSize, TArray<float>& OutPCMData)
+{
+	const int32 NumOfDecodedFrames = Decode(PacketData, PacketSize, static_cast<int32>(SampleRate * MaxPacketDurationMs / 1000), false, OutPCMData);
+	if (NumOfDecodedFrames > 0)
+	{
+		NumOfFramesPerPacket = NumOfDecodedFrames;
+	}
+	return NumOfDecodedFrames;
+}
+
+int32 FOPUS_RuntimePacketDecoder::RecoverLostPacket(const uint8* NextPacketData, int32 NextPacketSize, TArray<float>& OutPCMData)
+{
+	// The FEC data describes exactly the duration of the lost packet, which is assumed to be the same as the one of the last decoded packet
+	return Decode(NextPacketData, NextPacketSize, NumOfFramesPerPacket, true, OutPCMData);
+}
+
+int32 FOPUS_RuntimePacketDecoder::ConcealLostPacket(TArray<float>& OutPCMData)
+{
+	return Decode(nullptr, 0, NumOfFramesPerPacket, false, OutPCMData);
+}
+
+int32 FOPUS_RuntimePacketDecoder::Decode(const uint8* PacketData, int32 PacketSize, int32 MaxNumOfFrames, bool bDecodeFEC, TArray<float>& OutPCMData)
+{
+	if (!Decoder)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to decode OPUS packet as the decoder is not initialized"));
+		return -1;
+	}
+
+	const int32 PreviousNumOfSamples = OutPCMData.Num();
+	OutPCMData.AddUninitialized(MaxNumOfFrames * NumOfChannels);
+
+	const int32 NumOfDecodedFrames = opus_decode_float(Decoder, PacketData, PacketSize, OutPCMData.GetData() + PreviousNumOfSamples, MaxNumOfFrames, bDecodeFEC ? 1 : 0);
+	if (NumOfDecodedFrames < 0)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("OPUS packet decoding failed: error %d: %s"), NumOfDecodedFrames, *FString(ANSI_TO_TCHAR(opus_strerror(NumOfDecodedFrames))));
+		OutPCMData.SetNum(PreviousNumOfSamples);
+		return -1;
+	}
+
+	OutPCMData.SetNum(PreviousNumOfSamples + NumOfDecodedFrames * NumOfChannels);
+	return NumOfDecodedFrames;
+}
+
+void FOPUS_RuntimePacketDecoder::Release()
+{
+	if (Decoder)
+	{
+		opus_decoder_destroy(Decoder);
+		Decoder = nullptr;
+	}
+}
+
+FOPUS_RuntimeJitterBuffer::FOPUS_RuntimeJitterBuffer(int32 InDepth)
+	: Depth(FMath::Max(InDepth, 1))
+  , NextSequenceNumber(INDEX_NONE)
+  , HighestSequenceNumber(INDEX_NONE)
+{
+}
+
+bool FOPUS_RuntimeJitterBuffer::Initialize(uint32 InSampleRate, uint32 InNumOfChannels)
+{
+	PendingPackets.Reset();
+	NextSequenceNumber = INDEX_NONE;
+	HighestSequenceNumber = INDEX_NONE;
+	Stats = FOPUS_RuntimeJitterBufferStats();
+	return Decoder.Initialize(InSampleRate, InNumOfChannels);
+}
+
+bool FOPUS_RuntimeJitterBuffer::PushPacket(int64 SequenceNumber, TArray<uint8>&& Packet)
+{
+	++Stats.NumOfReceivedPackets;
+
+	if (SequenceNumber < 0)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to push OPUS packet to the jitter buffer as the sequence number (%lld) is negative"), SequenceNumber);
+		return false;
+	}
+
+	if (NextSequenceNumber != INDEX_NONE && SequenceNumber < NextSequenceNumber)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Verbose, TEXT("Dropping OPUS packet %lld as it arrived too late (expected %lld)"), SequenceNumber, NextSequenceNumber);
+		++Stats.NumOfLatePackets;
+		return false;
+	}
+
+	if (PendingPackets.Contains(SequenceNumber))
+	{
+		++Stats.NumOfDuplicatePackets;
+		return false;
+	}
+
+	if (SequenceNumber < HighestSequenceNumber)
+	{
+		++Stats.NumOfReorderedPackets;
+	}
+	HighestSequenceNumber = FMath::Max(HighestSequenceNumber, SequenceNumber);
+
+	PendingPackets.Add(SequenceNumber, MoveTemp(Packet));
+	return true;
+}
+
+int64 FOPUS_RuntimeJitterBuffer::PopFrames(TArray<float>& OutPCMData, bool bFlush)
+{
+	if (PendingPackets.Num() == 0 || !Decoder.IsInitialized())
+	{
+		return 0;
+	}
+
+	int64 LowestSequenceNumber = TNumericLimits<int64>::Max();
+	for (const TPair<int64, TArray<uint8>>& Pair : PendingPackets)
+	{
+		LowestSequenceNumber = FMath::Min(LowestSequenceNumber, Pair.Key);
+	}
+
+	if (NextSequenceNumber == INDEX_NONE)
+	{
+		// Waiting for the packets preceding the first one received, which may have been reordered
+		if (!bFlush && HighestSequenceNumber - LowestSequenceNumber < Depth)
+		{
+			return 0;
+		}
+		NextSequenceNumber = LowestSequenceNumber;
+	}
+	else if (LowestSequenceNumber - NextSequenceNumber > MaxNumOfConcealedPackets)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Skipping %lld missing OPUS packets instead of concealing them"), LowestSequenceNumber - NextSequenceNumber);
+		NextSequenceNumber = LowestSequenceNumber;
+	}
+
+	int64 NumOfFrames = 0;
+	while (PendingPackets.Num() > 0)
+	{
+		int32 NumOfDecodedFrames;
+		if (TArray<uint8>* Packet = PendingPackets.Find(NextSequenceNumber))
+		{
+			NumOfDecodedFrames = Decoder.DecodePacket(Packet->GetData(), Packet->Num(), OutPCMData);
+			PendingPackets.Remove(NextSequenceNumber);
+			++Stats.NumOfDecodedPackets;
+		}
+		else
+		{
+			// The packet is declared lost only once a packet Depth sequence numbers newer has arrived, as it may still be on its way
+			if (!bFlush && HighestSequenceNumber - NextSequenceNumber < Depth)
+			{
+				break;
+			}
+
+			if (const TArray<uint8>* NextPacket = PendingPackets.Find(NextSequenceNumber + 1))
+			{
+				NumOfDecodedFrames = Decoder.RecoverLostPacket(NextPacket->GetData(), NextPacket->Num(), OutPCMData);
+				++Stats.NumOfRecoveredPackets;
+			}
+			else
+			{
+				NumOfDecodedFrames = Decoder.ConcealLostPacket(OutPCMData);
+				++Stats.NumOfConcealedPackets;
+			}
+		}
+
+		++NextSequenceNumber;
+		NumOfFrames += FMath::Max(NumOfDecodedFrames, 0);
+	}
+
+	return NumOfFrames;
+}
@@ -0,0 +1,168 @@
+﻿// Georgy Treshchev 2024.
+
+#include "Codecs/RuntimeDecoderSession.h"
+#include "RuntimeAudioImporterDefines.h"
+
+FBaseRuntimeDecoderSession::FBaseRuntimeDecoderSession()
+	: PendingDataOffset(0)
+  , SampleRate(0)
+  , NumOfChannels(0)
+  , TargetSampleRate(0)
+  , TargetNumOfChannels(0)
+  , bFinished(false)
+  , NumOfBytesPushed(0)
+  , NumOfFramesDecoded(0)
+{
+}
+
+FBaseRuntimeDecoderSession::~FBaseRuntimeDecoderSession()
+{
+	// Release_Internal can't be called here since the derived part has already been destroyed, so derived sessions release their resources in their own destructors
+	if (!bFinished && NumOfBytesPushed > 0)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Log, TEXT("The decoder session is being destroyed without being finished. '%lld' pending bytes are discarded"), GetNumOfPendingBytes());
+	}
+}
+
+void FBaseRuntimeDecoderSession::SetTargetFormat(uint32 InTargetSampleRate, uint32 InTargetNumOfChannels)
+{
+	if (Converter.IsValid())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Unable to set the target format of the decoder session after decoding has started"));
+		return;
+	}
+
+	TargetSampleRate = InTargetSampleRate;
+	TargetNumOfChannels = InTargetNumOfChannels;
+}
+
+bool FBaseRuntimeDecoderSession::PushData(const uint8* Data, int64 Size, FDecodedAudioStruct& OutDecodedAudioInfo)
+{
+	if (bFinished)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to push data to the decoder session as it has been finished"));
+		return false;
+	}
+
+	if (!Data || Size <= 0)
+	{
+		return Size == 0;
+	}
+
+	PendingData.Append(Data, Size);
+	NumOfBytesPushed += Size;
+
+	const bool bSucceeded = Decode_Internal(false);
+
+	// Keeping only the incomplete data for the next push. It is at most one frame or page, so moving it is cheap
+	if (PendingDataOffset > 0)
+	{
+		PendingData.RemoveAt(0, PendingDataOffset);
+		PendingDataOffset = 0;
+	}
+
+	if (!bSucceeded)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to decode '%lld' bytes pushed to the %s decoder session"), Size, *UEnum::GetValueAsString(GetAudioFormat()));
+		Release_Internal();
+		bFinished = true;
+		return false;
+	}
+
+	ReleaseDecodedAudio(OutDecodedAudioInfo);
+	return true;
+}
+
+bool FBaseRuntimeDecoderSession::Finish(FDecodedAudioStruct& OutDecodedAudioInfo)
+{
+	if (bFinished)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to finish the decoder session as it has already been finished"));
+		return false;
+	}
+
+	bool bSucceeded = Decode_Internal(true);
+	if (bSucceeded && Converter.IsValid())
+	{
+		bSucceeded = Converter->Finish();
+	}
+
+	Release_Internal();
+	bFinished = true;
+
+	PendingData.Empty();
+	PendingDataOffset = 0;
+
+	if (!bSucceeded)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to finish the %s decoder session"), *UEnum::GetValueAsString(GetAudioFormat()));
+		return false;
+	}
+
+	ReleaseDecodedAudio(OutDecodedAudioInfo);
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully finished the %s decoder session (bytes pushed: %lld, frames decoded: %lld)"), *UEnum::GetValueAsString(GetAudioFormat()), NumOfBytesPushed, NumOfFramesDecoded);
+	return true;
+}
+
+void FBaseRuntimeDecoderSession::ConsumePendingData(int64 NumOfBytes)
+{
+	PendingDataOffset = FMath::Min<int64>(PendingDataOffset + FMath::Max<int64>(NumOfBytes, 0), PendingData.Num());
+}
+
+bool FBaseRuntimeDecoderSession::SetFormat(uint32 InSampleRate, uint32 InNumOfChannels)
+{
+	if (Converter.IsValid())
+	{
+		if (InSampleRate != SampleRate || InNumOfChannels != NumOfChannels)
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to change the format of the %s decoder session in the middle of the stream (sample rate: %d -> %d, number of channels: %d -> %d)"),
+				*UEnum::GetValueAsString(GetAudioFormat()), SampleRate, InSampleRate, NumOfChannels, InNumOfChannels);
+			return false;
+		}
+		return true;
+	}
+
+	Converter = MakeUnique<FRuntimePCMFormatConverter>(InSampleRate, InNumOfChannels, TargetSampleRate, TargetNumOfChannels);
+	if (!Converter->IsValid())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("The %s decoder session has an invalid format (sample rate: %d, number of channels: %d)"), *UEnum::GetValueAsString(GetAudioFormat()), InSampleRate, InNumOfChannels);
+		Converter.Reset();
+		return false;
+	}
+
+	SampleRate = InSampleRate;
+	NumOfChannels = InNumOfChannels;
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("The %s decoder session has started decoding (sample rate: %d, number of channels: %d)"), *UEnum::GetValueAsString(GetAudioFormat()), SampleRate, NumOfChannels);
+	return true;
+}
+
+bool FBaseRuntimeDecoderSession::EmitFrames(const float* PCMData, int64 NumOfFrames)
+{
+	if (!Converter.IsValid())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to emit decoded frames before the format of the %s decoder session is known"), *UEnum::GetValueAsString(GetAudioFormat()));
+		return false;
+	}
+
+	if (!Converter->PushFrames(PCMData, NumOfFrames))
+	{
+		return false;
+	}
+
+	NumOfFramesDecoded += NumOfFrames;
+	return true;
+}
+
+void FBaseRuntimeDecoderSession::ReleaseDecodedAudio(FDecodedAudioStruct& OutDecodedAudioInfo)
+{
+	OutDecodedAudioInfo = FDecodedAudioStruct();
+	if (!Converter.IsValid())
+	{
+		return;
+	}
+
+	Converter->ReleaseDecodedAudio(OutDecodedAudioInfo);
+	OutDecodedAudioInfo.SoundWaveBasicInfo.AudioFormat = GetAudioFormat();
+}
@@ -0,0 +1,179 @@
+﻿// Georgy Treshchev 2024.
+
+#include "Codecs/RuntimeEncodedAudioSink.h"
+#include "RuntimeAudioImporterDefines.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Serialization/Archive.h"
+
+FRuntimeFileHandleAudioSink::FRuntimeFileHandleAudioSink(TUniquePtr<IFileHandle> InFileHandle, int64 InAsyncWriteBufferSize)
+	: FileHandle(MoveTemp(InFileHandle))
+  , AsyncWriteBufferSize(FMath::Max<int64>(InAsyncWriteBufferSize, 0))
+  , Position(FileHandle.IsValid() ? FileHandle->Tell() : 0)
+{
+	if (AsyncWriteBufferSize > 0)
+	{
+		ActiveBuffer.Reserve(AsyncWriteBufferSize);
+		WritingBuffer.Reserve(AsyncWriteBufferSize);
+	}
+}
+
+FRuntimeFileHandleAudioSink::~FRuntimeFileHandleAudioSink()
+{
+	// The file handle must not be destroyed while it is being written to
+	WaitForPendingWrite();
+
+	if (ActiveBuffer.Num() > 0 && FileHandle.IsValid())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("The file sink is being destroyed without being flushed. Writing the remaining '%lld' bytes"), ActiveBuffer.Num());
+		FileHandle->Write(ActiveBuffer.GetData(), ActiveBuffer.Num());
+	}
+}
+
+bool FRuntimeFileHandleAudioSink::Write(const uint8* Data, int64 Size)
+{
+	if (!FileHandle.IsValid())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to write encoded data as the file handle is invalid"));
+		return false;
+	}
+
+	if (AsyncWriteBufferSize <= 0)
+	{
+		if (!FileHandle->Write(Data, Size))
+		{
+			return false;
+		}
+		Position += Size;
+		return true;
+	}
+
+	while (Size > 0)
+	{
+		const int64 SizeToCopy = FMath::Min<int64>(Size, AsyncWriteBufferSize - ActiveBuffer.Num());
+		ActiveBuffer.Append(Data, SizeToCopy);
+		Data += SizeToCopy;
+		Size -= SizeToCopy;
+		Position += SizeToCopy;
+
+		if (ActiveBuffer.Num() >= AsyncWriteBufferSize && !SubmitActiveBuffer())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FRuntimeFileHandleAudioSink::Seek(int64 NewPosition)
+{
+	if (!FileHandle.IsValid())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to seek as the file handle is invalid"));
+		return false;
+	}
+
+	// All buffered data must be written before the file position changes
+	if (!SubmitActiveBuffer() || !WaitForPendingWrite())
+	{
+		return false;
+	}
+
+	if (!FileHandle->Seek(NewPosition))
+	{
+		return false;
+	}
+
+	Position = NewPosition;
+	return true;
+}
+
+int64 FRuntimeFileHandleAudioSink::Tell() const
+{
+	return Position;
+}
+
+bool FRuntimeFileHandleAudioSink::Flush()
+{
+	if (!FileHandle.IsValid())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to flush as the file handle is invalid"));
+		return false;
+	}
+
+	if (!SubmitActiveBuffer() || !WaitForPendingWrite())
+	{
+		return false;
+	}
+
+	return FileHandle->Flush();
+}
+
+bool FRuntimeFileHandleAudioSink::SubmitActiveBuffer()
+{
+	if (ActiveBuffer.Num() <= 0)
+	{
+		return true;
+	}
+
+	if (!WaitForPendingWrite())
+	{
+		return false;
+	}
+
+	// The buffer that has just been written is reused for the next data, so no allocations happen after the first two buffers are filled
+	Swap(ActiveBuffer, WritingBuffer);
+	ActiveBuffer.Reset();
+
+	PendingWrite = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this]()
+	{
+		return FileHandle->Write(WritingBuffer.GetData(), WritingBuffer.Num());
+	}, UE::Tasks::ETaskPriority::BackgroundHigh);
+
+	return true;
+}
+
+bool FRuntimeFileHandleAudioSink::WaitForPendingWrite()
+{
+	if (!PendingWrite.IsValid())
+	{
+		return true;
+	}
+
+	const bool bSucceeded = PendingWrite.GetResult();
+	PendingWrite = UE::Tasks::TTask<bool>();
+
+	if (!bSucceeded)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to write '%lld' bytes of encoded data to the file asynchronously"), WritingBuffer.Num());
+	}
+
+	return bSucceeded;
+}
+
+FRuntimeArchiveAudioSink::FRuntimeArchiveAudioSink(FArchive& InArchive)
+	: Archive(InArchive)
+{
+}
+
+bool FRuntimeArchiveAudioSink::Write(const uint8* Data, int64 Size)
+{
+	Archive.Serialize(const_cast<uint8*>(Data), Size);
+	return !Archive.IsError();
+}
+
+bool FRuntimeArchiveAudioSink::Seek(int64 Position)
+{
+	Archive.Seek(Position);
+	return !Archive.IsError();
+}
+
+int64 FRuntimeArchiveAudioSink::Tell() const
+{
+	return Archive.Tell();
+}
+
+bool FRuntimeArchiveAudioSink::Flush()
+{
+	Archive.Flush();
+	return !Archive.IsError();
+}
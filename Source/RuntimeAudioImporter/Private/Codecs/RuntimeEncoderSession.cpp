@@ -0,0 +1,151 @@
+﻿// Georgy Treshchev 2024.
+
+#include "Codecs/RuntimeEncoderSession.h"
+#include "RuntimeAudioImporterDefines.h"
+
+FBaseRuntimeEncoderSession::FBaseRuntimeEncoderSession()
+	: SampleRate(0)
+  , NumOfChannels(0)
+  , Quality(0)
+  , bActive(false)
+  , NumOfFramesPushed(0)
+  , NumOfBytesWritten(0)
+{
+}
+
+FBaseRuntimeEncoderSession::~FBaseRuntimeEncoderSession()
+{
+	// Release_Internal can't be called here since the derived part has already been destroyed, so derived sessions release their resources in their own destructors
+	if (bActive)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("The encoder session is being destroyed without being finished. The written data will most likely be incomplete"));
+	}
+}
+
+bool FBaseRuntimeEncoderSession::Begin(TUniquePtr<FBaseRuntimeEncodedAudioSink> InSink, uint32 InSampleRate, uint32 InNumOfChannels, uint8 InQuality)
+{
+	if (bActive)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to begin the encoder session as it has already been started"));
+		return false;
+	}
+
+	if (!InSink.IsValid())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to begin the encoder session as the sink is invalid"));
+		return false;
+	}
+
+	if (InSampleRate == 0 || InNumOfChannels == 0)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to begin the encoder session with the sample rate '%d' and the number of channels '%d'"), InSampleRate, InNumOfChannels);
+		return false;
+	}
+
+	Sink = MoveTemp(InSink);
+	SampleRate = InSampleRate;
+	NumOfChannels = InNumOfChannels;
+	Quality = FMath::Clamp<uint8>(InQuality, 0, 100);
+	NumOfFramesPushed = 0;
+	NumOfBytesWritten = 0;
+
+	if (!Begin_Internal())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to begin the %s encoder session (sample rate: %d, number of channels: %d, quality: %d)"), *UEnum::GetValueAsString(GetAudioFormat()), SampleRate, NumOfChannels, Quality);
+		Release_Internal();
+		Sink.Reset();
+		return false;
+	}
+
+	bActive = true;
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully began the %s encoder session (sample rate: %d, number of channels: %d, quality: %d)"), *UEnum::GetValueAsString(GetAudioFormat()), SampleRate, NumOfChannels, Quality);
+	return true;
+}
+
+bool FBaseRuntimeEncoderSession::PushFrames(const float* PCMData, int64 NumOfFrames)
+{
+	if (!bActive)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to push frames to the encoder session as it is not active"));
+		return false;
+	}
+
+	if (!PCMData || NumOfFrames <= 0)
+	{
+		return NumOfFrames == 0;
+	}
+
+	if (!PushFrames_Internal(PCMData, NumOfFrames))
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to push '%lld' frames to the %s encoder session"), NumOfFrames, *UEnum::GetValueAsString(GetAudioFormat()));
+		return false;
+	}
+
+	NumOfFramesPushed += NumOfFrames;
+	return true;
+}
+
+bool FBaseRuntimeEncoderSession::Finish()
+{
+	if (!bActive)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to finish the encoder session as it is not active"));
+		return false;
+	}
+
+	const bool bSucceeded = Finish_Internal();
+	Release_Internal();
+
+	bActive = false;
+
+	if (!Sink->Flush())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to flush the sink of the %s encoder session"), *UEnum::GetValueAsString(GetAudioFormat()));
+		Sink.Reset();
+		return false;
+	}
+	Sink.Reset();
+
+	if (!bSucceeded)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to finish the %s encoder session"), *UEnum::GetValueAsString(GetAudioFormat()));
+		return false;
+	}
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully finished the %s encoder session (frames pushed: %lld, bytes written: %lld)"), *UEnum::GetValueAsString(GetAudioFormat()), NumOfFramesPushed, NumOfBytesWritten);
+	return true;
+}
+
+bool FBaseRuntimeEncoderSession::Write(const void* Data, int64 Size)
+{
+	if (Size <= 0)
+	{
+		return true;
+	}
+
+	if (!Sink.IsValid() || !Sink->Write(static_cast<const uint8*>(Data), Size))
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to write '%lld' bytes of encoded data to the sink"), Size);
+		return false;
+	}
+
+	NumOfBytesWritten += Size;
+	return true;
+}
+
+bool FBaseRuntimeEncoderSession::Seek(int64 Position)
+{
+	if (!Sink.IsValid() || !Sink->Seek(Position))
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to seek the sink to the position '%lld'"), Position);
+		return false;
+	}
+
+	return true;
+}
+
+int64 FBaseRuntimeEncoderSession::Tell() const
+{
+	return Sink.IsValid() ? Sink->Tell() : INDEX_NONE;
+}
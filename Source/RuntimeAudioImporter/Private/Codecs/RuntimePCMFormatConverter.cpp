@@ -0,0 +1,336 @@
+﻿// Georgy Treshchev 2024.
+
+#include "Codecs/RuntimePCMFormatConverter.h"
+#include "Codecs/RAW_RuntimeCodec.h"
+#include "RuntimeAudioImporterDefines.h"
+#include "HAL/UnrealMemory.h"
+
+namespace
+{
+	/** The number of frames the resampler may hold back in addition to the ones proportional to the input */
+	constexpr int32 NumOfResamplerMarginFrames = 1024;
+}
+
+FRuntimePCMFormatConverter::FRuntimePCMFormatConverter(uint32 InSourceSampleRate, uint32 InSourceNumOfChannels, uint32 InTargetSampleRate, uint32 InTargetNumOfChannels)
+	: SourceSampleRate(InSourceSampleRate)
+  , SourceNumOfChannels(InSourceNumOfChannels)
+  , TargetSampleRate(InTargetSampleRate > 0 ? InTargetSampleRate : InSourceSampleRate)
+  , TargetNumOfChannels(InTargetNumOfChannels > 0 ? InTargetNumOfChannels : InSourceNumOfChannels)
+  , bMixBeforeResampling(TargetNumOfChannels < SourceNumOfChannels)
+  , ConvertedPCMData(nullptr)
+  , NumOfSamples(0)
+  , Capacity(0)
+{
+	if (IsValid() && SourceSampleRate != TargetSampleRate)
+	{
+		Resampler = MakeUnique<Audio::FResampler>();
+		Resampler->Init(Audio::EResamplingMethod::BestSinc, static_cast<float>(TargetSampleRate) / SourceSampleRate, bMixBeforeResampling ? TargetNumOfChannels : SourceNumOfChannels);
+	}
+}
+
+FRuntimePCMFormatConverter::~FRuntimePCMFormatConverter()
+{
+	if (ConvertedPCMData)
+	{
+		FMemory::Free(ConvertedPCMData);
+	}
+}
+
+bool FRuntimePCMFormatConverter::IsValid() const
+{
+	return SourceSampleRate > 0 && SourceNumOfChannels > 0 && TargetSampleRate > 0 && TargetNumOfChannels > 0;
+}
+
+bool FRuntimePCMFormatConverter::IsPassthrough() const
+{
+	return SourceSampleRate == TargetSampleRate && SourceNumOfChannels == TargetNumOfChannels;
+}
+
+void FRuntimePCMFormatConverter::Reserve(int64 NumOfSourceFrames)
+{
+	if (!IsValid() || NumOfSourceFrames <= 0)
+	{
+		return;
+	}
+
+	const int64 NumOfTargetFrames = static_cast<int64>(FMath::CeilToDouble(static_cast<double>(NumOfSourceFrames) * TargetSampleRate / SourceSampleRate)) + NumOfResamplerMarginFrames;
+	const int64 NewCapacity = NumOfTargetFrames * TargetNumOfChannels;
+	if (NewCapacity <= Capacity)
+	{
+		return;
+	}
+
+	ConvertedPCMData = static_cast<float*>(FMemory::Realloc(ConvertedPCMData, NewCapacity * sizeof(float)));
+	Capacity = NewCapacity;
+}
+
+bool FRuntimePCMFormatConverter::PushFrames(const float* PCMData, int64 NumOfFrames)
+{
+	if (!IsValid())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to convert PCM data because the format is invalid (sample rate: %d -> %d, number of channels: %d -> %d)"), SourceSampleRate, TargetSampleRate, SourceNumOfChannels, TargetNumOfChannels);
+		return false;
+	}
+
+	if (!PCMData || NumOfFrames <= 0)
+	{
+		return NumOfFrames == 0;
+	}
+
+	for (int64 FrameIndex = 0; FrameIndex < NumOfFrames; FrameIndex += NumOfFramesPerBlock)
+	{
+		const int32 NumOfBlockFrames = static_cast<int32>(FMath::Min<int64>(NumOfFramesPerBlock, NumOfFrames - FrameIndex));
+		if (!PushBlock(PCMData + FrameIndex * SourceNumOfChannels, NumOfBlockFrames))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FRuntimePCMFormatConverter::PushFramesFrom(TFunctionRef<int64(float* OutPCMData, int64 MaxNumOfFrames)> ReadFrames)
+{
+	// Only one block of the source PCM data is held at a time
+	TArray<float> BlockPCMData;
+	BlockPCMData.SetNumUninitialized(NumOfFramesPerBlock * SourceNumOfChannels);
+
+	while (true)
+	{
+		const int64 NumOfReadFrames = ReadFrames(BlockPCMData.GetData(), NumOfFramesPerBlock);
+		if (NumOfReadFrames <= 0)
+		{
+			return true;
+		}
+
+		if (!PushFrames(BlockPCMData.GetData(), FMath::Min<int64>(NumOfReadFrames, NumOfFramesPerBlock)))
+		{
+			return false;
+		}
+	}
+}
+
+bool FRuntimePCMFormatConverter::Finish()
+{
+	if (!Resampler.IsValid())
+	{
+		return true;
+	}
+
+	float EmptyInput = 0;
+	if (!Resample(&EmptyInput, 0, true))
+	{
+		return false;
+	}
+
+	Resampler.Reset();
+	return true;
+}
+
+void FRuntimePCMFormatConverter::ReleasePCMData(FPCMStruct& OutPCMInfo)
+{
+	OutPCMInfo.Empty();
+
+	if (!ConvertedPCMData || NumOfSamples <= 0)
+	{
+		return;
+	}
+
+	// Giving back the memory reserved for the frames that never came
+	if (NumOfSamples < Capacity)
+	{
+		ConvertedPCMData = static_cast<float*>(FMemory::Realloc(ConvertedPCMData, NumOfSamples * sizeof(float)));
+	}
+
+	OutPCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(ConvertedPCMData, NumOfSamples);
+	OutPCMInfo.PCMNumOfFrames = static_cast<uint32>(NumOfSamples / TargetNumOfChannels);
+
+	ConvertedPCMData = nullptr;
+	NumOfSamples = 0;
+	Capacity = 0;
+}
+
+void FRuntimePCMFormatConverter::ReleaseDecodedAudio(FDecodedAudioStruct& OutDecodedAudioInfo)
+{
+	ReleasePCMData(OutDecodedAudioInfo.PCMInfo);
+	OutDecodedAudioInfo.SoundWaveBasicInfo.SampleRate = TargetSampleRate;
+	OutDecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels = TargetNumOfChannels;
+	OutDecodedAudioInfo.SoundWaveBasicInfo.Duration = TargetSampleRate > 0 ? static_cast<float>(OutDecodedAudioInfo.PCMInfo.PCMNumOfFrames) / TargetSampleRate : 0;
+}
+
+bool FRuntimePCMFormatConverter::ConvertDecodedAudio(FDecodedAudioStruct& DecodedAudioInfo, uint32 TargetSampleRate, uint32 TargetNumOfChannels)
+{
+	FRuntimePCMFormatConverter Converter(DecodedAudioInfo.SoundWaveBasicInfo.SampleRate, DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels, TargetSampleRate, TargetNumOfChannels);
+	if (!Converter.IsValid())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to convert decoded audio data because the format is invalid (sample rate: %d -> %d, number of channels: %d -> %d)"),
+			DecodedAudioInfo.SoundWaveBasicInfo.SampleRate, TargetSampleRate, DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels, TargetNumOfChannels);
+		return false;
+	}
+
+	if (Converter.IsPassthrough())
+	{
+		return true;
+	}
+
+	FPCMStruct ConvertedPCMInfo;
+	if (!Converter.ConvertPCMData(DecodedAudioInfo.PCMInfo, [](int32) {}, ConvertedPCMInfo))
+	{
+		return false;
+	}
+
+	DecodedAudioInfo.PCMInfo = MoveTemp(ConvertedPCMInfo);
+	DecodedAudioInfo.SoundWaveBasicInfo.SampleRate = Converter.GetTargetSampleRate();
+	DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels = Converter.GetTargetNumOfChannels();
+	DecodedAudioInfo.SoundWaveBasicInfo.Duration = static_cast<float>(DecodedAudioInfo.PCMInfo.PCMNumOfFrames) / Converter.GetTargetSampleRate();
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Decoded audio data has been converted to sample rate '%d' and number of channels '%d'"), Converter.GetTargetSampleRate(), Converter.GetTargetNumOfChannels());
+	return true;
+}
+
+bool FRuntimePCMFormatConverter::ConvertPCMData(const FPCMStruct& PCMInfo, TFunctionRef<void(int32)> OnProgress, FPCMStruct& OutPCMInfo)
+{
+	const int64 NumOfFrames = PCMInfo.GetNumOfSamples() / FMath::Max<uint32>(SourceNumOfChannels, 1);
+	Reserve(NumOfFrames);
+
+	// Only one block of the source PCM data is converted to float at a time
+	TArray<float> BlockPCMData;
+	BlockPCMData.SetNumUninitialized(FMath::Min<int64>(NumOfFrames, NumOfFramesPerBlock) * SourceNumOfChannels);
+
+	int32 LastProgress = -1;
+	for (int64 FrameIndex = 0; FrameIndex < NumOfFrames; FrameIndex += NumOfFramesPerBlock)
+	{
+		const int32 NumOfBlockFrames = static_cast<int32>(FMath::Min<int64>(NumOfFramesPerBlock, NumOfFrames - FrameIndex));
+		FRAW_RuntimeCodec::CopyPCMDataAsFloat(PCMInfo, FrameIndex * SourceNumOfChannels, NumOfBlockFrames * SourceNumOfChannels, BlockPCMData.GetData());
+
+		if (!PushFrames(BlockPCMData.GetData(), NumOfBlockFrames))
+		{
+			return false;
+		}
+
+		const int32 Progress = static_cast<int32>((FrameIndex + NumOfBlockFrames) * 100 / NumOfFrames);
+		if (Progress != LastProgress)
+		{
+			LastProgress = Progress;
+			OnProgress(Progress);
+		}
+	}
+
+	if (!Finish())
+	{
+		return false;
+	}
+
+	ReleasePCMData(OutPCMInfo);
+	return OutPCMInfo.IsValid();
+}
+
+bool FRuntimePCMFormatConverter::PushBlock(const float* PCMData, int32 NumOfFrames)
+{
+	if (IsPassthrough())
+	{
+		return AppendSamples(PCMData, static_cast<int64>(NumOfFrames) * SourceNumOfChannels);
+	}
+
+	auto MixChannels = [this](const float* InPCMData, int32 InNumOfFrames, uint32 InSampleRate, Audio::FAlignedFloatBuffer& OutMixedPCMData)
+	{
+		Audio::FAlignedFloatBuffer BlockPCMData(InPCMData, InNumOfFrames * SourceNumOfChannels);
+		return FRAW_RuntimeCodec::MixChannelsRAWData(BlockPCMData, InSampleRate, SourceNumOfChannels, TargetNumOfChannels, OutMixedPCMData);
+	};
+
+	// Mixing first when reducing the number of channels so that fewer channels are resampled
+	if (bMixBeforeResampling)
+	{
+		Audio::FAlignedFloatBuffer MixedPCMData;
+		if (!MixChannels(PCMData, NumOfFrames, SourceSampleRate, MixedPCMData))
+		{
+			return false;
+		}
+		return Resampler.IsValid() ? Resample(MixedPCMData.GetData(), NumOfFrames, false) : AppendSamples(MixedPCMData.GetData(), MixedPCMData.Num());
+	}
+
+	if (!Resampler.IsValid())
+	{
+		Audio::FAlignedFloatBuffer MixedPCMData;
+		return MixChannels(PCMData, NumOfFrames, SourceSampleRate, MixedPCMData) && AppendSamples(MixedPCMData.GetData(), MixedPCMData.Num());
+	}
+
+	return Resample(PCMData, NumOfFrames, false);
+}
+
+bool FRuntimePCMFormatConverter::Resample(const float* PCMData, int32 NumOfFrames, bool bEndOfInput)
+{
+	const uint32 NumOfResampledChannels = bMixBeforeResampling ? TargetNumOfChannels : SourceNumOfChannels;
+	const float SampleRateRatio = static_cast<float>(TargetSampleRate) / SourceSampleRate;
+
+	// Leaving room for the frames held back by the resampler filter
+	const int32 MaxOutputFrames = FMath::CeilToInt((NumOfFrames + NumOfResamplerMarginFrames) * SampleRateRatio) + NumOfResamplerMarginFrames;
+	Audio::FAlignedFloatBuffer ResampledPCMData;
+	ResampledPCMData.SetNumUninitialized(MaxOutputFrames * NumOfResampledChannels);
+
+	// The resampler may produce more frames than fit at the end of input, so it is flushed until it runs dry
+	int32 NumOfResampledFrames = 0;
+	do
+	{
+		const int32 ErrorCode = Resampler->ProcessAudio(const_cast<float*>(PCMData), NumOfFrames, bEndOfInput, ResampledPCMData.GetData(), MaxOutputFrames, NumOfResampledFrames);
+		if (ErrorCode != 0)
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to resample PCM data (%d -> %d), error code: %d"), SourceSampleRate, TargetSampleRate, ErrorCode);
+			return false;
+		}
+
+		if (NumOfResampledFrames <= 0)
+		{
+			break;
+		}
+
+		if (bMixBeforeResampling || NumOfResampledChannels == TargetNumOfChannels)
+		{
+			if (!AppendSamples(ResampledPCMData.GetData(), static_cast<int64>(NumOfResampledFrames) * TargetNumOfChannels))
+			{
+				return false;
+			}
+		}
+		else
+		{
+			ResampledPCMData.SetNum(NumOfResampledFrames * NumOfResampledChannels, false);
+			Audio::FAlignedFloatBuffer MixedPCMData;
+			if (!FRAW_RuntimeCodec::MixChannelsRAWData(ResampledPCMData, TargetSampleRate, SourceNumOfChannels, TargetNumOfChannels, MixedPCMData)
+				|| !AppendSamples(MixedPCMData.GetData(), MixedPCMData.Num()))
+			{
+				return false;
+			}
+			ResampledPCMData.SetNumUninitialized(MaxOutputFrames * NumOfResampledChannels);
+		}
+
+		NumOfFrames = 0;
+	}
+	while (bEndOfInput && NumOfResampledFrames >= MaxOutputFrames);
+
+	return true;
+}
+
+bool FRuntimePCMFormatConverter::AppendSamples(const float* Samples, int64 InNumOfSamples)
+{
+	if (InNumOfSamples <= 0)
+	{
+		return true;
+	}
+
+	if (NumOfSamples + InNumOfSamples > Capacity)
+	{
+		const int64 NewCapacity = FMath::Max<int64>(NumOfSamples + InNumOfSamples, Capacity + Capacity / 2);
+		float* NewPCMData = static_cast<float*>(FMemory::Realloc(ConvertedPCMData, NewCapacity * sizeof(float)));
+		if (!NewPCMData)
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to allocate memory for %lld converted PCM samples"), NewCapacity);
+			return false;
+		}
+		ConvertedPCMData = NewPCMData;
+		Capacity = NewCapacity;
+	}
+
+	FMemory::Memcpy(ConvertedPCMData + NumOfSamples, Samples, InNumOfSamples * sizeof(float));
+	NumOfSamples += InNumOfSamples;
+	return true;
+}
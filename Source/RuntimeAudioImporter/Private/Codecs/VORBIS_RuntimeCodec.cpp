@@ -242,6 +242,384 @@ bool FVORBIS_RuntimeCodec::Encode(FDecodedAudioStruct DecodedData, FEncodedAudio
 #endif
 }
 
+#if PLATFORM_SUPPORTS_VORBIS_CODEC
+namespace
+{
+	/**
+	 * Incremental VORBIS encoder session. Keeps the encoder and the Ogg stream alive between pushes and writes the pages as soon as they are produced
+	 */
+	class FVORBIS_RuntimeEncoderSession : public FBaseRuntimeEncoderSession
+	{
+	public:
+		FVORBIS_RuntimeEncoderSession()
+			: bEncoderInitialized(false)
+		{
+		}
+
+		virtual ~FVORBIS_RuntimeEncoderSession() override
+		{
+			Release_Internal();
+		}
+
+		virtual ERuntimeAudioFormat GetAudioFormat() const override { return ERuntimeAudioFormat::OggVorbis; }
+
+	protected:
+		virtual bool Begin_Internal() override
+		{
+			vorbis_info_init(&VorbisInfo);
+
+			if (vorbis_encode_init_vbr(&VorbisInfo, NumOfChannels, SampleRate, static_cast<float>(Quality) / 100) < 0)
+			{
+				vorbis_info_clear(&VorbisInfo);
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to initialize VORBIS encoder"));
+				return false;
+			}
+
+			vorbis_comment_init(&VorbisComment);
+			vorbis_comment_add_tag(&VorbisComment, "ENCODER", "RuntimeAudioImporter");
+
+			vorbis_analysis_init(&VorbisDspState, &VorbisInfo);
+			vorbis_block_init(&VorbisDspState, &VorbisBlock);
+
+			ogg_stream_init(&OggStreamState, 0);
+			bEncoderInitialized = true;
+
+			ogg_packet OggPacket, OggComment, OggCode;
+			vorbis_analysis_headerout(&VorbisDspState, &VorbisComment, &OggPacket, &OggComment, &OggCode);
+			ogg_stream_packetin(&OggStreamState, &OggPacket);
+			ogg_stream_packetin(&OggStreamState, &OggComment);
+			ogg_stream_packetin(&OggStreamState, &OggCode);
+
+			// The headers must be on separate pages before the audio data
+			ogg_page OggPage;
+			while (ogg_stream_flush(&OggStreamState, &OggPage))
+			{
+				if (!WritePage(OggPage))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		virtual bool PushFrames_Internal(const float* PCMData, int64 NumOfFrames) override
+		{
+			int64 FramesEncoded = 0;
+			while (FramesEncoded < NumOfFrames)
+			{
+				// Make sure we don't write more than FramesSplitCount at once, since libvorbis can segfault if we read too much at once
+				constexpr int64 FramesSplitCount = 1024;
+				const int64 FramesToEncode = FMath::Min<int64>(NumOfFrames - FramesEncoded, FramesSplitCount);
+
+				float** AnalysisBuffer = vorbis_analysis_buffer(&VorbisDspState, static_cast<int>(FramesToEncode));
+				if (!AnalysisBuffer)
+				{
+					UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to create VORBIS analysis buffers"));
+					return false;
+				}
+
+				// Deinterleave for the encoder
+				for (int64 FrameIndex = 0; FrameIndex < FramesToEncode; ++FrameIndex)
+				{
+					const float* Frame = PCMData + (FramesEncoded + FrameIndex) * NumOfChannels;
+
+					for (uint32 ChannelIndex = 0; ChannelIndex < NumOfChannels; ++ChannelIndex)
+					{
+						AnalysisBuffer[ChannelIndex][FrameIndex] = Frame[ChannelIndex];
+					}
+				}
+
+				if (vorbis_analysis_wrote(&VorbisDspState, static_cast<int>(FramesToEncode)) < 0)
+				{
+					UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to read VORBIS frames"));
+					return false;
+				}
+
+				if (!DrainBlocks())
+				{
+					return false;
+				}
+
+				FramesEncoded += FramesToEncode;
+			}
+
+			return true;
+		}
+
+		virtual bool Finish_Internal() override
+		{
+			// Signal the end of the stream so that the remaining blocks and the last page are produced
+			if (vorbis_analysis_wrote(&VorbisDspState, 0) < 0)
+			{
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to finalize the VORBIS stream"));
+				return false;
+			}
+
+			if (!DrainBlocks())
+			{
+				return false;
+			}
+
+			ogg_page OggPage;
+			while (ogg_stream_flush(&OggStreamState, &OggPage))
+			{
+				if (!WritePage(OggPage))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		virtual void Release_Internal() override
+		{
+			if (bEncoderInitialized)
+			{
+				ogg_stream_clear(&OggStreamState);
+				vorbis_block_clear(&VorbisBlock);
+				vorbis_dsp_clear(&VorbisDspState);
+				vorbis_comment_clear(&VorbisComment);
+				vorbis_info_clear(&VorbisInfo);
+				bEncoderInitialized = false;
+			}
+		}
+
+	private:
+		/**
+		 * Analyze all available blocks and write the complete pages
+		 */
+		bool DrainBlocks()
+		{
+			ogg_packet OggPacket;
+			ogg_page OggPage;
+
+			while (vorbis_analysis_blockout(&VorbisDspState, &VorbisBlock) == 1)
+			{
+				vorbis_analysis(&VorbisBlock, nullptr);
+				vorbis_bitrate_addblock(&VorbisBlock);
+
+				while (vorbis_bitrate_flushpacket(&VorbisDspState, &OggPacket))
+				{
+					ogg_stream_packetin(&OggStreamState, &OggPacket);
+
+					while (ogg_stream_pageout(&OggStreamState, &OggPage))
+					{
+						if (!WritePage(OggPage))
+						{
+							return false;
+						}
+					}
+				}
+			}
+
+			return true;
+		}
+
+		bool WritePage(const ogg_page& OggPage)
+		{
+			return Write(OggPage.header, OggPage.header_len) && Write(OggPage.body, OggPage.body_len);
+		}
+
+		vorbis_info VorbisInfo;
+		vorbis_comment VorbisComment;
+		vorbis_dsp_state VorbisDspState;
+		vorbis_block VorbisBlock;
+		ogg_stream_state OggStreamState;
+		bool bEncoderInitialized;
+	};
+}
+#endif
+
+TUniquePtr<FBaseRuntimeEncoderSession> FVORBIS_RuntimeCodec::CreateEncoderSession()
+{
+#if PLATFORM_SUPPORTS_VORBIS_CODEC
+	return MakeUnique<FVORBIS_RuntimeEncoderSession>();
+#else
+	UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Your platform (%hs) does not support VORBIS encoding"), FPlatformProperties::IniPlatformName());
+	return nullptr;
+#endif
+}
+
+#if PLATFORM_SUPPORTS_VORBIS_CODEC
+namespace
+{
+	/**
+	 * Incremental VORBIS decoder session. Keeps the Ogg sync and stream state and the synthesis state between pushes, so the pushed data may end in the middle of a page
+	 */
+	class FVORBIS_RuntimeDecoderSession : public FBaseRuntimeDecoderSession
+	{
+	public:
+		FVORBIS_RuntimeDecoderSession()
+			: bOggStreamInitialized(false)
+		  , bSynthesisInitialized(false)
+		  , NumOfHeaderPackets(0)
+		{
+			ogg_sync_init(&OggSyncState);
+			vorbis_info_init(&VorbisInfo);
+			vorbis_comment_init(&VorbisComment);
+		}
+
+		virtual ~FVORBIS_RuntimeDecoderSession() override
+		{
+			Release_Internal();
+		}
+
+		virtual ERuntimeAudioFormat GetAudioFormat() const override { return ERuntimeAudioFormat::OggVorbis; }
+
+	protected:
+		virtual bool Decode_Internal(bool bEndOfStream) override
+		{
+			// The Ogg sync layer keeps the incomplete page until the rest of it is pushed
+			const int64 NumOfPendingBytes = GetNumOfPendingBytes();
+			if (NumOfPendingBytes > 0)
+			{
+				char* SyncBuffer = ogg_sync_buffer(&OggSyncState, static_cast<long>(NumOfPendingBytes));
+				FMemory::Memcpy(SyncBuffer, GetPendingData(), NumOfPendingBytes);
+				ogg_sync_wrote(&OggSyncState, static_cast<long>(NumOfPendingBytes));
+				ConsumePendingData(NumOfPendingBytes);
+			}
+
+			ogg_page OggPage;
+			while (ogg_sync_pageout(&OggSyncState, &OggPage) == 1)
+			{
+				if (!bOggStreamInitialized)
+				{
+					ogg_stream_init(&OggStreamState, ogg_page_serialno(&OggPage));
+					bOggStreamInitialized = true;
+				}
+
+				// Only the first logical stream is decoded
+				if (ogg_stream_pagein(&OggStreamState, &OggPage) != 0)
+				{
+					continue;
+				}
+
+				ogg_packet OggPacket;
+				int32 PacketResult;
+				while ((PacketResult = ogg_stream_packetout(&OggStreamState, &OggPacket)) != 0)
+				{
+					// A gap in the data, the next packet is decoded as usual
+					if (PacketResult < 0)
+					{
+						continue;
+					}
+
+					if (!DecodePacket(OggPacket))
+					{
+						return false;
+					}
+				}
+			}
+
+			return true;
+		}
+
+		virtual void Release_Internal() override
+		{
+			if (bSynthesisInitialized)
+			{
+				vorbis_block_clear(&VorbisBlock);
+				vorbis_dsp_clear(&VorbisDspState);
+				bSynthesisInitialized = false;
+			}
+			if (bOggStreamInitialized)
+			{
+				ogg_stream_clear(&OggStreamState);
+				bOggStreamInitialized = false;
+			}
+			vorbis_comment_clear(&VorbisComment);
+			vorbis_info_clear(&VorbisInfo);
+			ogg_sync_clear(&OggSyncState);
+		}
+
+	private:
+		bool DecodePacket(ogg_packet& OggPacket)
+		{
+			// The identification, comment and setup headers come first
+			if (NumOfHeaderPackets < 3)
+			{
+				if (vorbis_synthesis_headerin(&VorbisInfo, &VorbisComment, &OggPacket) != 0)
+				{
+					UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to decode VORBIS header packet %d"), NumOfHeaderPackets);
+					return false;
+				}
+
+				if (++NumOfHeaderPackets == 3)
+				{
+					if (vorbis_synthesis_init(&VorbisDspState, &VorbisInfo) != 0)
+					{
+						UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to initialize VORBIS decoder"));
+						return false;
+					}
+					vorbis_block_init(&VorbisDspState, &VorbisBlock);
+					bSynthesisInitialized = true;
+
+					return SetFormat(static_cast<uint32>(VorbisInfo.rate), static_cast<uint32>(VorbisInfo.channels));
+				}
+				return true;
+			}
+
+			if (vorbis_synthesis(&VorbisBlock, &OggPacket) == 0)
+			{
+				vorbis_synthesis_blockin(&VorbisDspState, &VorbisBlock);
+			}
+
+			// Interleaving the decoded channels
+			float** ChannelsPCMData;
+			int32 NumOfFrames;
+			while ((NumOfFrames = vorbis_synthesis_pcmout(&VorbisDspState, &ChannelsPCMData)) > 0)
+			{
+				const int32 NumOfChannels = VorbisInfo.channels;
+				InterleavedPCMData.SetNumUninitialized(NumOfFrames * NumOfChannels);
+				for (int32 FrameIndex = 0; FrameIndex < NumOfFrames; ++FrameIndex)
+				{
+					for (int32 ChannelIndex = 0; ChannelIndex < NumOfChannels; ++ChannelIndex)
+					{
+						InterleavedPCMData[FrameIndex * NumOfChannels + ChannelIndex] = ChannelsPCMData[ChannelIndex][FrameIndex];
+					}
+				}
+
+				vorbis_synthesis_read(&VorbisDspState, NumOfFrames);
+
+				if (!EmitFrames(InterleavedPCMData.GetData(), NumOfFrames))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		ogg_sync_state OggSyncState;
+		ogg_stream_state OggStreamState;
+		vorbis_info VorbisInfo;
+		vorbis_comment VorbisComment;
+		vorbis_dsp_state VorbisDspState;
+		vorbis_block VorbisBlock;
+		bool bOggStreamInitialized;
+		bool bSynthesisInitialized;
+
+		/** The number of header packets decoded so far */
+		int32 NumOfHeaderPackets;
+
+		/** Reused buffer for the interleaved PCM data */
+		TArray<float> InterleavedPCMData;
+	};
+}
+#endif
+
+TUniquePtr<FBaseRuntimeDecoderSession> FVORBIS_RuntimeCodec::CreateDecoderSession()
+{
+#if PLATFORM_SUPPORTS_VORBIS_CODEC
+	return MakeUnique<FVORBIS_RuntimeDecoderSession>();
+#else
+	UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Your platform (%hs) does not support VORBIS decoding"), FPlatformProperties::IniPlatformName());
+	return nullptr;
+#endif
+}
+
 bool FVORBIS_RuntimeCodec::Decode(FEncodedAudioStruct EncodedData, FDecodedAudioStruct& DecodedData)
 {
 	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Decoding VORBIS audio data to uncompressed audio format.\nEncoded audio info: %s"), *EncodedData.ToString());
@@ -293,3 +671,61 @@ bool FVORBIS_RuntimeCodec::Decode(FEncodedAudioStruct EncodedData, FDecodedAudio
 	UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Your platform (%hs) does not support VORBIS decoding"), FPlatformProperties::IniPlatformName());
 #endif
 }
+
+bool FVORBIS_RuntimeCodec::DecodeToFormat(FEncodedAudioStruct EncodedData, FDecodedAudioStruct& DecodedData, uint32 TargetSampleRate, uint32 TargetNumOfChannels)
+{
+#if WITH_OGGVORBIS
+	FVorbisAudioInfo AudioInfo;
+	FSoundQualityInfo SoundQualityInfo;
+
+	if (!AudioInfo.ReadCompressedInfo(EncodedData.AudioData.GetView().GetData(), EncodedData.AudioData.GetView().Num(), &SoundQualityInfo) || SoundQualityInfo.NumChannels == 0)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to read VORBIS compressed info"));
+		return false;
+	}
+
+	FRuntimePCMFormatConverter Converter(SoundQualityInfo.SampleRate, SoundQualityInfo.NumChannels, TargetSampleRate, TargetNumOfChannels);
+	if (!Converter.IsValid() || Converter.IsPassthrough())
+	{
+		return Decode(MoveTemp(EncodedData), DecodedData);
+	}
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Decoding VORBIS audio data to sample rate '%d' and number of channels '%d'.\nEncoded audio info: %s"), Converter.GetTargetSampleRate(), Converter.GetTargetNumOfChannels(), *EncodedData.ToString());
+
+	const uint32 NumOfChannels = SoundQualityInfo.NumChannels;
+	int64 NumOfRemainingFrames = SoundQualityInfo.SampleDataSize / (NumOfChannels * sizeof(int16));
+
+	// Decoding to 16-bit integer (the format the decoder produces) block by block, and converting each block as it is decoded
+	Converter.Reserve(NumOfRemainingFrames);
+	TArray<int16> BlockPCMData;
+	const bool bSucceeded = Converter.PushFramesFrom([&AudioInfo, &BlockPCMData, &NumOfRemainingFrames, NumOfChannels](float* OutPCMData, int64 MaxNumOfFrames)
+	{
+		const int64 NumOfFrames = FMath::Min<int64>(MaxNumOfFrames, NumOfRemainingFrames);
+		if (NumOfFrames <= 0)
+		{
+			return static_cast<int64>(0);
+		}
+
+		BlockPCMData.SetNumUninitialized(NumOfFrames * NumOfChannels);
+		AudioInfo.ReadCompressedData(reinterpret_cast<uint8*>(BlockPCMData.GetData()), false, BlockPCMData.Num() * sizeof(int16));
+		FRAW_RuntimeCodec::ConvertInt16ToFloat(BlockPCMData.GetData(), OutPCMData, BlockPCMData.Num());
+		NumOfRemainingFrames -= NumOfFrames;
+		return NumOfFrames;
+	}) && Converter.Finish();
+
+	if (!bSucceeded)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to convert decoded VORBIS audio data"));
+		return false;
+	}
+
+	Converter.ReleaseDecodedAudio(DecodedData);
+	DecodedData.SoundWaveBasicInfo.AudioFormat = GetAudioFormat();
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully decoded VORBIS audio data to uncompressed audio format.\nDecoded audio info: %s"), *DecodedData.ToString());
+	return true;
+#else
+	UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Your platform (%hs) does not support VORBIS decoding"), FPlatformProperties::IniPlatformName());
+	return false;
+#endif
+}
@@ -14,9 +14,10 @@ namespace
 {
 	/**
 	 * Check and fix the WAV audio data with the correct byte size in the RIFF container
+	 * Externally owned (e.g. memory-mapped) data is read-only, so it is copied before being fixed
 	 * Made by https://github.com/kass-kass
 	 */
-	bool CheckAndFixWavDurationErrors(const FRuntimeBulkDataBuffer<uint8>& WavData)
+	bool CheckAndFixWavDurationErrors(FRuntimeBulkDataBuffer<uint8>& WavData)
 	{
 		drwav WAV;
 
@@ -39,6 +40,11 @@ namespace
 		// The field should be (size of file - 8 bytes), as the chunk identifier for the whole file (4 bytes spelling out RIFF at the start of the file), and the chunk length (4 bytes that we're replacing) are excluded.
 		if (BytesToHex(WavData.GetView().GetData() + 4, 4) == "FFFFFFFF")
 		{
+			if (!WavData.MakeOwned())
+			{
+				drwav_uninit(&WAV);
+				return false;
+			}
 			const int32 ActualFileSize = WavData.GetView().Num() - 8;
 			FMemory::Memcpy(WavData.GetView().GetData() + 4, &ActualFileSize, 4);
 		}
@@ -66,6 +72,12 @@ namespace
 		// Same process as replacing full file size, except DataSize counts bytes from end of DataSize int to end of file.
 		if (BytesToHex(WavData.GetView().GetData() + DataSizeLocation, 4) == "FFFFFFFF")
 		{
+			if (!WavData.MakeOwned())
+			{
+				drwav_uninit(&WAV);
+				return false;
+			}
+
 			// -4 to not include the DataSize int itself
 			const uint32 ActualDataSize = WavData.GetView().Num() - DataSizeLocation - 4;
 
@@ -81,7 +93,11 @@ bool FWAV_RuntimeCodec::CheckAudioFormat(const FRuntimeBulkDataBuffer<uint8>& Au
 {
 	drwav WAV;
 
-	CheckAndFixWavDurationErrors(AudioData);
+	// Externally owned (e.g. memory-mapped) data is not copied just to detect the format. It is fixed, if needed, during decoding
+	if (!AudioData.IsExternallyOwned())
+	{
+		CheckAndFixWavDurationErrors(const_cast<FRuntimeBulkDataBuffer<uint8>&>(AudioData));
+	}
 
 	if (!drwav_init_memory(&WAV, AudioData.GetView().GetData(), AudioData.GetView().Num(), nullptr))
 	{
@@ -160,6 +176,98 @@ bool FWAV_RuntimeCodec::Encode(FDecodedAudioStruct DecodedData, FEncodedAudioStr
 	return true;
 }
 
+namespace
+{
+	/**
+	 * Incremental WAV encoder session. Streams 16-bit PCM data and patches the RIFF and data chunk sizes on finish
+	 */
+	class FWAV_RuntimeEncoderSession : public FBaseRuntimeEncoderSession
+	{
+	public:
+		FWAV_RuntimeEncoderSession()
+			: bEncoderInitialized(false)
+		{
+		}
+
+		virtual ~FWAV_RuntimeEncoderSession() override
+		{
+			Release_Internal();
+		}
+
+		virtual ERuntimeAudioFormat GetAudioFormat() const override { return ERuntimeAudioFormat::Wav; }
+
+	protected:
+		virtual bool Begin_Internal() override
+		{
+			drwav_data_format WAV_Format;
+			{
+				WAV_Format.container = drwav_container_riff;
+				WAV_Format.format = DR_WAVE_FORMAT_PCM;
+				WAV_Format.channels = NumOfChannels;
+				WAV_Format.sampleRate = SampleRate;
+				WAV_Format.bitsPerSample = 16;
+			}
+
+			// Providing the seek callback makes the encoder go back and write the final sizes on uninit
+			if (!drwav_init_write(&WAV_Encoder, &WAV_Format, &OnWrite, &OnSeek, this, nullptr))
+			{
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to initialize WAV Encoder"));
+				return false;
+			}
+
+			bEncoderInitialized = true;
+			return true;
+		}
+
+		virtual bool PushFrames_Internal(const float* PCMData, int64 NumOfFrames) override
+		{
+			int16* TempInt16Buffer;
+			FRAW_RuntimeCodec::TranscodeRAWData<float, int16>(PCMData, NumOfFrames * NumOfChannels, TempInt16Buffer);
+
+			const drwav_uint64 NumOfFramesWritten = drwav_write_pcm_frames(&WAV_Encoder, NumOfFrames, TempInt16Buffer);
+			FMemory::Free(TempInt16Buffer);
+
+			return NumOfFramesWritten == static_cast<drwav_uint64>(NumOfFrames);
+		}
+
+		virtual bool Finish_Internal() override
+		{
+			bEncoderInitialized = false;
+			return drwav_uninit(&WAV_Encoder) == DRWAV_SUCCESS;
+		}
+
+		virtual void Release_Internal() override
+		{
+			if (bEncoderInitialized)
+			{
+				drwav_uninit(&WAV_Encoder);
+				bEncoderInitialized = false;
+			}
+		}
+
+	private:
+		static size_t OnWrite(void* UserData, const void* Data, size_t BytesToWrite)
+		{
+			return static_cast<FWAV_RuntimeEncoderSession*>(UserData)->Write(Data, BytesToWrite) ? BytesToWrite : 0;
+		}
+
+		static drwav_bool32 OnSeek(void* UserData, int Offset, drwav_seek_origin Origin)
+		{
+			FWAV_RuntimeEncoderSession* Session = static_cast<FWAV_RuntimeEncoderSession*>(UserData);
+			const int64 Position = Origin == drwav_seek_origin_start ? Offset : Session->Tell() + Offset;
+			return Session->Seek(Position) ? DRWAV_TRUE : DRWAV_FALSE;
+		}
+
+		drwav WAV_Encoder;
+		bool bEncoderInitialized;
+	};
+}
+
+TUniquePtr<FBaseRuntimeEncoderSession> FWAV_RuntimeCodec::CreateEncoderSession()
+{
+	return MakeUnique<FWAV_RuntimeEncoderSession>();
+}
+
 bool FWAV_RuntimeCodec::Decode(FEncodedAudioStruct EncodedData, FDecodedAudioStruct& DecodedData)
 {
 	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Decoding WAV audio data to uncompressed audio format.\nEncoded audio info: %s"), *EncodedData.ToString());
@@ -182,12 +290,40 @@ bool FWAV_RuntimeCodec::Decode(FEncodedAudioStruct EncodedData, FDecodedAudioStr
 		return false;
 	}
 
+	// Getting basic audio information
+	{
+		DecodedData.SoundWaveBasicInfo.Duration = static_cast<float>(WAV_Decoder.totalPCMFrameCount) / WAV_Decoder.sampleRate;
+		DecodedData.SoundWaveBasicInfo.NumOfChannels = WAV_Decoder.channels;
+		DecodedData.SoundWaveBasicInfo.SampleRate = WAV_Decoder.sampleRate;
+		DecodedData.SoundWaveBasicInfo.AudioFormat = GetAudioFormat();
+	}
+
+	// If the data is memory-mapped and is already stored as 32-bit float PCM, reference it directly instead of decoding it into a separate buffer
+	if (EncodedData.AudioData.IsExternallyOwned() && PLATFORM_LITTLE_ENDIAN && WAV_Decoder.translatedFormatTag == DR_WAVE_FORMAT_IEEE_FLOAT && WAV_Decoder.bitsPerSample == 32)
+	{
+		const int64 PCMDataSize = static_cast<int64>(WAV_Decoder.totalPCMFrameCount * WAV_Decoder.channels);
+		const int64 PCMDataOffset = static_cast<int64>(WAV_Decoder.dataChunkDataPos);
+		uint8* PCMDataPtr = EncodedData.AudioData.GetView().GetData() + PCMDataOffset;
+
+		if (PCMDataSize > 0 && PCMDataOffset + PCMDataSize * static_cast<int64>(sizeof(float)) <= EncodedData.AudioData.GetView().Num() && IsAligned(PCMDataPtr, alignof(float)))
+		{
+			// The decoder state is not accessed after it is uninitialized
+			DecodedData.PCMInfo.PCMNumOfFrames = WAV_Decoder.totalPCMFrameCount;
+			drwav_uninit(&WAV_Decoder);
+
+			DecodedData.PCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(reinterpret_cast<float*>(PCMDataPtr), PCMDataSize, EncodedData.AudioData.GetExternalOwner());
+
+			UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully referenced memory-mapped 32-bit float WAV audio data without decoding.\nDecoded audio info: %s"), *DecodedData.ToString());
+			return true;
+		}
+	}
+
 	// Allocating memory for PCM data
 	float* TempPCMData = static_cast<float*>(FMemory::Malloc(WAV_Decoder.totalPCMFrameCount * WAV_Decoder.channels * sizeof(float)));
 	if (!TempPCMData)
 	{
 		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to allocate memory for WAV Decoder"));
-		
+		drwav_uninit(&WAV_Decoder);
 		return false;
 	}
 
@@ -199,15 +335,56 @@ bool FWAV_RuntimeCodec::Decode(FEncodedAudioStruct EncodedData, FDecodedAudioStr
 
 	DecodedData.PCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(TempPCMData, TempPCMDataSize);
 
-	// Getting basic audio information
+	drwav_uninit(&WAV_Decoder);
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully decoded WAV audio data to uncompressed audio format.\nDecoded audio info: %s"), *DecodedData.ToString());
+	return true;
+}
+
+bool FWAV_RuntimeCodec::DecodeToFormat(FEncodedAudioStruct EncodedData, FDecodedAudioStruct& DecodedData, uint32 TargetSampleRate, uint32 TargetNumOfChannels)
+{
+	if (!CheckAndFixWavDurationErrors(EncodedData.AudioData))
 	{
-		DecodedData.SoundWaveBasicInfo.Duration = static_cast<float>(WAV_Decoder.totalPCMFrameCount) / WAV_Decoder.sampleRate;
-		DecodedData.SoundWaveBasicInfo.NumOfChannels = WAV_Decoder.channels;
-		DecodedData.SoundWaveBasicInfo.SampleRate = WAV_Decoder.sampleRate;
-		DecodedData.SoundWaveBasicInfo.AudioFormat = GetAudioFormat();
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Something went wrong while fixing WAV audio data duration error"));
+		return false;
+	}
+
+	drwav WAV_Decoder;
+	if (!drwav_init_memory(&WAV_Decoder, EncodedData.AudioData.GetView().GetData(), EncodedData.AudioData.GetView().Num(), nullptr))
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to initialize WAV Decoder"));
+		return false;
 	}
 
-	
+	FRuntimePCMFormatConverter Converter(WAV_Decoder.sampleRate, WAV_Decoder.channels, TargetSampleRate, TargetNumOfChannels);
+
+	// Keeping the regular decoding (including referencing memory-mapped float PCM data directly) if there is nothing to convert
+	if (!Converter.IsValid() || Converter.IsPassthrough())
+	{
+		drwav_uninit(&WAV_Decoder);
+		return Decode(MoveTemp(EncodedData), DecodedData);
+	}
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Decoding WAV audio data to sample rate '%d' and number of channels '%d'.\nEncoded audio info: %s"), Converter.GetTargetSampleRate(), Converter.GetTargetNumOfChannels(), *EncodedData.ToString());
+
+	// Converting the PCM data block by block as it is decoded
+	Converter.Reserve(WAV_Decoder.totalPCMFrameCount);
+	const bool bSucceeded = Converter.PushFramesFrom([&WAV_Decoder](float* OutPCMData, int64 MaxNumOfFrames)
+	{
+		return static_cast<int64>(drwav_read_pcm_frames_f32(&WAV_Decoder, MaxNumOfFrames, OutPCMData));
+	}) && Converter.Finish();
+
+	drwav_uninit(&WAV_Decoder);
+
+	if (!bSucceeded)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to convert decoded WAV audio data"));
+		return false;
+	}
+
+	Converter.ReleaseDecodedAudio(DecodedData);
+	DecodedData.SoundWaveBasicInfo.AudioFormat = GetAudioFormat();
+
 	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully decoded WAV audio data to uncompressed audio format.\nDecoded audio info: %s"), *DecodedData.ToString());
 	return true;
 }
@@ -3,12 +3,58 @@
 #if WITH_RUNTIMEAUDIOIMPORTER_METASOUND_SUPPORT
 #include "MetaSound/MetasoundImportedWave.h"
 #include "RuntimeAudioImporterDefines.h"
+#include "Sound/ImportedSoundWave.h"
 
 namespace RuntimeAudioImporter
 {
 	const FString PluginAuthor = TEXT("Georgy Treshchev");
 	const FText PluginNodeMissingPrompt = NSLOCTEXT("RuntimeAudioImporter", "DefaultMissingNodePrompt", "The node was likely removed, renamed, or the RuntimeAudioImporter plugin is not loaded.");
 
+	/** Sound wave data (unique per sound wave and shared by all of its proxies) mapped to the PCM source of the imported sound wave */
+	static TMap<const FSoundWaveData*, TWeakPtr<FImportedSoundWavePCMSource>> PCMSourceRegistry;
+
+	/** Data guard (mutex) for PCMSourceRegistry */
+	static FCriticalSection PCMSourceRegistryGuard;
+
+	void RegisterPCMSource(FSoundWaveProxy& SoundWaveProxy, const TSharedPtr<FImportedSoundWavePCMSource>& PCMSource)
+	{
+		const FSoundWaveData* SoundWaveData = SoundWaveProxy.GetSoundWaveData().Get();
+		if (!SoundWaveData || !PCMSource.IsValid())
+		{
+			UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Unable to register the PCM source for the sound wave proxy '%s'"), *SoundWaveProxy.GetFName().ToString());
+			return;
+		}
+
+		FRAIScopeLock Lock(&PCMSourceRegistryGuard);
+
+		// Removing entries of the sound waves that no longer exist
+		for (auto It = PCMSourceRegistry.CreateIterator(); It; ++It)
+		{
+			if (!It.Value().IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		PCMSourceRegistry.Add(SoundWaveData, PCMSource);
+	}
+
+	TSharedPtr<FImportedSoundWavePCMSource> FindPCMSource(FSoundWaveProxy& SoundWaveProxy)
+	{
+		const FSoundWaveData* SoundWaveData = SoundWaveProxy.GetSoundWaveData().Get();
+		if (!SoundWaveData)
+		{
+			return nullptr;
+		}
+
+		FRAIScopeLock Lock(&PCMSourceRegistryGuard);
+		if (const TWeakPtr<FImportedSoundWavePCMSource>* PCMSource = PCMSourceRegistry.Find(SoundWaveData))
+		{
+			return PCMSource->Pin();
+		}
+		return nullptr;
+	}
+
 	FImportedWave::FImportedWave(const FProxyDataPtrType& InInitData)
 	{
 		if (InInitData.IsValid())
@@ -17,6 +63,7 @@ namespace RuntimeAudioImporter
 			{
 				UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully retrieved proxy data from Imported Sound Wave"));
 				SoundWaveProxy = MakeShared<FSoundWaveProxy, ESPMode::ThreadSafe>(InInitData->GetAs<FSoundWaveProxy>());
+				PCMSource = FindPCMSource(*SoundWaveProxy);
 			}
 		}
 	}
@@ -0,0 +1,462 @@
+// Georgy Treshchev 2024.
+
+#if WITH_RUNTIMEAUDIOIMPORTER_METASOUND_SUPPORT
+#include "CoreMinimal.h"
+#include "Internationalization/Text.h"
+#include "RuntimeAudioImporterDefines.h"
+#include "Sound/ImportedSoundWave.h"
+
+#include "MetasoundFacade.h"
+#include "MetasoundParamHelper.h"
+#include "MetasoundExecutableOperator.h"
+#include "MetasoundNodeRegistrationMacro.h"
+#include "MetasoundStandardNodesCategories.h"
+#include "MetasoundAudioBuffer.h"
+#include "MetasoundPrimitives.h"
+#include "MetasoundTime.h"
+#include "MetasoundTrigger.h"
+#include "MetasoundVertex.h"
+#include "MetaSound/MetasoundImportedWave.h"
+
+#define LOCTEXT_NAMESPACE "MetasoundImportedWavePlayer"
+
+namespace RuntimeAudioImporter
+{
+	namespace ImportedWavePlayerNodeParameterNames
+	{
+		METASOUND_PARAM(ParamTriggerPlay, "Play", "Play the imported wave from the start time.");
+		METASOUND_PARAM(ParamTriggerStop, "Stop", "Stop the imported wave playback.");
+		METASOUND_PARAM(ParamImportedWave, "Imported Wave", "The imported wave to play. Its PCM data is read directly, no preparation (encoding) is required.");
+		METASOUND_PARAM(ParamStartTime, "Start Time", "Time into the imported wave to start (or seek) playback from when Play is triggered.");
+		METASOUND_PARAM(ParamLoop, "Loop", "Whether to loop the playback.");
+
+		METASOUND_PARAM(ParamOnPlay, "On Play", "Triggers when the playback starts.");
+		METASOUND_PARAM(ParamOnFinished, "On Finished", "Triggers when the playback finishes or is stopped.");
+		METASOUND_PARAM(ParamOnLooped, "On Looped", "Triggers when the playback wraps around to the beginning.");
+		METASOUND_PARAM(ParamAudioLeft, "Out Left", "The left channel audio output. Mono audio is played on both channels.");
+		METASOUND_PARAM(ParamAudioRight, "Out Right", "The right channel audio output. Mono audio is played on both channels.");
+	}
+
+	/**
+	 * Plays back an imported wave by reading its PCM data directly from the shared PCM buffer
+	 * Unlike the Wave Player with a Wave Asset, this requires neither PrepareSoundWaveForMetaSounds nor encoding the whole buffer,
+	 * and picks up audio data appended to streaming sound waves as it arrives
+	 */
+	class FImportedWavePlayerNodeOperator : public Metasound::TExecutableOperator<FImportedWavePlayerNodeOperator>
+	{
+	public:
+		FImportedWavePlayerNodeOperator(const Metasound::FOperatorSettings& InSettings,
+		                                const Metasound::FTriggerReadRef& InPlayTrigger,
+		                                const Metasound::FTriggerReadRef& InStopTrigger,
+		                                const FImportedWaveReadRef& InImportedWave,
+		                                const Metasound::FTimeReadRef& InStartTime,
+		                                const Metasound::FBoolReadRef& InLoop)
+			: PlayTrigger(InPlayTrigger)
+		  , StopTrigger(InStopTrigger)
+		  , ImportedWave(InImportedWave)
+		  , StartTime(InStartTime)
+		  , bLoop(InLoop)
+		  , OnPlayTrigger(Metasound::FTriggerWriteRef::CreateNew(InSettings))
+		  , OnFinishedTrigger(Metasound::FTriggerWriteRef::CreateNew(InSettings))
+		  , OnLoopedTrigger(Metasound::FTriggerWriteRef::CreateNew(InSettings))
+		  , AudioLeft(Metasound::FAudioBufferWriteRef::CreateNew(InSettings))
+		  , AudioRight(Metasound::FAudioBufferWriteRef::CreateNew(InSettings))
+		  , OutputSampleRate(InSettings.GetSampleRate())
+		  , PlaybackFrame(0)
+		  , PlaybackSampleRate(0)
+		  , bIsPlaying(false)
+		  , SnapshotSampleRate(0)
+		  , SnapshotNumOfChannels(0)
+		  , bSnapshotReversePlayback(false)
+		  , SnapshotRevision(0)
+		{
+		}
+
+		static const Metasound::FNodeClassMetadata& GetNodeInfo()
+		{
+			auto InitNodeInfo = []() -> Metasound::FNodeClassMetadata
+			{
+				Metasound::FNodeClassMetadata Metadata
+				{
+					Metasound::FNodeClassName{"RuntimeAudioImporter", "ImportedWavePlayer", "Stereo"},
+					1, // Major Version
+					0, // Minor Version
+					LOCTEXT("ImportedWavePlayerNode_Name", "Imported Wave Player (Stereo)"),
+					LOCTEXT("ImportedWavePlayerNode_Description", "Plays back an imported wave directly from its PCM data, without converting it to a Wave Asset."),
+					RuntimeAudioImporter::PluginAuthor,
+					RuntimeAudioImporter::PluginNodeMissingPrompt,
+					GetDefaultInterface(),
+					{METASOUND_LOCTEXT("RuntimeAudioImporter_Metasound_Category", "RuntimeAudioImporter")},
+					{
+						METASOUND_LOCTEXT("RuntimeAudioImporter_Metasound_Keyword", "RuntimeAudioImported"),
+						METASOUND_LOCTEXT("ImportedSoundWave_Metasound_Keyword", "ImportedSoundWave"),
+						METASOUND_LOCTEXT("ImportedWavePlayer_Metasound_Keyword", "Wave Player")
+					},
+					{}
+				};
+
+				return Metadata;
+			};
+
+			static const Metasound::FNodeClassMetadata Info = InitNodeInfo();
+
+			return Info;
+		}
+
+		static const Metasound::FVertexInterface& GetDefaultInterface()
+		{
+			using namespace Metasound;
+			using namespace ImportedWavePlayerNodeParameterNames;
+
+			static const FVertexInterface DefaultInterface(
+				FInputVertexInterface(
+					TInputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(ParamTriggerPlay)),
+					TInputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(ParamTriggerStop)),
+					TInputDataVertex<FImportedWave>(METASOUND_GET_PARAM_NAME_AND_METADATA(ParamImportedWave)),
+					TInputDataVertex<FTime>(METASOUND_GET_PARAM_NAME_AND_METADATA(ParamStartTime), 0.0f),
+					TInputDataVertex<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(ParamLoop), false)
+				),
+				FOutputVertexInterface(
+					TOutputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(ParamOnPlay)),
+					TOutputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(ParamOnFinished)),
+					TOutputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(ParamOnLooped)),
+					TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(ParamAudioLeft)),
+					TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(ParamAudioRight))
+				)
+			);
+
+			return DefaultInterface;
+		}
+
+#if UE_VERSION_OLDER_THAN(5, 4, 0)
+		static TUniquePtr<IOperator> CreateOperator(const Metasound::FCreateOperatorParams& InParams, Metasound::FBuildErrorArray& OutErrors)
+		{
+			using namespace Metasound;
+			using namespace ImportedWavePlayerNodeParameterNames;
+
+			const FDataReferenceCollection& InputDataRefs = InParams.InputDataReferences;
+			const FInputVertexInterface& InputInterface = GetDefaultInterface().GetInputInterface();
+
+			FTriggerReadRef PlayTriggerIn = InputDataRefs.GetDataReadReferenceOrConstruct<FTrigger>(METASOUND_GET_PARAM_NAME(ParamTriggerPlay), InParams.OperatorSettings);
+			FTriggerReadRef StopTriggerIn = InputDataRefs.GetDataReadReferenceOrConstruct<FTrigger>(METASOUND_GET_PARAM_NAME(ParamTriggerStop), InParams.OperatorSettings);
+			FImportedWaveReadRef ImportedWaveIn = InputDataRefs.GetDataReadReferenceOrConstruct<FImportedWave>(METASOUND_GET_PARAM_NAME(ParamImportedWave));
+			FTimeReadRef StartTimeIn = InputDataRefs.GetDataReadReferenceOrConstructWithVertexDefault<FTime>(InputInterface, METASOUND_GET_PARAM_NAME(ParamStartTime), InParams.OperatorSettings);
+			FBoolReadRef LoopIn = InputDataRefs.GetDataReadReferenceOrConstructWithVertexDefault<bool>(InputInterface, METASOUND_GET_PARAM_NAME(ParamLoop), InParams.OperatorSettings);
+
+			return MakeUnique<FImportedWavePlayerNodeOperator>(InParams.OperatorSettings, PlayTriggerIn, StopTriggerIn, ImportedWaveIn, StartTimeIn, LoopIn);
+		}
+#else
+		static TUniquePtr<IOperator> CreateOperator(const Metasound::FBuildOperatorParams& InParams, Metasound::FBuildResults& OutResults)
+		{
+			using namespace Metasound;
+			using namespace ImportedWavePlayerNodeParameterNames;
+
+			const FInputVertexInterfaceData& InputDataRefs = InParams.InputData;
+
+			FTriggerReadRef PlayTriggerIn = InputDataRefs.GetOrConstructDataReadReference<FTrigger>(METASOUND_GET_PARAM_NAME(ParamTriggerPlay), InParams.OperatorSettings);
+			FTriggerReadRef StopTriggerIn = InputDataRefs.GetOrConstructDataReadReference<FTrigger>(METASOUND_GET_PARAM_NAME(ParamTriggerStop), InParams.OperatorSettings);
+			FImportedWaveReadRef ImportedWaveIn = InputDataRefs.GetOrCreateDefaultDataReadReference<FImportedWave>(METASOUND_GET_PARAM_NAME(ParamImportedWave), InParams.OperatorSettings);
+			FTimeReadRef StartTimeIn = InputDataRefs.GetOrCreateDefaultDataReadReference<FTime>(METASOUND_GET_PARAM_NAME(ParamStartTime), InParams.OperatorSettings);
+			FBoolReadRef LoopIn = InputDataRefs.GetOrCreateDefaultDataReadReference<bool>(METASOUND_GET_PARAM_NAME(ParamLoop), InParams.OperatorSettings);
+
+			return MakeUnique<FImportedWavePlayerNodeOperator>(InParams.OperatorSettings, PlayTriggerIn, StopTriggerIn, ImportedWaveIn, StartTimeIn, LoopIn);
+		}
+#endif
+
+		virtual Metasound::FDataReferenceCollection GetInputs() const override
+		{
+			using namespace Metasound;
+			using namespace ImportedWavePlayerNodeParameterNames;
+
+			FDataReferenceCollection InputDataReferences;
+			InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(ParamTriggerPlay), PlayTrigger);
+			InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(ParamTriggerStop), StopTrigger);
+			InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(ParamImportedWave), ImportedWave);
+			InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(ParamStartTime), StartTime);
+			InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(ParamLoop), bLoop);
+
+			return InputDataReferences;
+		}
+
+		virtual Metasound::FDataReferenceCollection GetOutputs() const override
+		{
+			using namespace Metasound;
+			using namespace ImportedWavePlayerNodeParameterNames;
+
+			FDataReferenceCollection OutputDataReferences;
+			OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(ParamOnPlay), FTriggerReadRef(OnPlayTrigger));
+			OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(ParamOnFinished), FTriggerReadRef(OnFinishedTrigger));
+			OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(ParamOnLooped), FTriggerReadRef(OnLoopedTrigger));
+			OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(ParamAudioLeft), FAudioBufferReadRef(AudioLeft));
+			OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(ParamAudioRight), FAudioBufferReadRef(AudioRight));
+
+			return OutputDataReferences;
+		}
+
+		void Execute()
+		{
+			OnPlayTrigger->AdvanceBlock();
+			OnFinishedTrigger->AdvanceBlock();
+			OnLoopedTrigger->AdvanceBlock();
+
+			AudioLeft->Zero();
+			AudioRight->Zero();
+
+			const int32 NumFramesInBlock = AudioLeft->Num();
+
+			// Play and Stop events sorted by the frame within the block so that they are applied sample-accurately
+			TArray<TPair<int32, bool>, TInlineAllocator<8>> Events;
+			for (int32 TriggerIndex = 0; TriggerIndex < PlayTrigger->NumTriggeredInBlock(); ++TriggerIndex)
+			{
+				Events.Emplace((*PlayTrigger)[TriggerIndex], true);
+			}
+			for (int32 TriggerIndex = 0; TriggerIndex < StopTrigger->NumTriggeredInBlock(); ++TriggerIndex)
+			{
+				Events.Emplace((*StopTrigger)[TriggerIndex], false);
+			}
+			Events.StableSort([](const TPair<int32, bool>& A, const TPair<int32, bool>& B)
+			{
+				return A.Key < B.Key;
+			});
+
+			int32 CurrentFrame = 0;
+			for (const TPair<int32, bool>& Event : Events)
+			{
+				const int32 EventFrame = FMath::Clamp(Event.Key, 0, NumFramesInBlock);
+				RenderFrames(CurrentFrame, EventFrame);
+				CurrentFrame = EventFrame;
+
+				if (Event.Value)
+				{
+					StartPlayback(EventFrame);
+				}
+				else if (bIsPlaying)
+				{
+					bIsPlaying = false;
+					OnFinishedTrigger->TriggerFrame(EventFrame);
+				}
+			}
+			RenderFrames(CurrentFrame, NumFramesInBlock);
+		}
+
+	private:
+		/**
+		 * Start (or restart) the playback from the start time at the specified frame within the block
+		 */
+		void StartPlayback(int32 BlockFrame)
+		{
+			PCMSource = ImportedWave->GetPCMSource();
+			if (!PCMSource.IsValid())
+			{
+				UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Unable to play the imported wave because it has no PCM source. Make sure the Imported Wave input is set to an imported sound wave"));
+				bIsPlaying = false;
+				return;
+			}
+
+			// The PCM source may be a different one than before, so the snapshot is taken regardless of the revision
+			UpdatePCMSnapshot(true);
+			const int64 SourceNumOfFrames = PCMSnapshot.IsValid() ? PCMSnapshot->PCMNumOfFrames : 0;
+
+			// The start time is a position in the PCM data in both directions, and a reverse playback without it starts from the end
+			const double StartSeconds = StartTime->GetSeconds();
+			PlaybackFrame = bSnapshotReversePlayback && StartSeconds <= 0
+				? FMath::Max<double>(SourceNumOfFrames - 1, 0)
+				: FMath::Max(0.0, StartSeconds * SnapshotSampleRate);
+			PlaybackSampleRate = SnapshotSampleRate;
+			bIsPlaying = true;
+			OnPlayTrigger->TriggerFrame(BlockFrame);
+		}
+
+		/**
+		 * Take a new snapshot of the PCM data and its format if the PCM source has changed since the last one (or if forced)
+		 * The PCM source data guard is only locked when taking the snapshot, so rendering a block normally costs a single atomic load
+		 */
+		void UpdatePCMSnapshot(bool bForce = false)
+		{
+			if (!bForce && PCMSource->Revision.load(std::memory_order_acquire) == SnapshotRevision)
+			{
+				return;
+			}
+
+			FRAIScopeLock Lock(&*PCMSource->DataGuard);
+
+			SnapshotRevision = PCMSource->Revision.load(std::memory_order_relaxed);
+			SnapshotSampleRate = PCMSource->SampleRate;
+			SnapshotNumOfChannels = PCMSource->NumOfChannels;
+			bSnapshotReversePlayback = PCMSource->bReversePlayback;
+
+			// There is no audio data yet (e.g. a streaming sound wave that hasn't received any data)
+			if (!PCMSource->PCMBufferInfo->IsValid())
+			{
+				PCMSnapshot.Reset();
+				return;
+			}
+
+			// The snapshot shares the allocation of the live PCM data, so taking it doesn't copy any audio data, and the data appended afterwards doesn't affect the shared frames
+			TSharedRef<FPCMStruct, ESPMode::ThreadSafe> Snapshot = MakeShared<FPCMStruct, ESPMode::ThreadSafe>();
+			Snapshot->PCMData = PCMSource->PCMBufferInfo->PCMData.Share();
+			Snapshot->PCMDataInt16 = PCMSource->PCMBufferInfo->PCMDataInt16.Share();
+			Snapshot->PCMNumOfFrames = PCMSource->PCMBufferInfo->PCMNumOfFrames;
+			PCMSnapshot = Snapshot;
+		}
+
+		/**
+		 * Render the PCM data into the output buffers for the specified range of frames within the block
+		 */
+		void RenderFrames(int32 StartFrame, int32 EndFrame)
+		{
+			if (!bIsPlaying || StartFrame >= EndFrame || !PCMSource.IsValid())
+			{
+				return;
+			}
+
+			UpdatePCMSnapshot();
+
+			// There is no audio data yet (e.g. a streaming sound wave that hasn't received any data), so keep waiting for it
+			if (!PCMSnapshot.IsValid() || !PCMSnapshot->IsValid() || SnapshotNumOfChannels <= 0 || PCMSnapshot->PCMNumOfFrames <= 0 || SnapshotSampleRate <= 0)
+			{
+				return;
+			}
+
+			const int64 NumOfChannels = SnapshotNumOfChannels;
+			const int64 NumOfFrames = PCMSnapshot->PCMNumOfFrames;
+
+			// The PCM data has been resampled during playback (e.g. by ResampleSoundWave), so keep the playback position at the same time
+			if (SnapshotSampleRate != PlaybackSampleRate)
+			{
+				if (PlaybackSampleRate > 0)
+				{
+					PlaybackFrame *= static_cast<double>(SnapshotSampleRate) / PlaybackSampleRate;
+				}
+				PlaybackSampleRate = SnapshotSampleRate;
+			}
+
+			// The PCM data is read in the format it is stored in, converting only the interpolated samples
+			if (PCMSnapshot->GetStorageFormat() == ERuntimePCMStorageFormat::Int16)
+			{
+				RenderPCMFrames(PCMSnapshot->PCMDataInt16.GetView().GetData(), NumOfChannels, NumOfFrames, StartFrame, EndFrame);
+			}
+			else
+			{
+				RenderPCMFrames(PCMSnapshot->PCMData.GetView().GetData(), NumOfChannels, NumOfFrames, StartFrame, EndFrame);
+			}
+		}
+
+		/**
+		 * Convert a PCM sample to 32-bit float
+		 */
+		static float SampleToFloat(float Sample)
+		{
+			return Sample;
+		}
+
+		static float SampleToFloat(int16 Sample)
+		{
+			return static_cast<float>(Sample) / MAX_int16;
+		}
+
+		/**
+		 * Render the PCM data stored in the specified sample format into the output buffers
+		 */
+		template <typename SampleType>
+		void RenderPCMFrames(const SampleType* PCMData, int64 NumOfChannels, int64 NumOfFrames, int32 StartFrame, int32 EndFrame)
+		{
+			float* LeftData = AudioLeft->GetData();
+			float* RightData = AudioRight->GetData();
+
+			// Linear interpolation is used to play the PCM data at the output sample rate. When playing in reverse (see UImportedSoundWave::SetReversePlayback), the playback position moves backwards
+			const double FrameStep = static_cast<double>(SnapshotSampleRate) / OutputSampleRate * (bSnapshotReversePlayback ? -1 : 1);
+			const int64 RightChannelOffset = NumOfChannels > 1 ? 1 : 0;
+
+			for (int32 Frame = StartFrame; Frame < EndFrame; ++Frame)
+			{
+				if (PlaybackFrame >= NumOfFrames || PlaybackFrame < 0)
+				{
+					if (*bLoop)
+					{
+						PlaybackFrame = FMath::Fmod(PlaybackFrame, static_cast<double>(NumOfFrames));
+						if (PlaybackFrame < 0)
+						{
+							PlaybackFrame += NumOfFrames;
+						}
+						OnLoopedTrigger->TriggerFrame(Frame);
+					}
+					else
+					{
+						bIsPlaying = false;
+						OnFinishedTrigger->TriggerFrame(Frame);
+						return;
+					}
+				}
+
+				const int64 FrameIndex = static_cast<int64>(PlaybackFrame);
+				const int64 NextFrameIndex = FrameIndex + 1 < NumOfFrames ? FrameIndex + 1 : (*bLoop ? 0 : FrameIndex);
+				const float Alpha = static_cast<float>(PlaybackFrame - FrameIndex);
+
+				const SampleType* CurrentSamples = PCMData + FrameIndex * NumOfChannels;
+				const SampleType* NextSamples = PCMData + NextFrameIndex * NumOfChannels;
+
+				LeftData[Frame] = FMath::Lerp(SampleToFloat(CurrentSamples[0]), SampleToFloat(NextSamples[0]), Alpha);
+				RightData[Frame] = FMath::Lerp(SampleToFloat(CurrentSamples[RightChannelOffset]), SampleToFloat(NextSamples[RightChannelOffset]), Alpha);
+
+				PlaybackFrame += FrameStep;
+			}
+		}
+
+		Metasound::FTriggerReadRef PlayTrigger;
+		Metasound::FTriggerReadRef StopTrigger;
+		FImportedWaveReadRef ImportedWave;
+		Metasound::FTimeReadRef StartTime;
+		Metasound::FBoolReadRef bLoop;
+
+		Metasound::FTriggerWriteRef OnPlayTrigger;
+		Metasound::FTriggerWriteRef OnFinishedTrigger;
+		Metasound::FTriggerWriteRef OnLoopedTrigger;
+		Metasound::FAudioBufferWriteRef AudioLeft;
+		Metasound::FAudioBufferWriteRef AudioRight;
+
+		/** PCM source of the imported wave being played. Keeps the PCM data alive during playback */
+		TSharedPtr<FImportedSoundWavePCMSource> PCMSource;
+
+		/** Sample rate of the MetaSound graph */
+		float OutputSampleRate;
+
+		/** Fractional playback position, in frames of the PCM data */
+		double PlaybackFrame;
+
+		/** Sample rate of the PCM data PlaybackFrame refers to */
+		uint32 PlaybackSampleRate;
+
+		/** Whether the imported wave is currently playing */
+		bool bIsPlaying;
+
+		/** Snapshot of the PCM data being played, read without locking the PCM source data guard */
+		FImportedSoundWavePCMSnapshotPtr PCMSnapshot;
+
+		/** Sample rate of the PCM data in the snapshot */
+		uint32 SnapshotSampleRate;
+
+		/** Number of channels of the PCM data in the snapshot */
+		uint32 SnapshotNumOfChannels;
+
+		/** Whether the PCM data in the snapshot is played in reverse or not */
+		bool bSnapshotReversePlayback;
+
+		/** Revision of the PCM source the snapshot was taken at */
+		uint64 SnapshotRevision;
+	};
+
+	class FImportedWavePlayerNode : public Metasound::FNodeFacade
+	{
+	public:
+		FImportedWavePlayerNode(const Metasound::FNodeInitData& InInitData)
+			: FNodeFacade(InInitData.InstanceName, InInitData.InstanceID, Metasound::TFacadeOperatorClass<FImportedWavePlayerNodeOperator>())
+		{
+		}
+	};
+
+	METASOUND_REGISTER_NODE(FImportedWavePlayerNode);
+}
+
+#undef LOCTEXT_NAMESPACE
+#endif
@@ -6,7 +6,13 @@
 #include "RuntimeAudioTranscoder.h"
 #include "RuntimeAudioUtilities.h"
 #include "Codecs/RAW_RuntimeCodec.h"
+#include "Codecs/RuntimeCodecFactory.h"
+#include "Codecs/RuntimePCMFormatConverter.h"
+#include "Sound/ImportedSoundWavePCMReadLease.h"
 #include "Async/Async.h"
+#include "HAL/PlatformFileManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Misc/Paths.h"
 
 void URuntimeAudioExporter::ExportSoundWaveToFile(UImportedSoundWave* ImportedSoundWave, const FString& SavePath, ERuntimeAudioFormat AudioFormat, uint8 Quality, const FRuntimeAudioExportOverrideOptions& OverrideOptions, const FOnAudioExportToFileResult& Result)
 {
@@ -26,6 +32,16 @@ void URuntimeAudioExporter::ExportSoundWaveToFile(UImportedSoundWave* ImportedSo
 void URuntimeAudioExporter::ExportSoundWaveToFile(TWeakObjectPtr<UImportedSoundWave> ImportedSoundWavePtr, const FString& SavePath, ERuntimeAudioFormat AudioFormat, uint8 Quality, const FRuntimeAudioExportOverrideOptions& OverrideOptions, const FOnAudioExportToFileResultNative& Result)
 {
 #if WITH_RUNTIMEAUDIOIMPORTER_FILEOPERATION_SUPPORT
+	// Opening and writing the file should not block the game thread
+	if (IsInGameThread())
+	{
+		AsyncTask(ENamedThreads::AnyBackgroundHiPriTask, [ImportedSoundWavePtr, SavePath, AudioFormat, Quality, OverrideOptions, Result]()
+		{
+			ExportSoundWaveToFile(ImportedSoundWavePtr, SavePath, AudioFormat, Quality, OverrideOptions, Result);
+		});
+		return;
+	}
+
 	TArray<ERuntimeAudioFormat> AudioFormats = URuntimeAudioUtilities::GetAudioFormats(SavePath);
 
 	AudioFormat = AudioFormat == ERuntimeAudioFormat::Auto ? (AudioFormats.Num() == 0 ? ERuntimeAudioFormat::Invalid : AudioFormats[0]) : AudioFormat;
@@ -33,6 +49,46 @@ void URuntimeAudioExporter::ExportSoundWaveToFile(TWeakObjectPtr<UImportedSoundW
 	// Can't export to a file if there are multiple audio formats available
 	AudioFormat = AudioFormats.Num() > 1 ? ERuntimeAudioFormat::Invalid : AudioFormat;
 
+	// Encoding directly into the file if the format supports incremental encoding, so that the encoded data is never held in memory
+	{
+		bool bSupportsEncoderSession = false;
+		FRuntimeCodecFactory CodecFactory;
+		for (FBaseRuntimeCodec* Codec : CodecFactory.GetCodecs(AudioFormat))
+		{
+			if (Codec->CreateEncoderSession().IsValid())
+			{
+				bSupportsEncoderSession = true;
+				break;
+			}
+		}
+
+		if (bSupportsEncoderSession)
+		{
+			IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+			PlatformFile.CreateDirectoryTree(*FPaths::GetPath(SavePath));
+
+			TUniquePtr<IFileHandle> FileHandle(PlatformFile.OpenWrite(*SavePath));
+			if (!FileHandle.IsValid())
+			{
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to open the file '%s' for writing"), *SavePath);
+				Result.ExecuteIfBound(false);
+				return;
+			}
+
+			// Double-buffered asynchronous writes let the encoding overlap with the disk I/O
+			// The sink closes the file before the result is reported, so a truncated file left by a failed encoding can be deleted
+			ExportSoundWaveToSink(ImportedSoundWavePtr, MakeUnique<FRuntimeFileHandleAudioSink>(MoveTemp(FileHandle), FRuntimeFileHandleAudioSink::DefaultAsyncWriteBufferSize), AudioFormat, Quality, OverrideOptions, FOnAudioExportToFileResultNative::CreateLambda([Result, SavePath](bool bSucceeded)
+			{
+				if (!bSucceeded)
+				{
+					DeletePartiallyExportedFile(SavePath);
+				}
+				Result.ExecuteIfBound(bSucceeded);
+			}));
+			return;
+		}
+	}
+
 	ExportSoundWaveToBuffer(ImportedSoundWavePtr, AudioFormat, Quality, OverrideOptions, FOnAudioExportToBufferResultNative::CreateLambda([Result, SavePath](bool bSucceeded, const TArray64<uint8>& AudioData)
 	{
 		if (!bSucceeded)
@@ -44,6 +100,7 @@ void URuntimeAudioExporter::ExportSoundWaveToFile(TWeakObjectPtr<UImportedSoundW
 		if (!RuntimeAudioImporter::SaveAudioFileFromArray(AudioData, *SavePath))
 		{
 			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Something went wrong when saving audio data to the path '%s'"), *SavePath);
+			DeletePartiallyExportedFile(SavePath);
 			Result.ExecuteIfBound(false);
 			return;
 		}
@@ -56,6 +113,106 @@ void URuntimeAudioExporter::ExportSoundWaveToFile(TWeakObjectPtr<UImportedSoundW
 #endif
 }
 
+void URuntimeAudioExporter::ExportSoundWaveToSink(TWeakObjectPtr<UImportedSoundWave> ImportedSoundWavePtr, TUniquePtr<FBaseRuntimeEncodedAudioSink> Sink, ERuntimeAudioFormat AudioFormat, uint8 Quality, const FRuntimeAudioExportOverrideOptions& OverrideOptions, const FOnAudioExportToFileResultNative& Result)
+{
+	if (IsInGameThread())
+	{
+		AsyncTask(ENamedThreads::AnyBackgroundHiPriTask, [ImportedSoundWavePtr, Sink = MoveTemp(Sink), AudioFormat, Quality, OverrideOptions, Result]() mutable
+		{
+			ExportSoundWaveToSink(ImportedSoundWavePtr, MoveTemp(Sink), AudioFormat, Quality, OverrideOptions, Result);
+		});
+		return;
+	}
+
+	TUniquePtr<FBaseRuntimeEncoderSession> Session;
+
+	// Releasing the session and the sink (e.g. closing the file) before reporting the result, so that the result handler is free to delete or read the output
+	auto ExecuteResult = [Result, &Session, &Sink](bool bSucceeded)
+	{
+		Session.Reset();
+		Sink.Reset();
+		AsyncTask(ENamedThreads::AnyBackgroundHiPriTask, [Result, bSucceeded]()
+		{
+			Result.ExecuteIfBound(bSucceeded);
+		});
+	};
+
+	if (!Sink.IsValid())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to export sound wave as the sink is invalid"));
+		ExecuteResult(false);
+		return;
+	}
+
+	{
+		FRuntimeCodecFactory CodecFactory;
+		for (FBaseRuntimeCodec* Codec : CodecFactory.GetCodecs(AudioFormat))
+		{
+			Session = Codec->CreateEncoderSession();
+			if (Session.IsValid())
+			{
+				break;
+			}
+		}
+	}
+
+	if (!Session.IsValid())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to export sound wave as the %s format does not support incremental encoding"), *UEnum::GetValueAsString(AudioFormat));
+		ExecuteResult(false);
+		return;
+	}
+
+	FDecodedAudioStruct DecodedAudioInfo;
+	if (!GetDecodedAudioForExport(ImportedSoundWavePtr, OverrideOptions, DecodedAudioInfo))
+	{
+		ExecuteResult(false);
+		return;
+	}
+
+	const uint32 NumOfChannels = DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels;
+	if (!Session->Begin(MoveTemp(Sink), DecodedAudioInfo.SoundWaveBasicInfo.SampleRate, NumOfChannels, Quality))
+	{
+		ExecuteResult(false);
+		return;
+	}
+
+	// Pushing in chunks to keep the temporary buffers of the encoders small
+	constexpr int64 FramesChunkSize = 65536;
+	const FPCMStruct& PCMInfo = DecodedAudioInfo.PCMInfo;
+	const int64 NumOfFrames = PCMInfo.GetNumOfSamples() / NumOfChannels;
+
+	// The 16-bit integer PCM data is converted chunk by chunk rather than as a whole
+	TArray<float> ChunkPCMData;
+	if (PCMInfo.GetStorageFormat() == ERuntimePCMStorageFormat::Int16)
+	{
+		ChunkPCMData.SetNumUninitialized(FMath::Min<int64>(FramesChunkSize, NumOfFrames) * NumOfChannels);
+	}
+
+	for (int64 FrameIndex = 0; FrameIndex < NumOfFrames; FrameIndex += FramesChunkSize)
+	{
+		const int64 NumOfChunkFrames = FMath::Min<int64>(FramesChunkSize, NumOfFrames - FrameIndex);
+		const float* ChunkData = ChunkPCMData.GetData();
+		if (PCMInfo.GetStorageFormat() == ERuntimePCMStorageFormat::Int16)
+		{
+			FRAW_RuntimeCodec::CopyPCMDataAsFloat(PCMInfo, FrameIndex * NumOfChannels, NumOfChunkFrames * NumOfChannels, ChunkPCMData.GetData());
+		}
+		else
+		{
+			ChunkData = PCMInfo.PCMData.GetView().GetData() + FrameIndex * NumOfChannels;
+		}
+
+		if (!Session->PushFrames(ChunkData, NumOfChunkFrames))
+		{
+			Session->Finish();
+			ExecuteResult(false);
+			return;
+		}
+	}
+
+	ExecuteResult(Session->Finish());
+}
+
 void URuntimeAudioExporter::ExportSoundWaveToBuffer(UImportedSoundWave* ImportedSoundWave, ERuntimeAudioFormat AudioFormat, uint8 Quality, const FRuntimeAudioExportOverrideOptions& OverrideOptions, const FOnAudioExportToBufferResult& Result)
 {
 	if (!IsValid(ImportedSoundWave))
@@ -105,71 +262,20 @@ void URuntimeAudioExporter::ExportSoundWaveToBuffer(TWeakObjectPtr<UImportedSoun
 	}
 
 	FDecodedAudioStruct DecodedAudioInfo;
+	if (!GetDecodedAudioForExport(ImportedSoundWavePtr, OverrideOptions, DecodedAudioInfo))
 	{
-		FRAIScopeLock Lock(&*ImportedSoundWavePtr->DataGuard);
-
-		if (!ImportedSoundWavePtr->GetPCMBuffer().IsValid())
-		{
-			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to export sound wave as the PCM data is invalid"));
-			ExecuteResult(false, TArray64<uint8>());
-			return;
-		}
-
-		{
-			DecodedAudioInfo.PCMInfo = ImportedSoundWavePtr->GetPCMBuffer();
-			FSoundWaveBasicStruct SoundWaveBasicInfo;
-			{
-				SoundWaveBasicInfo.NumOfChannels = ImportedSoundWavePtr->GetNumOfChannels();
-				SoundWaveBasicInfo.SampleRate = ImportedSoundWavePtr->GetSampleRate();
-				SoundWaveBasicInfo.Duration = ImportedSoundWavePtr->GetDurationConst_Internal();
-			}
-			DecodedAudioInfo.SoundWaveBasicInfo = MoveTemp(SoundWaveBasicInfo);
-		}
+		ExecuteResult(false, TArray64<uint8>());
+		return;
 	}
 
+	// The encoders take 32-bit float PCM data
+	FRAW_RuntimeCodec::ConvertPCMStorageFormat(DecodedAudioInfo.PCMInfo, ERuntimePCMStorageFormat::Float32);
+
 	FEncodedAudioStruct EncodedAudioInfo;
 	{
 		EncodedAudioInfo.AudioFormat = AudioFormat;
 	}
 
-	// Check if the number of channels and the sampling rate of the sound wave and desired override options are not the same
-	if (OverrideOptions.IsOverriden() && (ImportedSoundWavePtr->GetSampleRate() != OverrideOptions.SampleRate || ImportedSoundWavePtr->GetNumOfChannels() != OverrideOptions.NumOfChannels))
-	{
-		Audio::FAlignedFloatBuffer WaveData(DecodedAudioInfo.PCMInfo.PCMData.GetView().GetData(), DecodedAudioInfo.PCMInfo.PCMData.GetView().Num());
-
-		// Resampling if needed
-		if (OverrideOptions.IsSampleRateOverriden() && ImportedSoundWavePtr->GetSampleRate() != OverrideOptions.SampleRate)
-		{
-			Audio::FAlignedFloatBuffer ResamplerOutputData;
-			if (!FRAW_RuntimeCodec::ResampleRAWData(WaveData, ImportedSoundWavePtr->GetNumOfChannels(), ImportedSoundWavePtr->GetSampleRate(), OverrideOptions.SampleRate, ResamplerOutputData))
-			{
-				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to resample audio data to the overriden sample rate. Resampling failed"));
-				ExecuteResult(false, TArray64<uint8>());
-				return;
-			}
-
-			WaveData = MoveTemp(ResamplerOutputData);
-			DecodedAudioInfo.SoundWaveBasicInfo.SampleRate = OverrideOptions.SampleRate;
-		}
-
-		// Mixing the channels if needed
-		if (OverrideOptions.IsNumOfChannelsOverriden() && ImportedSoundWavePtr->GetNumOfChannels() != OverrideOptions.NumOfChannels)
-		{
-			Audio::FAlignedFloatBuffer WaveDataTemp;
-			if (!FRAW_RuntimeCodec::MixChannelsRAWData(WaveData, OverrideOptions.SampleRate, DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels, OverrideOptions.NumOfChannels, WaveDataTemp))
-			{
-				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to mix audio channels to the overriden number of channels. Mixing failed"));
-				ExecuteResult(false, TArray64<uint8>());
-				return;
-			}
-			WaveData = MoveTemp(WaveDataTemp);
-			DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels = OverrideOptions.NumOfChannels;
-		}
-
-		DecodedAudioInfo.PCMInfo.PCMNumOfFrames = WaveData.Num() / DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels;
-		DecodedAudioInfo.PCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(WaveData);
-	}
-
 	if (!URuntimeAudioImporterLibrary::EncodeAudioData(MoveTemp(DecodedAudioInfo), EncodedAudioInfo, Quality))
 	{
 		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to export sound wave '%s'"), *ImportedSoundWavePtr->GetName());
@@ -209,6 +315,7 @@ void URuntimeAudioExporter::ExportSoundWaveToRAWFile(TWeakObjectPtr<UImportedSou
 		if (!RuntimeAudioImporter::SaveAudioFileFromArray(AudioData, *SavePath))
 		{
 			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Something went wrong when saving RAW audio data to the path '%s'"), *SavePath);
+			DeletePartiallyExportedFile(SavePath);
 			Result.ExecuteIfBound(false);
 			return;
 		}
@@ -269,58 +376,106 @@ void URuntimeAudioExporter::ExportSoundWaveToRAWBuffer(TWeakObjectPtr<UImportedS
 		return;
 	}
 
-	FRAIScopeLock Lock(&*ImportedSoundWavePtr->DataGuard);
-
-	if (!ImportedSoundWavePtr->GetPCMBuffer().IsValid())
+	FDecodedAudioStruct DecodedAudioInfo;
+	if (!GetDecodedAudioForExport(ImportedSoundWavePtr, OverrideOptions, DecodedAudioInfo))
 	{
-		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to export sound wave as the PCM data is invalid"));
 		ExecuteResult(false, TArray64<uint8>());
 		return;
 	}
 
+	const FPCMStruct& PCMBufferInfo = DecodedAudioInfo.PCMInfo;
 	TArray64<uint8> RAWDataFrom;
+	ERuntimeRAWAudioFormat RAWFormatFrom = ERuntimeRAWAudioFormat::Float32;
 
-	// Check if the number of channels and the sampling rate of the sound wave and desired override options are not the same
-	if (OverrideOptions.IsOverriden() && (ImportedSoundWavePtr->GetSampleRate() != OverrideOptions.SampleRate || ImportedSoundWavePtr->GetNumOfChannels() != OverrideOptions.NumOfChannels))
+	// Transcoding from the format the PCM data is stored in, so the 16-bit integer PCM data is not converted to float and back
+	if (PCMBufferInfo.GetStorageFormat() == ERuntimePCMStorageFormat::Int16)
+	{
+		RAWDataFrom = TArray64<uint8>(reinterpret_cast<const uint8*>(PCMBufferInfo.PCMDataInt16.GetView().GetData()), PCMBufferInfo.PCMDataInt16.GetView().Num() * sizeof(int16));
+		RAWFormatFrom = ERuntimeRAWAudioFormat::Int16;
+	}
+	else
 	{
-		Audio::FAlignedFloatBuffer WaveData(ImportedSoundWavePtr->GetPCMBuffer().PCMData.GetView().GetData(), ImportedSoundWavePtr->GetPCMBuffer().PCMData.GetView().Num());
+		RAWDataFrom = TArray64<uint8>(reinterpret_cast<const uint8*>(PCMBufferInfo.PCMData.GetView().GetData()), PCMBufferInfo.PCMData.GetView().Num() * sizeof(float));
+	}
 
-		// Resampling if needed
-		if (OverrideOptions.IsSampleRateOverriden() && ImportedSoundWavePtr->GetSampleRate() != OverrideOptions.SampleRate)
-		{
-			Audio::FAlignedFloatBuffer ResamplerOutputData;
-			if (!FRAW_RuntimeCodec::ResampleRAWData(WaveData, ImportedSoundWavePtr->GetNumOfChannels(), ImportedSoundWavePtr->GetSampleRate(), OverrideOptions.SampleRate, ResamplerOutputData))
-			{
-				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to resample audio data to the overriden sample rate. Resampling failed"));
-				ExecuteResult(false, TArray64<uint8>());
-				return;
-			}
+	URuntimeAudioTranscoder::TranscodeRAWDataFromBuffer(MoveTemp(RAWDataFrom), RAWFormatFrom, RAWFormat, FOnRAWDataTranscodeFromBufferResultNative::CreateWeakLambda(ImportedSoundWavePtr.Get(), [ExecuteResult](bool bSucceeded, const TArray64<uint8>& RAWData)
+	{
+		ExecuteResult(bSucceeded, RAWData);
+	}));
+}
 
-			WaveData = MoveTemp(ResamplerOutputData);
-		}
+bool URuntimeAudioExporter::GetDecodedAudioForExport(TWeakObjectPtr<UImportedSoundWave> ImportedSoundWavePtr, const FRuntimeAudioExportOverrideOptions& OverrideOptions, FDecodedAudioStruct& DecodedAudioInfo)
+{
+	if (!ImportedSoundWavePtr.IsValid())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to export sound wave as it is invalid"));
+		return false;
+	}
+
+	// Pinning the PCM data instead of copying it under the data guard, so the sound wave is not blocked for the duration of the export
+	const FImportedSoundWavePCMReadLease Lease = ImportedSoundWavePtr->AcquirePCMReadLease();
+	if (!Lease.IsValid() || Lease.GetNumOfChannels() == 0 || Lease.GetSampleRate() == 0)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to export sound wave as the PCM data is invalid"));
+		return false;
+	}
 
-		// Mixing the channels if needed
-		if (OverrideOptions.IsNumOfChannelsOverriden() && ImportedSoundWavePtr->GetNumOfChannels() != OverrideOptions.NumOfChannels)
+	if ((OverrideOptions.IsSampleRateOverriden() && OverrideOptions.SampleRate <= 0) || (OverrideOptions.IsNumOfChannelsOverriden() && OverrideOptions.NumOfChannels <= 0))
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to export sound wave as the overriden sample rate (%d) or number of channels (%d) is invalid"), OverrideOptions.SampleRate, OverrideOptions.NumOfChannels);
+		return false;
+	}
+
+	const uint32 TargetSampleRate = OverrideOptions.IsSampleRateOverriden() ? static_cast<uint32>(OverrideOptions.SampleRate) : Lease.GetSampleRate();
+	const uint32 TargetNumOfChannels = OverrideOptions.IsNumOfChannelsOverriden() ? static_cast<uint32>(OverrideOptions.NumOfChannels) : Lease.GetNumOfChannels();
+
+	// Referencing the pinned PCM data as is if the format does not need to be changed
+	if (TargetSampleRate == Lease.GetSampleRate() && TargetNumOfChannels == Lease.GetNumOfChannels())
+	{
+		DecodedAudioInfo.PCMInfo = Lease.SharePCMData();
+		DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels = Lease.GetNumOfChannels();
+		DecodedAudioInfo.SoundWaveBasicInfo.SampleRate = Lease.GetSampleRate();
+		DecodedAudioInfo.SoundWaveBasicInfo.Duration = static_cast<float>(Lease.GetNumOfFrames()) / Lease.GetSampleRate();
+		return true;
+	}
+
+	// Converting block by block straight from the pinned PCM data, so only the PCM data in the target format is allocated
+	FRuntimePCMFormatConverter Converter(Lease.GetSampleRate(), Lease.GetNumOfChannels(), TargetSampleRate, TargetNumOfChannels);
+	if (!Converter.IsValid())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to convert audio data from %d Hz and %d channels to %d Hz and %d channels"), Lease.GetSampleRate(), Lease.GetNumOfChannels(), TargetSampleRate, TargetNumOfChannels);
+		return false;
+	}
+
+	Converter.Reserve(Lease.GetNumOfFrames());
+
+	int64 NumOfReadFrames = 0;
+	const bool bConverted = Converter.PushFramesFrom([&Lease, &NumOfReadFrames](float* OutPCMData, int64 MaxNumOfFrames) -> int64
+	{
+		const int64 NumOfFrames = Lease.ReadFrames(NumOfReadFrames, MaxNumOfFrames, OutPCMData);
+		if (NumOfFrames <= 0)
 		{
-			Audio::FAlignedFloatBuffer WaveDataTemp;
-			if (!FRAW_RuntimeCodec::MixChannelsRAWData(WaveData, OverrideOptions.SampleRate, ImportedSoundWavePtr->GetNumOfChannels(), OverrideOptions.NumOfChannels, WaveDataTemp))
-			{
-				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to mix audio channels to the overriden number of channels. Mixing failed"));
-				ExecuteResult(false, TArray64<uint8>());
-				return;
-			}
-			WaveData = MoveTemp(WaveDataTemp);
+			return 0;
 		}
+		NumOfReadFrames += NumOfFrames;
+		return NumOfFrames;
+	}) && Converter.Finish();
 
-		RAWDataFrom = TArray64<uint8>(reinterpret_cast<uint8*>(WaveData.GetData()), WaveData.Num() * sizeof(float));
-	}
-	else
+	if (!bConverted)
 	{
-		RAWDataFrom = TArray64<uint8>(reinterpret_cast<uint8*>(ImportedSoundWavePtr->GetPCMBuffer().PCMData.GetView().GetData()), ImportedSoundWavePtr->GetPCMBuffer().PCMData.GetView().Num() * sizeof(float));
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to convert audio data to the overriden sample rate and number of channels"));
+		return false;
 	}
 
-	URuntimeAudioTranscoder::TranscodeRAWDataFromBuffer(MoveTemp(RAWDataFrom), ERuntimeRAWAudioFormat::Float32, RAWFormat, FOnRAWDataTranscodeFromBufferResultNative::CreateWeakLambda(ImportedSoundWavePtr.Get(), [ExecuteResult](bool bSucceeded, const TArray64<uint8>& RAWData)
+	Converter.ReleaseDecodedAudio(DecodedAudioInfo);
+	return true;
+}
+
+void URuntimeAudioExporter::DeletePartiallyExportedFile(const FString& SavePath)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (PlatformFile.FileExists(*SavePath) && !PlatformFile.DeleteFile(*SavePath))
 	{
-		ExecuteResult(bSucceeded, RAWData);
-	}));
-}
\ No newline at end of file
+		UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Unable to delete the partially exported file '%s'"), *SavePath);
+	}
+}
@@ -1,6 +1,11 @@
 ﻿// Georgy Treshchev 2024.
 
 #include "RuntimeAudioImporterDefines.h"
+#include "RuntimeAudioImporterTypes.h"
+#include "Async/MappedFileHandle.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
 
 #if PLATFORM_ANDROID && WITH_RUNTIMEAUDIOIMPORTER_FILEOPERATION_SUPPORT
 #include "Async/Future.h"
@@ -161,6 +166,118 @@ namespace RuntimeAudioImporter
 
 		return true;
 	}
+
+	/**
+	 * Memory-mapped audio file, keeping the mapped region alive for the buffers referencing it
+	 */
+	struct FRuntimeMappedAudioFile
+	{
+		~FRuntimeMappedAudioFile()
+		{
+			// The region must be unmapped before the file handle is closed
+			MappedFileRegion.Reset();
+			MappedFileHandle.Reset();
+		}
+
+		TUniquePtr<IMappedFileHandle> MappedFileHandle;
+		TUniquePtr<IMappedFileRegion> MappedFileRegion;
+	};
+
+	bool MapAudioFile(FRuntimeBulkDataBuffer<uint8>& AudioData, const FString& FilePath)
+	{
+		CheckAndRequestPermissions();
+
+		TSharedPtr<FRuntimeMappedAudioFile, ESPMode::ThreadSafe> MappedFile = MakeShared<FRuntimeMappedAudioFile, ESPMode::ThreadSafe>();
+
+#if UE_VERSION_OLDER_THAN(5, 3, 0)
+		MappedFile->MappedFileHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+#else
+		FOpenMappedResult OpenMappedResult = FPlatformFileManager::Get().GetPlatformFile().OpenMappedEx(*FilePath);
+		if (!OpenMappedResult.HasError())
+		{
+			MappedFile->MappedFileHandle = OpenMappedResult.StealValue();
+		}
+#endif
+
+		if (MappedFile->MappedFileHandle.IsValid() && MappedFile->MappedFileHandle->GetFileSize() > 0)
+		{
+			MappedFile->MappedFileRegion.Reset(MappedFile->MappedFileHandle->MapRegion());
+		}
+
+		if (!MappedFile->MappedFileRegion.IsValid())
+		{
+			UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Unable to map audio file '%s' into memory, loading it instead"), *FilePath);
+
+			TArray64<uint8> LoadedAudioData;
+			if (!LoadAudioFileToArray(LoadedAudioData, FilePath))
+			{
+				return false;
+			}
+
+			AudioData = FRuntimeBulkDataBuffer<uint8>(LoadedAudioData);
+			return true;
+		}
+
+		const int64 MappedSize = MappedFile->MappedFileRegion->GetMappedSize();
+#if UE_VERSION_OLDER_THAN(4, 27, 0)
+		if (MappedSize > TNumericLimits<int32>::Max())
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to map audio file '%s' into memory as its size '%lld' exceeds the maximum supported size"), *FilePath, MappedSize);
+			return false;
+		}
+#endif
+
+		// The mapped region is read-only. The buffer never writes to externally owned data, and copies it if it has to be modified
+		uint8* MappedData = const_cast<uint8*>(MappedFile->MappedFileRegion->GetMappedPtr());
+		AudioData = FRuntimeBulkDataBuffer<uint8>(MappedData, MappedSize, MappedFile);
+
+		UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully mapped audio file '%s' into memory (%lld bytes)"), *FilePath, MappedSize);
+		return true;
+	}
+
+	int32 DeleteLeastRecentlyUsedFiles(const TArray<FString>& FilePaths, int64 MaxSize, int64& OutRemainingSize)
+	{
+		struct FUsedFile
+		{
+			FString FilePath;
+			int64 Size;
+			FDateTime LastUsed;
+		};
+
+		TArray<FUsedFile> UsedFiles;
+		OutRemainingSize = 0;
+		for (const FString& FilePath : FilePaths)
+		{
+			const FFileStatData StatData = IFileManager::Get().GetStatData(*FilePath);
+			if (StatData.bIsValid)
+			{
+				UsedFiles.Add(FUsedFile{FilePath, StatData.FileSize, StatData.ModificationTime});
+				OutRemainingSize += StatData.FileSize;
+			}
+		}
+
+		UsedFiles.Sort([](const FUsedFile& A, const FUsedFile& B)
+		{
+			return A.LastUsed < B.LastUsed;
+		});
+
+		int32 NumOfDeletedFiles = 0;
+		for (const FUsedFile& UsedFile : UsedFiles)
+		{
+			if (OutRemainingSize <= MaxSize)
+			{
+				break;
+			}
+
+			if (IFileManager::Get().Delete(*UsedFile.FilePath))
+			{
+				OutRemainingSize -= UsedFile.Size;
+				++NumOfDeletedFiles;
+			}
+		}
+
+		return NumOfDeletedFiles;
+	}
 }
 
 #if PLATFORM_ANDROID && USE_ANDROID_JNI
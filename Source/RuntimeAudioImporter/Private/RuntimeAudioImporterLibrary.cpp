@@ -9,8 +9,11 @@
 #include "PreImportedSoundAsset.h"
 #include "RuntimeAudioTranscoder.h"
 #include "RuntimeAudioUtilities.h"
+#include "Sound/DecodedAudioCache.h"
+#include "Sound/DecodedAudioDiskCache.h"
 
 #include "Codecs/RAW_RuntimeCodec.h"
+#include "Codecs/RuntimePCMFormatConverter.h"
 
 #include "Misc/FileHelper.h"
 #include "HAL/PlatformFileManager.h"
@@ -24,6 +27,83 @@
 
 #include "Interfaces/IAudioFormat.h"
 
+namespace
+{
+	/**
+	 * Whether the decoded audio data should be looked up in and stored to the decoded audio cache (in memory or on disk)
+	 */
+	bool IsDecodedAudioCacheEnabled()
+	{
+		return FRuntimeDecodedAudioCache::Get().IsEnabled() || FRuntimeDecodedAudioDiskCache::IsEnabled();
+	}
+
+	/**
+	 * Determine the audio format to decode the file with, based on its extension
+	 */
+	ERuntimeAudioFormat GetAudioFormatForFile(const FString& FilePath, ERuntimeAudioFormat AudioFormat)
+	{
+		TArray<ERuntimeAudioFormat> PossibleFormats = URuntimeAudioUtilities::GetAudioFormats(FilePath);
+
+		AudioFormat = AudioFormat == ERuntimeAudioFormat::Auto ? (PossibleFormats.Num() == 0 ? ERuntimeAudioFormat::Invalid : PossibleFormats[0]) : AudioFormat;
+		AudioFormat = AudioFormat == ERuntimeAudioFormat::Invalid ? ERuntimeAudioFormat::Auto : AudioFormat;
+
+		// If there are multiple possible formats, we need to use the auto format to identify the correct format based on the file content
+		return PossibleFormats.Num() > 1 ? ERuntimeAudioFormat::Auto : AudioFormat;
+	}
+
+	/**
+	 * Transcode RAW data to newly allocated 32-bit float data
+	 */
+	void TranscodeRAWDataToFloat32(const uint8* ByteDataPtr, int64 ByteDataSize, ERuntimeRAWAudioFormat RAWFormat, float*& Float32DataPtr, int64& NumOfSamples)
+	{
+		switch (RAWFormat)
+		{
+		case ERuntimeRAWAudioFormat::Int8:
+			{
+				NumOfSamples = ByteDataSize / sizeof(int8);
+				FRAW_RuntimeCodec::TranscodeRAWData<int8, float>(reinterpret_cast<const int8*>(ByteDataPtr), NumOfSamples, Float32DataPtr);
+				break;
+			}
+		case ERuntimeRAWAudioFormat::UInt8:
+			{
+				NumOfSamples = ByteDataSize / sizeof(uint8);
+				FRAW_RuntimeCodec::TranscodeRAWData<uint8, float>(ByteDataPtr, NumOfSamples, Float32DataPtr);
+				break;
+			}
+		case ERuntimeRAWAudioFormat::Int16:
+			{
+				NumOfSamples = ByteDataSize / sizeof(int16);
+				FRAW_RuntimeCodec::TranscodeRAWData<int16, float>(reinterpret_cast<const int16*>(ByteDataPtr), NumOfSamples, Float32DataPtr);
+				break;
+			}
+		case ERuntimeRAWAudioFormat::UInt16:
+			{
+				NumOfSamples = ByteDataSize / sizeof(uint16);
+				FRAW_RuntimeCodec::TranscodeRAWData<uint16, float>(reinterpret_cast<const uint16*>(ByteDataPtr), NumOfSamples, Float32DataPtr);
+				break;
+			}
+		case ERuntimeRAWAudioFormat::UInt32:
+			{
+				NumOfSamples = ByteDataSize / sizeof(uint32);
+				FRAW_RuntimeCodec::TranscodeRAWData<uint32, float>(reinterpret_cast<const uint32*>(ByteDataPtr), NumOfSamples, Float32DataPtr);
+				break;
+			}
+		case ERuntimeRAWAudioFormat::Int32:
+			{
+				NumOfSamples = ByteDataSize / sizeof(int32);
+				FRAW_RuntimeCodec::TranscodeRAWData<int32, float>(reinterpret_cast<const int32*>(ByteDataPtr), NumOfSamples, Float32DataPtr);
+				break;
+			}
+		case ERuntimeRAWAudioFormat::Float32:
+			{
+				NumOfSamples = ByteDataSize / sizeof(float);
+				Float32DataPtr = static_cast<float*>(FMemory::Memcpy(FMemory::Malloc(NumOfSamples * sizeof(float)), ByteDataPtr, NumOfSamples * sizeof(float)));
+				break;
+			}
+		}
+	}
+}
+
 URuntimeAudioImporterLibrary* URuntimeAudioImporterLibrary::CreateRuntimeAudioImporter()
 {
 	return NewObject<URuntimeAudioImporterLibrary>();
@@ -54,13 +134,13 @@ void URuntimeAudioImporterLibrary::ImportAudioFromFile(const FString& FilePath,
 		return;
 	}
 
-	TArray<ERuntimeAudioFormat> PossibleFormats = URuntimeAudioUtilities::GetAudioFormats(FilePath);
+	AudioFormat = GetAudioFormatForFile(FilePath, AudioFormat);
 
-	AudioFormat = AudioFormat == ERuntimeAudioFormat::Auto ? (PossibleFormats.Num() == 0 ? ERuntimeAudioFormat::Invalid : PossibleFormats[0]) : AudioFormat;
-	AudioFormat = AudioFormat == ERuntimeAudioFormat::Invalid ? ERuntimeAudioFormat::Auto : AudioFormat;
-
-	// If there are multiple possible formats, we need to use the auto format to identify the correct format based on the file content
-	AudioFormat = PossibleFormats.Num() > 1 ? ERuntimeAudioFormat::Auto : AudioFormat;
+	const FString CacheKey = IsDecodedAudioCacheEnabled() ? AppendDesiredOutputFormat_Internal(FRuntimeDecodedAudioCache::MakeFileKey(FilePath, AudioFormat)) : FString();
+	if (ImportAudioFromDecodedAudioCache_Internal(CacheKey))
+	{
+		return;
+	}
 
 	TArray64<uint8> AudioBuffer;
 	if (!RuntimeAudioImporter::LoadAudioFileToArray(AudioBuffer, *FilePath))
@@ -69,13 +149,60 @@ void URuntimeAudioImporterLibrary::ImportAudioFromFile(const FString& FilePath,
 		return;
 	}
 
-	ImportAudioFromBuffer(MoveTemp(AudioBuffer), AudioFormat);
+	ImportAudioFromEncodedInfo_Internal(FEncodedAudioStruct(AudioBuffer, AudioFormat), CacheKey);
 #else
 	UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to import audio from file '%s' because the file operation support is disabled"), *FilePath);
 	OnResult_Internal(nullptr, ERuntimeImportStatus::AudioDoesNotExist);
 #endif
 }
 
+void URuntimeAudioImporterLibrary::ImportAudioFromMappedFile(const FString& FilePath, ERuntimeAudioFormat AudioFormat)
+{
+#if WITH_RUNTIMEAUDIOIMPORTER_FILEOPERATION_SUPPORT
+	if (IsInGameThread())
+	{
+		AsyncTask(ENamedThreads::AnyBackgroundHiPriTask, [WeakThis = MakeWeakObjectPtr(this), FilePath, AudioFormat]()
+		{
+			if (WeakThis.IsValid())
+			{
+				WeakThis->ImportAudioFromMappedFile(FilePath, AudioFormat);
+			}
+			else
+			{
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to import audio from mapped file '%s' because the RuntimeAudioImporterLibrary object has been destroyed"), *FilePath);
+			}
+		});
+		return;
+	}
+
+	if (!FPaths::FileExists(FilePath))
+	{
+		OnResult_Internal(nullptr, ERuntimeImportStatus::AudioDoesNotExist);
+		return;
+	}
+
+	AudioFormat = GetAudioFormatForFile(FilePath, AudioFormat);
+
+	const FString CacheKey = IsDecodedAudioCacheEnabled() ? AppendDesiredOutputFormat_Internal(FRuntimeDecodedAudioCache::MakeFileKey(FilePath, AudioFormat)) : FString();
+	if (ImportAudioFromDecodedAudioCache_Internal(CacheKey))
+	{
+		return;
+	}
+
+	FRuntimeBulkDataBuffer<uint8> AudioBuffer;
+	if (!RuntimeAudioImporter::MapAudioFile(AudioBuffer, FilePath))
+	{
+		OnResult_Internal(nullptr, ERuntimeImportStatus::LoadFileToArrayError);
+		return;
+	}
+
+	ImportAudioFromEncodedInfo_Internal(FEncodedAudioStruct(MoveTemp(AudioBuffer), AudioFormat), CacheKey);
+#else
+	UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to import audio from mapped file '%s' because the file operation support is disabled"), *FilePath);
+	OnResult_Internal(nullptr, ERuntimeImportStatus::AudioDoesNotExist);
+#endif
+}
+
 void URuntimeAudioImporterLibrary::ImportAudioFromPreImportedSound(UPreImportedSoundAsset* PreImportedSoundAsset)
 {
 	ImportAudioFromBuffer(PreImportedSoundAsset->AudioDataArray, PreImportedSoundAsset->AudioFormat);
@@ -105,29 +232,34 @@ void URuntimeAudioImporterLibrary::ImportAudioFromBuffer(TArray64<uint8> AudioDa
 		return;
 	}
 
-	OnProgress_Internal(15);
+	ImportAudioFromBuffer(FRuntimeBulkDataBuffer<uint8>(AudioData), AudioFormat);
+}
 
-	if (AudioFormat == ERuntimeAudioFormat::Invalid)
+void URuntimeAudioImporterLibrary::ImportAudioFromBuffer(FRuntimeBulkDataBuffer<uint8>&& AudioData, ERuntimeAudioFormat AudioFormat)
+{
+	if (IsInGameThread())
 	{
-		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Undefined audio data format for import"));
-		OnResult_Internal(nullptr, ERuntimeImportStatus::InvalidAudioFormat);
+		AsyncTask(ENamedThreads::AnyBackgroundHiPriTask, [WeakThis = MakeWeakObjectPtr(this), AudioData = MoveTemp(AudioData), AudioFormat]() mutable
+		{
+			if (WeakThis.IsValid())
+			{
+				WeakThis->ImportAudioFromBuffer(MoveTemp(AudioData), AudioFormat);
+			}
+			else
+			{
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to import audio from buffer because the RuntimeAudioImporterLibrary object has been destroyed"));
+			}
+		});
 		return;
 	}
 
-	FEncodedAudioStruct EncodedAudioInfo(AudioData, AudioFormat);
-
-	OnProgress_Internal(25);
-
-	FDecodedAudioStruct DecodedAudioInfo;
-	if (!DecodeAudioData(MoveTemp(EncodedAudioInfo), DecodedAudioInfo))
+	const FString CacheKey = IsDecodedAudioCacheEnabled() && AudioFormat != ERuntimeAudioFormat::Invalid ? AppendDesiredOutputFormat_Internal(FRuntimeDecodedAudioCache::MakeContentKey(AudioData, AudioFormat)) : FString();
+	if (ImportAudioFromDecodedAudioCache_Internal(CacheKey))
 	{
-		OnResult_Internal(nullptr, ERuntimeImportStatus::FailedToReadAudioDataArray);
 		return;
 	}
 
-	OnProgress_Internal(65);
-
-	ImportAudioFromDecodedInfo(MoveTemp(DecodedAudioInfo));
+	ImportAudioFromEncodedInfo_Internal(FEncodedAudioStruct(MoveTemp(AudioData), AudioFormat), CacheKey);
 }
 
 void URuntimeAudioImporterLibrary::ImportAudioFromRAWFile(const FString& FilePath, ERuntimeRAWAudioFormat RAWFormat, int32 SampleRate, int32 NumOfChannels)
@@ -172,6 +304,48 @@ void URuntimeAudioImporterLibrary::ImportAudioFromRAWFile(const FString& FilePat
 #endif
 }
 
+void URuntimeAudioImporterLibrary::ImportAudioFromMappedRAWFile(const FString& FilePath, ERuntimeRAWAudioFormat RAWFormat, int32 SampleRate, int32 NumOfChannels)
+{
+#if WITH_RUNTIMEAUDIOIMPORTER_FILEOPERATION_SUPPORT
+	if (IsInGameThread())
+	{
+		AsyncTask(ENamedThreads::AnyBackgroundHiPriTask, [WeakThis = MakeWeakObjectPtr(this), FilePath, RAWFormat, SampleRate, NumOfChannels]()
+		{
+			if (WeakThis.IsValid())
+			{
+				WeakThis->ImportAudioFromMappedRAWFile(FilePath, RAWFormat, SampleRate, NumOfChannels);
+			}
+			else
+			{
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to import RAW audio from mapped file '%s' because the RuntimeAudioImporterLibrary object has been destroyed"), *FilePath);
+			}
+		});
+		return;
+	}
+
+	if (!FPaths::FileExists(FilePath))
+	{
+		OnResult_Internal(nullptr, ERuntimeImportStatus::AudioDoesNotExist);
+		return;
+	}
+
+	OnProgress_Internal(5);
+
+	FRuntimeBulkDataBuffer<uint8> AudioBuffer;
+	if (!RuntimeAudioImporter::MapAudioFile(AudioBuffer, FilePath))
+	{
+		OnResult_Internal(nullptr, ERuntimeImportStatus::LoadFileToArrayError);
+		return;
+	}
+
+	OnProgress_Internal(35);
+	ImportAudioFromRAWBuffer(MoveTemp(AudioBuffer), RAWFormat, SampleRate, NumOfChannels);
+#else
+	UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to import audio from mapped file '%s' because the file operation support is disabled"), *FilePath);
+	OnResult_Internal(nullptr, ERuntimeImportStatus::AudioDoesNotExist);
+#endif
+}
+
 void URuntimeAudioImporterLibrary::ImportAudioFromRAWBuffer(TArray<uint8> RAWBuffer, ERuntimeRAWAudioFormat RAWFormat, int32 SampleRate, int32 NumOfChannels)
 {
 	ImportAudioFromRAWBuffer(TArray64<uint8>(MoveTemp(RAWBuffer)), RAWFormat, SampleRate, NumOfChannels);
@@ -179,63 +353,55 @@ void URuntimeAudioImporterLibrary::ImportAudioFromRAWBuffer(TArray<uint8> RAWBuf
 
 void URuntimeAudioImporterLibrary::ImportAudioFromRAWBuffer(TArray64<uint8> RAWBuffer, ERuntimeRAWAudioFormat RAWFormat, int32 SampleRate, int32 NumOfChannels)
 {
-	uint8* ByteDataPtr = RAWBuffer.GetData();
-	const int64 ByteDataSize = RAWBuffer.Num();
-
 	float* Float32DataPtr = nullptr;
 	int64 NumOfSamples = 0;
 
 	OnProgress_Internal(15);
 
 	// Transcoding RAW data to 32-bit float data
+	TranscodeRAWDataToFloat32(RAWBuffer.GetData(), RAWBuffer.Num(), RAWFormat, Float32DataPtr, NumOfSamples);
+
+	OnProgress_Internal(35);
+	if (!Float32DataPtr || NumOfSamples <= 0)
 	{
-		switch (RAWFormat)
+		OnResult_Internal(nullptr, ERuntimeImportStatus::FailedToReadAudioDataArray);
+		return;
+	}
+
+	ImportAudioFromFloat32Buffer(FRuntimeBulkDataBuffer<float>(Float32DataPtr, NumOfSamples), SampleRate, NumOfChannels);
+}
+
+void URuntimeAudioImporterLibrary::ImportAudioFromRAWBuffer(FRuntimeBulkDataBuffer<uint8>&& RAWBuffer, ERuntimeRAWAudioFormat RAWFormat, int32 SampleRate, int32 NumOfChannels)
+{
+	OnProgress_Internal(15);
+
+	uint8* ByteDataPtr = RAWBuffer.GetView().GetData();
+	const int64 ByteDataSize = RAWBuffer.GetView().Num();
+
+	// Memory-mapped 32-bit float data is already in the format used for playback, so it is referenced directly instead of being copied
+	if (RAWFormat == ERuntimeRAWAudioFormat::Float32 && RAWBuffer.IsExternallyOwned() && IsAligned(ByteDataPtr, alignof(float)))
+	{
+		const int64 NumOfSamples = ByteDataSize / sizeof(float);
+		if (NumOfSamples <= 0)
 		{
-		case ERuntimeRAWAudioFormat::Int8:
-			{
-				NumOfSamples = ByteDataSize / sizeof(int8);
-				FRAW_RuntimeCodec::TranscodeRAWData<int8, float>(reinterpret_cast<int8*>(ByteDataPtr), NumOfSamples, Float32DataPtr);
-				break;
-			}
-		case ERuntimeRAWAudioFormat::UInt8:
-			{
-				NumOfSamples = ByteDataSize / sizeof(uint8);
-				FRAW_RuntimeCodec::TranscodeRAWData<uint8, float>(ByteDataPtr, NumOfSamples, Float32DataPtr);
-				break;
-			}
-		case ERuntimeRAWAudioFormat::Int16:
-			{
-				NumOfSamples = ByteDataSize / sizeof(int16);
-				FRAW_RuntimeCodec::TranscodeRAWData<int16, float>(reinterpret_cast<int16*>(ByteDataPtr), NumOfSamples, Float32DataPtr);
-				break;
-			}
-		case ERuntimeRAWAudioFormat::UInt16:
-			{
-				NumOfSamples = ByteDataSize / sizeof(uint16);
-				FRAW_RuntimeCodec::TranscodeRAWData<uint16, float>(reinterpret_cast<uint16*>(ByteDataPtr), NumOfSamples, Float32DataPtr);
-				break;
-			}
-		case ERuntimeRAWAudioFormat::UInt32:
-			{
-				NumOfSamples = ByteDataSize / sizeof(uint32);
-				FRAW_RuntimeCodec::TranscodeRAWData<uint32, float>(reinterpret_cast<uint32*>(ByteDataPtr), NumOfSamples, Float32DataPtr);
-				break;
-			}
-		case ERuntimeRAWAudioFormat::Int32:
-			{
-				NumOfSamples = ByteDataSize / sizeof(int32);
-				FRAW_RuntimeCodec::TranscodeRAWData<int32, float>(reinterpret_cast<int32*>(ByteDataPtr), NumOfSamples, Float32DataPtr);
-				break;
-			}
-		case ERuntimeRAWAudioFormat::Float32:
-			{
-				NumOfSamples = ByteDataSize / sizeof(float);
-				Float32DataPtr = static_cast<float*>(FMemory::Memcpy(FMemory::Malloc(ByteDataSize), ByteDataPtr, ByteDataSize));
-				break;
-			}
+			OnResult_Internal(nullptr, ERuntimeImportStatus::FailedToReadAudioDataArray);
+			return;
 		}
+
+		OnProgress_Internal(35);
+		ImportAudioFromFloat32Buffer(FRuntimeBulkDataBuffer<float>(reinterpret_cast<float*>(ByteDataPtr), NumOfSamples, RAWBuffer.GetExternalOwner()), SampleRate, NumOfChannels);
+		return;
 	}
 
+	float* Float32DataPtr = nullptr;
+	int64 NumOfSamples = 0;
+
+	// Transcoding RAW data to 32-bit float data
+	TranscodeRAWDataToFloat32(ByteDataPtr, ByteDataSize, RAWFormat, Float32DataPtr, NumOfSamples);
+
+	// The RAW data is no longer needed, so release it (or unmap it) before importing
+	RAWBuffer.Empty();
+
 	OnProgress_Internal(35);
 	if (!Float32DataPtr || NumOfSamples <= 0)
 	{
@@ -497,37 +663,90 @@ bool URuntimeAudioImporterLibrary::ResampleAndMixChannelsInDecodedInfo(FDecodedA
 		return true;
 	}
 	
-	Audio::FAlignedFloatBuffer WaveData(DecodedAudioInfo.PCMInfo.PCMData.GetView().GetData(), DecodedAudioInfo.PCMInfo.PCMData.GetView().Num());
+	// Converting block by block so that only the converted audio data and a single block are held in addition to the source audio data
+	if (!FRuntimePCMFormatConverter::ConvertDecodedAudio(DecodedAudioInfo, NewSampleRate, NewNumOfChannels))
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to resample and mix audio data to the sample rate '%d' and number of channels '%d'"), NewSampleRate, NewNumOfChannels);
+		return false;
+	}
 
-	// Resampling if needed
-	if (NewSampleRate != DecodedAudioInfo.SoundWaveBasicInfo.SampleRate)
+	return true;
+}
+
+void URuntimeAudioImporterLibrary::SetDesiredOutputFormat(int32 SampleRate, int32 NumOfChannels)
+{
+	DesiredSampleRate = static_cast<uint32>(FMath::Max(SampleRate, 0));
+	DesiredNumOfChannels = static_cast<uint32>(FMath::Max(NumOfChannels, 0));
+}
+
+void URuntimeAudioImporterLibrary::SetSilenceTrimming(bool bEnable, float ThresholdDb, float PaddingSeconds)
+{
+	bTrimSilence = bEnable;
+	SilenceThresholdDb = FMath::Min(ThresholdDb, 0.f);
+	SilencePaddingSeconds = FMath::Max(PaddingSeconds, 0.f);
+}
+
+bool URuntimeAudioImporterLibrary::TrimSilenceInDecodedInfo(FDecodedAudioStruct& DecodedAudioInfo, float ThresholdDb, float PaddingSeconds)
+{
+	FPCMStruct& PCMInfo = DecodedAudioInfo.PCMInfo;
+	const uint32 NumOfChannels = DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels;
+	const uint32 SampleRate = DecodedAudioInfo.SoundWaveBasicInfo.SampleRate;
+
+	if (NumOfChannels <= 0 || SampleRate <= 0)
 	{
-		Audio::FAlignedFloatBuffer ResamplerOutputData;
-		if (!FRAW_RuntimeCodec::ResampleRAWData(WaveData, DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels, DecodedAudioInfo.SoundWaveBasicInfo.SampleRate, NewSampleRate, ResamplerOutputData))
-		{
-			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to resample audio data to the sound wave's sample rate. Resampling failed"));
-			return false;
-		}
-		WaveData = MoveTemp(ResamplerOutputData);
-		DecodedAudioInfo.SoundWaveBasicInfo.SampleRate = NewSampleRate;
-		UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Audio data has been resampled to the desired sample rate '%d'"), NewSampleRate);
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to trim silence because the audio format is invalid (sample rate: %d, number of channels: %d)"), SampleRate, NumOfChannels);
+		return false;
 	}
 
-	// Mixing the channels if needed
-	if (NewNumOfChannels != DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels)
+	if (!PCMInfo.IsValid())
 	{
-		Audio::FAlignedFloatBuffer WaveDataTemp;
-		if (!FRAW_RuntimeCodec::MixChannelsRAWData(WaveData, NewSampleRate, DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels, NewNumOfChannels, WaveDataTemp))
-		{
-			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to mix audio data to the sound wave's number of channels. Mixing failed"));
-			return false;
-		}
-		WaveData = MoveTemp(WaveDataTemp);
-		DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels = NewNumOfChannels;
-		UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Audio data has been mixed to the desired number of channels '%d'"), NewNumOfChannels);
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to trim silence because the PCM data is invalid"));
+		return false;
 	}
 
-	DecodedAudioInfo.PCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(WaveData);
+	const bool bInt16 = PCMInfo.GetStorageFormat() == ERuntimePCMStorageFormat::Int16;
+	const int64 NumOfFrames = FMath::Min<int64>(PCMInfo.PCMNumOfFrames, PCMInfo.GetNumOfSamples() / NumOfChannels);
+	const float Threshold = FMath::Pow(10.f, ThresholdDb / 20.f);
+
+	const int64 FirstLoudFrame = bInt16
+		? FRAW_RuntimeCodec::FindFirstLoudFrame(PCMInfo.PCMDataInt16.GetView().GetData(), NumOfFrames, NumOfChannels, Threshold)
+		: FRAW_RuntimeCodec::FindFirstLoudFrame(PCMInfo.PCMData.GetView().GetData(), NumOfFrames, NumOfChannels, Threshold);
+	if (FirstLoudFrame == INDEX_NONE)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Not trimming silence because the whole audio data is below the threshold of %f dB"), ThresholdDb);
+		return true;
+	}
+
+	const int64 LastLoudFrame = bInt16
+		? FRAW_RuntimeCodec::FindLastLoudFrame(PCMInfo.PCMDataInt16.GetView().GetData(), NumOfFrames, NumOfChannels, Threshold)
+		: FRAW_RuntimeCodec::FindLastLoudFrame(PCMInfo.PCMData.GetView().GetData(), NumOfFrames, NumOfChannels, Threshold);
+
+	const int64 NumOfPaddingFrames = static_cast<int64>(PaddingSeconds * SampleRate);
+	const int64 StartFrame = FMath::Max<int64>(FirstLoudFrame - NumOfPaddingFrames, 0);
+	const int64 EndFrame = FMath::Min<int64>(LastLoudFrame + 1 + NumOfPaddingFrames, NumOfFrames);
+	if (StartFrame == 0 && EndFrame == NumOfFrames)
+	{
+		return true;
+	}
+
+	const int64 NumOfTrimmedFrames = EndFrame - StartFrame;
+	const bool bTrimmed = bInt16
+		? PCMInfo.PCMDataInt16.Trim(StartFrame * NumOfChannels, NumOfTrimmedFrames * NumOfChannels)
+		: PCMInfo.PCMData.Trim(StartFrame * NumOfChannels, NumOfTrimmedFrames * NumOfChannels);
+	if (!bTrimmed)
+	{
+		return false;
+	}
+
+	PCMInfo.PCMNumOfFrames = static_cast<uint32>(NumOfTrimmedFrames);
+
+	FSoundWaveBasicStruct& SoundWaveBasicInfo = DecodedAudioInfo.SoundWaveBasicInfo;
+	SoundWaveBasicInfo.TrimmedLeadingDuration += static_cast<float>(StartFrame) / SampleRate;
+	SoundWaveBasicInfo.TrimmedTrailingDuration += static_cast<float>(NumOfFrames - EndFrame) / SampleRate;
+	SoundWaveBasicInfo.Duration = static_cast<float>(NumOfTrimmedFrames) / SampleRate;
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Trimmed %f sec of leading and %f sec of trailing silence (threshold: %f dB, padding: %f sec)"),
+	       static_cast<float>(StartFrame) / SampleRate, static_cast<float>(NumOfFrames - EndFrame) / SampleRate, ThresholdDb, PaddingSeconds);
 	return true;
 }
 
@@ -543,12 +762,19 @@ void URuntimeAudioImporterLibrary::ImportAudioFromFloat32Buffer(FRuntimeBulkData
 		DecodedAudioInfo.SoundWaveBasicInfo.Duration = static_cast<float>(DecodedAudioInfo.PCMInfo.PCMNumOfFrames) / SampleRate;
 	}
 
+	if (!FRuntimePCMFormatConverter::ConvertDecodedAudio(DecodedAudioInfo, DesiredSampleRate, DesiredNumOfChannels))
+	{
+		OnResult_Internal(nullptr, ERuntimeImportStatus::FailedToReadAudioDataArray);
+		return;
+	}
+
 	OnProgress_Internal(65);
 
+	TrimSilence_Internal(DecodedAudioInfo);
 	ImportAudioFromDecodedInfo(MoveTemp(DecodedAudioInfo));
 }
 
-bool URuntimeAudioImporterLibrary::DecodeAudioData(FEncodedAudioStruct&& EncodedAudioInfo, FDecodedAudioStruct& DecodedAudioInfo)
+bool URuntimeAudioImporterLibrary::DecodeAudioData(FEncodedAudioStruct&& EncodedAudioInfo, FDecodedAudioStruct& DecodedAudioInfo, uint32 TargetSampleRate, uint32 TargetNumOfChannels)
 {
 	FRuntimeCodecFactory CodecFactory;
 	TArray<FBaseRuntimeCodec*> RuntimeCodecs = [&EncodedAudioInfo, &CodecFactory]()
@@ -563,7 +789,10 @@ bool URuntimeAudioImporterLibrary::DecodeAudioData(FEncodedAudioStruct&& Encoded
 	for (FBaseRuntimeCodec* RuntimeCodec : RuntimeCodecs)
 	{
 		EncodedAudioInfo.AudioFormat = RuntimeCodec->GetAudioFormat();
-		if (!RuntimeCodec->Decode(MoveTemp(EncodedAudioInfo), DecodedAudioInfo))
+		const bool bDecoded = TargetSampleRate > 0 || TargetNumOfChannels > 0
+			? RuntimeCodec->DecodeToFormat(MoveTemp(EncodedAudioInfo), DecodedAudioInfo, TargetSampleRate, TargetNumOfChannels)
+			: RuntimeCodec->Decode(MoveTemp(EncodedAudioInfo), DecodedAudioInfo);
+		if (!bDecoded)
 		{
 			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Something went wrong while decoding '%s' audio data"), *UEnum::GetValueAsString(EncodedAudioInfo.AudioFormat));
 			continue;
@@ -598,6 +827,129 @@ bool URuntimeAudioImporterLibrary::EncodeAudioData(FDecodedAudioStruct&& Decoded
 	return false;
 }
 
+void URuntimeAudioImporterLibrary::SetDecodedAudioCacheMemoryBudget(int64 MemoryBudget)
+{
+	FRuntimeDecodedAudioCache::Get().SetMemoryBudget(MemoryBudget);
+}
+
+void URuntimeAudioImporterLibrary::EmptyDecodedAudioCache()
+{
+	FRuntimeDecodedAudioCache::Get().Empty();
+}
+
+void URuntimeAudioImporterLibrary::SetDecodedAudioDiskCacheEnabled(bool bEnabled, bool bStoreAsInt16)
+{
+	FRuntimeDecodedAudioDiskCache::SetEnabled(bEnabled, bStoreAsInt16);
+}
+
+int64 URuntimeAudioImporterLibrary::GetDecodedAudioDiskCacheSize()
+{
+	return FRuntimeDecodedAudioDiskCache::GetInfo().TotalSize;
+}
+
+int32 URuntimeAudioImporterLibrary::TrimDecodedAudioDiskCache(int64 MaxSize)
+{
+	return FRuntimeDecodedAudioDiskCache::Trim(MaxSize);
+}
+
+int32 URuntimeAudioImporterLibrary::ValidateDecodedAudioDiskCache(bool bDeleteInvalid)
+{
+	return FRuntimeDecodedAudioDiskCache::Validate(bDeleteInvalid);
+}
+
+bool URuntimeAudioImporterLibrary::ImportAudioFromDecodedAudioCache_Internal(const FString& CacheKey)
+{
+	if (CacheKey.IsEmpty())
+	{
+		return false;
+	}
+
+	FRuntimeDecodedAudioCache& DecodedAudioCache = FRuntimeDecodedAudioCache::Get();
+
+	FRuntimeDecodedAudioPtr CachedDecodedAudioInfo = DecodedAudioCache.IsEnabled() ? DecodedAudioCache.Find(CacheKey) : nullptr;
+	if (!CachedDecodedAudioInfo.IsValid())
+	{
+		FDecodedAudioStruct DiskCachedDecodedAudioInfo;
+		if (!FRuntimeDecodedAudioDiskCache::Load(CacheKey, DiskCachedDecodedAudioInfo))
+		{
+			return false;
+		}
+
+		if (!DecodedAudioCache.IsEnabled())
+		{
+			OnProgress_Internal(65);
+			TrimSilence_Internal(DiskCachedDecodedAudioInfo);
+			ImportAudioFromDecodedInfo(MoveTemp(DiskCachedDecodedAudioInfo));
+			return true;
+		}
+
+		CachedDecodedAudioInfo = DecodedAudioCache.Add(CacheKey, MoveTemp(DiskCachedDecodedAudioInfo));
+	}
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Importing audio from the decoded audio cache without decoding (key: '%s')"), *CacheKey);
+
+	OnProgress_Internal(65);
+
+	FDecodedAudioStruct DecodedAudioInfo = FRuntimeDecodedAudioCache::MakeDecodedAudioView(CachedDecodedAudioInfo);
+	TrimSilence_Internal(DecodedAudioInfo);
+	ImportAudioFromDecodedInfo(MoveTemp(DecodedAudioInfo));
+	return true;
+}
+
+void URuntimeAudioImporterLibrary::ImportAudioFromEncodedInfo_Internal(FEncodedAudioStruct&& EncodedAudioInfo, const FString& CacheKey)
+{
+	OnProgress_Internal(15);
+
+	if (EncodedAudioInfo.AudioFormat == ERuntimeAudioFormat::Invalid)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Undefined audio data format for import"));
+		OnResult_Internal(nullptr, ERuntimeImportStatus::InvalidAudioFormat);
+		return;
+	}
+
+	OnProgress_Internal(25);
+
+	FDecodedAudioStruct DecodedAudioInfo;
+	if (!DecodeAudioData(MoveTemp(EncodedAudioInfo), DecodedAudioInfo, DesiredSampleRate, DesiredNumOfChannels))
+	{
+		OnResult_Internal(nullptr, ERuntimeImportStatus::FailedToReadAudioDataArray);
+		return;
+	}
+
+	OnProgress_Internal(65);
+
+	if (!CacheKey.IsEmpty())
+	{
+		FRuntimeDecodedAudioDiskCache::Save(CacheKey, DecodedAudioInfo);
+
+		// The decoded audio data is moved to the cache and referenced from there, so subsequent imports of the same audio skip decoding
+		if (FRuntimeDecodedAudioCache::Get().IsEnabled())
+		{
+			DecodedAudioInfo = FRuntimeDecodedAudioCache::MakeDecodedAudioView(FRuntimeDecodedAudioCache::Get().Add(CacheKey, MoveTemp(DecodedAudioInfo)));
+		}
+	}
+
+	TrimSilence_Internal(DecodedAudioInfo);
+	ImportAudioFromDecodedInfo(MoveTemp(DecodedAudioInfo));
+}
+
+FString URuntimeAudioImporterLibrary::AppendDesiredOutputFormat_Internal(const FString& CacheKey) const
+{
+	if (CacheKey.IsEmpty() || (DesiredSampleRate == 0 && DesiredNumOfChannels == 0))
+	{
+		return CacheKey;
+	}
+	return FString::Printf(TEXT("%s|%u|%u"), *CacheKey, DesiredSampleRate, DesiredNumOfChannels);
+}
+
+void URuntimeAudioImporterLibrary::TrimSilence_Internal(FDecodedAudioStruct& DecodedAudioInfo) const
+{
+	if (bTrimSilence)
+	{
+		TrimSilenceInDecodedInfo(DecodedAudioInfo, SilenceThresholdDb, SilencePaddingSeconds);
+	}
+}
+
 void URuntimeAudioImporterLibrary::OnProgress_Internal(int32 Percentage)
 {
 	// Making sure we are in the game thread
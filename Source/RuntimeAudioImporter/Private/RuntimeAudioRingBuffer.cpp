@@ -0,0 +1,66 @@
+// Georgy Treshchev 2024.
+
+#include "RuntimeAudioRingBuffer.h"
+
+FRuntimeAudioRingBuffer::FRuntimeAudioRingBuffer(int32 InCapacity)
+	: Samples(nullptr)
+  , Mask(FMath::RoundUpToPowerOfTwo(static_cast<uint32>(FMath::Max(InCapacity, 2))) - 1)
+  , WriteIndex(0)
+  , ReadIndex(0)
+{
+	Samples = static_cast<float*>(FMemory::Malloc((Mask + 1) * sizeof(float)));
+}
+
+FRuntimeAudioRingBuffer::~FRuntimeAudioRingBuffer()
+{
+	FMemory::Free(Samples);
+}
+
+int32 FRuntimeAudioRingBuffer::Push(const float* InSamples, int32 NumOfSamples)
+{
+	const uint32 Write = WriteIndex.load(std::memory_order_relaxed);
+	const uint32 Read = ReadIndex.load(std::memory_order_acquire);
+	const int32 NumOfSamplesToPush = FMath::Min(NumOfSamples, GetCapacity() - static_cast<int32>(Write - Read));
+	if (NumOfSamplesToPush <= 0)
+	{
+		return 0;
+	}
+
+	// Copying in up to two parts, the second one wrapping around to the start
+	const uint32 Start = Write & Mask;
+	const int32 NumOfFirstPartSamples = FMath::Min<int32>(NumOfSamplesToPush, GetCapacity() - Start);
+	FMemory::Memcpy(Samples + Start, InSamples, NumOfFirstPartSamples * sizeof(float));
+	FMemory::Memcpy(Samples, InSamples + NumOfFirstPartSamples, (NumOfSamplesToPush - NumOfFirstPartSamples) * sizeof(float));
+
+	WriteIndex.store(Write + NumOfSamplesToPush, std::memory_order_release);
+	return NumOfSamplesToPush;
+}
+
+int32 FRuntimeAudioRingBuffer::Pop(float* OutSamples, int32 MaxNumOfSamples)
+{
+	const uint32 Read = ReadIndex.load(std::memory_order_relaxed);
+	const uint32 Write = WriteIndex.load(std::memory_order_acquire);
+	const int32 NumOfSamplesToPop = FMath::Min(MaxNumOfSamples, static_cast<int32>(Write - Read));
+	if (NumOfSamplesToPop <= 0)
+	{
+		return 0;
+	}
+
+	const uint32 Start = Read & Mask;
+	const int32 NumOfFirstPartSamples = FMath::Min<int32>(NumOfSamplesToPop, GetCapacity() - Start);
+	FMemory::Memcpy(OutSamples, Samples + Start, NumOfFirstPartSamples * sizeof(float));
+	FMemory::Memcpy(OutSamples + NumOfFirstPartSamples, Samples, (NumOfSamplesToPop - NumOfFirstPartSamples) * sizeof(float));
+
+	ReadIndex.store(Read + NumOfSamplesToPop, std::memory_order_release);
+	return NumOfSamplesToPop;
+}
+
+int32 FRuntimeAudioRingBuffer::Num() const
+{
+	return static_cast<int32>(WriteIndex.load(std::memory_order_acquire) - ReadIndex.load(std::memory_order_acquire));
+}
+
+int32 FRuntimeAudioRingBuffer::GetRemainder() const
+{
+	return GetCapacity() - Num();
+}
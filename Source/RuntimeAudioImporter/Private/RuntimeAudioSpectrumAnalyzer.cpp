@@ -0,0 +1,430 @@
+// Georgy Treshchev 2024.
+
+#include "RuntimeAudioSpectrumAnalyzer.h"
+#include "RuntimeAudioImporterDefines.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+#include "DSP/FFTAlgorithm.h"
+#endif
+
+namespace
+{
+	/** The number of frames mixed down to mono at a time when tapping, so that tapping never allocates */
+	constexpr int64 NumOfFramesPerTapBlock = 256;
+
+	float SampleToFloat(float Sample)
+	{
+		return Sample;
+	}
+
+	float SampleToFloat(int16 Sample)
+	{
+		return static_cast<float>(Sample) / MAX_int16;
+	}
+
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+	/**
+	 * Get the factor the power of every bin computed by the engine's FFT is multiplied by to match the unscaled FFT
+	 */
+	float GetFFTPowerScale(Audio::EFFTScaling Scaling, int32 FFTSize)
+	{
+		switch (Scaling)
+		{
+		case Audio::EFFTScaling::MultipliedByFFTSize:
+			return 1.f / (static_cast<float>(FFTSize) * FFTSize);
+		case Audio::EFFTScaling::MultipliedBySqrtFFTSize:
+			return 1.f / FFTSize;
+		case Audio::EFFTScaling::DividedByFFTSize:
+			return static_cast<float>(FFTSize) * FFTSize;
+		case Audio::EFFTScaling::DividedBySqrtFFTSize:
+			return static_cast<float>(FFTSize);
+		default:
+			return 1.f;
+		}
+	}
+#endif
+}
+
+FRuntimeAudioSpectrumAnalyzer::FRuntimeAudioSpectrumAnalyzer(const FRuntimeAudioSpectrumSettings& InSettings)
+	: Settings(InSettings)
+  , NumOfBins(0)
+  , Ring(FMath::Max(static_cast<int32>(FMath::RoundUpToPowerOfTwo(FMath::Clamp(InSettings.FFTSize, 64, 16384))) * 4, 32768))
+  , LatestSlotIndex(INDEX_NONE)
+  , SampleRate(0)
+  , NumOfAnalyzedFrames(0)
+  , bStopping(false)
+  , NumOfDroppedFrames(0)
+  , FramesAvailableEvent(FPlatformProcess::GetSynchEventFromPool(false))
+{
+	Settings.FFTSize = static_cast<int32>(FMath::RoundUpToPowerOfTwo(FMath::Clamp(Settings.FFTSize, 64, 16384)));
+	Settings.HopSize = FMath::Clamp(Settings.HopSize, 1, Settings.FFTSize);
+	Settings.NumOfBands = FMath::Clamp(Settings.NumOfBands, 1, 128);
+	Settings.MinFrequency = FMath::Max(Settings.MinFrequency, 0.f);
+
+	const int32 FFTSize = Settings.FFTSize;
+	NumOfBins = FFTSize / 2 + 1;
+
+	Window.SetNumZeroed(FFTSize);
+	FFTInput.SetNumZeroed(FFTSize);
+	PowerSpectrum.SetNumZeroed(NumOfBins);
+
+	// Periodic Hann window
+	WindowCoefficients.SetNumUninitialized(FFTSize);
+	for (int32 FrameIndex = 0; FrameIndex < FFTSize; ++FrameIndex)
+	{
+		WindowCoefficients[FrameIndex] = 0.5f * (1.f - FMath::Cos(2.f * PI * FrameIndex / FFTSize));
+	}
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	FFTReal.SetNumZeroed(FFTSize);
+	FFTImag.SetNumZeroed(FFTSize);
+
+	const int32 NumOfBits = FMath::FloorLog2(static_cast<uint32>(FFTSize));
+	BitReversedIndices.SetNumUninitialized(FFTSize);
+	for (int32 Index = 0; Index < FFTSize; ++Index)
+	{
+		int32 ReversedIndex = 0;
+		for (int32 BitIndex = 0; BitIndex < NumOfBits; ++BitIndex)
+		{
+			ReversedIndex |= ((Index >> BitIndex) & 1) << (NumOfBits - 1 - BitIndex);
+		}
+		BitReversedIndices[Index] = ReversedIndex;
+	}
+
+	TwiddleCos.SetNumUninitialized(FFTSize - 1);
+	TwiddleSin.SetNumUninitialized(FFTSize - 1);
+	for (int32 HalfSize = 1; HalfSize < FFTSize; HalfSize *= 2)
+	{
+		for (int32 Index = 0; Index < HalfSize; ++Index)
+		{
+			const double Angle = PI * Index / HalfSize;
+			TwiddleCos[HalfSize - 1 + Index] = static_cast<float>(FMath::Cos(Angle));
+			TwiddleSin[HalfSize - 1 + Index] = static_cast<float>(FMath::Sin(Angle));
+		}
+	}
+#else
+	Audio::FFFTSettings FFTSettings;
+	FFTSettings.Log2Size = FMath::FloorLog2(static_cast<uint32>(FFTSize));
+	FFTSettings.bArrays128BitAligned = true;
+	FFTSettings.bEnableHardwareAcceleration = true;
+
+	FFTAlgorithm = Audio::FFFTFactory::NewFFTAlgorithm(FFTSettings);
+	FFTPowerScale = 1.f;
+	if (FFTAlgorithm.IsValid())
+	{
+		FFTOutput.SetNumZeroed(FFTAlgorithm->NumOutputFloats());
+		FFTPowerScale = GetFFTPowerScale(FFTAlgorithm->ForwardScaling(), FFTSize);
+	}
+	else
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to create the FFT of size %d for spectrum analysis, no spectrum will be published"), FFTSize);
+	}
+#endif
+
+	for (int32 SlotIndex = 0; SlotIndex < NumOfSlots; ++SlotIndex)
+	{
+		Slots[SlotIndex].Magnitudes.SetNumZeroed(NumOfBins);
+		Slots[SlotIndex].BandEnergies.SetNumZeroed(Settings.NumOfBands);
+		NumOfSlotReaders[SlotIndex].store(0);
+	}
+
+	Thread.Reset(FRunnableThread::Create(this, TEXT("RuntimeAudioSpectrumAnalyzer"), 0, TPri_BelowNormal));
+}
+
+FRuntimeAudioSpectrumAnalyzer::~FRuntimeAudioSpectrumAnalyzer()
+{
+	StopAndWait();
+	FPlatformProcess::ReturnSynchEventToPool(FramesAvailableEvent);
+}
+
+uint32 FRuntimeAudioSpectrumAnalyzer::Run()
+{
+	const int32 FFTSize = Settings.FFTSize;
+	const int32 HopSize = Settings.HopSize;
+
+	while (!bStopping.load(std::memory_order_relaxed))
+	{
+		if (Ring.Num() < HopSize)
+		{
+			// The timeout only bounds how long stopping can take in case the render thread stops tapping
+			FramesAvailableEvent->Wait(50);
+			continue;
+		}
+
+		// Sliding the window by a hop, the oldest frames first
+		FMemory::Memmove(Window.GetData(), Window.GetData() + HopSize, (FFTSize - HopSize) * sizeof(float));
+		Ring.Pop(Window.GetData() + FFTSize - HopSize, HopSize);
+		NumOfAnalyzedFrames += HopSize;
+
+		AnalyzeWindow();
+	}
+
+	return 0;
+}
+
+void FRuntimeAudioSpectrumAnalyzer::Stop()
+{
+	bStopping = true;
+	FramesAvailableEvent->Trigger();
+}
+
+void FRuntimeAudioSpectrumAnalyzer::StopAndWait()
+{
+	Stop();
+	if (Thread.IsValid())
+	{
+		Thread->WaitForCompletion();
+		Thread.Reset();
+	}
+}
+
+void FRuntimeAudioSpectrumAnalyzer::PushFrames(const float* PCMData, int64 NumOfFrames, uint32 NumOfChannels, uint32 InSampleRate)
+{
+	PushMonoFrames(PCMData, NumOfFrames, NumOfChannels, InSampleRate);
+}
+
+void FRuntimeAudioSpectrumAnalyzer::PushFrames(const int16* PCMData, int64 NumOfFrames, uint32 NumOfChannels, uint32 InSampleRate)
+{
+	PushMonoFrames(PCMData, NumOfFrames, NumOfChannels, InSampleRate);
+}
+
+template <typename SampleType>
+void FRuntimeAudioSpectrumAnalyzer::PushMonoFrames(const SampleType* PCMData, int64 NumOfFrames, uint32 NumOfChannels, uint32 InSampleRate)
+{
+	if (!PCMData || NumOfFrames <= 0 || NumOfChannels == 0 || bStopping.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+
+	SampleRate.store(InSampleRate, std::memory_order_relaxed);
+
+	const float ChannelGain = 1.f / NumOfChannels;
+	float MonoBlock[NumOfFramesPerTapBlock];
+	for (int64 FrameIndex = 0; FrameIndex < NumOfFrames; FrameIndex += NumOfFramesPerTapBlock)
+	{
+		const int32 NumOfBlockFrames = static_cast<int32>(FMath::Min(NumOfFrames - FrameIndex, NumOfFramesPerTapBlock));
+		const SampleType* BlockPCMData = PCMData + FrameIndex * NumOfChannels;
+		for (int32 BlockFrameIndex = 0; BlockFrameIndex < NumOfBlockFrames; ++BlockFrameIndex)
+		{
+			float Sum = 0;
+			for (uint32 ChannelIndex = 0; ChannelIndex < NumOfChannels; ++ChannelIndex)
+			{
+				Sum += SampleToFloat(BlockPCMData[BlockFrameIndex * NumOfChannels + ChannelIndex]);
+			}
+			MonoBlock[BlockFrameIndex] = Sum * ChannelGain;
+		}
+
+		const int32 NumOfPushedFrames = Ring.Push(MonoBlock, NumOfBlockFrames);
+		if (NumOfPushedFrames < NumOfBlockFrames)
+		{
+			NumOfDroppedFrames.fetch_add(NumOfBlockFrames - NumOfPushedFrames, std::memory_order_relaxed);
+		}
+	}
+
+	if (Ring.Num() >= Settings.HopSize)
+	{
+		FramesAvailableEvent->Trigger();
+	}
+}
+
+void FRuntimeAudioSpectrumAnalyzer::AnalyzeWindow()
+{
+	const uint32 CurrentSampleRate = SampleRate.load(std::memory_order_relaxed);
+	if (CurrentSampleRate == 0)
+	{
+		return;
+	}
+
+	// Picking a slot that is neither the latest one (which readers may be about to pin) nor pinned by a reader. If the readers hold both other slots, this spectrum is skipped
+	const int32 LatestIndex = LatestSlotIndex.load();
+	int32 WriteSlotIndex = INDEX_NONE;
+	for (int32 SlotIndex = 0; SlotIndex < NumOfSlots; ++SlotIndex)
+	{
+		if (SlotIndex != LatestIndex && NumOfSlotReaders[SlotIndex].load() == 0)
+		{
+			WriteSlotIndex = SlotIndex;
+			break;
+		}
+	}
+	if (WriteSlotIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const int32 FFTSize = Settings.FFTSize;
+	for (int32 FrameIndex = 0; FrameIndex < FFTSize; FrameIndex += 4)
+	{
+		VectorStore(VectorMultiply(VectorLoad(Window.GetData() + FrameIndex), VectorLoad(WindowCoefficients.GetData() + FrameIndex)), FFTInput.GetData() + FrameIndex);
+	}
+
+	if (!ComputePowerSpectrum())
+	{
+		return;
+	}
+
+	FRuntimeAudioSpectrum& Spectrum = Slots[WriteSlotIndex];
+
+	// Normalizing so that a full-scale sine wave has a magnitude of about one (the coherent gain of the Hann window is 0.5)
+	const float MagnitudeScale = 4.f / FFTSize;
+	for (int32 BinIndex = 0; BinIndex < NumOfBins; ++BinIndex)
+	{
+		Spectrum.Magnitudes[BinIndex] = FMath::Sqrt(PowerSpectrum[BinIndex]) * MagnitudeScale;
+	}
+
+	// Logarithmically spaced bands between the lowest frequency (at least the first bin above DC) and the highest one
+	const float NyquistFrequency = CurrentSampleRate * 0.5f;
+	const float BinWidth = static_cast<float>(CurrentSampleRate) / FFTSize;
+	const float MinFrequency = FMath::Clamp(Settings.MinFrequency, BinWidth, NyquistFrequency);
+	const float MaxFrequency = Settings.MaxFrequency > MinFrequency ? FMath::Min(Settings.MaxFrequency, NyquistFrequency) : NyquistFrequency;
+	const int32 NumOfBands = Settings.NumOfBands;
+	int32 BandStartBin = FMath::Clamp(FMath::CeilToInt(MinFrequency / BinWidth), 0, NumOfBins);
+	for (int32 BandIndex = 0; BandIndex < NumOfBands; ++BandIndex)
+	{
+		const float BandEndFrequency = MinFrequency * FMath::Pow(MaxFrequency / MinFrequency, static_cast<float>(BandIndex + 1) / NumOfBands);
+		const int32 BandEndBin = BandIndex == NumOfBands - 1
+			? FMath::Clamp(FMath::FloorToInt(MaxFrequency / BinWidth) + 1, BandStartBin, NumOfBins)
+			: FMath::Clamp(FMath::CeilToInt(BandEndFrequency / BinWidth), BandStartBin, NumOfBins);
+
+		float Energy = 0;
+		for (int32 BinIndex = BandStartBin; BinIndex < BandEndBin; ++BinIndex)
+		{
+			Energy += Spectrum.Magnitudes[BinIndex] * Spectrum.Magnitudes[BinIndex];
+		}
+		Spectrum.BandEnergies[BandIndex] = Energy;
+		BandStartBin = BandEndBin;
+	}
+
+	Spectrum.SampleRate = static_cast<int32>(CurrentSampleRate);
+	Spectrum.NumOfAnalyzedFrames = NumOfAnalyzedFrames;
+
+	LatestSlotIndex.store(WriteSlotIndex);
+}
+
+bool FRuntimeAudioSpectrumAnalyzer::ComputePowerSpectrum()
+{
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	const int32 FFTSize = Settings.FFTSize;
+	float* Real = FFTReal.GetData();
+	float* Imag = FFTImag.GetData();
+
+	// Scattering into the bit-reversed order the FFT expects
+	for (int32 FrameIndex = 0; FrameIndex < FFTSize; ++FrameIndex)
+	{
+		Real[BitReversedIndices[FrameIndex]] = FFTInput[FrameIndex];
+	}
+	FMemory::Memzero(Imag, FFTSize * sizeof(float));
+
+	for (int32 HalfSize = 1; HalfSize < FFTSize; HalfSize *= 2)
+	{
+		const float* Cos = TwiddleCos.GetData() + HalfSize - 1;
+		const float* Sin = TwiddleSin.GetData() + HalfSize - 1;
+
+		for (int32 GroupStart = 0; GroupStart < FFTSize; GroupStart += HalfSize * 2)
+		{
+			float* RealA = Real + GroupStart;
+			float* ImagA = Imag + GroupStart;
+			float* RealB = RealA + HalfSize;
+			float* ImagB = ImagA + HalfSize;
+
+			// Butterflies four at a time once the stage is wide enough, B * W = (RealB + i * ImagB) * (Cos - i * Sin)
+			int32 Index = 0;
+			if (HalfSize >= 4)
+			{
+				for (; Index < HalfSize; Index += 4)
+				{
+					const FRAIVectorRegister CosVector = VectorLoad(Cos + Index);
+					const FRAIVectorRegister SinVector = VectorLoad(Sin + Index);
+					const FRAIVectorRegister RealBVector = VectorLoad(RealB + Index);
+					const FRAIVectorRegister ImagBVector = VectorLoad(ImagB + Index);
+					const FRAIVectorRegister RealProduct = VectorMultiplyAdd(ImagBVector, SinVector, VectorMultiply(RealBVector, CosVector));
+					const FRAIVectorRegister ImagProduct = VectorSubtract(VectorMultiply(ImagBVector, CosVector), VectorMultiply(RealBVector, SinVector));
+					const FRAIVectorRegister RealAVector = VectorLoad(RealA + Index);
+					const FRAIVectorRegister ImagAVector = VectorLoad(ImagA + Index);
+					VectorStore(VectorSubtract(RealAVector, RealProduct), RealB + Index);
+					VectorStore(VectorSubtract(ImagAVector, ImagProduct), ImagB + Index);
+					VectorStore(VectorAdd(RealAVector, RealProduct), RealA + Index);
+					VectorStore(VectorAdd(ImagAVector, ImagProduct), ImagA + Index);
+				}
+			}
+			for (; Index < HalfSize; ++Index)
+			{
+				const float RealProduct = RealB[Index] * Cos[Index] + ImagB[Index] * Sin[Index];
+				const float ImagProduct = ImagB[Index] * Cos[Index] - RealB[Index] * Sin[Index];
+				RealB[Index] = RealA[Index] - RealProduct;
+				ImagB[Index] = ImagA[Index] - ImagProduct;
+				RealA[Index] += RealProduct;
+				ImagA[Index] += ImagProduct;
+			}
+		}
+	}
+
+	const int32 NumOfVectorizedBins = FFTSize / 2;
+	for (int32 BinIndex = 0; BinIndex < NumOfVectorizedBins; BinIndex += 4)
+	{
+		const FRAIVectorRegister RealVector = VectorLoad(Real + BinIndex);
+		const FRAIVectorRegister ImagVector = VectorLoad(Imag + BinIndex);
+		VectorStore(VectorMultiplyAdd(RealVector, RealVector, VectorMultiply(ImagVector, ImagVector)), PowerSpectrum.GetData() + BinIndex);
+	}
+	PowerSpectrum[NumOfVectorizedBins] = Real[NumOfVectorizedBins] * Real[NumOfVectorizedBins] + Imag[NumOfVectorizedBins] * Imag[NumOfVectorizedBins];
+	return true;
+#else
+	if (!FFTAlgorithm.IsValid())
+	{
+		return false;
+	}
+
+	FFTAlgorithm->ForwardRealToComplex(FFTInput.GetData(), FFTOutput.GetData());
+
+	const float* Complex = FFTOutput.GetData();
+	for (int32 BinIndex = 0; BinIndex < NumOfBins; ++BinIndex)
+	{
+		const float Real = Complex[BinIndex * 2];
+		const float Imag = Complex[BinIndex * 2 + 1];
+		PowerSpectrum[BinIndex] = (Real * Real + Imag * Imag) * FFTPowerScale;
+	}
+	return true;
+#endif
+}
+
+int32 FRuntimeAudioSpectrumAnalyzer::PinLatestSlot() const
+{
+	// The slot is pinned before checking it is still the latest one, so the worker either sees the pin or has not published over the slot yet
+	while (true)
+	{
+		const int32 SlotIndex = LatestSlotIndex.load();
+		if (SlotIndex == INDEX_NONE)
+		{
+			return INDEX_NONE;
+		}
+
+		NumOfSlotReaders[SlotIndex].fetch_add(1);
+		if (LatestSlotIndex.load() == SlotIndex)
+		{
+			return SlotIndex;
+		}
+		NumOfSlotReaders[SlotIndex].fetch_sub(1);
+	}
+}
+
+bool FRuntimeAudioSpectrumAnalyzer::ReadLatestSpectrum(TFunctionRef<void(const FRuntimeAudioSpectrum&)> Visitor) const
+{
+	const int32 SlotIndex = PinLatestSlot();
+	if (SlotIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	Visitor(Slots[SlotIndex]);
+	NumOfSlotReaders[SlotIndex].fetch_sub(1);
+	return true;
+}
+
+bool FRuntimeAudioSpectrumAnalyzer::GetLatestSpectrum(FRuntimeAudioSpectrum& OutSpectrum) const
+{
+	return ReadLatestSpectrum([&OutSpectrum](const FRuntimeAudioSpectrum& Spectrum)
+	{
+		OutSpectrum = Spectrum;
+	});
+}
@@ -0,0 +1,189 @@
+// Georgy Treshchev 2024.
+
+#include "RuntimeAudioWaveformPyramid.h"
+
+namespace
+{
+	/**
+	 * Find the lowest and highest sample values and the sum of the squared sample values, four samples at a time
+	 */
+	void ReduceSamples(const float* Samples, int64 NumOfSamples, float& OutMin, float& OutMax, double& OutSumOfSquares)
+	{
+		FRAIVectorRegister MinVector = VectorSetFloat1(TNumericLimits<float>::Max());
+		FRAIVectorRegister MaxVector = VectorSetFloat1(TNumericLimits<float>::Lowest());
+		FRAIVectorRegister SumOfSquaresVector = VectorZero();
+
+		const int64 NumOfVectorizedSamples = NumOfSamples & ~static_cast<int64>(3);
+		for (int64 SampleIndex = 0; SampleIndex < NumOfVectorizedSamples; SampleIndex += 4)
+		{
+			const FRAIVectorRegister SamplesVector = VectorLoad(Samples + SampleIndex);
+			MinVector = VectorMin(MinVector, SamplesVector);
+			MaxVector = VectorMax(MaxVector, SamplesVector);
+			SumOfSquaresVector = VectorMultiplyAdd(SamplesVector, SamplesVector, SumOfSquaresVector);
+		}
+
+		float Mins[4], Maxs[4], SumsOfSquares[4];
+		VectorStore(MinVector, Mins);
+		VectorStore(MaxVector, Maxs);
+		VectorStore(SumOfSquaresVector, SumsOfSquares);
+
+		float Min = FMath::Min(FMath::Min(Mins[0], Mins[1]), FMath::Min(Mins[2], Mins[3]));
+		float Max = FMath::Max(FMath::Max(Maxs[0], Maxs[1]), FMath::Max(Maxs[2], Maxs[3]));
+		double SumOfSquares = static_cast<double>(SumsOfSquares[0]) + SumsOfSquares[1] + SumsOfSquares[2] + SumsOfSquares[3];
+
+		for (int64 SampleIndex = NumOfVectorizedSamples; SampleIndex < NumOfSamples; ++SampleIndex)
+		{
+			Min = FMath::Min(Min, Samples[SampleIndex]);
+			Max = FMath::Max(Max, Samples[SampleIndex]);
+			SumOfSquares += static_cast<double>(Samples[SampleIndex]) * Samples[SampleIndex];
+		}
+
+		OutMin = FMath::Min(OutMin, Min);
+		OutMax = FMath::Max(OutMax, Max);
+		OutSumOfSquares += SumOfSquares;
+	}
+}
+
+void FRuntimeAudioWaveformPyramid::FAccumulator::Add(float InMin, float InMax, float InMeanSquare)
+{
+	Min = FMath::Min(Min, InMin);
+	Max = FMath::Max(Max, InMax);
+	SumOfMeanSquares += InMeanSquare;
+	++NumOfBins;
+}
+
+FRuntimeAudioWaveformPeak FRuntimeAudioWaveformPyramid::FAccumulator::ToPeak() const
+{
+	FRuntimeAudioWaveformPeak Peak;
+	if (NumOfBins > 0)
+	{
+		Peak.Min = Min;
+		Peak.Max = Max;
+		Peak.RMS = FMath::Sqrt(static_cast<float>(SumOfMeanSquares / NumOfBins));
+	}
+	return Peak;
+}
+
+FRuntimeAudioWaveformPyramid::FRuntimeAudioWaveformPyramid()
+{
+	Reset(1);
+}
+
+void FRuntimeAudioWaveformPyramid::Reset(uint32 InNumOfChannels)
+{
+	NumOfChannels = FMath::Max<uint32>(InNumOfChannels, 1);
+	NumOfFrames = 0;
+	Levels.Reset();
+	PendingMin = TNumericLimits<float>::Max();
+	PendingMax = TNumericLimits<float>::Lowest();
+	PendingSumOfSquares = 0;
+	NumOfPendingFrames = 0;
+}
+
+void FRuntimeAudioWaveformPyramid::AppendFrames(const float* PCMData, int64 InNumOfFrames)
+{
+	while (InNumOfFrames > 0)
+	{
+		const int64 NumOfFramesToReduce = FMath::Min(InNumOfFrames, NumOfFramesPerBin - NumOfPendingFrames);
+		ReduceSamples(PCMData, NumOfFramesToReduce * NumOfChannels, PendingMin, PendingMax, PendingSumOfSquares);
+
+		NumOfPendingFrames += NumOfFramesToReduce;
+		NumOfFrames += NumOfFramesToReduce;
+		PCMData += NumOfFramesToReduce * NumOfChannels;
+		InNumOfFrames -= NumOfFramesToReduce;
+
+		if (NumOfPendingFrames == NumOfFramesPerBin)
+		{
+			AppendBin({PendingMin, PendingMax, static_cast<float>(PendingSumOfSquares / (NumOfFramesPerBin * NumOfChannels))});
+			PendingMin = TNumericLimits<float>::Max();
+			PendingMax = TNumericLimits<float>::Lowest();
+			PendingSumOfSquares = 0;
+			NumOfPendingFrames = 0;
+		}
+	}
+}
+
+void FRuntimeAudioWaveformPyramid::AppendBin(const FBin& Bin)
+{
+	FBin MergedBin = Bin;
+	for (int32 Level = 0; ; ++Level)
+	{
+		if (!Levels.IsValidIndex(Level))
+		{
+			Levels.AddDefaulted();
+		}
+
+		TArray<FBin>& Bins = Levels[Level];
+		Bins.Add(MergedBin);
+
+		// Every complete pair makes a bin of the next level
+		if (Bins.Num() % 2 != 0)
+		{
+			break;
+		}
+
+		const FBin& First = Bins[Bins.Num() - 2];
+		const FBin& Second = Bins[Bins.Num() - 1];
+		MergedBin = {FMath::Min(First.Min, Second.Min), FMath::Max(First.Max, Second.Max), (First.MeanSquare + Second.MeanSquare) * 0.5f};
+	}
+}
+
+void FRuntimeAudioWaveformPyramid::GetPeaks(int64 StartFrame, int64 EndFrame, int32 NumOfPeaks, TArray<FRuntimeAudioWaveformPeak>& OutPeaks) const
+{
+	OutPeaks.Reset(FMath::Max(NumOfPeaks, 0));
+	StartFrame = FMath::Clamp<int64>(StartFrame, 0, NumOfFrames);
+	EndFrame = FMath::Clamp<int64>(EndFrame, StartFrame, NumOfFrames);
+	if (NumOfPeaks <= 0)
+	{
+		return;
+	}
+
+	// The coarsest level whose bins are not longer than a single peak
+	const double NumOfFramesPerPeak = static_cast<double>(EndFrame - StartFrame) / NumOfPeaks;
+	int32 Level = 0;
+	while (Level + 1 < Levels.Num() && (NumOfFramesPerBin << (Level + 1)) <= NumOfFramesPerPeak)
+	{
+		++Level;
+	}
+
+	for (int32 PeakIndex = 0; PeakIndex < NumOfPeaks; ++PeakIndex)
+	{
+		const int64 PeakStartFrame = StartFrame + static_cast<int64>(PeakIndex * NumOfFramesPerPeak);
+		const int64 PeakEndFrame = FMath::Max(StartFrame + static_cast<int64>((PeakIndex + 1) * NumOfFramesPerPeak), PeakStartFrame + 1);
+
+		FAccumulator Accumulator;
+		if (PeakStartFrame < EndFrame)
+		{
+			AccumulateRange(PeakStartFrame, FMath::Min(PeakEndFrame, EndFrame), Level, Accumulator);
+		}
+		OutPeaks.Add(Accumulator.ToPeak());
+	}
+}
+
+void FRuntimeAudioWaveformPyramid::AccumulateRange(int64 RangeStartFrame, int64 RangeEndFrame, int32 Level, FAccumulator& Accumulator) const
+{
+	const int64 NumOfFramesPerLevelBin = NumOfFramesPerBin << Level;
+	const int64 NumOfLevelBins = Levels.IsValidIndex(Level) ? Levels[Level].Num() : 0;
+
+	const int64 FirstBinIndex = RangeStartFrame / NumOfFramesPerLevelBin;
+	const int64 EndBinIndex = (RangeEndFrame + NumOfFramesPerLevelBin - 1) / NumOfFramesPerLevelBin;
+	for (int64 BinIndex = FirstBinIndex; BinIndex < FMath::Min(EndBinIndex, NumOfLevelBins); ++BinIndex)
+	{
+		const FBin& Bin = Levels[Level][BinIndex];
+		Accumulator.Add(Bin.Min, Bin.Max, Bin.MeanSquare);
+	}
+
+	// The end of the range is not covered by this level yet, so it is taken from the finer levels and finally from the frames not yet forming a bin
+	const int64 CoveredEndFrame = NumOfLevelBins * NumOfFramesPerLevelBin;
+	if (RangeEndFrame > CoveredEndFrame)
+	{
+		if (Level > 0)
+		{
+			AccumulateRange(FMath::Max(RangeStartFrame, CoveredEndFrame), RangeEndFrame, Level - 1, Accumulator);
+		}
+		else if (NumOfPendingFrames > 0)
+		{
+			Accumulator.Add(PendingMin, PendingMax, static_cast<float>(PendingSumOfSquares / (NumOfPendingFrames * NumOfChannels)));
+		}
+	}
+}
@@ -5,6 +5,7 @@
 #include "RuntimeAudioImporterDefines.h"
 #include "AudioThread.h"
 #include "Async/Async.h"
+#include "HAL/PlatformTime.h"
 #include "UObject/WeakObjectPtrTemplates.h"
 
 UCapturableSoundWave::UCapturableSoundWave(const FObjectInitializer& ObjectInitializer)
@@ -22,6 +23,16 @@ void UCapturableSoundWave::BeginDestroy()
 	Super::BeginDestroy();
 }
 
+int32 UCapturableSoundWave::OnGeneratePCMAudio(TArray<uint8>& OutAudio, int32 NumSamples)
+{
+	const int32 NumOfGeneratedSamples = Super::OnGeneratePCMAudio(OutAudio, NumSamples);
+	if (NumOfGeneratedSamples > 0 && bHasCaptureFrameOffset.load(std::memory_order_relaxed))
+	{
+		UpdateCaptureLatency(GetNumOfPlayedFrames());
+	}
+	return NumOfGeneratedSamples;
+}
+
 UCapturableSoundWave* UCapturableSoundWave::CreateCapturableSoundWave()
 {
 	if (!IsInGameThread())
@@ -80,19 +91,67 @@ void UCapturableSoundWave::GetAvailableAudioInputDevices(const FOnGetAvailableAu
 #endif
 }
 
+bool UCapturableSoundWave::SetCaptureBufferSize(int32 NumOfFrames)
+{
+	if (NumOfFrames <= 0)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to set the capture buffer size for sound wave %s as the number of frames (%d) is invalid"), *GetName(), NumOfFrames);
+		return false;
+	}
+
+	NumOfFramesPerCaptureCallback = NumOfFrames;
+	return true;
+}
+
+void UCapturableSoundWave::SetLowLatencyCapture(bool bEnable)
+{
+	bLowLatencyCapture = bEnable;
+}
+
+bool UCapturableSoundWave::GetCaptureLatencyStatistics(float& LatencySeconds, float& JitterSeconds, float& MaxLatencySeconds, int64& NumOfDroppedFrames) const
+{
+	NumOfDroppedFrames = NumOfDroppedCaptureFrames.load(std::memory_order_relaxed);
+
+	FRAIScopeLock Lock(&CaptureLatencyGuard);
+	LatencySeconds = static_cast<float>(CaptureLatency);
+	JitterSeconds = static_cast<float>(CaptureJitter);
+	MaxLatencySeconds = static_cast<float>(MaxCaptureLatency);
+	return NumOfCaptureLatencyMeasurements > 0;
+}
+
 bool UCapturableSoundWave::StartCapture_Implementation(int32 DeviceId)
 {
 #if WITH_RUNTIMEAUDIOIMPORTER_CAPTURE_SUPPORT
+	if (AudioCapture.IsStreamOpen())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to start capture as the stream is already open"));
+		return false;
+	}
+
 	Audio::FAudioCaptureDeviceParams Params = Audio::FAudioCaptureDeviceParams();
 	Params.DeviceIndex = DeviceId;
 	LastDeviceIndex = DeviceId;
 
+	// Resetting the latency measurement of the previous capture
+	NumOfCapturedFrames = 0;
+	NumOfDrainedCaptureFrames = 0;
+	NumOfDroppedCaptureFrames = 0;
+	bHasCaptureFrameOffset = false;
+	{
+		FRAIScopeLock Lock(&CaptureLatencyGuard);
+		CaptureLatency = LastCaptureLatency = CaptureJitter = MaxCaptureLatency = 0;
+		NumOfCaptureLatencyMeasurements = 0;
+	}
+
+	// Room for 8 capture callbacks of up to 8 channels, which is plenty as long as the audio task pipe keeps up
+	CaptureRing = bLowLatencyCapture ? MakeShared<FRuntimeAudioRingBuffer, ESPMode::ThreadSafe>(NumOfFramesPerCaptureCallback * 8 * 8) : nullptr;
+
 #if UE_VERSION_NEWER_THAN(5, 2, 9)
 	Audio::FOnAudioCaptureFunction
 #else
 	Audio::FOnCaptureFunction
 #endif
-	OnCapture = [WeakThis = MakeWeakObjectPtr(this)](const void* PCMData, int32 NumFrames, int32 NumOfChannels,
+	OnCapture = [WeakThis = MakeWeakObjectPtr(this), Ring = CaptureRing](const void* PCMData, int32 NumFrames, int32 NumOfChannels,
 #if UE_VERSION_NEWER_THAN(4, 25, 0)
 	                   int32 InSampleRate,
 #endif
@@ -106,6 +165,52 @@ bool UCapturableSoundWave::StartCapture_Implementation(int32 DeviceId)
 
 		if (WeakThis->AudioCapture.IsCapturing())
 		{
+			const uint32 CallbackSampleRate =
+#if UE_VERSION_NEWER_THAN(4, 25, 0)
+				InSampleRate;
+#else
+				WeakThis->AudioCapture.GetSampleRate();
+#endif
+
+			// Low-latency capture: the float frames are copied straight into the ring, which is drained by a single queued task at a time. Queuing that task is the only allocation left on the capture thread
+			if (Ring.IsValid())
+			{
+				const int32 NumOfSamples = NumOfChannels * NumFrames;
+				if (NumOfSamples <= 0 || CallbackSampleRate == 0)
+				{
+					return;
+				}
+
+				// The whole buffer is dropped if it does not fit, so that the ring never holds partial frames
+				if (Ring->GetRemainder() < NumOfSamples)
+				{
+					WeakThis->NumOfDroppedCaptureFrames += NumFrames;
+				}
+				else
+				{
+					Ring->Push(static_cast<const float*>(PCMData), NumOfSamples);
+
+					// The last pushed frame has just been captured, which dates the first one
+					const int64 NumOfPushedFrames = (WeakThis->NumOfCapturedFrames += NumFrames);
+					WeakThis->CaptureStartTime = FPlatformTime::Seconds() - static_cast<double>(NumOfPushedFrames) / CallbackSampleRate;
+					WeakThis->CaptureSampleRate = CallbackSampleRate;
+					WeakThis->CaptureNumOfChannels = static_cast<uint32>(NumOfChannels);
+				}
+
+				if (!WeakThis->bCaptureDrainQueued.exchange(true))
+				{
+					WeakThis->LaunchAudioTask([WeakThis, Ring, CallbackSampleRate, NumOfChannels]()
+					{
+						if (WeakThis.IsValid())
+						{
+							WeakThis->bCaptureDrainQueued = false;
+							WeakThis->DrainCaptureRing(*Ring, CallbackSampleRate, static_cast<uint32>(NumOfChannels));
+						}
+					});
+				}
+				return;
+			}
+
 			const int64 PCMDataSize = NumOfChannels * NumFrames;
 			int64 PCMDataSizeInBytes = PCMDataSize * sizeof(float);
 
@@ -115,29 +220,25 @@ bool UCapturableSoundWave::StartCapture_Implementation(int32 DeviceId)
 				PCMDataSizeInBytes = TNumericLimits<int32>::Max();
 			}
 
-			WeakThis->AppendAudioDataFromRAW(TArray<uint8>(reinterpret_cast<const uint8*>(PCMData), static_cast<int32>(PCMDataSizeInBytes)), ERuntimeRAWAudioFormat::Float32,
-#if UE_VERSION_NEWER_THAN(4, 25, 0)
-				InSampleRate
-#else
-				WeakThis->AudioCapture.GetSampleRate()
-#endif
-			  , NumOfChannels);
+			// Always queued, so that the capture thread is not blocked and the buffers captured while a previous one is still queued are appended as a single block
+			FStreamingSoundWaveAppendRequest Request;
+			{
+				Request.AudioData = TArray<uint8>(reinterpret_cast<const uint8*>(PCMData), static_cast<int32>(PCMDataSizeInBytes));
+				Request.RAWFormat = ERuntimeRAWAudioFormat::Float32;
+				Request.SampleRate = CallbackSampleRate;
+				Request.NumOfChannels = NumOfChannels;
+			}
+			WeakThis->QueueAppendRequest(MoveTemp(Request));
 		}
 	};
 
-	if (AudioCapture.IsStreamOpen())
-	{
-		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to start capture as the stream is already open"));
-		return false;
-	}
-
 	if (!AudioCapture.
 #if UE_VERSION_NEWER_THAN(5, 2, 9)
 		OpenAudioCaptureStream
 #else
 		OpenCaptureStream
 #endif
-		(Params, MoveTemp(OnCapture), 1024))
+		(Params, MoveTemp(OnCapture), NumOfFramesPerCaptureCallback))
 	{
 		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to open capturing stream for sound wave %s"), *GetName());
 		return false;
@@ -149,7 +250,7 @@ bool UCapturableSoundWave::StartCapture_Implementation(int32 DeviceId)
 		return false;
 	}
 
-	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully started capturing for sound wave %s"), *GetName());
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully started %scapturing for sound wave %s (%d frames per callback)"), CaptureRing.IsValid() ? TEXT("low-latency ") : TEXT(""), *GetName(), NumOfFramesPerCaptureCallback);
 	return true;
 #else
 	UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to start capturing as its support is disabled (please enable in RuntimeAudioImporter.Build.cs)"));
@@ -164,6 +265,20 @@ void UCapturableSoundWave::StopCapture_Implementation()
 	{
 		AudioCapture.CloseStream();
 	}
+
+	// Appending whatever is left in the capture ring, after the drains already queued
+	if (TSharedPtr<FRuntimeAudioRingBuffer, ESPMode::ThreadSafe> Ring = MoveTemp(CaptureRing))
+	{
+		const uint32 RingSampleRate = CaptureSampleRate;
+		const uint32 RingNumOfChannels = CaptureNumOfChannels;
+		LaunchAudioTask([WeakThis = MakeWeakObjectPtr(this), Ring, RingSampleRate, RingNumOfChannels]()
+		{
+			if (WeakThis.IsValid())
+			{
+				WeakThis->DrainCaptureRing(*Ring, RingSampleRate, RingNumOfChannels);
+			}
+		});
+	}
 #else
 	UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to stop capturing as its support is disabled (please enable in RuntimeAudioImporter.Build.cs)"));
 #endif
@@ -234,3 +349,55 @@ bool UCapturableSoundWave::IsCapturing_Implementation() const
 	return false;
 #endif
 }
+
+void UCapturableSoundWave::DrainCaptureRing(FRuntimeAudioRingBuffer& Ring, uint32 InSampleRate, uint32 NumOfChannels)
+{
+	// The drained frames are placed right after the ones populated so far. Published before populating, so that the frames are never rendered with a stale offset
+	{
+		FRAIScopeLock Lock(&*DataGuard);
+		CaptureFrameOffset = (PCMBufferInfo.IsValid() ? static_cast<int64>(PCMBufferInfo->PCMNumOfFrames) : 0) - NumOfDrainedCaptureFrames.load(std::memory_order_relaxed);
+	}
+	bHasCaptureFrameOffset = true;
+
+	NumOfDrainedCaptureFrames += PopulateAudioDataFromRing(Ring, InSampleRate, NumOfChannels);
+}
+
+void UCapturableSoundWave::UpdateCaptureLatency(int64 NumOfPlayedFrames)
+{
+	// The frames are not comparable if they have been resampled or are played backwards
+	const uint32 RingSampleRate = CaptureSampleRate.load(std::memory_order_relaxed);
+	if (RingSampleRate == 0 || static_cast<uint32>(GetSampleRate()) != RingSampleRate || bReversePlayback)
+	{
+		return;
+	}
+
+	// The last rendered frame, counted among the captured ones
+	const int64 CapturedFrameIndex = NumOfPlayedFrames - 1 - CaptureFrameOffset.load(std::memory_order_relaxed);
+	if (CapturedFrameIndex < 0 || CapturedFrameIndex >= NumOfCapturedFrames.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+
+	const double CapturedTime = CaptureStartTime.load(std::memory_order_relaxed) + static_cast<double>(CapturedFrameIndex + 1) / RingSampleRate;
+	const double Latency = FPlatformTime::Seconds() - CapturedTime;
+	if (Latency < 0)
+	{
+		return;
+	}
+
+	FRAIScopeLock Lock(&CaptureLatencyGuard);
+	if (NumOfCaptureLatencyMeasurements == 0)
+	{
+		CaptureLatency = Latency;
+		CaptureJitter = 0;
+	}
+	else
+	{
+		// Smoothed the same way as the interarrival jitter of RTP (RFC 3550)
+		CaptureJitter += (FMath::Abs(Latency - LastCaptureLatency) - CaptureJitter) / 16;
+		CaptureLatency += (Latency - CaptureLatency) / 16;
+	}
+	LastCaptureLatency = Latency;
+	MaxCaptureLatency = FMath::Max(MaxCaptureLatency, Latency);
+	++NumOfCaptureLatencyMeasurements;
+}
@@ -0,0 +1,220 @@
+// Georgy Treshchev 2024.
+
+#include "Sound/CompressedAudioCache.h"
+
+#include "RuntimeAudioImporterDefines.h"
+#include "Codecs/VORBIS_RuntimeCodec.h"
+#include "HAL/FileManager.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+
+std::atomic<bool> FRuntimeCompressedAudioCache::bDiskCacheEnabled{false};
+std::atomic<int64> FRuntimeCompressedAudioCache::DiskCacheMaxSize{DefaultDiskCacheMaxSize};
+std::atomic<uint64> FRuntimeCompressedAudioCache::NextRevision{1};
+
+FRuntimeCompressedAudioCache::FRuntimeCompressedAudioCache()
+	: Revision(NextRevision++)
+  , CompressedDataRevision(0)
+{
+}
+
+void FRuntimeCompressedAudioCache::Invalidate()
+{
+	FRAIScopeLock Lock(&DataGuard);
+	Revision = NextRevision++;
+	CompressedData.Reset();
+	CompressedDataRevision = 0;
+}
+
+uint64 FRuntimeCompressedAudioCache::GetRevision() const
+{
+	FRAIScopeLock Lock(&DataGuard);
+	return Revision;
+}
+
+FRuntimeCompressedAudioDataPtr FRuntimeCompressedAudioCache::GetCompressedData(uint64 InRevision) const
+{
+	FRAIScopeLock Lock(&DataGuard);
+	return CompressedDataRevision == InRevision ? CompressedData : nullptr;
+}
+
+FRuntimeCompressedAudioDataPtr FRuntimeCompressedAudioCache::GetOrEncodeCompressedData(uint64 InRevision, FDecodedAudioStruct&& DecodedAudioInfo)
+{
+	// Only one encode at a time. Callers waiting here will most likely find the data already produced by the previous caller
+	FRAIScopeLock EncodeLock(&EncodeGuard);
+
+	if (FRuntimeCompressedAudioDataPtr ExistingCompressedData = GetCompressedData(InRevision))
+	{
+		UE_LOG(LogRuntimeAudioImporter, Verbose, TEXT("Reusing cached compressed audio data (revision: %llu)"), InRevision);
+		return ExistingCompressedData;
+	}
+
+	FRuntimeCompressedAudioDataPtr NewCompressedData;
+
+#if WITH_RUNTIMEAUDIOIMPORTER_FILEOPERATION_SUPPORT
+	const bool bUseDiskCache = IsDiskCacheEnabled();
+	const FString DiskCacheFilePath = bUseDiskCache ? FPaths::Combine(GetDiskCacheDirectory(), ComputeContentHash(DecodedAudioInfo) + TEXT(".ogg")) : FString();
+
+	if (bUseDiskCache && FPaths::FileExists(DiskCacheFilePath))
+	{
+		TArray64<uint8> DiskCompressedData;
+		if (RuntimeAudioImporter::LoadAudioFileToArray(DiskCompressedData, DiskCacheFilePath) && DiskCompressedData.Num() > 0)
+		{
+			UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Loaded compressed audio data from the disk cache '%s'"), *DiskCacheFilePath);
+
+			// The modification time is used to find the least recently used files when trimming
+			IFileManager::Get().SetTimeStamp(*DiskCacheFilePath, FDateTime::UtcNow());
+			NewCompressedData = MakeShared<const TArray64<uint8>, ESPMode::ThreadSafe>(MoveTemp(DiskCompressedData));
+		}
+		else
+		{
+			UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Unable to load compressed audio data from the disk cache '%s'. The audio data will be encoded again"), *DiskCacheFilePath);
+		}
+	}
+#endif
+
+	if (!NewCompressedData.IsValid())
+	{
+		FVORBIS_RuntimeCodec VorbisCodec;
+		FEncodedAudioStruct EncodedAudioInfo;
+		if (!VorbisCodec.Encode(MoveTemp(DecodedAudioInfo), EncodedAudioInfo, CompressionQuality))
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Something went wrong while encoding Vorbis audio data for the compressed audio cache"));
+			return nullptr;
+		}
+
+		if (EncodedAudioInfo.AudioData.GetView().Num() <= 0)
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to cache compressed audio data because the encoded Vorbis audio data is empty"));
+			return nullptr;
+		}
+
+		NewCompressedData = MakeShared<const TArray64<uint8>, ESPMode::ThreadSafe>(EncodedAudioInfo.AudioData.GetView().GetData(), EncodedAudioInfo.AudioData.GetView().Num());
+
+#if WITH_RUNTIMEAUDIOIMPORTER_FILEOPERATION_SUPPORT
+		if (bUseDiskCache)
+		{
+			// Writing to a uniquely named temporary file first so that an interrupted or concurrent write never leaves a partially written file under the final name
+			const FString TempFilePath = FString::Printf(TEXT("%s.%s.tmp"), *DiskCacheFilePath, *FGuid::NewGuid().ToString());
+			if (RuntimeAudioImporter::SaveAudioFileFromArray(*NewCompressedData, TempFilePath) && IFileManager::Get().Move(*DiskCacheFilePath, *TempFilePath, true, true))
+			{
+				UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Saved compressed audio data to the disk cache '%s'"), *DiskCacheFilePath);
+
+				// Keeping the disk cache within its budget, evicting the least recently used files first
+				const int64 MaxSize = GetDiskCacheMaxSize();
+				if (MaxSize > 0)
+				{
+					TrimDiskCache(MaxSize);
+				}
+			}
+			else
+			{
+				UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Unable to save compressed audio data to the disk cache '%s'"), *DiskCacheFilePath);
+				IFileManager::Get().Delete(*TempFilePath);
+			}
+		}
+#endif
+	}
+
+	{
+		FRAIScopeLock Lock(&DataGuard);
+
+		// The PCM data might have changed while encoding, in which case the result is only valid for this caller
+		if (Revision == InRevision)
+		{
+			CompressedData = NewCompressedData;
+			CompressedDataRevision = InRevision;
+		}
+		else
+		{
+			UE_LOG(LogRuntimeAudioImporter, Log, TEXT("The PCM data changed while encoding compressed audio data (encoded revision: %llu, current revision: %llu). The result will not be cached"), InRevision, Revision);
+		}
+	}
+
+	return NewCompressedData;
+}
+
+void FRuntimeCompressedAudioCache::SetDiskCacheEnabled(bool bEnabled)
+{
+#if WITH_RUNTIMEAUDIOIMPORTER_FILEOPERATION_SUPPORT
+	bDiskCacheEnabled = bEnabled;
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("The compressed audio disk cache has been %s (directory: '%s')"), bEnabled ? TEXT("enabled") : TEXT("disabled"), *GetDiskCacheDirectory());
+#else
+	UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to toggle the compressed audio disk cache because file operation support is disabled in RuntimeAudioImporter.Build.cs"));
+#endif
+}
+
+bool FRuntimeCompressedAudioCache::IsDiskCacheEnabled()
+{
+	return bDiskCacheEnabled;
+}
+
+FString FRuntimeCompressedAudioCache::GetDiskCacheDirectory()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("RuntimeAudioImporter"), TEXT("CompressedAudioCache"));
+}
+
+void FRuntimeCompressedAudioCache::SetDiskCacheMaxSize(int64 MaxSize)
+{
+	DiskCacheMaxSize = FMath::Max<int64>(MaxSize, 0);
+}
+
+int64 FRuntimeCompressedAudioCache::GetDiskCacheMaxSize()
+{
+	return DiskCacheMaxSize;
+}
+
+int32 FRuntimeCompressedAudioCache::TrimDiskCache(int64 MaxSize)
+{
+	const FString DiskCacheDirectory = GetDiskCacheDirectory();
+
+	// Only the complete files, the temporary ones being written have another extension
+	TArray<FString> FileNames;
+	IFileManager::Get().FindFiles(FileNames, *DiskCacheDirectory, TEXT(".ogg"));
+
+	TArray<FString> FilePaths;
+	FilePaths.Reserve(FileNames.Num());
+	for (const FString& FileName : FileNames)
+	{
+		FilePaths.Add(FPaths::Combine(DiskCacheDirectory, FileName));
+	}
+
+	int64 TotalSize;
+	const int32 NumOfDeletedFiles = RuntimeAudioImporter::DeleteLeastRecentlyUsedFiles(FilePaths, MaxSize, TotalSize);
+	if (NumOfDeletedFiles > 0)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Trimmed the compressed audio disk cache to '%lld' bytes (deleted files: %d, remaining size: %lld bytes)"), MaxSize, NumOfDeletedFiles, TotalSize);
+	}
+	return NumOfDeletedFiles;
+}
+
+FString FRuntimeCompressedAudioCache::ComputeContentHash(const FDecodedAudioStruct& DecodedAudioInfo)
+{
+	FSHA1 HashState;
+
+	// The sample rate, the number of channels and the quality affect the encoded data, so they are part of the key
+	const uint32 SampleRate = DecodedAudioInfo.SoundWaveBasicInfo.SampleRate;
+	const uint32 NumOfChannels = DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels;
+	const uint8 Quality = CompressionQuality;
+	HashState.Update(reinterpret_cast<const uint8*>(&SampleRate), sizeof(SampleRate));
+	HashState.Update(reinterpret_cast<const uint8*>(&NumOfChannels), sizeof(NumOfChannels));
+	HashState.Update(&Quality, sizeof(Quality));
+
+	// Hashing in chunks since the size parameter is 32-bit on older engine versions
+	const uint8* PCMDataPtr = reinterpret_cast<const uint8*>(DecodedAudioInfo.PCMInfo.PCMData.GetView().GetData());
+	int64 RemainingBytes = DecodedAudioInfo.PCMInfo.PCMData.GetView().Num() * sizeof(float);
+	while (RemainingBytes > 0)
+	{
+		const int64 ChunkSize = FMath::Min<int64>(RemainingBytes, MAX_int32);
+		HashState.Update(PCMDataPtr, ChunkSize);
+		PCMDataPtr += ChunkSize;
+		RemainingBytes -= ChunkSize;
+	}
+
+	HashState.Final();
+
+	FSHAHash Hash;
+	HashState.GetHash(Hash.Hash);
+	return Hash.ToString();
+}
@@ -0,0 +1,179 @@
+// Georgy Treshchev 2024.
+
+#include "Sound/DecodedAudioCache.h"
+
+#include "RuntimeAudioImporterDefines.h"
+#include "HAL/FileManager.h"
+#include "Hash/CityHash.h"
+#include "Misc/Paths.h"
+
+FRuntimeDecodedAudioCache::FRuntimeDecodedAudioCache()
+	: AccessCounter(0)
+{
+}
+
+FRuntimeDecodedAudioCache& FRuntimeDecodedAudioCache::Get()
+{
+	static FRuntimeDecodedAudioCache DecodedAudioCache;
+	return DecodedAudioCache;
+}
+
+bool FRuntimeDecodedAudioCache::IsEnabled() const
+{
+	FRAIScopeLock Lock(&DataGuard);
+	return Stats.MemoryBudget > 0;
+}
+
+void FRuntimeDecodedAudioCache::SetMemoryBudget(int64 InMemoryBudget)
+{
+	FRAIScopeLock Lock(&DataGuard);
+	Stats.MemoryBudget = FMath::Max<int64>(InMemoryBudget, 0);
+	EvictToFit_Internal(0);
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("The memory budget of the decoded audio cache has been set to '%lld' bytes (%s)"), Stats.MemoryBudget, Stats.MemoryBudget > 0 ? TEXT("enabled") : TEXT("disabled"));
+}
+
+int64 FRuntimeDecodedAudioCache::GetMemoryBudget() const
+{
+	FRAIScopeLock Lock(&DataGuard);
+	return Stats.MemoryBudget;
+}
+
+FRuntimeDecodedAudioPtr FRuntimeDecodedAudioCache::Find(const FString& Key)
+{
+	FRAIScopeLock Lock(&DataGuard);
+
+	FEntry* Entry = Entries.Find(Key);
+	if (!Entry)
+	{
+		++Stats.NumOfMisses;
+		return nullptr;
+	}
+
+	++Stats.NumOfHits;
+	Entry->LastAccess = ++AccessCounter;
+
+	UE_LOG(LogRuntimeAudioImporter, Verbose, TEXT("Found decoded audio data in the cache for the key '%s'"), *Key);
+	return Entry->DecodedAudioInfo;
+}
+
+FRuntimeDecodedAudioPtr FRuntimeDecodedAudioCache::Add(const FString& Key, FDecodedAudioStruct&& DecodedAudioInfo)
+{
+	const int64 EntrySize = GetEntrySize(DecodedAudioInfo);
+	FRuntimeDecodedAudioPtr SharedDecodedAudioInfo = MakeShared<const FDecodedAudioStruct, ESPMode::ThreadSafe>(MoveTemp(DecodedAudioInfo));
+
+	FRAIScopeLock Lock(&DataGuard);
+
+	if (EntrySize > Stats.MemoryBudget)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Unable to cache decoded audio data for the key '%s' as its size '%lld' exceeds the memory budget '%lld'"), *Key, EntrySize, Stats.MemoryBudget);
+		return SharedDecodedAudioInfo;
+	}
+
+	if (const FEntry* ExistingEntry = Entries.Find(Key))
+	{
+		Stats.UsedBytes -= ExistingEntry->Size;
+		Entries.Remove(Key);
+	}
+
+	EvictToFit_Internal(EntrySize);
+
+	Entries.Add(Key, FEntry{SharedDecodedAudioInfo, EntrySize, ++AccessCounter});
+	Stats.UsedBytes += EntrySize;
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Cached decoded audio data for the key '%s' (%lld bytes, entries: %d, used: %lld bytes, budget: %lld bytes)"), *Key, EntrySize, Entries.Num(), Stats.UsedBytes, Stats.MemoryBudget);
+	return SharedDecodedAudioInfo;
+}
+
+void FRuntimeDecodedAudioCache::Empty()
+{
+	FRAIScopeLock Lock(&DataGuard);
+	Entries.Empty();
+	Stats.UsedBytes = 0;
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("The decoded audio cache has been emptied"));
+}
+
+FRuntimeDecodedAudioCacheStats FRuntimeDecodedAudioCache::GetStats() const
+{
+	FRAIScopeLock Lock(&DataGuard);
+	FRuntimeDecodedAudioCacheStats CurrentStats = Stats;
+	CurrentStats.NumOfEntries = Entries.Num();
+	return CurrentStats;
+}
+
+FDecodedAudioStruct FRuntimeDecodedAudioCache::MakeDecodedAudioView(const FRuntimeDecodedAudioPtr& SharedDecodedAudioInfo)
+{
+	FDecodedAudioStruct DecodedAudioInfo;
+	if (!SharedDecodedAudioInfo.IsValid())
+	{
+		return DecodedAudioInfo;
+	}
+
+	DecodedAudioInfo.SoundWaveBasicInfo = SharedDecodedAudioInfo->SoundWaveBasicInfo;
+	DecodedAudioInfo.PCMInfo.PCMNumOfFrames = SharedDecodedAudioInfo->PCMInfo.PCMNumOfFrames;
+
+	// The shared data is never written to, the view only keeps it alive
+	const FRuntimeBulkDataBuffer<float>& SharedPCMData = SharedDecodedAudioInfo->PCMInfo.PCMData;
+	DecodedAudioInfo.PCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(const_cast<float*>(SharedPCMData.GetView().GetData()), SharedPCMData.GetView().Num(), ConstCastSharedPtr<FDecodedAudioStruct>(SharedDecodedAudioInfo));
+
+	return DecodedAudioInfo;
+}
+
+FString FRuntimeDecodedAudioCache::MakeFileKey(const FString& FilePath, ERuntimeAudioFormat AudioFormat)
+{
+	const FFileStatData StatData = IFileManager::Get().GetStatData(*FilePath);
+	if (!StatData.bIsValid || StatData.bIsDirectory)
+	{
+		return FString();
+	}
+
+	return FString::Printf(TEXT("File:%s|%lld|%lld|%d"), *FPaths::ConvertRelativePathToFull(FilePath), StatData.ModificationTime.GetTicks(), StatData.FileSize, static_cast<int32>(AudioFormat));
+}
+
+FString FRuntimeDecodedAudioCache::MakeContentKey(const FRuntimeBulkDataBuffer<uint8>& AudioData, ERuntimeAudioFormat AudioFormat)
+{
+	// Hashing in chunks since the size parameter is 32-bit
+	uint64 Hash = 0;
+	const uint8* DataPtr = AudioData.GetView().GetData();
+	int64 RemainingBytes = AudioData.GetView().Num();
+	while (RemainingBytes > 0)
+	{
+		const int64 ChunkSize = FMath::Min<int64>(RemainingBytes, MAX_int32);
+		Hash = CityHash64WithSeed(reinterpret_cast<const char*>(DataPtr), static_cast<uint32>(ChunkSize), Hash);
+		DataPtr += ChunkSize;
+		RemainingBytes -= ChunkSize;
+	}
+
+	return FString::Printf(TEXT("Content:%016llx|%lld|%d"), Hash, static_cast<int64>(AudioData.GetView().Num()), static_cast<int32>(AudioFormat));
+}
+
+void FRuntimeDecodedAudioCache::EvictToFit_Internal(int64 BytesToFit)
+{
+	while (Entries.Num() > 0 && Stats.UsedBytes + BytesToFit > Stats.MemoryBudget)
+	{
+		const FString* LeastRecentlyUsedKey = nullptr;
+		uint64 LeastRecentAccess = TNumericLimits<uint64>::Max();
+		for (const TPair<FString, FEntry>& Entry : Entries)
+		{
+			if (Entry.Value.LastAccess < LeastRecentAccess)
+			{
+				LeastRecentAccess = Entry.Value.LastAccess;
+				LeastRecentlyUsedKey = &Entry.Key;
+			}
+		}
+
+		const FString KeyToEvict = *LeastRecentlyUsedKey;
+		const int64 SizeToEvict = Entries.FindChecked(KeyToEvict).Size;
+
+		UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Evicting decoded audio data for the key '%s' (%lld bytes) from the cache"), *KeyToEvict, SizeToEvict);
+
+		Entries.Remove(KeyToEvict);
+		Stats.UsedBytes -= SizeToEvict;
+		++Stats.NumOfEvictions;
+	}
+}
+
+int64 FRuntimeDecodedAudioCache::GetEntrySize(const FDecodedAudioStruct& DecodedAudioInfo)
+{
+	return static_cast<int64>(DecodedAudioInfo.PCMInfo.PCMData.GetView().Num()) * sizeof(float);
+}
@@ -0,0 +1,440 @@
+// Georgy Treshchev 2024.
+
+#include "Sound/DecodedAudioDiskCache.h"
+
+#include "RuntimeAudioImporterDefines.h"
+#include "Codecs/RAW_RuntimeCodec.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Hash/CityHash.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+
+std::atomic<bool> FRuntimeDecodedAudioDiskCache::bEnabled{false};
+std::atomic<bool> FRuntimeDecodedAudioDiskCache::bStoreAsInt16{false};
+
+namespace
+{
+	/** "RAIP" */
+	constexpr uint32 DiskCacheMagic = 0x50494152;
+
+	/** Incremented every time the layout of the cached files changes */
+	constexpr uint32 DiskCacheVersion = 1;
+
+	/** Alignment of the PCM data within the cached file, so it can be referenced directly from the mapped file */
+	constexpr int64 DiskCacheDataAlignment = 16;
+
+	/** Size of the blocks the PCM data is hashed in */
+	constexpr int64 DiskCacheHashBlockSize = 1024 * 1024;
+
+	const TCHAR* DiskCacheExtension = TEXT(".rapcm");
+
+	enum class EDiskCacheSampleFormat : uint32
+	{
+		Float32 = 0,
+		Int16 = 1
+	};
+
+	/**
+	 * Header of a cached file, stored as is at the beginning of the file
+	 * Followed by the UTF-8 key (KeySize bytes) and the interleaved PCM data (DataSize bytes) at DataOffset
+	 */
+	struct FDiskCacheHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint32 SampleFormat;
+		uint32 NumOfChannels;
+		uint32 SampleRate;
+		float Duration;
+		uint32 AudioFormat;
+		uint32 KeySize;
+		uint64 NumOfFrames;
+		uint64 DataOffset;
+		uint64 DataSize;
+		uint64 DataHash;
+	};
+
+	int64 GetBytesPerSample(uint32 SampleFormat)
+	{
+		return SampleFormat == static_cast<uint32>(EDiskCacheSampleFormat::Int16) ? sizeof(int16) : sizeof(float);
+	}
+
+	/**
+	 * Continue hashing the PCM data with the specified block. All blocks except the last one must be DiskCacheHashBlockSize bytes
+	 */
+	uint64 HashBlock(const uint8* Data, int64 Size, uint64 Hash)
+	{
+		return CityHash64WithSeed(reinterpret_cast<const char*>(Data), static_cast<uint32>(Size), Hash);
+	}
+
+	uint64 HashData(const uint8* Data, int64 Size)
+	{
+		uint64 Hash = 0;
+		for (int64 Offset = 0; Offset < Size; Offset += DiskCacheHashBlockSize)
+		{
+			Hash = HashBlock(Data + Offset, FMath::Min<int64>(DiskCacheHashBlockSize, Size - Offset), Hash);
+		}
+		return Hash;
+	}
+
+	/**
+	 * Read and verify the header of the cached file
+	 *
+	 * @param FileData The cached file data
+	 * @param Key The expected key. Not verified if empty
+	 * @param OutHeader The header. Populated only if the function returns true
+	 * @return True if the header is valid and matches the file size and the key
+	 */
+	bool ReadHeader(const FRuntimeBulkDataBuffer<uint8>& FileData, const FString& Key, FDiskCacheHeader& OutHeader)
+	{
+		const int64 FileSize = FileData.GetView().Num();
+		if (FileSize < static_cast<int64>(sizeof(FDiskCacheHeader)))
+		{
+			return false;
+		}
+
+		FMemory::Memcpy(&OutHeader, FileData.GetView().GetData(), sizeof(FDiskCacheHeader));
+
+		if (OutHeader.Magic != DiskCacheMagic || OutHeader.Version != DiskCacheVersion || OutHeader.SampleFormat > static_cast<uint32>(EDiskCacheSampleFormat::Int16)
+			|| OutHeader.NumOfChannels == 0 || OutHeader.SampleRate == 0 || OutHeader.NumOfFrames == 0 || OutHeader.NumOfFrames > TNumericLimits<uint32>::Max())
+		{
+			return false;
+		}
+
+		if (OutHeader.DataOffset < sizeof(FDiskCacheHeader) + OutHeader.KeySize || OutHeader.DataOffset % DiskCacheDataAlignment != 0
+			|| OutHeader.DataSize != OutHeader.NumOfFrames * OutHeader.NumOfChannels * GetBytesPerSample(OutHeader.SampleFormat)
+			|| OutHeader.DataOffset + OutHeader.DataSize > static_cast<uint64>(FileSize))
+		{
+			return false;
+		}
+
+		if (!Key.IsEmpty())
+		{
+			const FTCHARToUTF8 KeyUTF8(*Key);
+			if (OutHeader.KeySize != static_cast<uint32>(KeyUTF8.Length()) || FMemory::Memcmp(FileData.GetView().GetData() + sizeof(FDiskCacheHeader), KeyUTF8.Get(), KeyUTF8.Length()) != 0)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+void FRuntimeDecodedAudioDiskCache::SetEnabled(bool bInEnabled, bool bInStoreAsInt16)
+{
+#if WITH_RUNTIMEAUDIOIMPORTER_FILEOPERATION_SUPPORT
+	bEnabled = bInEnabled;
+	bStoreAsInt16 = bInStoreAsInt16;
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("The decoded audio disk cache has been %s (directory: '%s', sample format: %s)"), bInEnabled ? TEXT("enabled") : TEXT("disabled"), *GetDirectory(), bInStoreAsInt16 ? TEXT("int16") : TEXT("float32"));
+#else
+	UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to toggle the decoded audio disk cache because file operation support is disabled in RuntimeAudioImporter.Build.cs"));
+#endif
+}
+
+bool FRuntimeDecodedAudioDiskCache::IsEnabled()
+{
+	return bEnabled;
+}
+
+bool FRuntimeDecodedAudioDiskCache::Load(const FString& Key, FDecodedAudioStruct& OutDecodedAudioInfo)
+{
+#if WITH_RUNTIMEAUDIOIMPORTER_FILEOPERATION_SUPPORT
+	if (!IsEnabled() || Key.IsEmpty())
+	{
+		return false;
+	}
+
+	const FString FilePath = GetFilePath(Key);
+	if (!FPaths::FileExists(FilePath))
+	{
+		return false;
+	}
+
+	FDecodedAudioStruct DecodedAudioInfo;
+	{
+		FRuntimeBulkDataBuffer<uint8> FileData;
+		if (!RuntimeAudioImporter::MapAudioFile(FileData, FilePath))
+		{
+			UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Unable to open the cached decoded audio file '%s'"), *FilePath);
+			return false;
+		}
+
+		FDiskCacheHeader Header;
+		if (!ReadHeader(FileData, Key, Header))
+		{
+			UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("The cached decoded audio file '%s' is invalid or belongs to a different key and will be deleted"), *FilePath);
+			FileData.Empty();
+			IFileManager::Get().Delete(*FilePath);
+			return false;
+		}
+
+		uint8* PCMDataPtr = FileData.GetView().GetData() + Header.DataOffset;
+		const int64 NumOfSamples = static_cast<int64>(Header.NumOfFrames * Header.NumOfChannels);
+
+		if (Header.SampleFormat == static_cast<uint32>(EDiskCacheSampleFormat::Float32))
+		{
+			// The mapped data is already in the format used for playback, so it is referenced directly
+			if (FileData.IsExternallyOwned())
+			{
+				DecodedAudioInfo.PCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(reinterpret_cast<float*>(PCMDataPtr), NumOfSamples, FileData.GetExternalOwner());
+			}
+			else
+			{
+				float* Float32DataPtr = static_cast<float*>(FMemory::Memcpy(FMemory::Malloc(Header.DataSize), PCMDataPtr, Header.DataSize));
+				DecodedAudioInfo.PCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(Float32DataPtr, NumOfSamples);
+			}
+		}
+		else
+		{
+			float* Float32DataPtr = nullptr;
+			FRAW_RuntimeCodec::TranscodeRAWData<int16, float>(reinterpret_cast<const int16*>(PCMDataPtr), NumOfSamples, Float32DataPtr);
+			DecodedAudioInfo.PCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(Float32DataPtr, NumOfSamples);
+		}
+
+		DecodedAudioInfo.PCMInfo.PCMNumOfFrames = static_cast<uint32>(Header.NumOfFrames);
+		DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels = Header.NumOfChannels;
+		DecodedAudioInfo.SoundWaveBasicInfo.SampleRate = Header.SampleRate;
+		DecodedAudioInfo.SoundWaveBasicInfo.Duration = Header.Duration;
+		DecodedAudioInfo.SoundWaveBasicInfo.AudioFormat = static_cast<ERuntimeAudioFormat>(Header.AudioFormat);
+	}
+
+	if (!DecodedAudioInfo.IsValid())
+	{
+		return false;
+	}
+
+	// The modification time is used to find the least recently used files when trimming
+	IFileManager::Get().SetTimeStamp(*FilePath, FDateTime::UtcNow());
+
+	OutDecodedAudioInfo = MoveTemp(DecodedAudioInfo);
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Loaded decoded audio data from the disk cache '%s' without decoding"), *FilePath);
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool FRuntimeDecodedAudioDiskCache::Save(const FString& Key, const FDecodedAudioStruct& DecodedAudioInfo)
+{
+#if WITH_RUNTIMEAUDIOIMPORTER_FILEOPERATION_SUPPORT
+	if (!IsEnabled() || Key.IsEmpty() || !DecodedAudioInfo.IsValid())
+	{
+		return false;
+	}
+
+	RuntimeAudioImporter::CheckAndRequestPermissions();
+
+	const FString FilePath = GetFilePath(Key);
+	const FString TempFilePath = FilePath + TEXT(".tmp");
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*GetDirectory());
+
+	const FTCHARToUTF8 KeyUTF8(*Key);
+	const EDiskCacheSampleFormat SampleFormat = bStoreAsInt16 ? EDiskCacheSampleFormat::Int16 : EDiskCacheSampleFormat::Float32;
+	const int64 NumOfSamples = DecodedAudioInfo.PCMInfo.PCMData.GetView().Num();
+
+	FDiskCacheHeader Header;
+	FMemory::Memzero(Header);
+	Header.Magic = DiskCacheMagic;
+	Header.Version = DiskCacheVersion;
+	Header.SampleFormat = static_cast<uint32>(SampleFormat);
+	Header.NumOfChannels = DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels;
+	Header.SampleRate = DecodedAudioInfo.SoundWaveBasicInfo.SampleRate;
+	Header.Duration = DecodedAudioInfo.SoundWaveBasicInfo.Duration;
+	Header.AudioFormat = static_cast<uint32>(DecodedAudioInfo.SoundWaveBasicInfo.AudioFormat);
+	Header.KeySize = KeyUTF8.Length();
+	Header.NumOfFrames = DecodedAudioInfo.PCMInfo.PCMNumOfFrames;
+	Header.DataOffset = Align(sizeof(FDiskCacheHeader) + Header.KeySize, DiskCacheDataAlignment);
+	Header.DataSize = NumOfSamples * GetBytesPerSample(Header.SampleFormat);
+
+	if (static_cast<uint64>(NumOfSamples) != Header.NumOfFrames * Header.NumOfChannels)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to store decoded audio data in the disk cache because the number of samples '%lld' does not match the number of frames '%llu' and channels '%d'"), NumOfSamples, Header.NumOfFrames, Header.NumOfChannels);
+		return false;
+	}
+
+	bool bSucceeded = false;
+	{
+		TUniquePtr<IFileHandle> FileHandle(PlatformFile.OpenWrite(*TempFilePath));
+		if (!FileHandle.IsValid())
+		{
+			UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Unable to create the cached decoded audio file '%s'"), *TempFilePath);
+			return false;
+		}
+
+		// The header is written again once the hash of the PCM data is known
+		TArray<uint8> Prefix;
+		Prefix.SetNumZeroed(Header.DataOffset);
+		FMemory::Memcpy(Prefix.GetData() + sizeof(FDiskCacheHeader), KeyUTF8.Get(), KeyUTF8.Length());
+		bSucceeded = FileHandle->Write(Prefix.GetData(), Prefix.Num());
+
+		const float* PCMDataPtr = DecodedAudioInfo.PCMInfo.PCMData.GetView().GetData();
+		const int64 SamplesPerBlock = DiskCacheHashBlockSize / GetBytesPerSample(Header.SampleFormat);
+
+		uint64 DataHash = 0;
+		for (int64 SampleIndex = 0; bSucceeded && SampleIndex < NumOfSamples; SampleIndex += SamplesPerBlock)
+		{
+			const int64 NumOfBlockSamples = FMath::Min<int64>(SamplesPerBlock, NumOfSamples - SampleIndex);
+
+			if (SampleFormat == EDiskCacheSampleFormat::Int16)
+			{
+				int16* Int16DataPtr = nullptr;
+				FRAW_RuntimeCodec::TranscodeRAWData<float, int16>(PCMDataPtr + SampleIndex, NumOfBlockSamples, Int16DataPtr);
+				DataHash = HashBlock(reinterpret_cast<const uint8*>(Int16DataPtr), NumOfBlockSamples * sizeof(int16), DataHash);
+				bSucceeded = FileHandle->Write(reinterpret_cast<const uint8*>(Int16DataPtr), NumOfBlockSamples * sizeof(int16));
+				FMemory::Free(Int16DataPtr);
+			}
+			else
+			{
+				const uint8* BlockDataPtr = reinterpret_cast<const uint8*>(PCMDataPtr + SampleIndex);
+				DataHash = HashBlock(BlockDataPtr, NumOfBlockSamples * sizeof(float), DataHash);
+				bSucceeded = FileHandle->Write(BlockDataPtr, NumOfBlockSamples * sizeof(float));
+			}
+		}
+
+		Header.DataHash = DataHash;
+		bSucceeded = bSucceeded && FileHandle->Seek(0) && FileHandle->Write(reinterpret_cast<const uint8*>(&Header), sizeof(FDiskCacheHeader)) && FileHandle->Flush();
+	}
+
+	// Writing to a temporary file first so that an interrupted write never leaves a partially written file under the final name
+	if (!bSucceeded || !IFileManager::Get().Move(*FilePath, *TempFilePath, true, true))
+	{
+		UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Unable to store decoded audio data in the disk cache '%s'"), *FilePath);
+		IFileManager::Get().Delete(*TempFilePath);
+		return false;
+	}
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Stored decoded audio data in the disk cache '%s' (%llu bytes of %s PCM data)"), *FilePath, Header.DataSize, SampleFormat == EDiskCacheSampleFormat::Int16 ? TEXT("int16") : TEXT("float32"));
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool FRuntimeDecodedAudioDiskCache::Remove(const FString& Key)
+{
+	if (Key.IsEmpty())
+	{
+		return false;
+	}
+
+	const FString FilePath = GetFilePath(Key);
+	return IFileManager::Get().FileExists(*FilePath) && IFileManager::Get().Delete(*FilePath);
+}
+
+FString FRuntimeDecodedAudioDiskCache::GetDirectory()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("RuntimeAudioImporter"), TEXT("DecodedAudioCache"));
+}
+
+FRuntimeDecodedAudioDiskCacheInfo FRuntimeDecodedAudioDiskCache::GetInfo()
+{
+	FRuntimeDecodedAudioDiskCacheInfo Info;
+	for (const FString& FilePath : GetFilePaths())
+	{
+		const int64 FileSize = IFileManager::Get().FileSize(*FilePath);
+		if (FileSize >= 0)
+		{
+			++Info.NumOfFiles;
+			Info.TotalSize += FileSize;
+		}
+	}
+	return Info;
+}
+
+int32 FRuntimeDecodedAudioDiskCache::Trim(int64 MaxSize)
+{
+	int64 TotalSize;
+	const int32 NumOfDeletedFiles = RuntimeAudioImporter::DeleteLeastRecentlyUsedFiles(GetFilePaths(), MaxSize, TotalSize);
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Trimmed the decoded audio disk cache to '%lld' bytes (deleted files: %d, remaining size: %lld bytes)"), MaxSize, NumOfDeletedFiles, TotalSize);
+	return NumOfDeletedFiles;
+}
+
+int32 FRuntimeDecodedAudioDiskCache::Validate(bool bDeleteInvalid)
+{
+	int32 NumOfInvalidFiles = 0;
+#if WITH_RUNTIMEAUDIOIMPORTER_FILEOPERATION_SUPPORT
+	for (const FString& FilePath : GetFilePaths())
+	{
+		bool bValid = false;
+		{
+			FRuntimeBulkDataBuffer<uint8> FileData;
+			FDiskCacheHeader Header;
+			if (RuntimeAudioImporter::MapAudioFile(FileData, FilePath) && ReadHeader(FileData, FString(), Header))
+			{
+				bValid = HashData(FileData.GetView().GetData() + Header.DataOffset, Header.DataSize) == Header.DataHash;
+			}
+		}
+
+		if (!bValid)
+		{
+			++NumOfInvalidFiles;
+			UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("The cached decoded audio file '%s' is invalid%s"), *FilePath, bDeleteInvalid ? TEXT(" and will be deleted") : TEXT(""));
+			if (bDeleteInvalid)
+			{
+				IFileManager::Get().Delete(*FilePath);
+			}
+		}
+	}
+#endif
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Validated the decoded audio disk cache (invalid files: %d)"), NumOfInvalidFiles);
+	return NumOfInvalidFiles;
+}
+
+FString FRuntimeDecodedAudioDiskCache::GetFilePath(const FString& Key)
+{
+	const FTCHARToUTF8 KeyUTF8(*Key);
+
+	FSHAHash Hash;
+	FSHA1::HashBuffer(KeyUTF8.Get(), KeyUTF8.Length(), Hash.Hash);
+	return FPaths::Combine(GetDirectory(), Hash.ToString() + DiskCacheExtension);
+}
+
+TArray<FString> FRuntimeDecodedAudioDiskCache::GetFilePaths()
+{
+	TArray<FString> FileNames;
+	IFileManager::Get().FindFiles(FileNames, *GetDirectory(), DiskCacheExtension);
+
+	TArray<FString> FilePaths;
+	FilePaths.Reserve(FileNames.Num());
+	for (const FString& FileName : FileNames)
+	{
+		FilePaths.Add(FPaths::Combine(GetDirectory(), FileName));
+	}
+	return FilePaths;
+}
+
+#if WITH_RUNTIMEAUDIOIMPORTER_FILEOPERATION_SUPPORT
+static FAutoConsoleCommand DecodedAudioDiskCacheInfoCommand(
+	TEXT("RuntimeAudioImporter.DecodedAudioDiskCache.Info"),
+	TEXT("Print the number and the total size of the files in the decoded audio disk cache"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		const FRuntimeDecodedAudioDiskCacheInfo Info = FRuntimeDecodedAudioDiskCache::GetInfo();
+		UE_LOG(LogRuntimeAudioImporter, Display, TEXT("Decoded audio disk cache '%s': %d files, %lld bytes"), *FRuntimeDecodedAudioDiskCache::GetDirectory(), Info.NumOfFiles, Info.TotalSize);
+	}));
+
+static FAutoConsoleCommand DecodedAudioDiskCacheTrimCommand(
+	TEXT("RuntimeAudioImporter.DecodedAudioDiskCache.Trim"),
+	TEXT("Delete the least recently used files in the decoded audio disk cache until it fits within the specified size. Usage: RuntimeAudioImporter.DecodedAudioDiskCache.Trim <MaxSizeInMegabytes>"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int64 MaxSize = Args.Num() > 0 ? FCString::Atoi64(*Args[0]) * 1024 * 1024 : 0;
+		FRuntimeDecodedAudioDiskCache::Trim(MaxSize);
+	}));
+
+static FAutoConsoleCommand DecodedAudioDiskCacheValidateCommand(
+	TEXT("RuntimeAudioImporter.DecodedAudioDiskCache.Validate"),
+	TEXT("Verify all files in the decoded audio disk cache. Usage: RuntimeAudioImporter.DecodedAudioDiskCache.Validate [delete]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		FRuntimeDecodedAudioDiskCache::Validate(Args.Num() > 0 && Args[0] == TEXT("delete"));
+	}));
+#endif
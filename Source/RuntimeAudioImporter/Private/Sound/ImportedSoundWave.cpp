@@ -5,7 +5,6 @@
 #include "RuntimeAudioImporterLibrary.h"
 #include "AudioDevice.h"
 #include "Async/Async.h"
-#include "Async/Future.h"
 #include "Engine/Engine.h"
 #include "AudioThread.h"
 #if UE_VERSION_OLDER_THAN(5, 2, 0)
@@ -13,19 +12,144 @@
 #else
 #include "AudioDeviceHandle.h"
 #endif
+#include "Codecs/RAW_RuntimeCodec.h"
+#include "Codecs/RuntimePCMFormatConverter.h"
 #if WITH_RUNTIMEAUDIOIMPORTER_METASOUND_SUPPORT
-#include "Codecs/VORBIS_RuntimeCodec.h"
+#include "MetaSound/MetasoundImportedWave.h"
+#include "Containers/Ticker.h"
 #endif
-#include "Codecs/RAW_RuntimeCodec.h"
+
+namespace
+{
+	/** The number of times processing of the PCM data is restarted if the PCM data is changed (other than appended to) during processing */
+	constexpr int32 MaxNumOfProcessAttempts = 3;
+
+	/** The number of times the frames appended during processing are converted without locking before the remaining ones are converted under the lock */
+	constexpr int32 MaxNumOfAppendedFramesRounds = 3;
+
+	/**
+	 * Copy the PCM data as 32-bit float, regardless of the format it is stored in
+	 */
+	Audio::FAlignedFloatBuffer GetFloatPCMData(const FPCMStruct& PCMInfo)
+	{
+		Audio::FAlignedFloatBuffer FloatPCMData;
+		FloatPCMData.AddUninitialized(PCMInfo.GetNumOfSamples());
+		FRAW_RuntimeCodec::CopyPCMDataAsFloat(PCMInfo, 0, FloatPCMData.Num(), FloatPCMData.GetData());
+		return FloatPCMData;
+	}
+
+	/**
+	 * Replace the PCM data with the 32-bit float PCM data, storing it in the specified format
+	 */
+	void SetFloatPCMData(FPCMStruct& PCMInfo, const Audio::FAlignedFloatBuffer& FloatPCMData, ERuntimePCMStorageFormat StorageFormat)
+	{
+		PCMInfo.PCMData.Empty();
+		PCMInfo.PCMDataInt16.Empty();
+
+		if (StorageFormat == ERuntimePCMStorageFormat::Int16)
+		{
+			int16* Int16PCMData = static_cast<int16*>(FMemory::Malloc(FloatPCMData.Num() * sizeof(int16)));
+			FRAW_RuntimeCodec::ConvertFloatToInt16(FloatPCMData.GetData(), Int16PCMData, FloatPCMData.Num());
+			PCMInfo.PCMDataInt16 = FRuntimeBulkDataBuffer<int16>(Int16PCMData, FloatPCMData.Num());
+		}
+		else
+		{
+			PCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(FloatPCMData);
+		}
+	}
+
+	/**
+	 * Copy the PCM data, referencing the externally owned (immutable) buffers instead of copying them
+	 */
+	FPCMStruct SharePCMData(const FPCMStruct& PCMInfo)
+	{
+		FPCMStruct SharedPCMInfo;
+		SharedPCMInfo.PCMNumOfFrames = PCMInfo.PCMNumOfFrames;
+
+		if (PCMInfo.PCMData.IsExternallyOwned())
+		{
+			SharedPCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(PCMInfo.PCMData.GetView().GetData(), PCMInfo.PCMData.GetView().Num(), PCMInfo.PCMData.GetExternalOwner());
+		}
+		else if (PCMInfo.PCMData.GetView().Num() > 0)
+		{
+			SharedPCMInfo.PCMData = PCMInfo.PCMData;
+		}
+
+		if (PCMInfo.PCMDataInt16.IsExternallyOwned())
+		{
+			SharedPCMInfo.PCMDataInt16 = FRuntimeBulkDataBuffer<int16>(PCMInfo.PCMDataInt16.GetView().GetData(), PCMInfo.PCMDataInt16.GetView().Num(), PCMInfo.PCMDataInt16.GetExternalOwner());
+		}
+		else if (PCMInfo.PCMDataInt16.GetView().Num() > 0)
+		{
+			SharedPCMInfo.PCMDataInt16 = PCMInfo.PCMDataInt16;
+		}
+
+		return SharedPCMInfo;
+	}
+
+	/**
+	 * Reference the frames of the immutable PCM data starting from the specified one, without copying them
+	 */
+	FPCMStruct SharePCMFrames(const FImportedSoundWavePCMSnapshotPtr& PCMSnapshot, int64 StartFrame, uint32 NumOfChannels)
+	{
+		FPCMStruct SharedPCMInfo;
+		const int64 StartSample = FMath::Min<int64>(StartFrame * NumOfChannels, PCMSnapshot->GetNumOfSamples());
+		const TSharedPtr<FPCMStruct, ESPMode::ThreadSafe> Owner = ConstCastSharedPtr<FPCMStruct>(PCMSnapshot);
+
+		if (PCMSnapshot->GetStorageFormat() == ERuntimePCMStorageFormat::Int16)
+		{
+			const FRuntimeBulkDataBuffer<int16>::ViewType& View = PCMSnapshot->PCMDataInt16.GetView();
+			SharedPCMInfo.PCMDataInt16 = FRuntimeBulkDataBuffer<int16>(const_cast<int16*>(View.GetData()) + StartSample, View.Num() - StartSample, Owner);
+		}
+		else
+		{
+			const FRuntimeBulkDataBuffer<float>::ViewType& View = PCMSnapshot->PCMData.GetView();
+			SharedPCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(const_cast<float*>(View.GetData()) + StartSample, View.Num() - StartSample, Owner);
+		}
+		SharedPCMInfo.PCMNumOfFrames = (PCMSnapshot->GetNumOfSamples() - StartSample) / FMath::Max<uint32>(NumOfChannels, 1);
+
+		return SharedPCMInfo;
+	}
+
+	/**
+	 * Append the PCM data, converting it to the format the PCM data being appended to is stored in
+	 */
+	void AppendPCMData(FPCMStruct& PCMInfo, FPCMStruct&& AppendedPCMInfo)
+	{
+		FRAW_RuntimeCodec::ConvertPCMStorageFormat(AppendedPCMInfo, PCMInfo.GetStorageFormat());
+		PCMInfo.PCMNumOfFrames += AppendedPCMInfo.PCMNumOfFrames;
+
+		if (PCMInfo.GetStorageFormat() == ERuntimePCMStorageFormat::Int16)
+		{
+			PCMInfo.PCMDataInt16.Append(MoveTemp(AppendedPCMInfo.PCMDataInt16));
+		}
+		else
+		{
+			PCMInfo.PCMData.Append(MoveTemp(AppendedPCMInfo.PCMData));
+		}
+	}
+}
 
 UImportedSoundWave::UImportedSoundWave(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
   , DataGuard(MakeShared<FCriticalSection>())
   , PlaybackFinishedBroadcast(false)
   , PlayedNumOfFrames(0)
+  , NumOfActivePlaybacks(0)
   , PCMBufferInfo(MakeShared<FPCMStruct>())
+  , PCMSource(MakeShared<FImportedSoundWavePCMSource>(DataGuard, PCMBufferInfo))
   , bStopSoundOnPlaybackFinish(true)
   , ImportedAudioFormat(ERuntimeAudioFormat::Invalid)
+  , CompressedAudioCache(MakeShared<FRuntimeCompressedAudioCache, ESPMode::ThreadSafe>())
+  , AudioResourceRevision(0)
+  , bPrecacheCompressedAudio(false)
+  , bPrecacheScheduled(false)
+  , LastPCMAppendTime(0)
+  , PCMStorageFormat(ERuntimePCMStorageFormat::Float32)
+  , bPlaybackInstancing(false)
+  , bReversePlayback(false)
+  , PCMDataGeneration(0)
+  , NumOfAudioSubscriptions(0)
 {
 	ensure(PCMBufferInfo);
 
@@ -92,24 +216,234 @@ void UImportedSoundWave::DuplicateSoundWave(bool bUseSharedAudioBuffer, const FO
 	}
 	DuplicatedSoundWave->SetInternalFlags(EInternalObjectFlags::Async);
 	FRAIScopeLock Lock(&*DataGuard);
-	DuplicatedSoundWave->PCMBufferInfo = bUseSharedAudioBuffer ? PCMBufferInfo : MakeShared<FPCMStruct>(*PCMBufferInfo);
+
+	// Copy-on-write: the PCM data is moved into an immutable snapshot that both sound waves reference without copying
+	// Changing the PCM data of either sound wave afterwards (e.g. resampling, mixing, reversing or appending) only replaces its own reference, so the other one is never affected
+	if (bUseSharedAudioBuffer)
+	{
+		GetPCMSnapshot_Internal();
+		DuplicatedSoundWave->PCMSnapshot = PCMSnapshot;
+	}
+	DuplicatedSoundWave->PCMBufferInfo = MakeShared<FPCMStruct>(SharePCMData(*PCMBufferInfo));
 	DuplicatedSoundWave->bStopSoundOnPlaybackFinish = bStopSoundOnPlaybackFinish;
 	DuplicatedSoundWave->ImportedAudioFormat = ImportedAudioFormat;
 	DuplicatedSoundWave->Duration = Duration;
 	DuplicatedSoundWave->SetSampleRate(GetSampleRate());
 	DuplicatedSoundWave->NumChannels = NumChannels;
-	if (bUseSharedAudioBuffer)
+
+	// The PCM data is identical, so the compressed audio data is shared (including the one produced later) until the PCM data of either sound wave changes
+	DuplicatedSoundWave->CompressedAudioCache = CompressedAudioCache;
+	DuplicatedSoundWave->PCMSource = MakeShared<FImportedSoundWavePCMSource>(DuplicatedSoundWave->DataGuard, DuplicatedSoundWave->PCMBufferInfo);
+	DuplicatedSoundWave->PCMSource->SampleRate = PCMSource->SampleRate;
+	DuplicatedSoundWave->PCMSource->NumOfChannels = PCMSource->NumOfChannels;
+	DuplicatedSoundWave->PCMSource->bReversePlayback = PCMSource->bReversePlayback;
+	DuplicatedSoundWave->bPrecacheCompressedAudio = bPrecacheCompressedAudio;
+	DuplicatedSoundWave->PCMStorageFormat = PCMStorageFormat;
+	DuplicatedSoundWave->bPlaybackInstancing = bPlaybackInstancing;
+	DuplicatedSoundWave->bReversePlayback = bReversePlayback;
+	ExecuteResult(true, DuplicatedSoundWave);
+}
+
+bool UImportedSoundWave::SetPlaybackInstancing(bool bEnable)
+{
+#if WITH_RUNTIMEAUDIOIMPORTER_PLAYBACK_INSTANCE_GENERATOR_SUPPORT
 	{
-		DuplicatedSoundWave->DataGuard = DataGuard;
+		FRAIScopeLock Lock(&*DataGuard);
+		bPlaybackInstancing = bEnable;
 	}
-	ExecuteResult(true, DuplicatedSoundWave);
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Playback instancing for the sound wave '%s' has been %s"), *GetName(), bEnable ? TEXT("enabled") : TEXT("disabled"));
+	return true;
+#else
+	UE_LOG(LogRuntimeAudioImporter, Error, TEXT("SetPlaybackInstancing works only for Unreal Engine version >= 5.0"));
+	return false;
+#endif
+}
+
+bool UImportedSoundWave::IsPlaybackInstancingEnabled() const
+{
+	FRAIScopeLock Lock(&*DataGuard);
+	return bPlaybackInstancing;
+}
+
+void UImportedSoundWave::SetReversePlayback(bool bReverse)
+{
+	FRAIScopeLock Lock(&*DataGuard);
+
+	if (bReversePlayback == bReverse)
+	{
+		return;
+	}
+
+	bReversePlayback = bReverse;
+	PCMSource->bReversePlayback = bReverse;
+	++PCMSource->Revision;
+
+	// The playhead is a position in the PCM data regardless of the direction, so the playback continues from the same position
+	// If the playback has not started yet in the previous direction, it starts from the beginning of the new direction instead
+	if (PCMBufferInfo.IsValid() && PlayedNumOfFrames == (bReverse ? 0 : PCMBufferInfo->PCMNumOfFrames))
+	{
+		PlayedNumOfFrames = bReverse ? PCMBufferInfo->PCMNumOfFrames : 0;
+		ResetPlaybackFinish();
+	}
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Reverse playback for the sound wave '%s' has been %s"), *GetName(), bReverse ? TEXT("enabled") : TEXT("disabled"));
+}
+
+bool UImportedSoundWave::IsReversePlayback() const
+{
+	FRAIScopeLock Lock(&*DataGuard);
+	return bReversePlayback;
+}
+
+TSharedPtr<FImportedSoundWavePlaybackInstance, ESPMode::ThreadSafe> UImportedSoundWave::CreatePlaybackInstance(bool bLoop)
+{
+	FRAIScopeLock Lock(&*DataGuard);
+
+	FImportedSoundWavePCMSnapshotPtr Snapshot = GetPCMSnapshot_Internal();
+	if (!Snapshot.IsValid())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to create a playback instance for the sound wave '%s' because it has no PCM data"), *GetName());
+		return nullptr;
+	}
+
+	return MakeShared<FImportedSoundWavePlaybackInstance, ESPMode::ThreadSafe>(MoveTemp(Snapshot), GetSampleRate(), GetNumOfChannels(), bLoop, bReversePlayback);
+}
+
+TSharedRef<FImportedSoundWaveAudioSubscription, ESPMode::ThreadSafe> UImportedSoundWave::SubscribeToAudio(ERuntimeAudioSubscriptionSource Source, int32 Capacity, ERuntimeAudioSubscriptionOverflowPolicy OverflowPolicy)
+{
+	TSharedRef<FImportedSoundWaveAudioSubscription, ESPMode::ThreadSafe> Subscription = MakeShared<FImportedSoundWaveAudioSubscription, ESPMode::ThreadSafe>(Source, Capacity, OverflowPolicy);
+	{
+		FRAIScopeLock Lock(&AudioSubscriptions_DataGuard);
+		AudioSubscriptions.Add(Subscription);
+		NumOfAudioSubscriptions.store(AudioSubscriptions.Num(), std::memory_order_relaxed);
+	}
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Subscribed to the %s audio data of the sound wave '%s' with a capacity of %d chunks"),
+		Source == ERuntimeAudioSubscriptionSource::Populated ? TEXT("populated") : TEXT("generated"), *GetName(), Subscription->GetCapacity());
+	return Subscription;
+}
+
+void UImportedSoundWave::UnsubscribeFromAudio(const TSharedPtr<FImportedSoundWaveAudioSubscription, ESPMode::ThreadSafe>& Subscription)
+{
+	if (!Subscription.IsValid())
+	{
+		return;
+	}
+
+	Subscription->Deactivate();
+
+	FRAIScopeLock Lock(&AudioSubscriptions_DataGuard);
+	AudioSubscriptions.RemoveAll([&Subscription](const TWeakPtr<FImportedSoundWaveAudioSubscription, ESPMode::ThreadSafe>& WeakSubscription)
+	{
+		return !WeakSubscription.IsValid() || WeakSubscription.Pin() == Subscription;
+	});
+	NumOfAudioSubscriptions.store(AudioSubscriptions.Num(), std::memory_order_relaxed);
+}
+
+bool UImportedSoundWave::HasAudioSubscriptions() const
+{
+	return NumOfAudioSubscriptions.load(std::memory_order_relaxed) > 0;
+}
+
+void UImportedSoundWave::DeliverAudioChunk(ERuntimeAudioSubscriptionSource Source, const FImportedSoundWaveAudioChunkPtr& Chunk)
+{
+	if (!HasAudioSubscriptions() || !Chunk.IsValid())
+	{
+		return;
+	}
+
+	FRAIScopeLock Lock(&AudioSubscriptions_DataGuard);
+	for (int32 SubscriptionIndex = AudioSubscriptions.Num() - 1; SubscriptionIndex >= 0; --SubscriptionIndex)
+	{
+		const TSharedPtr<FImportedSoundWaveAudioSubscription, ESPMode::ThreadSafe> Subscription = AudioSubscriptions[SubscriptionIndex].Pin();
+		if (!Subscription.IsValid())
+		{
+			AudioSubscriptions.RemoveAtSwap(SubscriptionIndex);
+			continue;
+		}
+		if (Subscription->GetSource() == Source)
+		{
+			Subscription->Deliver(Chunk);
+		}
+	}
+	NumOfAudioSubscriptions.store(AudioSubscriptions.Num(), std::memory_order_relaxed);
+}
+
+void UImportedSoundWave::BroadcastPopulatedAudioChunk(const FImportedSoundWaveAudioChunkPtr& Chunk)
+{
+	const bool IsBound = [this]()
+	{
+		FRAIScopeLock Lock(&OnPopulateAudioData_DataGuard);
+		return OnPopulateAudioDataNative.IsBound() || OnPopulateAudioData.IsBound();
+	}();
+	if (!IsBound || !Chunk.IsValid())
+	{
+		return;
+	}
+
+	// The delegates take an array, so it is made from the shared chunk on the broadcasting thread rather than on the populating one
+	AsyncTask(ENamedThreads::AnyBackgroundHiPriTask, [WeakThis = MakeWeakObjectPtr(this), Chunk]()
+	{
+		if (WeakThis.IsValid())
+		{
+			const TArray<float> PCMData(Chunk->PCMData.GetView().GetData(), static_cast<int32>(Chunk->PCMData.GetView().Num()));
+			FRAIScopeLock Lock(&WeakThis->OnPopulateAudioData_DataGuard);
+			if (WeakThis->OnPopulateAudioDataNative.IsBound())
+			{
+				WeakThis->OnPopulateAudioDataNative.Broadcast(PCMData);
+			}
+			if (WeakThis->OnPopulateAudioData.IsBound())
+			{
+				WeakThis->OnPopulateAudioData.Broadcast(PCMData);
+			}
+		}
+		else
+		{
+			UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Unable to broadcast OnPopulateAudioDataNative and OnPopulateAudioData delegates because the streaming sound wave has been destroyed"));
+		}
+	});
+}
+
+FImportedSoundWavePCMSnapshotPtr UImportedSoundWave::GetPCMSnapshot_Internal()
+{
+	if (PCMSnapshot.IsValid() || !PCMBufferInfo->IsValid())
+	{
+		return PCMSnapshot;
+	}
+
+	// The snapshot shares the allocation of the live PCM data instead of taking it over, and the live PCM data keeps appending after the shared frames (e.g. into the capacity reserved by UStreamingSoundWave::PreAllocateAudioData)
+	// That way neither taking a snapshot nor appending afterwards copies the PCM data that has already been populated
+	TSharedRef<FPCMStruct, ESPMode::ThreadSafe> Snapshot = MakeShared<FPCMStruct, ESPMode::ThreadSafe>();
+	Snapshot->PCMData = PCMBufferInfo->PCMData.Share();
+	Snapshot->PCMDataInt16 = PCMBufferInfo->PCMDataInt16.Share();
+	Snapshot->PCMNumOfFrames = PCMBufferInfo->PCMNumOfFrames;
+
+	PCMSnapshot = Snapshot;
+	return PCMSnapshot;
 }
 
 Audio::EAudioMixerStreamDataFormat::Type UImportedSoundWave::GetGeneratedPCMDataFormat() const
 {
-	return Audio::EAudioMixerStreamDataFormat::Type::Float;
+	FRAIScopeLock Lock(&*DataGuard);
+	return PCMStorageFormat == ERuntimePCMStorageFormat::Int16 ? Audio::EAudioMixerStreamDataFormat::Type::Int16 : Audio::EAudioMixerStreamDataFormat::Type::Float;
 }
 
+#if WITH_RUNTIMEAUDIOIMPORTER_PLAYBACK_INSTANCE_GENERATOR_SUPPORT
+ISoundGeneratorPtr UImportedSoundWave::CreateSoundGenerator(const FSoundGeneratorInitParams& InParams)
+{
+	{
+		FRAIScopeLock Lock(&*DataGuard);
+		if (!bPlaybackInstancing)
+		{
+			return Super::CreateSoundGenerator(InParams);
+		}
+	}
+
+	return CreatePlaybackInstance(bLooping);
+}
+#endif
+
 #if WITH_RUNTIMEAUDIOIMPORTER_METASOUND_SUPPORT
 TSharedPtr<Audio::IProxyData> UImportedSoundWave::CreateProxyData(const Audio::FProxyDataInitParams& InitParams)
 {
@@ -119,7 +453,13 @@ TSharedPtr<Audio::IProxyData> UImportedSoundWave::CreateProxyData(const Audio::F
 		SoundWaveDataPtr->InitializeDataFromSoundWave(*this);
 		SoundWaveDataPtr->OverrideRuntimeFormat(Audio::NAME_OGG);
 	}
-	return USoundWave::CreateProxyData(InitParams);
+
+	TSharedPtr<Audio::IProxyData> ProxyDataPtr = USoundWave::CreateProxyData(InitParams);
+	if (ProxyDataPtr.IsValid() && ProxyDataPtr->CheckTypeCast<FSoundWaveProxy>())
+	{
+		RuntimeAudioImporter::RegisterPCMSource(ProxyDataPtr->GetAs<FSoundWaveProxy>(), PCMSource);
+	}
+	return ProxyDataPtr;
 #else
 	TSharedPtr<Audio::IProxyData> ProxyDataPtr = USoundWave::CreateProxyData(InitParams);
 	FSoundWaveProxyPtr ProxyData = StaticCastSharedPtr<FSoundWaveProxy>(ProxyDataPtr);
@@ -138,6 +478,7 @@ TSharedPtr<Audio::IProxyData> UImportedSoundWave::CreateProxyData(const Audio::F
 
 	ProxyData_SoundWaveDataPtr->InitializeDataFromSoundWave(*this);
 	ProxyData_SoundWaveDataPtr->OverrideRuntimeFormat(Audio::NAME_OGG);
+	RuntimeAudioImporter::RegisterPCMSource(*ProxyData, PCMSource);
 	return ProxyDataPtr;
 #endif
 }
@@ -152,22 +493,34 @@ bool UImportedSoundWave::InitAudioResource(FName Format)
 	}
 
 #if UE_VERSION_OLDER_THAN(5, 5, 0)
-	if (SoundWaveDataPtr->GetResourceSize() > 0)
-	{
-		return true;
-	}
+	const bool bHasAudioResource = SoundWaveDataPtr->GetResourceSize() > 0;
 #else
-	if (GetResourceSize() > 0)
-	{
-		return true;
-	}
+	const bool bHasAudioResource = GetResourceSize() > 0;
 #endif
 
+	TSharedPtr<FRuntimeCompressedAudioCache, ESPMode::ThreadSafe> Cache;
+	uint64 Revision;
+	FRuntimeCompressedAudioDataPtr CompressedData;
 	FDecodedAudioStruct DecodedAudioInfo;
 	{
 		FRAIScopeLock Lock(&*DataGuard);
+
+		// The cache might be replaced once the lock is released (see OnPCMDataChanged_Internal)
+		Cache = CompressedAudioCache;
+		Revision = Cache->GetRevision();
+
+		// The audio resource is up to date with the PCM data
+		if (bHasAudioResource && AudioResourceRevision == Revision)
+		{
+			return true;
+		}
+
+		// Copying the PCM data only if the compressed data has not yet been produced (e.g. precached or initialized by a duplicated sound wave)
+		CompressedData = Cache->GetCompressedData(Revision);
+		if (!CompressedData.IsValid())
 		{
 			DecodedAudioInfo.PCMInfo = GetPCMBuffer();
+			FRAW_RuntimeCodec::ConvertPCMStorageFormat(DecodedAudioInfo.PCMInfo, ERuntimePCMStorageFormat::Float32);
 			FSoundWaveBasicStruct SoundWaveBasicInfo;
 			{
 				SoundWaveBasicInfo.NumOfChannels = NumChannels;
@@ -178,17 +531,21 @@ bool UImportedSoundWave::InitAudioResource(FName Format)
 		}
 	}
 
-	FVORBIS_RuntimeCodec VorbisCodec;
-	FEncodedAudioStruct EncodedAudioInfo;
-	if (!VorbisCodec.Encode(MoveTemp(DecodedAudioInfo), EncodedAudioInfo, 100))
+	if (!CompressedData.IsValid())
 	{
-		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Something went wrong while encoding Vorbis audio data"));
-		return false;
+		CompressedData = Cache->GetOrEncodeCompressedData(Revision, MoveTemp(DecodedAudioInfo));
+		if (!CompressedData.IsValid() || CompressedData->Num() <= 0)
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Something went wrong while encoding Vorbis audio data"));
+			return false;
+		}
 	}
 
-	if (EncodedAudioInfo.AudioData.GetView().Num() <= 0)
+	// The PCM data has changed since the audio resource was initialized, so the outdated resource has to be removed first
+	if (bHasAudioResource)
 	{
-		return false;
+		UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Replacing the outdated audio resource of the sound wave '%s'"), *GetName());
+		RemoveAudioResource();
 	}
 
 	FByteBulkData CompressedBulkData;
@@ -196,24 +553,33 @@ bool UImportedSoundWave::InitAudioResource(FName Format)
 	// Filling in the compressed data
 	{
 		CompressedBulkData.Lock(LOCK_READ_WRITE);
-		FMemory::Memcpy(CompressedBulkData.Realloc(EncodedAudioInfo.AudioData.GetView().Num()), EncodedAudioInfo.AudioData.GetView().GetData(), EncodedAudioInfo.AudioData.GetView().Num());
+		FMemory::Memcpy(CompressedBulkData.Realloc(CompressedData->Num()), CompressedData->GetData(), CompressedData->Num());
 		CompressedBulkData.Unlock();
 	}
 
 	USoundWave::InitAudioResource(CompressedBulkData);
+	AudioResourceRevision = Revision;
 	return true;
 }
 
 bool UImportedSoundWave::IsSeekable() const
 {
 	FRAIScopeLock Lock(&*DataGuard);
-	return PCMBufferInfo.IsValid() && PCMBufferInfo.Get()->PCMData.GetView().Num() > 0 && PCMBufferInfo.Get()->PCMNumOfFrames > 0;
+	return PCMBufferInfo.IsValid() && PCMBufferInfo.Get()->IsValid();
 }
 #endif
 
 int32 UImportedSoundWave::OnGeneratePCMAudio(TArray<uint8>& OutAudio, int32 NumSamples)
 {
-	float* RetrievedPCMDataPtr;
+	const bool IsBound = [this]()
+	{
+		FRAIScopeLock Lock(&OnGeneratePCMData_DataGuard);
+		return OnGeneratePCMDataNative.IsBound() || OnGeneratePCMData.IsBound();
+	}();
+
+	const bool bHasSubscriptions = HasAudioSubscriptions();
+
+	FImportedSoundWaveAudioChunkPtr Chunk;
 	{
 		FRAIScopeLock Lock(&*DataGuard);
 
@@ -222,48 +588,108 @@ int32 UImportedSoundWave::OnGeneratePCMAudio(TArray<uint8>& OutAudio, int32 NumS
 			return 0;
 		}
 
+		// The playhead is a position in the PCM data, and when playing in reverse the frames preceding it remain to be played
+		const int64 PlaybackFrame = GetNumOfPlayedFrames_Internal();
+		const int64 NumOfRemainingFrames = bReversePlayback ? PlaybackFrame : static_cast<int64>(PCMBufferInfo->PCMNumOfFrames) - PlaybackFrame;
+
 		// Ensure there is enough number of frames. Lack of frames means audio playback has finished
-		if (GetNumOfPlayedFrames_Internal() >= PCMBufferInfo->PCMNumOfFrames)
+		if (NumOfRemainingFrames <= 0)
 		{
 			return 0;
 		}
 
 		// Getting the remaining number of samples if the required number of samples is greater than the total available number
-		if (GetNumOfPlayedFrames_Internal() + (static_cast<uint32>(NumSamples) / static_cast<uint32>(NumChannels)) >= PCMBufferInfo->PCMNumOfFrames)
+		if (static_cast<int64>(NumSamples / NumChannels) >= NumOfRemainingFrames)
 		{
-			NumSamples = (PCMBufferInfo->PCMNumOfFrames - GetNumOfPlayedFrames_Internal()) * NumChannels;
+			NumSamples = static_cast<int32>(NumOfRemainingFrames * NumChannels);
 		}
 
-		// Retrieving a part of PCM data
-		RetrievedPCMDataPtr = PCMBufferInfo->PCMData.GetView().GetData() + (GetNumOfPlayedFrames_Internal() * NumChannels);
-		const int32 RetrievedPCMDataSize = NumSamples * sizeof(float);
+		// Retrieving a part of PCM data. When playing in reverse, the block preceding the playhead is read and then reversed
+		const int64 SampleIndex = bReversePlayback
+			? PlaybackFrame * NumChannels - NumSamples
+			: PlaybackFrame * NumChannels;
 
 		// Ensure we got a valid PCM data
-		if (RetrievedPCMDataSize <= 0 || !RetrievedPCMDataPtr)
+		if (NumSamples <= 0 || SampleIndex < 0 || SampleIndex + NumSamples > PCMBufferInfo->GetNumOfSamples())
 		{
 			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to get PCM audio from imported sound wave since the retrieved PCM data is invalid"));
 			return 0;
 		}
 
-		// Filling in OutAudio array with the retrieved PCM data
-		OutAudio = TArray<uint8>(reinterpret_cast<uint8*>(RetrievedPCMDataPtr), RetrievedPCMDataSize);
+		// Filling in OutAudio array with the retrieved PCM data in the format reported to the audio mixer (see GetGeneratedPCMDataFormat). Converted only if the PCM data is stored in a different format
+		if (PCMStorageFormat == ERuntimePCMStorageFormat::Int16)
+		{
+			OutAudio.SetNumUninitialized(NumSamples * sizeof(int16));
+			int16* OutPCMData = reinterpret_cast<int16*>(OutAudio.GetData());
+			if (PCMBufferInfo->GetStorageFormat() == ERuntimePCMStorageFormat::Int16)
+			{
+				FMemory::Memcpy(OutPCMData, PCMBufferInfo->PCMDataInt16.GetView().GetData() + SampleIndex, NumSamples * sizeof(int16));
+			}
+			else
+			{
+				FRAW_RuntimeCodec::ConvertFloatToInt16(PCMBufferInfo->PCMData.GetView().GetData() + SampleIndex, OutPCMData, NumSamples);
+			}
+
+			if (bReversePlayback)
+			{
+				FRAW_RuntimeCodec::ReverseFrames(OutPCMData, NumSamples / NumChannels, NumChannels);
+			}
+		}
+		else
+		{
+			OutAudio.SetNumUninitialized(NumSamples * sizeof(float));
+			FRAW_RuntimeCodec::CopyPCMDataAsFloat(*PCMBufferInfo, SampleIndex, NumSamples, reinterpret_cast<float*>(OutAudio.GetData()));
+
+			if (bReversePlayback)
+			{
+				FRAW_RuntimeCodec::ReverseFrames(reinterpret_cast<float*>(OutAudio.GetData()), NumSamples / NumChannels, NumChannels);
+			}
+		}
+
+		if (SpectrumAnalyzer.IsValid())
+		{
+			if (PCMStorageFormat == ERuntimePCMStorageFormat::Int16)
+			{
+				SpectrumAnalyzer->PushFrames(reinterpret_cast<const int16*>(OutAudio.GetData()), NumSamples / NumChannels, NumChannels, GetSampleRate());
+			}
+			else
+			{
+				SpectrumAnalyzer->PushFrames(reinterpret_cast<const float*>(OutAudio.GetData()), NumSamples / NumChannels, NumChannels, GetSampleRate());
+			}
+		}
+
+		// A single chunk is shared by the delegates and all audio subscriptions
+		if (IsBound || bHasSubscriptions)
+		{
+			float* ChunkPCMData = static_cast<float*>(FMemory::Malloc(NumSamples * sizeof(float)));
+			if (PCMStorageFormat == ERuntimePCMStorageFormat::Float32)
+			{
+				FMemory::Memcpy(ChunkPCMData, OutAudio.GetData(), NumSamples * sizeof(float));
+			}
+			else
+			{
+				FRAW_RuntimeCodec::CopyPCMDataAsFloat(*PCMBufferInfo, SampleIndex, NumSamples, ChunkPCMData);
+				if (bReversePlayback)
+				{
+					FRAW_RuntimeCodec::ReverseFrames(ChunkPCMData, NumSamples / NumChannels, NumChannels);
+				}
+			}
+			Chunk = MakeShared<const FImportedSoundWaveAudioChunk, ESPMode::ThreadSafe>(FRuntimeBulkDataBuffer<float>(ChunkPCMData, NumSamples), static_cast<uint32>(GetSampleRate()), static_cast<uint32>(NumChannels), static_cast<int64>(GetNumOfPlayedFrames_Internal()));
+		}
 
-		// Increasing the number of frames played
-		SetNumOfPlayedFrames_Internal(GetNumOfPlayedFrames_Internal() + (NumSamples / NumChannels));
+		// Moving the playhead in the playback direction
+		SetNumOfPlayedFrames_Internal(static_cast<uint32>(bReversePlayback ? PlaybackFrame - NumSamples / NumChannels : PlaybackFrame + NumSamples / NumChannels));
 	}
 
-	const bool IsBound = [this]()
-	{
-		FRAIScopeLock Lock(&OnGeneratePCMData_DataGuard);
-		return OnGeneratePCMDataNative.IsBound() || OnGeneratePCMData.IsBound();
-	}();
+	DeliverAudioChunk(ERuntimeAudioSubscriptionSource::Generated, Chunk);
+
 	if (IsBound)
 	{
-		TArray<float> PCMData(RetrievedPCMDataPtr, NumSamples);
-		AsyncTask(ENamedThreads::AnyBackgroundHiPriTask, [WeakThis = MakeWeakObjectPtr(this), PCMData = MoveTemp(PCMData)]() mutable
+		AsyncTask(ENamedThreads::AnyBackgroundHiPriTask, [WeakThis = MakeWeakObjectPtr(this), Chunk]()
 		{
 			if (WeakThis.IsValid())
 			{
+				const TArray<float> PCMData(Chunk->PCMData.GetView().GetData(), static_cast<int32>(Chunk->PCMData.GetView().Num()));
 				FRAIScopeLock Lock(&WeakThis->OnGeneratePCMData_DataGuard);
 				if (WeakThis->OnGeneratePCMDataNative.IsBound())
 				{
@@ -294,13 +720,112 @@ void UImportedSoundWave::BeginDestroy()
 												"If it's not intended, make sure to keep a hard reference to the sound wave (e.g. by adding it to a UPROPERTY, variable in Blueprint, etc.)"), *GetName());
 	}
 
+	DisableSpectrumAnalysis();
+
 	Super::BeginDestroy();
 }
 
+bool UImportedSoundWave::EnableSpectrumAnalysis(const FRuntimeAudioSpectrumSettings& Settings)
+{
+	if (Settings.FFTSize <= 0 || Settings.HopSize <= 0 || Settings.NumOfBands <= 0)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to enable spectrum analysis for sound wave '%s' because the settings are invalid (FFT size: %d, hop size: %d, number of bands: %d)"),
+		       *GetName(), Settings.FFTSize, Settings.HopSize, Settings.NumOfBands);
+		return false;
+	}
+
+	DisableSpectrumAnalysis();
+
+	TSharedPtr<FRuntimeAudioSpectrumAnalyzer, ESPMode::ThreadSafe> Analyzer = MakeShared<FRuntimeAudioSpectrumAnalyzer, ESPMode::ThreadSafe>(Settings);
+
+	// Logging the sanitized settings before publishing the analyzer, as it may be disabled from another thread as soon as the locks are released
+	const FRuntimeAudioSpectrumSettings& AnalyzerSettings = Analyzer->GetSettings();
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Enabled spectrum analysis for sound wave '%s' (FFT size: %d, hop size: %d, number of bands: %d)"),
+	       *GetName(), AnalyzerSettings.FFTSize, AnalyzerSettings.HopSize, AnalyzerSettings.NumOfBands);
+
+	{
+		FRAIScopeLock Lock(&*DataGuard);
+		FRAIScopeLock AnalyzerLock(&SpectrumAnalyzer_DataGuard);
+		SpectrumAnalyzer = MoveTemp(Analyzer);
+	}
+
+	return true;
+}
+
+void UImportedSoundWave::DisableSpectrumAnalysis()
+{
+	TSharedPtr<FRuntimeAudioSpectrumAnalyzer, ESPMode::ThreadSafe> Analyzer;
+	{
+		FRAIScopeLock Lock(&*DataGuard);
+		FRAIScopeLock AnalyzerLock(&SpectrumAnalyzer_DataGuard);
+		Analyzer = MoveTemp(SpectrumAnalyzer);
+		SpectrumAnalyzer.Reset();
+	}
+
+	// Joining the worker outside of the locks so that rendering is not blocked meanwhile
+	if (Analyzer.IsValid())
+	{
+		Analyzer->StopAndWait();
+	}
+}
+
+bool UImportedSoundWave::IsSpectrumAnalysisEnabled() const
+{
+	return GetSpectrumAnalyzer().IsValid();
+}
+
+bool UImportedSoundWave::GetSpectrum(FRuntimeAudioSpectrum& OutSpectrum) const
+{
+	const TSharedPtr<FRuntimeAudioSpectrumAnalyzer, ESPMode::ThreadSafe> Analyzer = GetSpectrumAnalyzer();
+	return Analyzer.IsValid() && Analyzer->GetLatestSpectrum(OutSpectrum);
+}
+
+TSharedPtr<FRuntimeAudioSpectrumAnalyzer, ESPMode::ThreadSafe> UImportedSoundWave::GetSpectrumAnalyzer() const
+{
+	FRAIScopeLock Lock(&SpectrumAnalyzer_DataGuard);
+	return SpectrumAnalyzer;
+}
+
+void UImportedSoundWave::OnBeginGenerate()
+{
+	Super::OnBeginGenerate();
+	++NumOfActivePlaybacks;
+}
+
+void UImportedSoundWave::OnEndGenerate()
+{
+	Super::OnEndGenerate();
+	EndActivePlayback();
+}
+
+#if WITH_RUNTIMEAUDIOIMPORTER_PLAYBACK_INSTANCE_GENERATOR_SUPPORT
+void UImportedSoundWave::OnEndGenerate(ISoundGeneratorPtr Generator)
+{
+	Super::OnEndGenerate(Generator);
+	EndActivePlayback();
+}
+#endif
+
+void UImportedSoundWave::EndActivePlayback()
+{
+	// Never going below zero in case the audio mixer ends generating audio without having begun it
+	int32 ExpectedNumOfActivePlaybacks = NumOfActivePlaybacks.load(std::memory_order_relaxed);
+	while (ExpectedNumOfActivePlaybacks > 0 && !NumOfActivePlaybacks.compare_exchange_weak(ExpectedNumOfActivePlaybacks, ExpectedNumOfActivePlaybacks - 1))
+	{
+	}
+}
+
 void UImportedSoundWave::Parse(FAudioDevice* AudioDevice, const UPTRINT NodeWaveInstanceHash, FActiveSound& ActiveSound, const FSoundParseParameters& ParseParams, TArray<FWaveInstance*>& WaveInstances)
 {
 	FRAIScopeLock Lock(&*DataGuard);
 
+	// Every playback has its own playback instance, so there is no shared playback state to track
+	if (bPlaybackInstancing)
+	{
+		Super::Parse(AudioDevice, NodeWaveInstanceHash, ActiveSound, ParseParams, WaveInstances);
+		return;
+	}
+
 	if (ActiveSound.PlaybackTime == 0 && ActiveSound.PlaybackTime != ParseParams.StartTime)
 	{
 		UE_LOG(LogRuntimeAudioImporter, Log, TEXT("The playback time for the sound wave '%s' will be set to '%f'"), *GetName(), ParseParams.StartTime);
@@ -361,8 +886,8 @@ void UImportedSoundWave::Parse(FAudioDevice* AudioDevice, const UPTRINT NodeWave
 		else
 		{
 			UE_LOG(LogRuntimeAudioImporter, Log, TEXT("The sound wave '%s' will be looped"), *GetName());
-			ActiveSound.PlaybackTime = 0.f;
-			RewindPlaybackTime_Internal(0.f);
+			SetNumOfPlayedFrames_Internal(bReversePlayback ? PCMBufferInfo->PCMNumOfFrames : 0);
+			ActiveSound.PlaybackTime = GetPlaybackTime_Internal();
 		}
 	}
 
@@ -392,7 +917,10 @@ void UImportedSoundWave::PopulateAudioDataFromDecodedInfo(FDecodedAudioStruct&&
 	ImportedAudioFormat = DecodedAudioInfo.SoundWaveBasicInfo.AudioFormat;
 
 	PCMBufferInfo->PCMData = MoveTemp(DecodedAudioInfo.PCMInfo.PCMData);
+	PCMBufferInfo->PCMDataInt16 = MoveTemp(DecodedAudioInfo.PCMInfo.PCMDataInt16);
 	PCMBufferInfo->PCMNumOfFrames = DecodedAudioInfo.PCMInfo.PCMNumOfFrames;
+	FRAW_RuntimeCodec::ConvertPCMStorageFormat(*PCMBufferInfo, PCMStorageFormat);
+	OnPCMDataChanged_Internal();
 
 	{
 		const bool IsBound = [this]()
@@ -400,28 +928,25 @@ void UImportedSoundWave::PopulateAudioDataFromDecodedInfo(FDecodedAudioStruct&&
 			FRAIScopeLock Lock(&OnPopulateAudioData_DataGuard);
 			return OnPopulateAudioDataNative.IsBound() || OnPopulateAudioData.IsBound();
 		}();
-		if (IsBound)
+		if (IsBound || HasAudioSubscriptions())
 		{
-			TArray<float> PCMData(PCMBufferInfo->PCMData.GetView().GetData(), PCMBufferInfo->PCMData.GetView().Num());
-			AsyncTask(ENamedThreads::AnyBackgroundHiPriTask, [WeakThis = MakeWeakObjectPtr(this), PCMData = MoveTemp(PCMData)]() mutable
+			// 32-bit float PCM data is referenced through the immutable snapshot instead of being copied
+			FRuntimeBulkDataBuffer<float> ChunkPCMData;
+			if (PCMBufferInfo->GetStorageFormat() == ERuntimePCMStorageFormat::Float32 && GetPCMSnapshot_Internal().IsValid())
 			{
-				if (WeakThis.IsValid())
-				{
-					FRAIScopeLock Lock(&WeakThis->OnPopulateAudioData_DataGuard);
-					if (WeakThis->OnPopulateAudioDataNative.IsBound())
-					{
-						WeakThis->OnPopulateAudioDataNative.Broadcast(PCMData);
-					}
-					if (WeakThis->OnPopulateAudioData.IsBound())
-					{
-						WeakThis->OnPopulateAudioData.Broadcast(PCMData);
-					}
-				}
-				else
-				{
-					UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Unable to broadcast OnPopulateAudioDataNative and OnPopulateAudioData delegates because the streaming sound wave has been destroyed"));
-				}
-			});
+				ChunkPCMData = FRuntimeBulkDataBuffer<float>(const_cast<float*>(PCMSnapshot->PCMData.GetView().GetData()), PCMSnapshot->PCMData.GetView().Num(), ConstCastSharedPtr<FPCMStruct>(PCMSnapshot));
+			}
+			else
+			{
+				const int64 NumOfSamples = PCMBufferInfo->GetNumOfSamples();
+				float* PCMData = static_cast<float*>(FMemory::Malloc(NumOfSamples * sizeof(float)));
+				FRAW_RuntimeCodec::CopyPCMDataAsFloat(*PCMBufferInfo, 0, NumOfSamples, PCMData);
+				ChunkPCMData = FRuntimeBulkDataBuffer<float>(PCMData, NumOfSamples);
+			}
+
+			const FImportedSoundWaveAudioChunkPtr Chunk = MakeShared<const FImportedSoundWaveAudioChunk, ESPMode::ThreadSafe>(MoveTemp(ChunkPCMData), static_cast<uint32>(GetSampleRate()), static_cast<uint32>(NumChannels), 0);
+			DeliverAudioChunk(ERuntimeAudioSubscriptionSource::Populated, Chunk);
+			BroadcastPopulatedAudioChunk(Chunk);
 		}
 	}
 
@@ -471,40 +996,251 @@ void UImportedSoundWave::PrepareSoundWaveForMetaSounds(const FOnPrepareSoundWave
 		});
 		return;
 	}
-	
-	auto ExecuteResult = [Result](bool bSucceeded)
-	{
-		AsyncTask(ENamedThreads::AnyBackgroundHiPriTask, [Result, bSucceeded]()
-		{
-			Result.ExecuteIfBound(bSucceeded);
-		});
-	};
+	
+	auto ExecuteResult = [Result](bool bSucceeded)
+	{
+		AsyncTask(ENamedThreads::AnyBackgroundHiPriTask, [Result, bSucceeded]()
+		{
+			Result.ExecuteIfBound(bSucceeded);
+		});
+	};
+
+	const bool bSucceeded = InitAudioResource(Audio::NAME_OGG);
+	if (bSucceeded)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully prepared the sound wave '%s' for MetaSounds"), *GetName());
+	}
+	else
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to initialize audio resource to prepare the sound wave '%s' for MetaSounds"), *GetName());
+	}
+
+	ExecuteResult(bSucceeded);
+		
+#else
+	UE_LOG(LogRuntimeAudioImporter, Error, TEXT("PrepareSoundWaveForMetaSounds works only for Unreal Engine version >= 5.3 and if explicitly enabled in RuntimeAudioImporter.Build.cs"));
+	Result.ExecuteIfBound(false);
+#endif
+}
+
+bool UImportedSoundWave::SetPrecacheCompressedAudio(bool bPrecache)
+{
+#if WITH_RUNTIMEAUDIOIMPORTER_METASOUND_SUPPORT
+	{
+		FRAIScopeLock Lock(&*DataGuard);
+		bPrecacheCompressedAudio = bPrecache;
+	}
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Precaching of compressed audio data for the sound wave '%s' has been %s"), *GetName(), bPrecache ? TEXT("enabled") : TEXT("disabled"));
+
+	if (bPrecache)
+	{
+		PrecacheCompressedAudio();
+	}
+	return true;
+#else
+	UE_LOG(LogRuntimeAudioImporter, Error, TEXT("SetPrecacheCompressedAudio works only for Unreal Engine version >= 5.3 and if explicitly enabled in RuntimeAudioImporter.Build.cs"));
+	return false;
+#endif
+}
+
+void UImportedSoundWave::SetCompressedAudioDiskCacheEnabled(bool bEnabled, int64 MaxSizeInMegabytes)
+{
+	FRuntimeCompressedAudioCache::SetDiskCacheMaxSize(MaxSizeInMegabytes * 1024 * 1024);
+	FRuntimeCompressedAudioCache::SetDiskCacheEnabled(bEnabled);
+}
+
+void UImportedSoundWave::OnPCMDataChanged_Internal(bool bAppended)
+{
+	PCMSource->SampleRate = GetSampleRate();
+	PCMSource->NumOfChannels = GetNumOfChannels();
+	++PCMSource->Revision;
+	PCMSnapshot.Reset();
+	if (!bAppended)
+	{
+		++PCMDataGeneration;
+	}
+	UpdateWaveform_Internal(bAppended);
+
+	// The cache shared with a duplicated sound wave still matches the PCM data of the other one, so this sound wave detaches from it instead of invalidating it
+	if (CompressedAudioCache.GetSharedReferenceCount() > 1)
+	{
+		CompressedAudioCache = MakeShared<FRuntimeCompressedAudioCache, ESPMode::ThreadSafe>();
+	}
+	else
+	{
+		CompressedAudioCache->Invalidate();
+	}
+
+	if (bPrecacheCompressedAudio)
+	{
+		// Appends usually come in a stream of small chunks, so precaching is postponed until they stop instead of encoding everything again after every chunk
+		if (bAppended)
+		{
+			SchedulePrecacheCompressedAudio_Internal();
+		}
+		else
+		{
+			PrecacheCompressedAudio();
+		}
+	}
+}
+
+void UImportedSoundWave::SchedulePrecacheCompressedAudio_Internal()
+{
+#if WITH_RUNTIMEAUDIOIMPORTER_METASOUND_SUPPORT
+	LastPCMAppendTime = FPlatformTime::Seconds();
+	if (bPrecacheScheduled)
+	{
+		return;
+	}
+	bPrecacheScheduled = true;
+
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakThis = MakeWeakObjectPtr(this)](float DeltaTime)
+	{
+		if (!WeakThis.IsValid())
+		{
+			return false;
+		}
+
+		{
+			FRAIScopeLock Lock(&*WeakThis->DataGuard);
+
+			// Frames are still being appended, check again later
+			if (FPlatformTime::Seconds() - WeakThis->LastPCMAppendTime < PrecacheAppendSettleTime)
+			{
+				return true;
+			}
+			WeakThis->bPrecacheScheduled = false;
+			if (!WeakThis->bPrecacheCompressedAudio)
+			{
+				return false;
+			}
+		}
+
+		WeakThis->PrecacheCompressedAudio();
+		return false;
+	}), PrecacheAppendSettleTime);
+#endif
+}
+
+void UImportedSoundWave::UpdateWaveform_Internal(bool bAppended)
+{
+	const uint32 NumOfChannels = static_cast<uint32>(FMath::Max<int32>(NumChannels, 1));
+	const int64 NumOfFrames = PCMBufferInfo->PCMNumOfFrames;
+	if (!bAppended || WaveformPyramid.GetNumOfChannels() != NumOfChannels || WaveformPyramid.GetNumOfFrames() > NumOfFrames)
+	{
+		WaveformPyramid.Reset(NumOfChannels);
+	}
+
+	int64 FrameIndex = WaveformPyramid.GetNumOfFrames();
+	if (FrameIndex >= NumOfFrames || PCMBufferInfo->GetNumOfSamples() < NumOfFrames * NumOfChannels)
+	{
+		return;
+	}
+
+	if (PCMBufferInfo->GetStorageFormat() == ERuntimePCMStorageFormat::Float32)
+	{
+		WaveformPyramid.AppendFrames(PCMBufferInfo->PCMData.GetView().GetData() + FrameIndex * NumOfChannels, NumOfFrames - FrameIndex);
+		return;
+	}
 
-	const bool bSucceeded = InitAudioResource(Audio::NAME_OGG);
-	if (bSucceeded)
+	// PCM data stored in another format is converted block by block
+	constexpr int64 NumOfFramesPerBlock = 16384;
+	TArray<float> BlockPCMData;
+	while (FrameIndex < NumOfFrames)
 	{
-		UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully prepared the sound wave '%s' for MetaSounds"), *GetName());
+		const int64 NumOfBlockFrames = FMath::Min(NumOfFramesPerBlock, NumOfFrames - FrameIndex);
+		BlockPCMData.SetNumUninitialized(static_cast<int32>(NumOfBlockFrames * NumOfChannels));
+		FRAW_RuntimeCodec::CopyPCMDataAsFloat(*PCMBufferInfo, FrameIndex * NumOfChannels, NumOfBlockFrames * NumOfChannels, BlockPCMData.GetData());
+		WaveformPyramid.AppendFrames(BlockPCMData.GetData(), NumOfBlockFrames);
+		FrameIndex += NumOfBlockFrames;
 	}
-	else
+}
+
+bool UImportedSoundWave::GetWaveformPeaks(float StartTime, float EndTime, int32 NumOfPeaks, TArray<FRuntimeAudioWaveformPeak>& OutPeaks) const
+{
+	FRAIScopeLock Lock(&*DataGuard);
+
+	if (NumOfPeaks <= 0 || WaveformPyramid.GetNumOfFrames() <= 0)
 	{
-		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to initialize audio resource to prepare the sound wave '%s' for MetaSounds"), *GetName());
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to get waveform peaks for the imported sound wave '%s' as %s"), *GetName(), NumOfPeaks <= 0 ? TEXT("the number of peaks is invalid") : TEXT("the PCM data is empty"));
+		OutPeaks.Reset();
+		return false;
 	}
 
-	ExecuteResult(bSucceeded);
-		
-#else
-	UE_LOG(LogRuntimeAudioImporter, Error, TEXT("PrepareSoundWaveForMetaSounds works only for Unreal Engine version >= 5.3 and if explicitly enabled in RuntimeAudioImporter.Build.cs"));
-	Result.ExecuteIfBound(false);
-#endif
+	const int64 StartFrame = FMath::Max<int64>(static_cast<int64>(StartTime * SampleRate), 0);
+	const int64 EndFrame = EndTime > 0 ? static_cast<int64>(EndTime * SampleRate) : WaveformPyramid.GetNumOfFrames();
+	WaveformPyramid.GetPeaks(StartFrame, EndFrame, NumOfPeaks, OutPeaks);
+	return true;
+}
+
+void UImportedSoundWave::PrecacheCompressedAudio()
+{
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakThis = MakeWeakObjectPtr(this)]()
+	{
+		if (!WeakThis.IsValid())
+		{
+			return;
+		}
+
+		TSharedPtr<FRuntimeCompressedAudioCache, ESPMode::ThreadSafe> Cache;
+		uint64 Revision;
+		FImportedSoundWavePCMSnapshotPtr Snapshot;
+		FDecodedAudioStruct DecodedAudioInfo;
+		{
+			FRAIScopeLock Lock(&*WeakThis->DataGuard);
+
+			Cache = WeakThis->CompressedAudioCache;
+			Revision = Cache->GetRevision();
+
+			// Already cached (e.g. by a previous precache request or a duplicated sound wave) or there is nothing to compress
+			if (Cache->GetCompressedData(Revision).IsValid() || !WeakThis->PCMBufferInfo->IsValid())
+			{
+				return;
+			}
+
+			// Referencing the immutable snapshot instead of copying the PCM data while holding the lock
+			Snapshot = WeakThis->GetPCMSnapshot_Internal();
+			if (!Snapshot.IsValid())
+			{
+				return;
+			}
+			DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels = WeakThis->NumChannels;
+			DecodedAudioInfo.SoundWaveBasicInfo.SampleRate = WeakThis->GetSampleRate();
+			DecodedAudioInfo.SoundWaveBasicInfo.Duration = WeakThis->Duration;
+		}
+
+		if (Snapshot->GetStorageFormat() == ERuntimePCMStorageFormat::Float32)
+		{
+			DecodedAudioInfo.PCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(const_cast<float*>(Snapshot->PCMData.GetView().GetData()), Snapshot->PCMData.GetView().Num(), ConstCastSharedPtr<FPCMStruct>(Snapshot));
+		}
+		else
+		{
+			DecodedAudioInfo.PCMInfo.PCMDataInt16 = FRuntimeBulkDataBuffer<int16>(const_cast<int16*>(Snapshot->PCMDataInt16.GetView().GetData()), Snapshot->PCMDataInt16.GetView().Num(), ConstCastSharedPtr<FPCMStruct>(Snapshot));
+			FRAW_RuntimeCodec::ConvertPCMStorageFormat(DecodedAudioInfo.PCMInfo, ERuntimePCMStorageFormat::Float32);
+		}
+		DecodedAudioInfo.PCMInfo.PCMNumOfFrames = Snapshot->PCMNumOfFrames;
+		Snapshot.Reset();
+
+		if (Cache->GetOrEncodeCompressedData(Revision, MoveTemp(DecodedAudioInfo)).IsValid())
+		{
+			UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully precached compressed audio data (revision: %llu)"), Revision);
+		}
+		else
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to precache compressed audio data (revision: %llu)"), Revision);
+		}
+	});
 }
 
 void UImportedSoundWave::ReleaseMemory()
 {
 	FRAIScopeLock Lock(&*DataGuard);
 	UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Releasing memory for the sound wave '%s'"), *GetName());
-	PCMBufferInfo->PCMData.Empty();
-	PCMBufferInfo->PCMNumOfFrames = 0;
+	PCMBufferInfo->Empty();
 	Duration = 0;
+	OnPCMDataChanged_Internal();
 }
 
 void UImportedSoundWave::SetLooping(bool bLoop)
@@ -562,7 +1298,7 @@ bool UImportedSoundWave::RewindPlaybackTime_Internal(float PlaybackTime)
 
 bool UImportedSoundWave::SetInitialDesiredSampleRate(int32 DesiredSampleRate)
 {
-	if (PCMBufferInfo->PCMData.GetView().Num() > 0)
+	if (PCMBufferInfo->GetNumOfSamples() > 0)
 	{
 		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to set the initial desired sample rate for the imported sound wave '%s' to '%d' because the PCM data has already been populated"), *GetName(), DesiredSampleRate);
 		return false;
@@ -582,7 +1318,7 @@ bool UImportedSoundWave::SetInitialDesiredSampleRate(int32 DesiredSampleRate)
 
 bool UImportedSoundWave::SetInitialDesiredNumOfChannels(int32 DesiredNumOfChannels)
 {
-	if (PCMBufferInfo->PCMData.GetView().Num() > 0)
+	if (PCMBufferInfo->GetNumOfSamples() > 0)
 	{
 		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to set the initial desired number of channels for the imported sound wave '%s' to '%d' because the PCM data has already been populated"), *GetName(), DesiredNumOfChannels);
 		return false;
@@ -600,6 +1336,34 @@ bool UImportedSoundWave::SetInitialDesiredNumOfChannels(int32 DesiredNumOfChanne
 	return true;
 }
 
+bool UImportedSoundWave::SetPCMStorageFormat(ERuntimePCMStorageFormat StorageFormat)
+{
+	FRAIScopeLock Lock(&*DataGuard);
+
+	if (PCMStorageFormat == StorageFormat)
+	{
+		return true;
+	}
+
+	PCMStorageFormat = StorageFormat;
+
+	// Releasing the snapshot so that it doesn't keep the PCM data in the previous format alive. The existing playback instances keep their own reference
+	PCMSnapshot.Reset();
+	++PCMSource->Revision;
+
+	// The PCM data itself does not change, so the compressed audio data stays valid
+	FRAW_RuntimeCodec::ConvertPCMStorageFormat(*PCMBufferInfo, PCMStorageFormat);
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully set the PCM storage format for the imported sound wave '%s' to '%s'"), *GetName(), *UEnum::GetValueAsString(StorageFormat));
+	return true;
+}
+
+ERuntimePCMStorageFormat UImportedSoundWave::GetPCMStorageFormat() const
+{
+	FRAIScopeLock Lock(&*DataGuard);
+	return PCMStorageFormat;
+}
+
 bool UImportedSoundWave::ResampleSoundWave(int32 NewSampleRate)
 {
 	if (NewSampleRate == GetSampleRate())
@@ -614,24 +1378,55 @@ bool UImportedSoundWave::ResampleSoundWave(int32 NewSampleRate)
 		return false;
 	}
 
-	FRAIScopeLock Lock(&*DataGuard);
+	return ProcessPCMData(NewSampleRate, GetNumOfChannels(), FOnProcessAudioDataProgressNative());
+}
+
+void UImportedSoundWave::ResampleSoundWaveAsync(int32 NewSampleRate, const FOnProcessAudioDataProgress& Progress, const FOnProcessAudioDataResult& Result)
+{
+	ResampleSoundWaveAsync(NewSampleRate, FOnProcessAudioDataProgressNative::CreateWeakLambda(this, [Progress](int32 Percentage)
+	{
+		Progress.ExecuteIfBound(Percentage);
+	}), FOnProcessAudioDataResultNative::CreateWeakLambda(this, [Result](bool bSucceeded)
+	{
+		Result.ExecuteIfBound(bSucceeded);
+	}));
+}
 
-	Audio::FAlignedFloatBuffer NewPCMData;
-	Audio::FAlignedFloatBuffer SourcePCMData = Audio::FAlignedFloatBuffer(PCMBufferInfo->PCMData.GetView().GetData(), PCMBufferInfo->PCMData.GetView().Num());
+void UImportedSoundWave::ResampleSoundWaveAsync(int32 NewSampleRate, const FOnProcessAudioDataProgressNative& Progress, const FOnProcessAudioDataResultNative& Result)
+{
+	auto ExecuteResult = [Result](bool bSucceeded)
+	{
+		AsyncTask(ENamedThreads::GameThread, [Result, bSucceeded]()
+		{
+			Result.ExecuteIfBound(bSucceeded);
+		});
+	};
 
-	if (!FRAW_RuntimeCodec::ResampleRAWData(SourcePCMData, GetNumOfChannels(), GetSampleRate(), NewSampleRate, NewPCMData))
+	if (NewSampleRate == GetSampleRate())
 	{
-		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to resample the imported sound wave '%s' from sample rate '%d' to sample rate '%d'"), *GetName(), GetSampleRate(), NewSampleRate);
-		return false;
+		UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Skipping resampling the imported sound wave '%s' because the new sample rate '%d' is the same as the current sample rate '%d'"), *GetName(), NewSampleRate, GetSampleRate());
+		ExecuteResult(true);
+		return;
 	}
 
-	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully resampled the imported sound wave '%s' from sample rate '%d' to sample rate '%d'"), *GetName(), GetSampleRate(), NewSampleRate);
-	SampleRate = NewSampleRate;
+	if (NewSampleRate <= 0)
 	{
-		PCMBufferInfo->PCMNumOfFrames = NewPCMData.Num() / GetNumOfChannels();
-		PCMBufferInfo->PCMData = FRuntimeBulkDataBuffer<float>(NewPCMData);
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to resample the imported sound wave '%s' to sample rate '%d' because the sample rate must be greater than zero"), *GetName(), NewSampleRate);
+		ExecuteResult(false);
+		return;
 	}
-	return true;
+
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakThis = MakeWeakObjectPtr(this), NewSampleRate, Progress, ExecuteResult]()
+	{
+		if (!WeakThis.IsValid())
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to resample the imported sound wave because it has been destroyed"));
+			ExecuteResult(false);
+			return;
+		}
+
+		ExecuteResult(WeakThis->ProcessPCMData(NewSampleRate, WeakThis->GetNumOfChannels(), Progress));
+	});
 }
 
 bool UImportedSoundWave::MixSoundWaveChannels(int32 NewNumOfChannels)
@@ -648,24 +1443,177 @@ bool UImportedSoundWave::MixSoundWaveChannels(int32 NewNumOfChannels)
 		return false;
 	}
 
-	FRAIScopeLock Lock(&*DataGuard);
+	return ProcessPCMData(GetSampleRate(), NewNumOfChannels, FOnProcessAudioDataProgressNative());
+}
+
+void UImportedSoundWave::MixSoundWaveChannelsAsync(int32 NewNumOfChannels, const FOnProcessAudioDataProgress& Progress, const FOnProcessAudioDataResult& Result)
+{
+	MixSoundWaveChannelsAsync(NewNumOfChannels, FOnProcessAudioDataProgressNative::CreateWeakLambda(this, [Progress](int32 Percentage)
+	{
+		Progress.ExecuteIfBound(Percentage);
+	}), FOnProcessAudioDataResultNative::CreateWeakLambda(this, [Result](bool bSucceeded)
+	{
+		Result.ExecuteIfBound(bSucceeded);
+	}));
+}
 
-	Audio::FAlignedFloatBuffer NewPCMData;
-	Audio::FAlignedFloatBuffer SourcePCMData = Audio::FAlignedFloatBuffer(PCMBufferInfo->PCMData.GetView().GetData(), PCMBufferInfo->PCMData.GetView().Num());
+void UImportedSoundWave::MixSoundWaveChannelsAsync(int32 NewNumOfChannels, const FOnProcessAudioDataProgressNative& Progress, const FOnProcessAudioDataResultNative& Result)
+{
+	auto ExecuteResult = [Result](bool bSucceeded)
+	{
+		AsyncTask(ENamedThreads::GameThread, [Result, bSucceeded]()
+		{
+			Result.ExecuteIfBound(bSucceeded);
+		});
+	};
 
-	if (!FRAW_RuntimeCodec::MixChannelsRAWData(SourcePCMData, GetSampleRate(), GetNumOfChannels(), NewNumOfChannels, NewPCMData))
+	if (NewNumOfChannels == GetNumOfChannels())
 	{
-		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to mix the imported sound wave '%s' from number of channels '%d' to number of channels '%d'"), *GetName(), GetNumOfChannels(), NewNumOfChannels);
-		return false;
+		UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Skipping mixing the imported sound wave '%s' because the new number of channels '%d' is the same as the current number of channels '%d'"), *GetName(), NewNumOfChannels, GetNumOfChannels());
+		ExecuteResult(true);
+		return;
 	}
 
-	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully mixed the imported sound wave '%s' from number of channels '%d' to number of channels '%d'"), *GetName(), GetNumOfChannels(), NewNumOfChannels);
-	NumChannels = NewNumOfChannels;
+	if (NewNumOfChannels <= 0)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to mix the imported sound wave '%s' to number of channels '%d' because the number of channels must be greater than zero"), *GetName(), NewNumOfChannels);
+		ExecuteResult(false);
+		return;
+	}
+
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakThis = MakeWeakObjectPtr(this), NewNumOfChannels, Progress, ExecuteResult]()
+	{
+		if (!WeakThis.IsValid())
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to mix the imported sound wave because it has been destroyed"));
+			ExecuteResult(false);
+			return;
+		}
+
+		ExecuteResult(WeakThis->ProcessPCMData(WeakThis->GetSampleRate(), NewNumOfChannels, Progress));
+	});
+}
+
+bool UImportedSoundWave::ProcessPCMData(uint32 NewSampleRate, uint32 NewNumOfChannels, const FOnProcessAudioDataProgressNative& Progress)
+{
+	auto OnProgress = [&Progress](int32 Percentage)
+	{
+		if (Progress.IsBound())
+		{
+			AsyncTask(ENamedThreads::GameThread, [Progress, Percentage]()
+			{
+				Progress.ExecuteIfBound(Percentage);
+			});
+		}
+	};
+
+	for (int32 AttemptIndex = 0; AttemptIndex < MaxNumOfProcessAttempts; ++AttemptIndex)
 	{
-		PCMBufferInfo->PCMNumOfFrames = NewPCMData.Num() / GetNumOfChannels();
-		PCMBufferInfo->PCMData = FRuntimeBulkDataBuffer<float>(NewPCMData);
+		FImportedSoundWavePCMSnapshotPtr SourcePCMSnapshot;
+		uint64 SourcePCMDataGeneration;
+		uint32 SourceSampleRate;
+		uint32 SourceNumOfChannels;
+		ERuntimePCMStorageFormat StorageFormat;
+		{
+			FRAIScopeLock Lock(&*DataGuard);
+			SourcePCMSnapshot = GetPCMSnapshot_Internal();
+			SourcePCMDataGeneration = PCMDataGeneration;
+			SourceSampleRate = GetSampleRate();
+			SourceNumOfChannels = GetNumOfChannels();
+			StorageFormat = PCMStorageFormat;
+		}
+
+		if (!SourcePCMSnapshot.IsValid())
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to process the imported sound wave '%s' because the PCM data is empty"), *GetName());
+			return false;
+		}
+
+		// Converting the frames of the snapshot starting from the specified one, which are in the source format even if they were appended during processing
+		auto ConvertPCMFrames = [this, SourceSampleRate, SourceNumOfChannels, NewSampleRate, NewNumOfChannels](const FImportedSoundWavePCMSnapshotPtr& Snapshot, int64 StartFrame, ERuntimePCMStorageFormat InStorageFormat, TFunctionRef<void(int32)> OnConvertProgress, FPCMStruct& OutPCMInfo)
+		{
+			FRuntimePCMFormatConverter Converter(SourceSampleRate, SourceNumOfChannels, NewSampleRate, NewNumOfChannels);
+			if (!Converter.ConvertPCMData(SharePCMFrames(Snapshot, StartFrame, SourceNumOfChannels), OnConvertProgress, OutPCMInfo))
+			{
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to process the imported sound wave '%s' from sample rate '%d' and number of channels '%d' to sample rate '%d' and number of channels '%d'"), *GetName(), SourceSampleRate, SourceNumOfChannels, NewSampleRate, NewNumOfChannels);
+				return false;
+			}
+			FRAW_RuntimeCodec::ConvertPCMStorageFormat(OutPCMInfo, InStorageFormat);
+			return true;
+		};
+
+		// The snapshot is immutable, so it is processed without locking while the playback keeps reading from it
+		FPCMStruct NewPCMInfo;
+		if (!ConvertPCMFrames(SourcePCMSnapshot, 0, StorageFormat, OnProgress, NewPCMInfo))
+		{
+			return false;
+		}
+		int64 NumOfConvertedFrames = SourcePCMSnapshot->GetNumOfSamples() / SourceNumOfChannels;
+
+		// Frames appended during processing (e.g. by a streaming sound wave) are converted as well, which only takes a few rounds since there are far fewer of them
+		for (int32 RoundIndex = 0; ; ++RoundIndex)
+		{
+			FImportedSoundWavePCMSnapshotPtr AppendedPCMSnapshot;
+			{
+				FRAIScopeLock Lock(&*DataGuard);
+
+				// Any other change (e.g. importing or processing the audio data) invalidates everything converted so far
+				if (PCMDataGeneration != SourcePCMDataGeneration)
+				{
+					break;
+				}
+
+				const int64 NumOfFrames = PCMBufferInfo->GetNumOfSamples() / SourceNumOfChannels;
+				const bool bConvertUnderLock = RoundIndex >= MaxNumOfAppendedFramesRounds;
+				if (NumOfFrames > NumOfConvertedFrames && bConvertUnderLock)
+				{
+					FPCMStruct AppendedPCMInfo;
+					if (!ConvertPCMFrames(GetPCMSnapshot_Internal(), NumOfConvertedFrames, PCMStorageFormat, [](int32) {}, AppendedPCMInfo))
+					{
+						return false;
+					}
+					AppendPCMData(NewPCMInfo, MoveTemp(AppendedPCMInfo));
+					NumOfConvertedFrames = NumOfFrames;
+				}
+
+				if (NumOfFrames <= NumOfConvertedFrames)
+				{
+					// The storage format might have been changed during processing
+					FRAW_RuntimeCodec::ConvertPCMStorageFormat(NewPCMInfo, PCMStorageFormat);
+					ReplaceProcessedPCMData_Internal(MoveTemp(NewPCMInfo), NewSampleRate, NewNumOfChannels);
+					UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully processed the imported sound wave '%s' from sample rate '%d' and number of channels '%d' to sample rate '%d' and number of channels '%d'"), *GetName(), SourceSampleRate, SourceNumOfChannels, NewSampleRate, NewNumOfChannels);
+					return true;
+				}
+
+				AppendedPCMSnapshot = GetPCMSnapshot_Internal();
+				StorageFormat = PCMStorageFormat;
+			}
+
+			FPCMStruct AppendedPCMInfo;
+			if (!ConvertPCMFrames(AppendedPCMSnapshot, NumOfConvertedFrames, StorageFormat, [](int32) {}, AppendedPCMInfo))
+			{
+				return false;
+			}
+			AppendPCMData(NewPCMInfo, MoveTemp(AppendedPCMInfo));
+			NumOfConvertedFrames = AppendedPCMSnapshot->GetNumOfSamples() / SourceNumOfChannels;
+		}
+
+		UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("The PCM data of the imported sound wave '%s' has been changed during processing, processing it again"), *GetName());
 	}
-	return true;
+
+	UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to process the imported sound wave '%s' because its PCM data kept being changed during processing"), *GetName());
+	return false;
+}
+
+void UImportedSoundWave::ReplaceProcessedPCMData_Internal(FPCMStruct&& NewPCMInfo, uint32 NewSampleRate, uint32 NewNumOfChannels)
+{
+	// Keeping the playhead at the same time position
+	PlayedNumOfFrames = static_cast<uint32>(FMath::Min<uint64>(static_cast<uint64>(PlayedNumOfFrames) * NewSampleRate / FMath::Max<uint32>(GetSampleRate(), 1), NewPCMInfo.PCMNumOfFrames));
+
+	*PCMBufferInfo = MoveTemp(NewPCMInfo);
+	SampleRate = NewSampleRate;
+	NumChannels = NewNumOfChannels;
+	OnPCMDataChanged_Internal();
 }
 
 void UImportedSoundWave::StopPlayback(const UObject* WorldContextObject, const FOnStopPlaybackResult& Result)
@@ -764,18 +1712,19 @@ void UImportedSoundWave::ReverseAudioBuffer(const FOnReverseAudioDataNative& Res
 
 	FRAIScopeLock Lock(&*DataGuard);
 
-	if (PCMBufferInfo->PCMData.GetView().Num() <= 0)
+	if (PCMBufferInfo->GetNumOfSamples() <= 0)
 	{
 		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to reverse the audio buffer for the imported sound wave '%s' because the PCM data is empty"), *GetName());
 		ExecuteResult(false);
 		return;
 	}
 
-	Audio::FAlignedFloatBuffer PCMData = Audio::FAlignedFloatBuffer(PCMBufferInfo->PCMData.GetView().GetData(), PCMBufferInfo->PCMData.GetView().Num());
-	FRAW_RuntimeCodec::ReverseRAWData(PCMData);
+	Audio::FAlignedFloatBuffer PCMData = GetFloatPCMData(*PCMBufferInfo);
+	FRAW_RuntimeCodec::ReverseRAWData(PCMData, NumChannels);
 
 	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully reversed the audio buffer for the imported sound wave '%s'"), *GetName());
-	PCMBufferInfo->PCMData = FRuntimeBulkDataBuffer<float>(PCMData);
+	SetFloatPCMData(*PCMBufferInfo, PCMData, PCMStorageFormat);
+	OnPCMDataChanged_Internal();
 	ExecuteResult(true);
 }
 
@@ -880,70 +1829,20 @@ bool UImportedSoundWave::IsPlaybackFinished() const
 	return IsPlaybackFinished_Internal();
 }
 
-bool UImportedSoundWave::IsPlaying(const UObject* WorldContextObject) const
+bool UImportedSoundWave::IsPlaying() const
 {
-	// Audio device operations must be done on the audio thread
-	if (!IsInAudioThread())
-	{
-		TPromise<bool> PromiseResult;
-
-		Async(EAsyncExecution::TaskGraph, [WeakThis = MakeWeakObjectPtr(this), WorldContextObject, &PromiseResult]()
-		{
-			FAudioThread::RunCommandOnAudioThread( [WeakThis, WorldContextObject, &PromiseResult]()
-			{
-				if (WeakThis.IsValid())
-				{
-					PromiseResult.SetValue(WeakThis->IsPlaying(WorldContextObject));
-					return;
-				}
-				PromiseResult.SetValue(false);
-			});
-		}).Wait();
-
-		TFuture<bool> FutureResult = PromiseResult.GetFuture();
-
-		// This operation is very short-lasting, so it's fine to wait here, even if it's called from the game thread every frame
-		FutureResult.Wait();
-		return FutureResult.Get();
-	}
-
-	if (!GEngine)
-	{
-		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to check if the sound wave '%s' is playing because GEngine is invalid"), *GetName());
-		return false;
-	}
-
-	UWorld* ThisWorld = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
-	if (!ThisWorld)
-	{
-		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to check if the sound wave '%s' is playing because the world context object is invalid"), *GetName());
-		return false;
-	}
+	return GetNumOfActivePlaybacks() > 0;
+}
 
-#if UE_VERSION_OLDER_THAN(4, 25, 0)
-	if (FAudioDevice* AudioDevice = ThisWorld->GetAudioDevice())
-#else
-	if (FAudioDeviceHandle AudioDevice = ThisWorld->GetAudioDevice())
-#endif
-	{
-		const TArray<FActiveSound*>& ActiveSounds = AudioDevice->GetActiveSounds();
-		for (FActiveSound* ActiveSoundPtr : ActiveSounds)
-		{
-			if (ActiveSoundPtr->GetSound() == this && ActiveSoundPtr->IsPlayingAudio())
-			{
-				UE_LOG(LogRuntimeAudioImporter, Log, TEXT("The sound wave '%s' is playing by the owner '%s' and audio component '%s'"), *GetName(), *ActiveSoundPtr->GetOwnerName(), *ActiveSoundPtr->GetAudioComponentName());
-				return true;
-			}
-		}
-	}
-	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("The sound wave '%s' is not playing"), *GetName());
-	return false;
+int32 UImportedSoundWave::GetNumOfActivePlaybacks() const
+{
+	return NumOfActivePlaybacks.load(std::memory_order_relaxed);
 }
 
 bool UImportedSoundWave::IsPlaybackFinished_Internal() const
 {
-	// Are there enough frames for future playback from the current ones or not
-	const bool bOutOfFrames = GetNumOfPlayedFrames_Internal() >= PCMBufferInfo->PCMNumOfFrames;
+	// Are there enough frames for future playback from the current ones or not. When playing in reverse, the frames preceding the playhead remain to be played
+	const bool bOutOfFrames = bReversePlayback ? GetNumOfPlayedFrames_Internal() == 0 : GetNumOfPlayedFrames_Internal() >= PCMBufferInfo->PCMNumOfFrames;
 
 	// Is PCM data valid
 	const bool bValidPCMData = PCMBufferInfo.IsValid();
@@ -966,7 +1865,7 @@ bool UImportedSoundWave::GetAudioHeaderInfo(FRuntimeAudioHeaderInfo& HeaderInfo)
 		HeaderInfo.AudioFormat = GetAudioFormat();
 		HeaderInfo.SampleRate = GetSampleRate();
 		HeaderInfo.NumOfChannels = GetNumOfChannels();
-		HeaderInfo.PCMDataSize = PCMBufferInfo->PCMData.GetView().Num();
+		HeaderInfo.PCMDataSize = PCMBufferInfo->GetNumOfSamples();
 	}
 	
 	return true;
@@ -980,7 +1879,57 @@ void UImportedSoundWave::ResetPlaybackFinish()
 TArray<float> UImportedSoundWave::GetPCMBufferCopy()
 {
 	FRAIScopeLock Lock(&*DataGuard);
-	return TArray<float>(PCMBufferInfo.Get()->PCMData.GetView().GetData(), PCMBufferInfo.Get()->PCMData.GetView().Num());
+	TArray<float> PCMData;
+	PCMData.SetNumUninitialized(PCMBufferInfo->GetNumOfSamples());
+	FRAW_RuntimeCodec::CopyPCMDataAsFloat(*PCMBufferInfo, 0, PCMData.Num(), PCMData.GetData());
+	return PCMData;
+}
+
+TArray<float> UImportedSoundWave::GetPCMBufferRange(int64 StartFrame, int64 NumOfFrames, int32 ChannelIndex)
+{
+	FRAIScopeLock Lock(&*DataGuard);
+	const int64 NumOfFramesToRead = FImportedSoundWavePCMReadLease::ClampFrameRange(*PCMBufferInfo, GetNumOfChannels(), StartFrame, NumOfFrames, ChannelIndex);
+	TArray<float> PCMData;
+	if (NumOfFramesToRead > 0)
+	{
+		PCMData.SetNumUninitialized(NumOfFramesToRead * (ChannelIndex == INDEX_NONE ? GetNumOfChannels() : 1));
+		FRAW_RuntimeCodec::CopyPCMFrames(*PCMBufferInfo, GetNumOfChannels(), StartFrame, NumOfFramesToRead, ChannelIndex, PCMData.GetData());
+	}
+	return PCMData;
+}
+
+int64 UImportedSoundWave::ReadPCMFrames(int64 StartFrame, int64 NumOfFrames, float* OutPCMData, int32 ChannelIndex) const
+{
+	FRAIScopeLock Lock(&*DataGuard);
+	const int64 NumOfFramesToRead = FImportedSoundWavePCMReadLease::ClampFrameRange(*PCMBufferInfo, GetNumOfChannels(), StartFrame, NumOfFrames, ChannelIndex);
+	if (NumOfFramesToRead > 0)
+	{
+		FRAW_RuntimeCodec::CopyPCMFrames(*PCMBufferInfo, GetNumOfChannels(), StartFrame, NumOfFramesToRead, ChannelIndex, OutPCMData);
+	}
+	return NumOfFramesToRead;
+}
+
+int64 UImportedSoundWave::ReadPCMFrames(int64 StartFrame, int64 NumOfFrames, int16* OutPCMData, int32 ChannelIndex) const
+{
+	FRAIScopeLock Lock(&*DataGuard);
+	const int64 NumOfFramesToRead = FImportedSoundWavePCMReadLease::ClampFrameRange(*PCMBufferInfo, GetNumOfChannels(), StartFrame, NumOfFrames, ChannelIndex);
+	if (NumOfFramesToRead > 0)
+	{
+		FRAW_RuntimeCodec::CopyPCMFrames(*PCMBufferInfo, GetNumOfChannels(), StartFrame, NumOfFramesToRead, ChannelIndex, OutPCMData);
+	}
+	return NumOfFramesToRead;
+}
+
+FImportedSoundWavePCMReadLease UImportedSoundWave::AcquirePCMReadLease()
+{
+	FRAIScopeLock Lock(&*DataGuard);
+	FImportedSoundWavePCMSnapshotPtr Snapshot = GetPCMSnapshot_Internal();
+	if (!Snapshot.IsValid())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Unable to acquire a PCM read lease for sound wave '%s' because there is no PCM data"), *GetName());
+		return FImportedSoundWavePCMReadLease();
+	}
+	return FImportedSoundWavePCMReadLease(MoveTemp(Snapshot), GetSampleRate(), GetNumOfChannels());
 }
 
 const FPCMStruct& UImportedSoundWave::GetPCMBuffer() const
@@ -988,6 +1937,11 @@ const FPCMStruct& UImportedSoundWave::GetPCMBuffer() const
 	return *PCMBufferInfo.Get();
 }
 
+TSharedPtr<FImportedSoundWavePCMSource> UImportedSoundWave::GetPCMSource() const
+{
+	return PCMSource;
+}
+
 ERuntimeAudioFormat UImportedSoundWave::GetAudioFormat() const
 {
 	return ImportedAudioFormat;
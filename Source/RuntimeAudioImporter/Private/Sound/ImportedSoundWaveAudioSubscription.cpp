@@ -0,0 +1,175 @@
+// Georgy Treshchev 2024.
+
+#include "Sound/ImportedSoundWaveAudioSubscription.h"
+
+FImportedSoundWaveAudioSubscription::FImportedSoundWaveAudioSubscription(ERuntimeAudioSubscriptionSource InSource, int32 InCapacity, ERuntimeAudioSubscriptionOverflowPolicy InOverflowPolicy)
+	: Source(InSource)
+  , OverflowPolicy(InOverflowPolicy)
+  , Mask(FMath::RoundUpToPowerOfTwo(static_cast<uint32>(FMath::Max(InCapacity, 2))) - 1)
+  , PushPosition(0)
+  , PopPosition(0)
+  , bActive(true)
+  , NumOfDeliveredChunks(0)
+  , NumOfReadChunks(0)
+  , NumOfDroppedChunks(0)
+  , NumOfDroppedFrames(0)
+  , NumOfPendingFrames(0)
+  , MaxNumOfPendingChunks(0)
+  , LastSampleRate(0)
+{
+	Slots = MakeUnique<FSlot[]>(Mask + 1);
+	for (uint64 SlotIndex = 0; SlotIndex <= Mask; ++SlotIndex)
+	{
+		Slots[SlotIndex].Sequence.store(SlotIndex, std::memory_order_relaxed);
+	}
+}
+
+FImportedSoundWaveAudioSubscription::~FImportedSoundWaveAudioSubscription()
+{
+}
+
+bool FImportedSoundWaveAudioSubscription::Read(FImportedSoundWaveAudioChunkPtr& OutChunk)
+{
+	if (!TryPop(OutChunk))
+	{
+		return false;
+	}
+
+	NumOfPendingFrames.fetch_sub(OutChunk->GetNumOfFrames(), std::memory_order_relaxed);
+	NumOfReadChunks.fetch_add(1, std::memory_order_relaxed);
+	return true;
+}
+
+int32 FImportedSoundWaveAudioSubscription::ReadAll(TArray<FImportedSoundWaveAudioChunkPtr>& OutChunks)
+{
+	int32 NumOfChunksRead = 0;
+	FImportedSoundWaveAudioChunkPtr Chunk;
+	while (Read(Chunk))
+	{
+		OutChunks.Add(MoveTemp(Chunk));
+		++NumOfChunksRead;
+	}
+	return NumOfChunksRead;
+}
+
+void FImportedSoundWaveAudioSubscription::Deliver(const FImportedSoundWaveAudioChunkPtr& Chunk)
+{
+	if (!Chunk.IsValid() || !IsActive())
+	{
+		return;
+	}
+
+	NumOfDeliveredChunks.fetch_add(1, std::memory_order_relaxed);
+	LastSampleRate.store(Chunk->SampleRate, std::memory_order_relaxed);
+
+	while (!TryPush(Chunk))
+	{
+		FImportedSoundWaveAudioChunkPtr DroppedChunk = Chunk;
+		if (OverflowPolicy == ERuntimeAudioSubscriptionOverflowPolicy::DropOldest && !TryPop(DroppedChunk))
+		{
+			// The subscriber has just made room, so retrying
+			continue;
+		}
+
+		NumOfDroppedChunks.fetch_add(1, std::memory_order_relaxed);
+		NumOfDroppedFrames.fetch_add(DroppedChunk->GetNumOfFrames(), std::memory_order_relaxed);
+
+		if (OverflowPolicy == ERuntimeAudioSubscriptionOverflowPolicy::DropNewest)
+		{
+			return;
+		}
+		NumOfPendingFrames.fetch_sub(DroppedChunk->GetNumOfFrames(), std::memory_order_relaxed);
+	}
+
+	NumOfPendingFrames.fetch_add(Chunk->GetNumOfFrames(), std::memory_order_relaxed);
+
+	// Tracking the high-water mark of the pending chunks
+	const int32 NumOfPendingChunks = static_cast<int32>(PushPosition.load(std::memory_order_relaxed) - PopPosition.load(std::memory_order_relaxed));
+	int32 PreviousMaxNumOfPendingChunks = MaxNumOfPendingChunks.load(std::memory_order_relaxed);
+	while (NumOfPendingChunks > PreviousMaxNumOfPendingChunks && !MaxNumOfPendingChunks.compare_exchange_weak(PreviousMaxNumOfPendingChunks, NumOfPendingChunks, std::memory_order_relaxed))
+	{
+	}
+}
+
+FImportedSoundWaveAudioSubscriptionStats FImportedSoundWaveAudioSubscription::GetStats() const
+{
+	FImportedSoundWaveAudioSubscriptionStats Stats;
+	Stats.NumOfDeliveredChunks = NumOfDeliveredChunks.load(std::memory_order_relaxed);
+	Stats.NumOfReadChunks = NumOfReadChunks.load(std::memory_order_relaxed);
+	Stats.NumOfDroppedChunks = NumOfDroppedChunks.load(std::memory_order_relaxed);
+	Stats.NumOfDroppedFrames = NumOfDroppedFrames.load(std::memory_order_relaxed);
+
+	// The positions are read one after another, so the difference may be momentarily out of range while chunks are being pushed and popped
+	const int64 NumOfPendingChunks = static_cast<int64>(PushPosition.load(std::memory_order_relaxed) - PopPosition.load(std::memory_order_relaxed));
+	Stats.NumOfPendingChunks = static_cast<int32>(FMath::Clamp<int64>(NumOfPendingChunks, 0, GetCapacity()));
+	Stats.MaxNumOfPendingChunks = MaxNumOfPendingChunks.load(std::memory_order_relaxed);
+	Stats.NumOfPendingFrames = FMath::Max<int64>(NumOfPendingFrames.load(std::memory_order_relaxed), 0);
+
+	const uint32 SampleRate = LastSampleRate.load(std::memory_order_relaxed);
+	Stats.LagSeconds = SampleRate > 0 ? static_cast<float>(Stats.NumOfPendingFrames) / SampleRate : 0;
+	return Stats;
+}
+
+bool FImportedSoundWaveAudioSubscription::TryPush(const FImportedSoundWaveAudioChunkPtr& Chunk)
+{
+	uint64 Position = PushPosition.load(std::memory_order_relaxed);
+	FSlot* Slot;
+	while (true)
+	{
+		Slot = &Slots[Position & Mask];
+		const uint64 Sequence = Slot->Sequence.load(std::memory_order_acquire);
+		const int64 Difference = static_cast<int64>(Sequence) - static_cast<int64>(Position);
+		if (Difference == 0)
+		{
+			if (PushPosition.compare_exchange_weak(Position, Position + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (Difference < 0)
+		{
+			// The slot still holds a chunk from the previous lap, so the ring is full
+			return false;
+		}
+		else
+		{
+			Position = PushPosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	Slot->Chunk = Chunk;
+	Slot->Sequence.store(Position + 1, std::memory_order_release);
+	return true;
+}
+
+bool FImportedSoundWaveAudioSubscription::TryPop(FImportedSoundWaveAudioChunkPtr& OutChunk)
+{
+	uint64 Position = PopPosition.load(std::memory_order_relaxed);
+	FSlot* Slot;
+	while (true)
+	{
+		Slot = &Slots[Position & Mask];
+		const uint64 Sequence = Slot->Sequence.load(std::memory_order_acquire);
+		const int64 Difference = static_cast<int64>(Sequence) - static_cast<int64>(Position + 1);
+		if (Difference == 0)
+		{
+			if (PopPosition.compare_exchange_weak(Position, Position + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (Difference < 0)
+		{
+			// The slot has not been written yet, so the ring is empty
+			return false;
+		}
+		else
+		{
+			Position = PopPosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	OutChunk = MoveTemp(Slot->Chunk);
+	Slot->Sequence.store(Position + Mask + 1, std::memory_order_release);
+	return true;
+}
@@ -0,0 +1,134 @@
+// Georgy Treshchev 2024.
+
+#include "Sound/ImportedSoundWavePCMReadLease.h"
+#include "Codecs/RAW_RuntimeCodec.h"
+#include "RuntimeAudioImporterDefines.h"
+
+FImportedSoundWavePCMReadLease::FImportedSoundWavePCMReadLease()
+	: SampleRate(0)
+  , NumOfChannels(0)
+{
+}
+
+FImportedSoundWavePCMReadLease::FImportedSoundWavePCMReadLease(FImportedSoundWavePCMSnapshotPtr InPCMSnapshot, uint32 InSampleRate, uint32 InNumOfChannels)
+	: PCMSnapshot(MoveTemp(InPCMSnapshot))
+  , SampleRate(InSampleRate)
+  , NumOfChannels(InNumOfChannels)
+{
+}
+
+bool FImportedSoundWavePCMReadLease::IsValid() const
+{
+	return PCMSnapshot.IsValid() && NumOfChannels > 0;
+}
+
+void FImportedSoundWavePCMReadLease::Release()
+{
+	PCMSnapshot.Reset();
+}
+
+ERuntimePCMStorageFormat FImportedSoundWavePCMReadLease::GetStorageFormat() const
+{
+	return PCMSnapshot.IsValid() ? PCMSnapshot->GetStorageFormat() : ERuntimePCMStorageFormat::Float32;
+}
+
+TArrayView<const float> FImportedSoundWavePCMReadLease::GetFloatPCMData() const
+{
+	if (!PCMSnapshot.IsValid() || PCMSnapshot->GetStorageFormat() != ERuntimePCMStorageFormat::Float32)
+	{
+		return TArrayView<const float>();
+	}
+	return PCMSnapshot->PCMData.GetView();
+}
+
+TArrayView<const int16> FImportedSoundWavePCMReadLease::GetInt16PCMData() const
+{
+	if (!PCMSnapshot.IsValid() || PCMSnapshot->GetStorageFormat() != ERuntimePCMStorageFormat::Int16)
+	{
+		return TArrayView<const int16>();
+	}
+	return PCMSnapshot->PCMDataInt16.GetView();
+}
+
+FPCMStruct FImportedSoundWavePCMReadLease::SharePCMData() const
+{
+	FPCMStruct SharedPCMInfo;
+	if (!PCMSnapshot.IsValid())
+	{
+		return SharedPCMInfo;
+	}
+
+	const TSharedPtr<FPCMStruct, ESPMode::ThreadSafe> Owner = ConstCastSharedPtr<FPCMStruct>(PCMSnapshot);
+	if (PCMSnapshot->GetStorageFormat() == ERuntimePCMStorageFormat::Int16)
+	{
+		SharedPCMInfo.PCMDataInt16 = FRuntimeBulkDataBuffer<int16>(const_cast<int16*>(PCMSnapshot->PCMDataInt16.GetView().GetData()), PCMSnapshot->PCMDataInt16.GetView().Num(), Owner);
+	}
+	else
+	{
+		SharedPCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(const_cast<float*>(PCMSnapshot->PCMData.GetView().GetData()), PCMSnapshot->PCMData.GetView().Num(), Owner);
+	}
+	SharedPCMInfo.PCMNumOfFrames = PCMSnapshot->PCMNumOfFrames;
+	return SharedPCMInfo;
+}
+
+int64 FImportedSoundWavePCMReadLease::ReadFrames(int64 StartFrame, int64 NumOfFrames, float* OutPCMData, int32 ChannelIndex) const
+{
+	if (!IsValid())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to read PCM frames because the PCM read lease is invalid"));
+		return -1;
+	}
+
+	const int64 NumOfFramesToRead = ClampFrameRange(*PCMSnapshot, NumOfChannels, StartFrame, NumOfFrames, ChannelIndex);
+	if (NumOfFramesToRead > 0)
+	{
+		FRAW_RuntimeCodec::CopyPCMFrames(*PCMSnapshot, NumOfChannels, StartFrame, NumOfFramesToRead, ChannelIndex, OutPCMData);
+	}
+	return NumOfFramesToRead;
+}
+
+int64 FImportedSoundWavePCMReadLease::ReadFrames(int64 StartFrame, int64 NumOfFrames, int16* OutPCMData, int32 ChannelIndex) const
+{
+	if (!IsValid())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to read PCM frames because the PCM read lease is invalid"));
+		return -1;
+	}
+
+	const int64 NumOfFramesToRead = ClampFrameRange(*PCMSnapshot, NumOfChannels, StartFrame, NumOfFrames, ChannelIndex);
+	if (NumOfFramesToRead > 0)
+	{
+		FRAW_RuntimeCodec::CopyPCMFrames(*PCMSnapshot, NumOfChannels, StartFrame, NumOfFramesToRead, ChannelIndex, OutPCMData);
+	}
+	return NumOfFramesToRead;
+}
+
+int64 FImportedSoundWavePCMReadLease::GetNumOfFrames() const
+{
+	return PCMSnapshot.IsValid() ? PCMSnapshot->PCMNumOfFrames : 0;
+}
+
+int64 FImportedSoundWavePCMReadLease::ClampFrameRange(const FPCMStruct& PCMInfo, uint32 NumOfChannels, int64 StartFrame, int64 NumOfFrames, int32 ChannelIndex)
+{
+	if (NumOfChannels == 0)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to read PCM frames because the number of channels is invalid"));
+		return -1;
+	}
+
+	if (ChannelIndex != INDEX_NONE && (ChannelIndex < 0 || static_cast<uint32>(ChannelIndex) >= NumOfChannels))
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to read PCM frames because the channel index %d is out of bounds (number of channels: %d)"), ChannelIndex, NumOfChannels);
+		return -1;
+	}
+
+	// The number of frames is derived from the samples actually stored, in case they are not in sync with PCMNumOfFrames yet
+	const int64 NumOfAvailableFrames = PCMInfo.GetNumOfSamples() / NumOfChannels;
+	if (StartFrame < 0 || NumOfFrames < 0 || StartFrame > NumOfAvailableFrames)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to read PCM frames because the range [%lld, %lld) is out of bounds (number of frames: %lld)"), StartFrame, StartFrame + NumOfFrames, NumOfAvailableFrames);
+		return -1;
+	}
+
+	return FMath::Min(NumOfFrames, NumOfAvailableFrames - StartFrame);
+}
@@ -0,0 +1,214 @@
+// Georgy Treshchev 2024.
+
+#include "Sound/ImportedSoundWavePlaybackInstance.h"
+
+#include "RuntimeAudioImporterDefines.h"
+#include "Codecs/RAW_RuntimeCodec.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+FImportedSoundWavePlaybackInstance::FImportedSoundWavePlaybackInstance(FImportedSoundWavePCMSnapshotPtr InPCMSnapshot, uint32 InSampleRate, uint32 InNumOfChannels, bool bInLoop, bool bInReverse)
+	: PCMSnapshot(MoveTemp(InPCMSnapshot))
+  , SampleRate(InSampleRate)
+  , NumOfChannels(InNumOfChannels)
+  , PlayedNumOfFrames(bInReverse && PCMSnapshot.IsValid() ? PCMSnapshot->PCMNumOfFrames : 0)
+  , bLoop(bInLoop)
+  , bReverse(bInReverse)
+  , bFinished(false)
+{
+}
+
+#if WITH_RUNTIMEAUDIOIMPORTER_PLAYBACK_INSTANCE_GENERATOR_SUPPORT
+int32 FImportedSoundWavePlaybackInstance::OnGenerateAudio(float* OutAudio, int32 NumSamples)
+{
+	return Render(OutAudio, NumSamples);
+}
+#endif
+
+int32 FImportedSoundWavePlaybackInstance::Render(float* OutAudio, int32 NumSamples)
+{
+	if (!OutAudio || NumSamples <= 0)
+	{
+		return 0;
+	}
+
+	const int64 NumOfFrames = PCMSnapshot.IsValid() ? PCMSnapshot->PCMNumOfFrames : 0;
+	int32 NumOfRenderedSamples = 0;
+
+	if (NumOfChannels > 0 && NumOfFrames > 0 && !bFinished.load(std::memory_order_relaxed))
+	{
+		const bool bLoopPlayback = bLoop.load(std::memory_order_relaxed);
+		const bool bReversePlayback = bReverse.load(std::memory_order_relaxed);
+		const uint32 StartFrame = PlayedNumOfFrames.load(std::memory_order_relaxed);
+		int64 Frame = FMath::Min<int64>(StartFrame, NumOfFrames);
+		bool bReachedEnd = false;
+
+		while (NumOfRenderedSamples + static_cast<int32>(NumOfChannels) <= NumSamples)
+		{
+			// The playhead is a position in the PCM data, and when playing in reverse the frames preceding it remain to be played
+			if (bReversePlayback ? Frame <= 0 : Frame >= NumOfFrames)
+			{
+				if (!bLoopPlayback)
+				{
+					bReachedEnd = true;
+					break;
+				}
+				Frame = bReversePlayback ? NumOfFrames : 0;
+			}
+
+			const int64 NumOfFramesToCopy = FMath::Min<int64>((NumSamples - NumOfRenderedSamples) / NumOfChannels, bReversePlayback ? Frame : NumOfFrames - Frame);
+			float* BlockAudio = OutAudio + NumOfRenderedSamples;
+			if (bReversePlayback)
+			{
+				Frame -= NumOfFramesToCopy;
+				FRAW_RuntimeCodec::CopyPCMDataAsFloat(*PCMSnapshot, Frame * NumOfChannels, NumOfFramesToCopy * NumOfChannels, BlockAudio);
+				FRAW_RuntimeCodec::ReverseFrames(BlockAudio, NumOfFramesToCopy, NumOfChannels);
+			}
+			else
+			{
+				FRAW_RuntimeCodec::CopyPCMDataAsFloat(*PCMSnapshot, Frame * NumOfChannels, NumOfFramesToCopy * NumOfChannels, BlockAudio);
+				Frame += NumOfFramesToCopy;
+			}
+			NumOfRenderedSamples += static_cast<int32>(NumOfFramesToCopy * NumOfChannels);
+		}
+
+		// A rewind made from another thread while rendering takes precedence over the rendered position
+		uint32 ExpectedFrame = StartFrame;
+		if (PlayedNumOfFrames.compare_exchange_strong(ExpectedFrame, static_cast<uint32>(Frame)) && bReachedEnd)
+		{
+			bFinished = true;
+		}
+	}
+
+	FMemory::Memzero(OutAudio + NumOfRenderedSamples, (NumSamples - NumOfRenderedSamples) * sizeof(float));
+	return NumSamples;
+}
+
+bool FImportedSoundWavePlaybackInstance::IsFinished() const
+{
+	return bFinished;
+}
+
+void FImportedSoundWavePlaybackInstance::Stop()
+{
+	bFinished = true;
+}
+
+void FImportedSoundWavePlaybackInstance::SetLooping(bool bInLoop)
+{
+	bLoop = bInLoop;
+}
+
+bool FImportedSoundWavePlaybackInstance::IsLooping() const
+{
+	return bLoop;
+}
+
+void FImportedSoundWavePlaybackInstance::SetReverse(bool bInReverse)
+{
+	bReverse = bInReverse;
+}
+
+bool FImportedSoundWavePlaybackInstance::IsReverse() const
+{
+	return bReverse;
+}
+
+bool FImportedSoundWavePlaybackInstance::RewindPlaybackTime(float PlaybackTime)
+{
+	if (PlaybackTime < 0 || PlaybackTime > GetDuration())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to rewind the playback instance to time '%f' because the total length is '%f'"), PlaybackTime, GetDuration());
+		return false;
+	}
+
+	PlayedNumOfFrames = static_cast<uint32>(PlaybackTime * SampleRate);
+	bFinished = false;
+	return true;
+}
+
+float FImportedSoundWavePlaybackInstance::GetPlaybackTime() const
+{
+	return SampleRate > 0 ? static_cast<float>(GetNumOfPlayedFrames()) / SampleRate : 0;
+}
+
+uint32 FImportedSoundWavePlaybackInstance::GetNumOfPlayedFrames() const
+{
+	return PlayedNumOfFrames;
+}
+
+float FImportedSoundWavePlaybackInstance::GetDuration() const
+{
+	return PCMSnapshot.IsValid() && SampleRate > 0 ? static_cast<float>(PCMSnapshot->PCMNumOfFrames) / SampleRate : 0;
+}
+
+uint32 FImportedSoundWavePlaybackInstance::GetSampleRate() const
+{
+	return SampleRate;
+}
+
+uint32 FImportedSoundWavePlaybackInstance::GetNumOfChannels() const
+{
+	return NumOfChannels;
+}
+
+static FAutoConsoleCommand PlaybackInstancesBenchmarkCommand(
+	TEXT("RuntimeAudioImporter.PlaybackInstances.Benchmark"),
+	TEXT("Create, render and destroy playback instances sharing one PCM buffer and print the timings. Usage: RuntimeAudioImporter.PlaybackInstances.Benchmark [NumOfInstances=1000] [NumOfSecondsToRender=10]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 NumOfInstances = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 1000;
+		const int32 NumOfSecondsToRender = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 10;
+		constexpr uint32 SampleRate = 48000;
+		constexpr uint32 NumOfChannels = 2;
+		constexpr int32 NumOfFramesPerCallback = 1024;
+
+		// Ten seconds of a stereo sine wave, shared by all instances
+		TSharedRef<FPCMStruct, ESPMode::ThreadSafe> PCMSnapshot = MakeShared<FPCMStruct, ESPMode::ThreadSafe>();
+		{
+			const int64 NumOfFrames = SampleRate * 10;
+			float* PCMData = static_cast<float*>(FMemory::Malloc(NumOfFrames * NumOfChannels * sizeof(float)));
+			for (int64 FrameIndex = 0; FrameIndex < NumOfFrames; ++FrameIndex)
+			{
+				PCMData[FrameIndex * NumOfChannels] = PCMData[FrameIndex * NumOfChannels + 1] = 0.5f * FMath::Sin(2 * PI * 440 * FrameIndex / SampleRate);
+			}
+			PCMSnapshot->PCMData = FRuntimeBulkDataBuffer<float>(PCMData, NumOfFrames * NumOfChannels);
+			PCMSnapshot->PCMNumOfFrames = NumOfFrames;
+		}
+
+		TArray<TSharedPtr<FImportedSoundWavePlaybackInstance, ESPMode::ThreadSafe>> Instances;
+		Instances.SetNum(NumOfInstances);
+
+		// Creating the instances concurrently, each starting at its own position
+		const double CreationStartTime = FPlatformTime::Seconds();
+		ParallelFor(NumOfInstances, [&Instances, &PCMSnapshot, SampleRate, NumOfChannels](int32 InstanceIndex)
+		{
+			Instances[InstanceIndex] = MakeShared<FImportedSoundWavePlaybackInstance, ESPMode::ThreadSafe>(PCMSnapshot, SampleRate, NumOfChannels, true);
+			Instances[InstanceIndex]->RewindPlaybackTime((InstanceIndex % 100) * 0.1f);
+		});
+		const double CreationTime = FPlatformTime::Seconds() - CreationStartTime;
+
+		// Rendering all instances callback by callback, as the audio mixer would
+		TArray<float> OutAudio;
+		OutAudio.SetNumUninitialized(NumOfFramesPerCallback * NumOfChannels);
+		const int32 NumOfCallbacks = NumOfSecondsToRender * SampleRate / NumOfFramesPerCallback;
+		const double RenderStartTime = FPlatformTime::Seconds();
+		for (int32 CallbackIndex = 0; CallbackIndex < NumOfCallbacks; ++CallbackIndex)
+		{
+			for (const TSharedPtr<FImportedSoundWavePlaybackInstance, ESPMode::ThreadSafe>& Instance : Instances)
+			{
+				Instance->Render(OutAudio.GetData(), OutAudio.Num());
+			}
+		}
+		const double RenderTime = FPlatformTime::Seconds() - RenderStartTime;
+
+		const double DestructionStartTime = FPlatformTime::Seconds();
+		Instances.Empty();
+		const double DestructionTime = FPlatformTime::Seconds() - DestructionStartTime;
+
+		UE_LOG(LogRuntimeAudioImporter, Display, TEXT("Playback instances benchmark: %d instances sharing a PCM buffer of %lld bytes"), NumOfInstances, PCMSnapshot->GetNumOfSamples() * static_cast<int64>(sizeof(float)));
+		UE_LOG(LogRuntimeAudioImporter, Display, TEXT("Created in %.3f ms (%.3f us per instance), destroyed in %.3f ms"), CreationTime * 1000, CreationTime * 1000000 / NumOfInstances, DestructionTime * 1000);
+		UE_LOG(LogRuntimeAudioImporter, Display, TEXT("Rendered %d seconds of audio (%d callbacks of %d frames) in %.3f ms: %.3f us per instance per callback, %.1fx faster than real time"),
+			NumOfSecondsToRender, NumOfCallbacks, NumOfFramesPerCallback, RenderTime * 1000, RenderTime * 1000000 / (static_cast<double>(NumOfCallbacks) * NumOfInstances), NumOfSecondsToRender / FMath::Max(RenderTime, static_cast<double>(SMALL_NUMBER)));
+	}));
@@ -0,0 +1,133 @@
+﻿// Georgy Treshchev 2024.
+
+#include "Sound/OpusStreamingSoundWave.h"
+#include "RuntimeAudioImporterDefines.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+UOpusStreamingSoundWave::UOpusStreamingSoundWave(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+UOpusStreamingSoundWave* UOpusStreamingSoundWave::CreateOpusStreamingSoundWave()
+{
+	if (!IsInGameThread())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to create a sound wave outside of the game thread"));
+		return nullptr;
+	}
+
+	return NewObject<UOpusStreamingSoundWave>();
+}
+
+bool UOpusStreamingSoundWave::StartOpusStream(int32 InSampleRate, int32 NumOfChannels, int32 JitterBufferDepth)
+{
+	TUniquePtr<FOPUS_RuntimeJitterBuffer> NewJitterBuffer = MakeUnique<FOPUS_RuntimeJitterBuffer>(JitterBufferDepth);
+	if (InSampleRate <= 0 || NumOfChannels <= 0 || !NewJitterBuffer->Initialize(static_cast<uint32>(InSampleRate), static_cast<uint32>(NumOfChannels)))
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to start Opus stream for sound wave '%s' (sample rate: %d, number of channels: %d)"), *GetName(), InSampleRate, NumOfChannels);
+		return false;
+	}
+
+	FRAIScopeLock Lock(&JitterBufferGuard);
+	JitterBuffer = MoveTemp(NewJitterBuffer);
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully started Opus stream for sound wave '%s' (sample rate: %d, number of channels: %d, jitter buffer depth: %d)"), *GetName(), InSampleRate, NumOfChannels, JitterBufferDepth);
+	return true;
+}
+
+void UOpusStreamingSoundWave::AppendOpusPacket(int64 SequenceNumber, TArray<uint8> Packet)
+{
+	{
+		FRAIScopeLock Lock(&JitterBufferGuard);
+		if (!JitterBuffer.IsValid())
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to append Opus packet to sound wave '%s' as the stream has not been started (see StartOpusStream)"), *GetName());
+			return;
+		}
+
+		// Pushed right away, so that the packets are ordered by the jitter buffer rather than by the order the tasks run in
+		JitterBuffer->PushPacket(SequenceNumber, MoveTemp(Packet));
+	}
+
+	LaunchAudioTask([WeakThis = MakeWeakObjectPtr(this)]()
+	{
+		if (WeakThis.IsValid())
+		{
+			WeakThis->PopulateAudioDataFromJitterBuffer(false);
+		}
+		else
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to decode Opus packets as the sound wave has been destroyed"));
+		}
+	});
+}
+
+void UOpusStreamingSoundWave::FinishOpusStream()
+{
+	LaunchAudioTask([WeakThis = MakeWeakObjectPtr(this)]()
+	{
+		if (WeakThis.IsValid())
+		{
+			WeakThis->PopulateAudioDataFromJitterBuffer(true);
+		}
+	});
+}
+
+void UOpusStreamingSoundWave::GetOpusStreamStatistics(int64& NumOfReceivedPackets, int64& NumOfLatePackets, int64& NumOfRecoveredPackets, int64& NumOfConcealedPackets) const
+{
+	const FOPUS_RuntimeJitterBufferStats Stats = GetJitterBufferStats();
+	NumOfReceivedPackets = Stats.NumOfReceivedPackets;
+	NumOfLatePackets = Stats.NumOfLatePackets;
+	NumOfRecoveredPackets = Stats.NumOfRecoveredPackets;
+	NumOfConcealedPackets = Stats.NumOfConcealedPackets;
+}
+
+FOPUS_RuntimeJitterBufferStats UOpusStreamingSoundWave::GetJitterBufferStats() const
+{
+	FRAIScopeLock Lock(&JitterBufferGuard);
+	return JitterBuffer.IsValid() ? JitterBuffer->GetStats() : FOPUS_RuntimeJitterBufferStats();
+}
+
+void UOpusStreamingSoundWave::PopulateAudioDataFromJitterBuffer(bool bFlush)
+{
+	TArray<float> PCMData;
+	uint32 DecodedSampleRate, DecodedNumOfChannels;
+	{
+		FRAIScopeLock Lock(&JitterBufferGuard);
+		if (!JitterBuffer.IsValid())
+		{
+			return;
+		}
+
+		JitterBuffer->PopFrames(PCMData, bFlush);
+		DecodedSampleRate = JitterBuffer->GetDecoder().GetSampleRate();
+		DecodedNumOfChannels = JitterBuffer->GetDecoder().GetNumOfChannels();
+	}
+
+	if (PCMData.Num() == 0)
+	{
+		return;
+	}
+
+	FDecodedAudioStruct DecodedAudioInfo;
+	{
+		FPCMStruct PCMInfo;
+		{
+			PCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(PCMData);
+			PCMInfo.PCMNumOfFrames = PCMData.Num() / DecodedNumOfChannels;
+		}
+		DecodedAudioInfo.PCMInfo = MoveTemp(PCMInfo);
+
+		FSoundWaveBasicStruct SoundWaveBasicInfo;
+		{
+			SoundWaveBasicInfo.NumOfChannels = DecodedNumOfChannels;
+			SoundWaveBasicInfo.SampleRate = DecodedSampleRate;
+			SoundWaveBasicInfo.Duration = static_cast<float>(DecodedAudioInfo.PCMInfo.PCMNumOfFrames) / DecodedSampleRate;
+		}
+		DecodedAudioInfo.SoundWaveBasicInfo = MoveTemp(SoundWaveBasicInfo);
+	}
+
+	++NumOfAppendedChunks;
+	PopulateAudioDataFromDecodedInfo(MoveTemp(DecodedAudioInfo));
+}
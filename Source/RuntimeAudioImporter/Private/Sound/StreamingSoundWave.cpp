@@ -3,15 +3,107 @@
 #include "Sound/StreamingSoundWave.h"
 
 #include "RuntimeAudioImporterLibrary.h"
+#include "RuntimeAudioUtilities.h"
+#include "RuntimeAudioRingBuffer.h"
 #include "Codecs/RAW_RuntimeCodec.h"
+#include "Codecs/RuntimeCodecFactory.h"
+#include "Codecs/RuntimePCMFormatConverter.h"
 
 #include "Async/Async.h"
 #include "SampleBuffer.h"
 #include "VAD/RuntimeVoiceActivityDetector.h"
 #include "UObject/WeakObjectPtrTemplates.h"
+#include "HAL/PlatformFileManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	/**
+	 * Check whether the audio data is in the format returned by GetAppendFormat_Internal, where 0 keeps the sample rate or the number of channels of the audio data
+	 */
+	bool MatchesAppendFormat(const FSoundWaveBasicStruct& SoundWaveBasicInfo, uint32 TargetSampleRate, uint32 TargetNumOfChannels)
+	{
+		return (TargetSampleRate == 0 || TargetSampleRate == SoundWaveBasicInfo.SampleRate) && (TargetNumOfChannels == 0 || TargetNumOfChannels == SoundWaveBasicInfo.NumOfChannels);
+	}
+
+	/**
+	 * Transcode RAW data to newly allocated 32-bit float decoded audio info
+	 */
+	bool TranscodeRAWDataToDecodedInfo(const TArray<uint8>& RAWData, ERuntimeRAWAudioFormat RAWFormat, int32 InSampleRate, int32 NumOfChannels, FDecodedAudioStruct& OutDecodedAudioInfo)
+	{
+		const uint8* ByteDataPtr = RAWData.GetData();
+		const int64 ByteDataSize = RAWData.Num();
+
+		float* Float32DataPtr = nullptr;
+		int64 NumOfSamples = 0;
+
+		switch (RAWFormat)
+		{
+		case ERuntimeRAWAudioFormat::Int8:
+			{
+				NumOfSamples = ByteDataSize / sizeof(int8);
+				FRAW_RuntimeCodec::TranscodeRAWData<int8, float>(reinterpret_cast<const int8*>(ByteDataPtr), NumOfSamples, Float32DataPtr);
+				break;
+			}
+		case ERuntimeRAWAudioFormat::UInt8:
+			{
+				NumOfSamples = ByteDataSize / sizeof(uint8);
+				FRAW_RuntimeCodec::TranscodeRAWData<uint8, float>(ByteDataPtr, NumOfSamples, Float32DataPtr);
+				break;
+			}
+		case ERuntimeRAWAudioFormat::Int16:
+			{
+				NumOfSamples = ByteDataSize / sizeof(int16);
+				FRAW_RuntimeCodec::TranscodeRAWData<int16, float>(reinterpret_cast<const int16*>(ByteDataPtr), NumOfSamples, Float32DataPtr);
+				break;
+			}
+		case ERuntimeRAWAudioFormat::UInt16:
+			{
+				NumOfSamples = ByteDataSize / sizeof(uint16);
+				FRAW_RuntimeCodec::TranscodeRAWData<uint16, float>(reinterpret_cast<const uint16*>(ByteDataPtr), NumOfSamples, Float32DataPtr);
+				break;
+			}
+		case ERuntimeRAWAudioFormat::UInt32:
+			{
+				NumOfSamples = ByteDataSize / sizeof(uint32);
+				FRAW_RuntimeCodec::TranscodeRAWData<uint32, float>(reinterpret_cast<const uint32*>(ByteDataPtr), NumOfSamples, Float32DataPtr);
+				break;
+			}
+		case ERuntimeRAWAudioFormat::Int32:
+			{
+				NumOfSamples = ByteDataSize / sizeof(int32);
+				FRAW_RuntimeCodec::TranscodeRAWData<int32, float>(reinterpret_cast<const int32*>(ByteDataPtr), NumOfSamples, Float32DataPtr);
+				break;
+			}
+		case ERuntimeRAWAudioFormat::Float32:
+			{
+				NumOfSamples = ByteDataSize / sizeof(float);
+				Float32DataPtr = static_cast<float*>(FMemory::Memcpy(FMemory::Malloc(NumOfSamples * sizeof(float)), ByteDataPtr, NumOfSamples * sizeof(float)));
+				break;
+			}
+		}
+
+		if (!Float32DataPtr || NumOfSamples <= 0 || InSampleRate <= 0 || NumOfChannels <= 0)
+		{
+			FMemory::Free(Float32DataPtr);
+			return false;
+		}
+
+		OutDecodedAudioInfo.PCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(Float32DataPtr, NumOfSamples);
+		OutDecodedAudioInfo.PCMInfo.PCMNumOfFrames = NumOfSamples / NumOfChannels;
+		OutDecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels = NumOfChannels;
+		OutDecodedAudioInfo.SoundWaveBasicInfo.SampleRate = InSampleRate;
+		OutDecodedAudioInfo.SoundWaveBasicInfo.Duration = static_cast<float>(OutDecodedAudioInfo.PCMInfo.PCMNumOfFrames) / InSampleRate;
+		return true;
+	}
+}
 
 UStreamingSoundWave::UStreamingSoundWave(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+  , EncoderQuality(100)
+  , NumOfAudioTasksLaunched(0)
+  , NumOfAppendedChunks(0)
 {
 	AudioTaskPipe = MakeUnique<UE::Tasks::FPipe>(*FString::Printf(TEXT("AudioTaskPipe_%s"), *GetName()));
 	ensureMsgf(AudioTaskPipe, TEXT("AudioTaskPipe is not initialized. This will cause issues with audio data appending"));
@@ -33,6 +125,34 @@ UStreamingSoundWave::UStreamingSoundWave(const FObjectInitializer& ObjectInitial
 	}
 }
 
+void UStreamingSoundWave::BeginDestroy()
+{
+	// Making sure the file is finalized with whatever has been encoded so far. Flushing the encoder and the sink may take a while, so it is done in the background
+	if (IsEncodingToFile())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Streaming sound wave ('%s') is being destroyed while encoding to a file. Finishing the encoding"), *GetName());
+
+		TUniquePtr<FBaseRuntimeEncoderSession> Session;
+		{
+			FRAIScopeLock Lock(&EncoderSessionGuard);
+			Session = MoveTemp(EncoderSession);
+			PendingEncoderSink.Reset();
+		}
+
+		DestroyEncoderFinishFuture = Async(EAsyncExecution::ThreadPool, [Session = MoveTemp(Session), SoundWaveName = GetName()]() mutable
+		{
+			return FinishEncoderSession(MoveTemp(Session), SoundWaveName);
+		});
+	}
+
+	Super::BeginDestroy();
+}
+
+bool UStreamingSoundWave::IsReadyForFinishDestroy()
+{
+	return Super::IsReadyForFinishDestroy() && (!DestroyEncoderFinishFuture.IsValid() || DestroyEncoderFinishFuture.IsReady());
+}
+
 bool UStreamingSoundWave::ToggleVAD(bool bVAD)
 {
 	VADInstance = bVAD ? NewObject<URuntimeVoiceActivityDetector>() : nullptr;
@@ -100,6 +220,14 @@ bool UStreamingSoundWave::SetSilenceDuration(int32 InDuration)
 }
 
 void UStreamingSoundWave::PopulateAudioDataFromDecodedInfo(FDecodedAudioStruct&& DecodedAudioInfo)
+{
+	if (ProcessVADForAppend(DecodedAudioInfo))
+	{
+		AppendDecodedAudio(MoveTemp(DecodedAudioInfo));
+	}
+}
+
+bool UStreamingSoundWave::ProcessVADForAppend(const FDecodedAudioStruct& DecodedAudioInfo)
 {
 #if WITH_RUNTIMEAUDIOIMPORTER_VAD_SUPPORT
 	// Process VAD if necessary
@@ -109,79 +237,111 @@ void UStreamingSoundWave::PopulateAudioDataFromDecodedInfo(FDecodedAudioStruct&&
 		if (!bDetected)
 		{
 			UE_LOG(LogRuntimeAudioImporter, Verbose, TEXT("VAD detected silence, skipping audio data append"));
-			return;
+			return false;
 		}
 		UE_LOG(LogRuntimeAudioImporter, Verbose, TEXT("VAD detected voice, appending audio data"));
 	}
 #endif
+	return true;
+}
 
+void UStreamingSoundWave::GetAppendFormat_Internal(uint32& OutSampleRate, uint32& OutNumOfChannels) const
+{
+	if (PCMBufferInfo->GetNumOfSamples() > 0)
 	{
-		FRAIScopeLock Lock(&*DataGuard);
-		if (!DecodedAudioInfo.IsValid())
+		OutSampleRate = static_cast<uint32>(SampleRate);
+		OutNumOfChannels = static_cast<uint32>(NumChannels);
+	}
+	else
+	{
+		OutSampleRate = InitialDesiredSampleRate.Get(0);
+		OutNumOfChannels = InitialDesiredNumOfChannels.Get(0);
+	}
+}
+
+void UStreamingSoundWave::AppendDecodedAudio(FDecodedAudioStruct&& DecodedAudioInfo)
+{
+	if (!DecodedAudioInfo.IsValid())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to continue populating the audio data because the decoded info is invalid"));
+		return;
+	}
+
+	int64 StartFrame;
+	while (true)
+	{
+		uint32 TargetSampleRate, TargetNumOfChannels;
 		{
-			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to continue populating the audio data because the decoded info is invalid"));
-			return;
+			FRAIScopeLock Lock(&*DataGuard);
+			GetAppendFormat_Internal(TargetSampleRate, TargetNumOfChannels);
 		}
 
-		// Whether the audio data has been populated with PCM buffer
-		const bool bHasPreviouslyPopulatedRealPCMData = PCMBufferInfo->PCMData.GetView().Num() > 0;
-
-		// Make sure the sample rate and the number of channels match the previously populated audio data
-		if (bHasPreviouslyPopulatedRealPCMData)
+		// Resampling and mixing the channels without holding the data guard, which playback and the other readers of the audio data take
+		if (!MatchesAppendFormat(DecodedAudioInfo.SoundWaveBasicInfo, TargetSampleRate, TargetNumOfChannels)
+			&& !URuntimeAudioImporterLibrary::ResampleAndMixChannelsInDecodedInfo(DecodedAudioInfo,
+				TargetSampleRate > 0 ? TargetSampleRate : DecodedAudioInfo.SoundWaveBasicInfo.SampleRate,
+				TargetNumOfChannels > 0 ? TargetNumOfChannels : DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels))
 		{
-			URuntimeAudioImporterLibrary::ResampleAndMixChannelsInDecodedInfo(DecodedAudioInfo, SampleRate, NumChannels);
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to resample and mix the audio data appended to the streaming sound wave '%s'"), *GetName());
+			return;
 		}
 
-		// If the sound wave has not yet been filled in with audio data and the initial desired sample rate and the number of channels are set, resample and mix the channels
-		else if (InitialDesiredSampleRate.IsSet() || InitialDesiredNumOfChannels.IsSet())
+		FRAIScopeLock Lock(&*DataGuard);
+
+		// The audio data may have been resampled, mixed or released in the meantime, in which case the appended audio data is brought to the new format
+		GetAppendFormat_Internal(TargetSampleRate, TargetNumOfChannels);
+		if (!MatchesAppendFormat(DecodedAudioInfo.SoundWaveBasicInfo, TargetSampleRate, TargetNumOfChannels))
 		{
-			URuntimeAudioImporterLibrary::ResampleAndMixChannelsInDecodedInfo(DecodedAudioInfo,
-				InitialDesiredSampleRate.IsSet() ? InitialDesiredSampleRate.GetValue() : DecodedAudioInfo.SoundWaveBasicInfo.SampleRate,
-				InitialDesiredNumOfChannels.IsSet() ? InitialDesiredNumOfChannels.GetValue() : DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels);
+			continue;
 		}
 
+		StartFrame = PCMBufferInfo->PCMNumOfFrames;
+
 		// Update the initial audio data if it hasn't already been filled in
-		if (!bHasPreviouslyPopulatedRealPCMData)
+		if (PCMBufferInfo->GetNumOfSamples() == 0)
 		{
 			SetSampleRate(DecodedAudioInfo.SoundWaveBasicInfo.SampleRate);
 			NumChannels = DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels;
 		}
 
-		PCMBufferInfo->PCMData.Append(DecodedAudioInfo.PCMInfo.PCMData);
+		// The decoded data is still needed as 32-bit float below (e.g. by the encoder session), so only the appended copy is converted
+		if (PCMStorageFormat == ERuntimePCMStorageFormat::Int16)
+		{
+			const int64 NumOfSamples = DecodedAudioInfo.PCMInfo.PCMData.GetView().Num();
+			int16* Int16PCMData = static_cast<int16*>(FMemory::Malloc(NumOfSamples * sizeof(int16)));
+			FRAW_RuntimeCodec::ConvertFloatToInt16(DecodedAudioInfo.PCMInfo.PCMData.GetView().GetData(), Int16PCMData, NumOfSamples);
+			PCMBufferInfo->PCMDataInt16.Append(FRuntimeBulkDataBuffer<int16>(Int16PCMData, NumOfSamples));
+		}
+		else
+		{
+			PCMBufferInfo->PCMData.Append(DecodedAudioInfo.PCMInfo.PCMData);
+		}
 
 		PCMBufferInfo->PCMNumOfFrames += DecodedAudioInfo.PCMInfo.PCMNumOfFrames;
 		Duration += DecodedAudioInfo.SoundWaveBasicInfo.Duration;
+		OnPCMDataChanged_Internal(true);
 		ResetPlaybackFinish();
+		break;
 	}
 
+	PushToEncoderSession(DecodedAudioInfo);
+
+	UE_LOG(LogRuntimeAudioImporter, Verbose, TEXT("Successfully added audio data to streaming sound wave.\nAdded audio info: %s"), *DecodedAudioInfo.ToString());
+
 	{
 		const bool IsBound = [this]()
 		{
 			FRAIScopeLock Lock(&OnPopulateAudioData_DataGuard);
 			return OnPopulateAudioDataNative.IsBound() || OnPopulateAudioData.IsBound();
 		}();
-		if (IsBound)
+
+		// The decoded PCM data is no longer needed, so it is moved into the chunk shared by the delegates and the audio subscriptions instead of being copied
+		if (IsBound || HasAudioSubscriptions())
 		{
-			TArray<float> PCMData(DecodedAudioInfo.PCMInfo.PCMData.GetView().GetData(), DecodedAudioInfo.PCMInfo.PCMData.GetView().Num());
-			AsyncTask(ENamedThreads::AnyBackgroundHiPriTask, [WeakThis = MakeWeakObjectPtr(this), PCMData = MoveTemp(PCMData)]() mutable
-			{
-				if (WeakThis.IsValid())
-				{
-					FRAIScopeLock Lock(&WeakThis->OnPopulateAudioData_DataGuard);
-					if (WeakThis->OnPopulateAudioDataNative.IsBound())
-					{
-						WeakThis->OnPopulateAudioDataNative.Broadcast(PCMData);
-					}
-					if (WeakThis->OnPopulateAudioData.IsBound())
-					{
-						WeakThis->OnPopulateAudioData.Broadcast(PCMData);
-					}
-				}
-				else
-				{
-					UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Unable to broadcast OnPopulateAudioDataNative and OnPopulateAudioData delegates because the streaming sound wave has been destroyed"));
-				}
-			});
+			const FImportedSoundWaveAudioChunkPtr Chunk = MakeShared<const FImportedSoundWaveAudioChunk, ESPMode::ThreadSafe>(MoveTemp(DecodedAudioInfo.PCMInfo.PCMData),
+				DecodedAudioInfo.SoundWaveBasicInfo.SampleRate, DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels, StartFrame);
+			DeliverAudioChunk(ERuntimeAudioSubscriptionSource::Populated, Chunk);
+			BroadcastPopulatedAudioChunk(Chunk);
 		}
 	}
 
@@ -208,8 +368,6 @@ void UStreamingSoundWave::PopulateAudioDataFromDecodedInfo(FDecodedAudioStruct&&
 			});
 		}
 	}
-
-	UE_LOG(LogRuntimeAudioImporter, Verbose, TEXT("Successfully added audio data to streaming sound wave.\nAdded audio info: %s"), *DecodedAudioInfo.ToString());
 }
 
 UStreamingSoundWave* UStreamingSoundWave::CreateStreamingSoundWave()
@@ -259,125 +417,343 @@ void UStreamingSoundWave::PreAllocateAudioData(int64 NumOfBytesToPreAllocate, co
 		});
 	};
 
-	PCMBufferInfo->PCMData.Reserve(NumOfBytesToPreAllocate / sizeof(float));
+	if (PCMStorageFormat == ERuntimePCMStorageFormat::Int16)
+	{
+		PCMBufferInfo->PCMDataInt16.Reserve(NumOfBytesToPreAllocate / sizeof(int16));
+	}
+	else
+	{
+		PCMBufferInfo->PCMData.Reserve(NumOfBytesToPreAllocate / sizeof(float));
+	}
 
 	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Successfully pre-allocated '%lld' number of bytes"), NumOfBytesToPreAllocate);
 	ExecuteResult(true);
 }
 
 void UStreamingSoundWave::AppendAudioDataFromEncoded(TArray<uint8> AudioData, ERuntimeAudioFormat AudioFormat)
+{
+	FStreamingSoundWaveAppendRequest Request;
+	{
+		Request.AudioData = MoveTemp(AudioData);
+		Request.bEncoded = true;
+		Request.AudioFormat = AudioFormat;
+	}
+
+	QueueAppendRequest(MoveTemp(Request));
+}
+
+void UStreamingSoundWave::AppendAudioDataFromEncodedStream(TArray<uint8> AudioData, ERuntimeAudioFormat AudioFormat)
 {
 	if (IsInGameThread())
 	{
-		AudioTaskPipe->Launch(AudioTaskPipe->GetDebugName(), [WeakThis = MakeWeakObjectPtr(this), AudioData = MoveTemp(AudioData), AudioFormat]() mutable
+		LaunchAudioTask([WeakThis = MakeWeakObjectPtr(this), AudioData = MoveTemp(AudioData), AudioFormat]() mutable
 		{
 			if (WeakThis.IsValid())
 			{
-				WeakThis->AppendAudioDataFromEncoded(MoveTemp(AudioData), AudioFormat);
+				WeakThis->AppendAudioDataFromEncodedStream(MoveTemp(AudioData), AudioFormat);
 			}
 			else
 			{
-				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to append audio data to streaming sound wave as the streaming sound wave has been destroyed"));
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to append encoded stream to streaming sound wave as the streaming sound wave has been destroyed"));
 			}
-		}, UE::Tasks::ETaskPriority::BackgroundHigh);
+		});
+		return;
+	}
+
+	if (AudioData.Num() <= 0)
+	{
+		return;
+	}
+
+	// Holding the session guard until the decoded slice is appended, so that the slices decoded concurrently are appended in the order they were decoded
+	FRAIScopeLock Lock(&DecoderSessionGuard);
+
+	if (!DecoderSession.IsValid() && !CreateDecoderSession_Internal(AudioData, AudioFormat))
+	{
 		return;
 	}
 
-	FEncodedAudioStruct EncodedAudioInfo(MoveTemp(AudioData), AudioFormat);
 	FDecodedAudioStruct DecodedAudioInfo;
-	if (!URuntimeAudioImporterLibrary::DecodeAudioData(MoveTemp(EncodedAudioInfo), DecodedAudioInfo))
+	if (!DecoderSession->PushData(AudioData.GetData(), AudioData.Num(), DecodedAudioInfo))
 	{
-		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to decode audio data to populate streaming sound wave audio data"));
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to decode encoded stream to populate streaming sound wave audio data. The next appended slice starts a new stream"));
+		DecoderSession.Reset();
 		return;
 	}
 
-	PopulateAudioDataFromDecodedInfo(MoveTemp(DecodedAudioInfo));
+	// The slice may not have completed any frame
+	if (DecodedAudioInfo.PCMInfo.PCMNumOfFrames > 0)
+	{
+		PopulateAudioDataFromDecodedInfo(MoveTemp(DecodedAudioInfo));
+	}
 }
 
-void UStreamingSoundWave::AppendAudioDataFromRAW(TArray<uint8> RAWData, ERuntimeRAWAudioFormat RAWFormat, int32 InSampleRate, int32 NumOfChannels)
+void UStreamingSoundWave::FinishEncodedStream()
 {
 	if (IsInGameThread())
 	{
-		AudioTaskPipe->Launch(AudioTaskPipe->GetDebugName(), [WeakThis = MakeWeakObjectPtr(this), RAWData = MoveTemp(RAWData), RAWFormat, InSampleRate, NumOfChannels]() mutable
+		LaunchAudioTask([WeakThis = MakeWeakObjectPtr(this)]()
 		{
 			if (WeakThis.IsValid())
 			{
-				WeakThis->AppendAudioDataFromRAW(MoveTemp(RAWData), RAWFormat, InSampleRate, NumOfChannels);
+				WeakThis->FinishEncodedStream();
 			}
 			else
 			{
-				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to append RAW audio data to streaming sound wave as the streaming sound wave has been destroyed"));
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to finish encoded stream as the streaming sound wave has been destroyed"));
 			}
-		}, UE::Tasks::ETaskPriority::BackgroundHigh);
+		});
 		return;
 	}
 
-	uint8* ByteDataPtr = RAWData.GetData();
-	const int64 ByteDataSize = RAWData.Num();
+	// Holding the session guard until the rest of the stream is appended, so that it is not appended before a slice being decoded concurrently
+	FRAIScopeLock Lock(&DecoderSessionGuard);
+	TUniquePtr<FBaseRuntimeDecoderSession> Session = MoveTemp(DecoderSession);
 
-	float* Float32DataPtr = nullptr;
-	int64 NumOfSamples = 0;
+	if (!Session.IsValid())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Unable to finish encoded stream as no encoded stream has been appended"));
+		return;
+	}
 
-	// Transcoding RAW data to 32-bit float data
+	FDecodedAudioStruct DecodedAudioInfo;
+	if (!Session->Finish(DecodedAudioInfo))
 	{
-		switch (RAWFormat)
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to finish encoded stream of streaming sound wave '%s'"), *GetName());
+		return;
+	}
+
+	if (DecodedAudioInfo.PCMInfo.PCMNumOfFrames > 0)
+	{
+		PopulateAudioDataFromDecodedInfo(MoveTemp(DecodedAudioInfo));
+	}
+}
+
+bool UStreamingSoundWave::CreateDecoderSession_Internal(const TArray<uint8>& AudioData, ERuntimeAudioFormat AudioFormat)
+{
+	FRuntimeCodecFactory CodecFactory;
+	TArray<FBaseRuntimeCodec*> Codecs;
+	if (AudioFormat == ERuntimeAudioFormat::Auto)
+	{
+		Codecs = CodecFactory.GetCodecs(FRuntimeBulkDataBuffer<uint8>(AudioData));
+	}
+	else
+	{
+		Codecs = CodecFactory.GetCodecs(AudioFormat);
+	}
+
+	for (FBaseRuntimeCodec* Codec : Codecs)
+	{
+		DecoderSession = Codec->CreateDecoderSession();
+		if (DecoderSession.IsValid())
 		{
-		case ERuntimeRAWAudioFormat::Int8:
-			{
-				NumOfSamples = ByteDataSize / sizeof(int8);
-				FRAW_RuntimeCodec::TranscodeRAWData<int8, float>(reinterpret_cast<int8*>(ByteDataPtr), NumOfSamples, Float32DataPtr);
-				break;
-			}
-		case ERuntimeRAWAudioFormat::UInt8:
-			{
-				NumOfSamples = ByteDataSize / sizeof(uint8);
-				FRAW_RuntimeCodec::TranscodeRAWData<uint8, float>(ByteDataPtr, NumOfSamples, Float32DataPtr);
-				break;
-			}
-		case ERuntimeRAWAudioFormat::Int16:
-			{
-				NumOfSamples = ByteDataSize / sizeof(int16);
-				FRAW_RuntimeCodec::TranscodeRAWData<int16, float>(reinterpret_cast<int16*>(ByteDataPtr), NumOfSamples, Float32DataPtr);
-				break;
-			}
-		case ERuntimeRAWAudioFormat::UInt16:
+			break;
+		}
+	}
+
+	if (!DecoderSession.IsValid())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to append encoded stream as the %s format does not support incremental decoding. Use AppendAudioDataFromEncoded instead"), *UEnum::GetValueAsString(AudioFormat));
+		return false;
+	}
+
+	// Decoding directly to the format of the previously populated audio data (or the initial desired one), so that the stream is converted continuously across slices
+	{
+		FRAIScopeLock Lock(&*DataGuard);
+		if (PCMBufferInfo->GetNumOfSamples() > 0)
+		{
+			DecoderSession->SetTargetFormat(static_cast<uint32>(SampleRate), static_cast<uint32>(NumChannels));
+		}
+		else
+		{
+			DecoderSession->SetTargetFormat(InitialDesiredSampleRate.Get(0), InitialDesiredNumOfChannels.Get(0));
+		}
+	}
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Started decoding %s encoded stream for streaming sound wave '%s'"), *UEnum::GetValueAsString(DecoderSession->GetAudioFormat()), *GetName());
+	return true;
+}
+
+void UStreamingSoundWave::AppendAudioDataFromRAW(TArray<uint8> RAWData, ERuntimeRAWAudioFormat RAWFormat, int32 InSampleRate, int32 NumOfChannels)
+{
+	FStreamingSoundWaveAppendRequest Request;
+	{
+		Request.AudioData = MoveTemp(RAWData);
+		Request.RAWFormat = RAWFormat;
+		Request.SampleRate = InSampleRate;
+		Request.NumOfChannels = NumOfChannels;
+	}
+
+	QueueAppendRequest(MoveTemp(Request));
+}
+
+void UStreamingSoundWave::GetAppendStatistics(int64& NumOfTasksLaunched, int64& NumOfChunksAppended) const
+{
+	NumOfTasksLaunched = NumOfAudioTasksLaunched.load(std::memory_order_relaxed);
+	NumOfChunksAppended = NumOfAppendedChunks.load(std::memory_order_relaxed);
+}
+
+void UStreamingSoundWave::LaunchAudioTask(TUniqueFunction<void()>&& Task, UE::Tasks::ETaskPriority Priority)
+{
+	FRAIScopeLock Lock(&AppendBatchGuard);
+
+	// The appends queued after this task must not join a batch that is drained before it
+	OpenAppendBatch.Reset();
+
+	++NumOfAudioTasksLaunched;
+	AudioTaskPipe->Launch(AudioTaskPipe->GetDebugName(), MoveTemp(Task), Priority);
+}
+
+void UStreamingSoundWave::QueueAppendRequest(FStreamingSoundWaveAppendRequest&& Request)
+{
+	FRAIScopeLock Lock(&AppendBatchGuard);
+
+	// Joining the batch of the drain task that has not started yet, if any, instead of launching a task per append
+	if (!OpenAppendBatch.IsValid())
+	{
+		OpenAppendBatch = MakeShared<TArray<FStreamingSoundWaveAppendRequest>, ESPMode::ThreadSafe>();
+
+		++NumOfAudioTasksLaunched;
+		AudioTaskPipe->Launch(AudioTaskPipe->GetDebugName(), [WeakThis = MakeWeakObjectPtr(this), Batch = OpenAppendBatch]()
+		{
+			if (!WeakThis.IsValid())
 			{
-				NumOfSamples = ByteDataSize / sizeof(uint16);
-				FRAW_RuntimeCodec::TranscodeRAWData<uint16, float>(reinterpret_cast<uint16*>(ByteDataPtr), NumOfSamples, Float32DataPtr);
-				break;
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to append audio data to streaming sound wave as the streaming sound wave has been destroyed"));
+				return;
 			}
-		case ERuntimeRAWAudioFormat::UInt32:
+
+			TArray<FStreamingSoundWaveAppendRequest> Requests;
 			{
-				NumOfSamples = ByteDataSize / sizeof(uint32);
-				FRAW_RuntimeCodec::TranscodeRAWData<uint32, float>(reinterpret_cast<uint32*>(ByteDataPtr), NumOfSamples, Float32DataPtr);
-				break;
+				FRAIScopeLock Lock(&WeakThis->AppendBatchGuard);
+				if (WeakThis->OpenAppendBatch == Batch)
+				{
+					WeakThis->OpenAppendBatch.Reset();
+				}
+				Requests = MoveTemp(*Batch);
 			}
-		case ERuntimeRAWAudioFormat::Int32:
+
+			WeakThis->ProcessAppendRequests(MoveTemp(Requests));
+		}, UE::Tasks::ETaskPriority::BackgroundHigh);
+	}
+
+	OpenAppendBatch->Add(MoveTemp(Request));
+}
+
+void UStreamingSoundWave::ProcessAppendRequests(TArray<FStreamingSoundWaveAppendRequest>&& Requests)
+{
+	NumOfAppendedChunks += Requests.Num();
+
+	// Decoding directly to the format of the previously populated audio data (or the initial desired one), so that the audio data is converted block by block while decoding
+	uint32 TargetSampleRate, TargetNumOfChannels;
+	{
+		FRAIScopeLock Lock(&*DataGuard);
+		GetAppendFormat_Internal(TargetSampleRate, TargetNumOfChannels);
+	}
+
+	// Bringing every chunk to 32-bit float in the format of the first one
+	TArray<FDecodedAudioStruct> DecodedChunks;
+	DecodedChunks.Reserve(Requests.Num());
+	int64 NumOfSamples = 0;
+	for (FStreamingSoundWaveAppendRequest& Request : Requests)
+	{
+		FDecodedAudioStruct DecodedAudioInfo;
+		if (Request.bEncoded)
+		{
+			FEncodedAudioStruct EncodedAudioInfo(MoveTemp(Request.AudioData), Request.AudioFormat);
+			if (!URuntimeAudioImporterLibrary::DecodeAudioData(MoveTemp(EncodedAudioInfo), DecodedAudioInfo, TargetSampleRate, TargetNumOfChannels))
 			{
-				NumOfSamples = ByteDataSize / sizeof(int32);
-				FRAW_RuntimeCodec::TranscodeRAWData<int32, float>(reinterpret_cast<int32*>(ByteDataPtr), NumOfSamples, Float32DataPtr);
-				break;
+				UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to decode audio data to populate streaming sound wave audio data"));
+				continue;
 			}
-		case ERuntimeRAWAudioFormat::Float32:
+		}
+		else if (!TranscodeRAWDataToDecodedInfo(Request.AudioData, Request.RAWFormat, Request.SampleRate, Request.NumOfChannels, DecodedAudioInfo))
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to transcode RAW data to decoded audio info"));
+			continue;
+		}
+
+		// Deciding per chunk, as a single decision for the whole batch would either skip voiced chunks or append silent ones
+		if (!ProcessVADForAppend(DecodedAudioInfo))
+		{
+			continue;
+		}
+
+		if (DecodedChunks.Num() > 0)
+		{
+			const FSoundWaveBasicStruct& BlockInfo = DecodedChunks[0].SoundWaveBasicInfo;
+			if (DecodedAudioInfo.SoundWaveBasicInfo.SampleRate != BlockInfo.SampleRate || DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels != BlockInfo.NumOfChannels)
 			{
-				NumOfSamples = ByteDataSize / sizeof(float);
-				Float32DataPtr = static_cast<float*>(FMemory::Memcpy(FMemory::Malloc(ByteDataSize), ByteDataPtr, ByteDataSize));
-				break;
+				if (!FRuntimePCMFormatConverter::ConvertDecodedAudio(DecodedAudioInfo, BlockInfo.SampleRate, BlockInfo.NumOfChannels))
+				{
+					UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to convert the appended audio data to the format of the rest of the batch"));
+					continue;
+				}
 			}
 		}
+
+		NumOfSamples += DecodedAudioInfo.PCMInfo.PCMData.GetView().Num();
+		DecodedChunks.Add(MoveTemp(DecodedAudioInfo));
 	}
 
-	if (!Float32DataPtr || NumOfSamples <= 0)
+	if (DecodedChunks.Num() == 0)
 	{
-		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to transcode RAW data to decoded audio info"))
 		return;
 	}
 
+	// Appending the voiced chunks of the batch as a single block, so that it is resampled, locked and broadcast once
+	FDecodedAudioStruct BlockAudioInfo = MoveTemp(DecodedChunks[0]);
+	if (DecodedChunks.Num() > 1)
+	{
+		float* BlockPCMData = static_cast<float*>(FMemory::Malloc(NumOfSamples * sizeof(float)));
+		if (!BlockPCMData)
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to allocate memory to append %lld samples to streaming sound wave"), NumOfSamples);
+			return;
+		}
+
+		int64 NumOfCopiedSamples = 0;
+		int64 NumOfFrames = 0;
+		for (int32 ChunkIndex = 0; ChunkIndex < DecodedChunks.Num(); ++ChunkIndex)
+		{
+			const FPCMStruct& PCMInfo = ChunkIndex == 0 ? BlockAudioInfo.PCMInfo : DecodedChunks[ChunkIndex].PCMInfo;
+			const int64 NumOfChunkSamples = PCMInfo.PCMData.GetView().Num();
+			FMemory::Memcpy(BlockPCMData + NumOfCopiedSamples, PCMInfo.PCMData.GetView().GetData(), NumOfChunkSamples * sizeof(float));
+			NumOfCopiedSamples += NumOfChunkSamples;
+			NumOfFrames += PCMInfo.PCMNumOfFrames;
+		}
+
+		BlockAudioInfo.PCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(BlockPCMData, NumOfSamples);
+		BlockAudioInfo.PCMInfo.PCMNumOfFrames = NumOfFrames;
+		BlockAudioInfo.SoundWaveBasicInfo.Duration = static_cast<float>(NumOfFrames) / BlockAudioInfo.SoundWaveBasicInfo.SampleRate;
+	}
+
+	AppendDecodedAudio(MoveTemp(BlockAudioInfo));
+}
+
+int64 UStreamingSoundWave::PopulateAudioDataFromRing(FRuntimeAudioRingBuffer& Ring, uint32 InSampleRate, uint32 NumOfChannels)
+{
+	const int32 NumOfSamples = NumOfChannels > 0 ? Ring.Num() / static_cast<int32>(NumOfChannels) * static_cast<int32>(NumOfChannels) : 0;
+	if (NumOfSamples <= 0 || InSampleRate == 0)
+	{
+		return 0;
+	}
+
+	// A single allocation for everything the ring holds, owned by the appended audio data
+	float* PCMData = static_cast<float*>(FMemory::Malloc(NumOfSamples * sizeof(float)));
+	if (!PCMData)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to allocate memory to append %d samples to streaming sound wave"), NumOfSamples);
+		return 0;
+	}
+	Ring.Pop(PCMData, NumOfSamples);
+
+	++NumOfAppendedChunks;
+
 	FDecodedAudioStruct DecodedAudioInfo;
 	{
 		FPCMStruct PCMInfo;
 		{
-			PCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(Float32DataPtr, NumOfSamples);
+			PCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(PCMData, NumOfSamples);
 			PCMInfo.PCMNumOfFrames = NumOfSamples / NumOfChannels;
 		}
 		DecodedAudioInfo.PCMInfo = MoveTemp(PCMInfo);
@@ -391,10 +767,170 @@ void UStreamingSoundWave::AppendAudioDataFromRAW(TArray<uint8> RAWData, ERuntime
 		DecodedAudioInfo.SoundWaveBasicInfo = MoveTemp(SoundWaveBasicInfo);
 	}
 
+	const int64 NumOfFrames = DecodedAudioInfo.PCMInfo.PCMNumOfFrames;
 	PopulateAudioDataFromDecodedInfo(MoveTemp(DecodedAudioInfo));
+	return NumOfFrames;
 }
 
 void UStreamingSoundWave::SetStopSoundOnPlaybackFinish(bool bStop)
 {
 	bStopSoundOnPlaybackFinish = bStop;
 }
+
+bool UStreamingSoundWave::StartEncodingToFile(const FString& FilePath, ERuntimeAudioFormat AudioFormat, uint8 Quality)
+{
+#if WITH_RUNTIMEAUDIOIMPORTER_FILEOPERATION_SUPPORT
+	if (AudioFormat == ERuntimeAudioFormat::Auto)
+	{
+		const TArray<ERuntimeAudioFormat> AudioFormats = URuntimeAudioUtilities::GetAudioFormats(FilePath);
+
+		// Can't determine the format if there are multiple audio formats available
+		AudioFormat = AudioFormats.Num() == 1 ? AudioFormats[0] : ERuntimeAudioFormat::Invalid;
+	}
+
+	TUniquePtr<FBaseRuntimeEncoderSession> Session;
+	{
+		FRuntimeCodecFactory CodecFactory;
+		for (FBaseRuntimeCodec* Codec : CodecFactory.GetCodecs(AudioFormat))
+		{
+			Session = Codec->CreateEncoderSession();
+			if (Session.IsValid())
+			{
+				break;
+			}
+		}
+	}
+
+	if (!Session.IsValid())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to start encoding to the file '%s' as the %s format does not support incremental encoding"), *FilePath, *UEnum::GetValueAsString(AudioFormat));
+		return false;
+	}
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(FilePath));
+
+	TUniquePtr<IFileHandle> FileHandle(PlatformFile.OpenWrite(*FilePath));
+	if (!FileHandle.IsValid())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to start encoding to the file '%s' as the file cannot be opened for writing"), *FilePath);
+		return false;
+	}
+
+	// Writing asynchronously so that the disk I/O does not stall appending the audio data
+	return StartEncoding(MoveTemp(Session), MakeUnique<FRuntimeFileHandleAudioSink>(MoveTemp(FileHandle), FRuntimeFileHandleAudioSink::DefaultAsyncWriteBufferSize), Quality);
+#else
+	UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to start encoding to a file as file operation support is disabled"));
+	return false;
+#endif
+}
+
+bool UStreamingSoundWave::StartEncoding(TUniquePtr<FBaseRuntimeEncoderSession> Session, TUniquePtr<FBaseRuntimeEncodedAudioSink> Sink, uint8 Quality)
+{
+	if (!Session.IsValid() || !Sink.IsValid())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to start encoding as the encoder session or the sink is invalid"));
+		return false;
+	}
+
+	FRAIScopeLock Lock(&EncoderSessionGuard);
+
+	if (EncoderSession.IsValid())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to start encoding as the streaming sound wave is already being encoded. Call StopEncodingToFile first"));
+		return false;
+	}
+
+	EncoderSession = MoveTemp(Session);
+	PendingEncoderSink = MoveTemp(Sink);
+	EncoderQuality = Quality;
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Started encoding the streaming sound wave '%s' to the %s format"), *GetName(), *UEnum::GetValueAsString(EncoderSession->GetAudioFormat()));
+	return true;
+}
+
+void UStreamingSoundWave::StopEncodingToFile(const FOnStopEncodingToFileResult& Result)
+{
+	StopEncodingToFile(FOnStopEncodingToFileResultNative::CreateWeakLambda(this, [Result](bool bSucceeded)
+	{
+		Result.ExecuteIfBound(bSucceeded);
+	}));
+}
+
+void UStreamingSoundWave::StopEncodingToFile(const FOnStopEncodingToFileResultNative& Result)
+{
+	// Going through the audio task pipe so that the audio data queued for appending is encoded first
+	LaunchAudioTask([WeakThis = MakeWeakObjectPtr(this), Result]()
+	{
+		const bool bSucceeded = WeakThis.IsValid() && WeakThis->FinishEncoderSession();
+		if (!WeakThis.IsValid())
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to stop encoding to file as the streaming sound wave has been destroyed"));
+		}
+
+		AsyncTask(ENamedThreads::AnyBackgroundHiPriTask, [Result, bSucceeded]()
+		{
+			Result.ExecuteIfBound(bSucceeded);
+		});
+	});
+}
+
+bool UStreamingSoundWave::IsEncodingToFile() const
+{
+	FRAIScopeLock Lock(&EncoderSessionGuard);
+	return EncoderSession.IsValid();
+}
+
+void UStreamingSoundWave::PushToEncoderSession(const FDecodedAudioStruct& DecodedAudioInfo)
+{
+	FRAIScopeLock Lock(&EncoderSessionGuard);
+
+	if (!EncoderSession.IsValid())
+	{
+		return;
+	}
+
+	if (!EncoderSession->IsActive())
+	{
+		if (!EncoderSession->Begin(MoveTemp(PendingEncoderSink), DecodedAudioInfo.SoundWaveBasicInfo.SampleRate, DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels, EncoderQuality))
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to begin encoding the streaming sound wave '%s'. Encoding will be stopped"), *GetName());
+			EncoderSession.Reset();
+			return;
+		}
+	}
+
+	if (!EncoderSession->PushFrames(DecodedAudioInfo.PCMInfo.PCMData.GetView().GetData(), DecodedAudioInfo.PCMInfo.PCMNumOfFrames))
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to encode the audio data appended to the streaming sound wave '%s'"), *GetName());
+	}
+}
+
+bool UStreamingSoundWave::FinishEncoderSession()
+{
+	TUniquePtr<FBaseRuntimeEncoderSession> Session;
+	{
+		FRAIScopeLock Lock(&EncoderSessionGuard);
+		Session = MoveTemp(EncoderSession);
+		PendingEncoderSink.Reset();
+	}
+
+	return FinishEncoderSession(MoveTemp(Session), GetName());
+}
+
+bool UStreamingSoundWave::FinishEncoderSession(TUniquePtr<FBaseRuntimeEncoderSession> Session, const FString& SoundWaveName)
+{
+	if (!Session.IsValid())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to stop encoding to file as encoding has not been started"));
+		return false;
+	}
+
+	if (!Session->IsActive())
+	{
+		UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Encoding to file has been stopped before any audio data was appended to the streaming sound wave '%s'"), *SoundWaveName);
+		return false;
+	}
+
+	return Session->Finish();
+}
@@ -5,12 +5,117 @@
 #include "AudioDevice.h"
 #include "Codecs/RAW_RuntimeCodec.h"
 #include "Engine/World.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+
+#if WITH_RUNTIMEAUDIOIMPORTER_SYNTH_SOUND_GENERATOR_SUPPORT
+FSynthBasedSoundWaveRenderWorker::FSynthBasedSoundWaveRenderWorker(ISoundGeneratorPtr InSoundGenerator, int32 InSampleRate, int32 InNumOfChannels, int32 InNumOfFramesPerBlock, TFunction<void(int32)> InOnBlockGenerated)
+	: SoundGenerator(MoveTemp(InSoundGenerator))
+  , SampleRate(InSampleRate)
+  , NumOfChannels(InNumOfChannels)
+  , NumOfFramesPerBlock(InNumOfFramesPerBlock)
+  , OnBlockGenerated(MoveTemp(InOnBlockGenerated))
+  , Ring(FMath::Max(InSampleRate * InNumOfChannels, InNumOfFramesPerBlock * InNumOfChannels * 8))
+  , bStopping(false)
+  , NumOfDroppedSamples(0)
+{
+	BlockBuffer.SetNumZeroed(NumOfFramesPerBlock * NumOfChannels);
+	Thread.Reset(FRunnableThread::Create(this, TEXT("SynthBasedSoundWaveRenderWorker"), 0, TPri_AboveNormal));
+}
+
+FSynthBasedSoundWaveRenderWorker::~FSynthBasedSoundWaveRenderWorker()
+{
+	StopAndWait();
+}
+
+uint32 FSynthBasedSoundWaveRenderWorker::Run()
+{
+	const double BlockDuration = static_cast<double>(NumOfFramesPerBlock) / SampleRate;
+	double NextBlockTime = FPlatformTime::Seconds();
+
+	while (!bStopping.load(std::memory_order_relaxed))
+	{
+		const int32 NumOfGeneratedSamples = FMath::Min(SoundGenerator->OnGenerateAudio(BlockBuffer.GetData(), BlockBuffer.Num()), BlockBuffer.Num());
+
+		// All-zero blocks generally mean the generator has nothing to generate at the moment (e.g. in pixel streaming when the player is not talking), same as when pulling on tick
+		if (NumOfGeneratedSamples > 0 && !FRAIMemory::MemIsZero(BlockBuffer.GetData(), NumOfGeneratedSamples * sizeof(float)))
+		{
+			// The whole block is dropped if it does not fit, so that the ring never holds partial frames
+			if (Ring.GetRemainder() >= NumOfGeneratedSamples)
+			{
+				Ring.Push(BlockBuffer.GetData(), NumOfGeneratedSamples);
+			}
+			else
+			{
+				NumOfDroppedSamples.fetch_add(NumOfGeneratedSamples, std::memory_order_relaxed);
+			}
+
+			OnBlockGenerated(Ring.Num());
+		}
+
+		// Pacing the generation to real time. Catching up is pointless after a long stall (e.g. a breakpoint), so the schedule is restarted instead
+		NextBlockTime += BlockDuration;
+		const double CurrentTime = FPlatformTime::Seconds();
+		if (CurrentTime - NextBlockTime > BlockDuration * 4)
+		{
+			NextBlockTime = CurrentTime;
+		}
+		else if (NextBlockTime > CurrentTime)
+		{
+			FPlatformProcess::SleepNoStats(static_cast<float>(NextBlockTime - CurrentTime));
+		}
+	}
+
+	return 0;
+}
+
+void FSynthBasedSoundWaveRenderWorker::Stop()
+{
+	bStopping = true;
+}
+
+void FSynthBasedSoundWaveRenderWorker::StopAndWait()
+{
+	Stop();
+	if (Thread.IsValid())
+	{
+		Thread->WaitForCompletion();
+		Thread.Reset();
+	}
+}
+#endif
 
 USynthBasedSoundWave::USynthBasedSoundWave(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer), SynthComponent(nullptr)
 {
 }
 
+void USynthBasedSoundWave::BeginDestroy()
+{
+	StopRenderWorker();
+	Super::BeginDestroy();
+}
+
+bool USynthBasedSoundWave::SetRenderRateGeneration(bool bEnable, int32 NumOfFramesPerBlock)
+{
+#if WITH_RUNTIMEAUDIOIMPORTER_SYNTH_SOUND_GENERATOR_SUPPORT
+	if (NumOfFramesPerBlock <= 0)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to set render-rate generation for sound wave '%s' as the number of frames per block (%d) is invalid"), *GetName(), NumOfFramesPerBlock);
+		return false;
+	}
+
+	bRenderRateGeneration = bEnable;
+	NumOfFramesPerRenderBlock = NumOfFramesPerBlock;
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Render-rate generation for sound wave '%s' has been %s (%d frames per block). Takes effect on the next capture"), *GetName(), bEnable ? TEXT("enabled") : TEXT("disabled"), NumOfFramesPerBlock);
+	return true;
+#else
+	UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to set render-rate generation as it is only supported on Unreal Engine version >= 5.0"));
+	return false;
+#endif
+}
+
 USynthBasedSoundWave* USynthBasedSoundWave::CreateSynthBasedSoundWave(USynthComponent* InSynthComponent)
 {
 	if (!IsInGameThread())
@@ -71,6 +176,7 @@ bool USynthBasedSoundWave::StartCapture_Implementation(int32 DeviceId)
 		{
 			// Indicate that the sound wave should start capturing audio data
 			WeakThis->bCapturing = true;
+			WeakThis->StartRenderWorker();
 		}
 	});
 
@@ -82,6 +188,9 @@ void USynthBasedSoundWave::StopCapture_Implementation()
 {
 	bCapturing = false;
 
+	// The generator must not be pulled anymore once it has been told to end generating
+	StopRenderWorker();
+
 #if WITH_RUNTIMEAUDIOIMPORTER_SYNTH_SOUND_GENERATOR_SUPPORT
 	if (SoundGenerator)
 	{
@@ -131,9 +240,14 @@ void USynthBasedSoundWave::Tick(float DeltaTime)
 	{
 		StopSynthSound();
 	}
-	if (IsCapturing())
+	if (IsCapturing()
+#if WITH_RUNTIMEAUDIOIMPORTER_SYNTH_SOUND_GENERATOR_SUPPORT
+		// The render worker pulls the sound generator instead
+		&& !(bRenderRateGeneration && SoundGenerator)
+#endif
+	)
 	{
-		AudioTaskPipe->Launch(AudioTaskPipe->GetDebugName(), [WeakThis = MakeWeakObjectPtr(this)]() mutable
+		LaunchAudioTask([WeakThis = MakeWeakObjectPtr(this)]() mutable
 		{
 			if (!WeakThis.IsValid())
 			{
@@ -214,8 +328,109 @@ void USynthBasedSoundWave::Tick(float DeltaTime)
 				WeakThis->PopulateAudioDataFromDecodedInfo(MoveTemp(DecodedAudioInfo));
 				UE_LOG(LogRuntimeAudioImporter, Verbose, TEXT("Audio data has been appended to the sound wave '%s'"), *WeakThis->GetName());
 			}
+		}, UE::Tasks::ETaskPriority::Normal);
+	}
+}
+
+bool USynthBasedSoundWave::StartRenderWorker()
+{
+#if WITH_RUNTIMEAUDIOIMPORTER_SYNTH_SOUND_GENERATOR_SUPPORT
+	if (!bRenderRateGeneration)
+	{
+		return false;
+	}
+
+	USynthSound* SynthSound = GetSynthSound();
+	if (!SoundGenerator || !SynthSound)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Unable to start render-rate generation for sound wave '%s' as the synth component does not provide a sound generator. Falling back to generating on tick"), *GetName());
+		return false;
+	}
+
+	const int32 SynthSampleRate = SynthSound->GetSampleRateForCurrentPlatform();
+	const int32 SynthNumOfChannels = SynthSound->NumChannels;
+
+	// Draining every ~50 ms (but not more often than every block), so that appending does not happen at block rate
+	const int32 NumOfSamplesPerDrain = FMath::Max(SynthSampleRate * SynthNumOfChannels / 20, NumOfFramesPerRenderBlock * SynthNumOfChannels);
+
+	TSharedPtr<FSynthBasedSoundWaveRenderWorker, ESPMode::ThreadSafe> Worker = MakeShared<FSynthBasedSoundWaveRenderWorker, ESPMode::ThreadSafe>(SoundGenerator, SynthSampleRate, SynthNumOfChannels, NumOfFramesPerRenderBlock,
+		[WeakThis = MakeWeakObjectPtr(this), NumOfSamplesPerDrain](int32 NumOfQueuedSamples)
+		{
+			USynthBasedSoundWave* ThisPtr = WeakThis.Get();
+			if (!ThisPtr || NumOfQueuedSamples < NumOfSamplesPerDrain || ThisPtr->bRenderDrainQueued.exchange(true))
+			{
+				return;
+			}
+
+			ThisPtr->LaunchAudioTask([WeakThis]()
+			{
+				if (!WeakThis.IsValid())
+				{
+					return;
+				}
+
+				WeakThis->bRenderDrainQueued = false;
+				TSharedPtr<FSynthBasedSoundWaveRenderWorker, ESPMode::ThreadSafe> Worker;
+				{
+					FRAIScopeLock Lock(&WeakThis->RenderWorkerGuard);
+					Worker = WeakThis->RenderWorker;
+				}
+				if (Worker.IsValid())
+				{
+					WeakThis->DrainRenderWorker(*Worker);
+				}
+			});
 		});
+
+	{
+		FRAIScopeLock Lock(&RenderWorkerGuard);
+		RenderWorker = MoveTemp(Worker);
 	}
+
+	UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Started render-rate generation for sound wave '%s' (%d Hz, %d channels, %d frames per block)"), *GetName(), SynthSampleRate, SynthNumOfChannels, NumOfFramesPerRenderBlock);
+	return true;
+#else
+	return false;
+#endif
+}
+
+void USynthBasedSoundWave::StopRenderWorker()
+{
+#if WITH_RUNTIMEAUDIOIMPORTER_SYNTH_SOUND_GENERATOR_SUPPORT
+	TSharedPtr<FSynthBasedSoundWaveRenderWorker, ESPMode::ThreadSafe> Worker;
+	{
+		FRAIScopeLock Lock(&RenderWorkerGuard);
+		Worker = MoveTemp(RenderWorker);
+	}
+
+	if (!Worker.IsValid())
+	{
+		return;
+	}
+
+	Worker->StopAndWait();
+
+	if (Worker->GetNumOfDroppedSamples() > 0)
+	{
+		UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Render-rate generation for sound wave '%s' dropped %lld samples because they were not appended in time"), *GetName(), Worker->GetNumOfDroppedSamples());
+	}
+
+	// Appending whatever is left in the ring, after the drains already queued
+	LaunchAudioTask([WeakThis = MakeWeakObjectPtr(this), Worker]()
+	{
+		if (WeakThis.IsValid())
+		{
+			WeakThis->DrainRenderWorker(*Worker);
+		}
+	});
+#endif
+}
+
+void USynthBasedSoundWave::DrainRenderWorker(FSynthBasedSoundWaveRenderWorker& Worker)
+{
+#if WITH_RUNTIMEAUDIOIMPORTER_SYNTH_SOUND_GENERATOR_SUPPORT
+	PopulateAudioDataFromRing(Worker.GetRing(), static_cast<uint32>(Worker.GetSampleRate()), static_cast<uint32>(Worker.GetNumOfChannels()));
+#endif
 }
 
 ETickableTickType USynthBasedSoundWave::GetTickableTickType() const
@@ -0,0 +1,111 @@
+// Georgy Treshchev 2024.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "RuntimeAudioImporterTestFlags.h"
+#include "Sound/ImportedSoundWaveAudioSubscription.h"
+
+namespace
+{
+	constexpr uint32 TestSampleRate = 48000;
+	constexpr int32 NumOfFramesPerChunk = 480;
+
+	/**
+	 * Make a mono chunk starting at the specified frame
+	 */
+	FImportedSoundWaveAudioChunkPtr MakeChunk(int64 StartFrame)
+	{
+		TArray<float> PCMData;
+		PCMData.Init(0.f, NumOfFramesPerChunk);
+		return MakeShared<const FImportedSoundWaveAudioChunk, ESPMode::ThreadSafe>(FRuntimeBulkDataBuffer<float>(PCMData), TestSampleRate, 1, StartFrame);
+	}
+
+	/**
+	 * Deliver the specified number of consecutive chunks to the subscription
+	 */
+	void DeliverChunks(FImportedSoundWaveAudioSubscription& Subscription, int32 NumOfChunks)
+	{
+		for (int32 ChunkIndex = 0; ChunkIndex < NumOfChunks; ++ChunkIndex)
+		{
+			Subscription.Deliver(MakeChunk(static_cast<int64>(ChunkIndex) * NumOfFramesPerChunk));
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAudioSubscriptionDropOldestTest, "RuntimeAudioImporter.SoundWave.AudioSubscription.DropOldest", RUNTIMEAUDIOIMPORTER_TEST_FLAGS)
+
+bool FAudioSubscriptionDropOldestTest::RunTest(const FString& Parameters)
+{
+	FImportedSoundWaveAudioSubscription Subscription(ERuntimeAudioSubscriptionSource::Populated, 3, ERuntimeAudioSubscriptionOverflowPolicy::DropOldest);
+	TestEqual(TEXT("The capacity is rounded up to a power of two"), Subscription.GetCapacity(), 4);
+
+	DeliverChunks(Subscription, 6);
+
+	FImportedSoundWaveAudioSubscriptionStats Stats = Subscription.GetStats();
+	TestEqual(TEXT("All chunks are counted as delivered"), Stats.NumOfDeliveredChunks, 6ll);
+	TestEqual(TEXT("The chunks that did not fit are dropped"), Stats.NumOfDroppedChunks, 2ll);
+	TestEqual(TEXT("The frames of the dropped chunks are counted"), Stats.NumOfDroppedFrames, 2ll * NumOfFramesPerChunk);
+	TestEqual(TEXT("The ring is full"), Stats.NumOfPendingChunks, 4);
+	TestEqual(TEXT("The pending frames are counted"), Stats.NumOfPendingFrames, 4ll * NumOfFramesPerChunk);
+	TestEqual(TEXT("The lag is the duration of the pending frames"), Stats.LagSeconds, 4.f * NumOfFramesPerChunk / TestSampleRate, KINDA_SMALL_NUMBER);
+
+	// The oldest chunks were dropped, so the latest ones are read in order
+	TArray<FImportedSoundWaveAudioChunkPtr> Chunks;
+	TestEqual(TEXT("All pending chunks are read"), Subscription.ReadAll(Chunks), 4);
+	for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ++ChunkIndex)
+	{
+		TestEqual(*FString::Printf(TEXT("Chunk %d is one of the latest, in order"), ChunkIndex), Chunks[ChunkIndex]->StartFrame, static_cast<int64>(ChunkIndex + 2) * NumOfFramesPerChunk);
+	}
+
+	FImportedSoundWaveAudioChunkPtr Chunk;
+	TestFalse(TEXT("Nothing is left to read"), Subscription.Read(Chunk));
+
+	Stats = Subscription.GetStats();
+	TestEqual(TEXT("The read chunks are counted"), Stats.NumOfReadChunks, 4ll);
+	TestEqual(TEXT("No chunks are pending"), Stats.NumOfPendingChunks, 0);
+	TestEqual(TEXT("No frames are pending"), Stats.NumOfPendingFrames, 0ll);
+	TestEqual(TEXT("The high-water mark is the capacity"), Stats.MaxNumOfPendingChunks, 4);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAudioSubscriptionDropNewestTest, "RuntimeAudioImporter.SoundWave.AudioSubscription.DropNewest", RUNTIMEAUDIOIMPORTER_TEST_FLAGS)
+
+bool FAudioSubscriptionDropNewestTest::RunTest(const FString& Parameters)
+{
+	FImportedSoundWaveAudioSubscription Subscription(ERuntimeAudioSubscriptionSource::Generated, 4, ERuntimeAudioSubscriptionOverflowPolicy::DropNewest);
+
+	DeliverChunks(Subscription, 6);
+
+	const FImportedSoundWaveAudioSubscriptionStats Stats = Subscription.GetStats();
+	TestEqual(TEXT("The chunks that did not fit are dropped"), Stats.NumOfDroppedChunks, 2ll);
+	TestEqual(TEXT("The ring is full"), Stats.NumOfPendingChunks, 4);
+
+	// The newest chunks were dropped, so the first ones are read contiguously
+	TArray<FImportedSoundWaveAudioChunkPtr> Chunks;
+	TestEqual(TEXT("All pending chunks are read"), Subscription.ReadAll(Chunks), 4);
+	for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ++ChunkIndex)
+	{
+		TestEqual(*FString::Printf(TEXT("Chunk %d is one of the first, in order"), ChunkIndex), Chunks[ChunkIndex]->StartFrame, static_cast<int64>(ChunkIndex) * NumOfFramesPerChunk);
+	}
+
+	// Reading makes room for new chunks again
+	Subscription.Deliver(MakeChunk(6ll * NumOfFramesPerChunk));
+	FImportedSoundWaveAudioChunkPtr Chunk;
+	if (TestTrue(TEXT("A chunk delivered after reading is read"), Subscription.Read(Chunk)))
+	{
+		TestEqual(TEXT("The chunk delivered after reading is not dropped"), Chunk->StartFrame, 6ll * NumOfFramesPerChunk);
+	}
+
+	// An ended subscription receives nothing
+	Subscription.Deactivate();
+	Subscription.Deliver(MakeChunk(7ll * NumOfFramesPerChunk));
+	TestFalse(TEXT("Nothing is delivered to an ended subscription"), Subscription.Read(Chunk));
+	TestEqual(TEXT("Chunks are not counted as delivered to an ended subscription"), Subscription.GetStats().NumOfDeliveredChunks, 7ll);
+
+	return true;
+}
+
+#endif
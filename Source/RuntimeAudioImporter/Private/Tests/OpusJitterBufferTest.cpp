@@ -0,0 +1,100 @@
+// Georgy Treshchev 2024.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "RuntimeAudioImporterTestFlags.h"
+#include "Codecs/OPUS_RuntimePacketCodec.h"
+
+namespace
+{
+	constexpr uint32 TestSampleRate = 48000;
+	constexpr int32 NumOfTestPackets = 13;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOpusJitterBufferLossAndReorderTest, "RuntimeAudioImporter.Codecs.OpusJitterBuffer.LossAndReorder", RUNTIMEAUDIOIMPORTER_TEST_FLAGS)
+
+bool FOpusJitterBufferLossAndReorderTest::RunTest(const FString& Parameters)
+{
+	FOPUS_RuntimePacketEncoder Encoder;
+	if (!TestTrue(TEXT("The encoder is initialized"), Encoder.Initialize(TestSampleRate, 1, 32000, 10)))
+	{
+		return false;
+	}
+
+	const int32 NumOfFramesPerPacket = Encoder.GetNumOfFramesPerPacket();
+	TArray<float> PCMData;
+	PCMData.SetNumUninitialized(NumOfFramesPerPacket * NumOfTestPackets);
+	for (int32 FrameIndex = 0; FrameIndex < PCMData.Num(); ++FrameIndex)
+	{
+		PCMData[FrameIndex] = 0.5f * FMath::Sin(2.f * PI * 440.f * FrameIndex / TestSampleRate);
+	}
+
+	TArray<TArray<uint8>> Packets;
+	if (!TestTrue(TEXT("The frames are encoded"), Encoder.PushFrames(PCMData.GetData(), PCMData.Num(), Packets))
+		|| !TestEqual(TEXT("Number of encoded packets"), Packets.Num(), NumOfTestPackets))
+	{
+		return false;
+	}
+
+	FOPUS_RuntimeJitterBuffer JitterBuffer(3);
+	if (!TestTrue(TEXT("The jitter buffer is initialized"), JitterBuffer.Initialize(TestSampleRate, 1)))
+	{
+		return false;
+	}
+
+	// Pushing a packet as received and decoding whatever has become ready, like a receiver would do
+	TArray<float> DecodedPCMData;
+	auto ReceivePacket = [&Packets, &JitterBuffer, &DecodedPCMData](int64 SequenceNumber)
+	{
+		TArray<uint8> Packet = Packets[SequenceNumber];
+		const bool bAccepted = JitterBuffer.PushPacket(SequenceNumber, MoveTemp(Packet));
+		JitterBuffer.PopFrames(DecodedPCMData);
+		return bAccepted;
+	};
+
+	// Packet 1 arrives after packet 2, which arrives twice
+	TestTrue(TEXT("Packet 0 is accepted"), ReceivePacket(0));
+	TestTrue(TEXT("Packet 2 is accepted"), ReceivePacket(2));
+	TestFalse(TEXT("The duplicate of packet 2 is dropped"), ReceivePacket(2));
+	TestTrue(TEXT("The reordered packet 1 is accepted"), ReceivePacket(1));
+	TestEqual(TEXT("Nothing is decoded until the depth is reached"), DecodedPCMData.Num(), 0);
+	TestTrue(TEXT("Packet 3 is accepted"), ReceivePacket(3));
+	TestEqual(TEXT("Packets 0 to 3 are decoded"), DecodedPCMData.Num(), 4 * NumOfFramesPerPacket);
+
+	// Packet 4 is lost and only arrives after its turn has passed, so it is recovered from the FEC data of packet 5
+	for (int64 SequenceNumber = 5; SequenceNumber < 10; ++SequenceNumber)
+	{
+		TestTrue(FString::Printf(TEXT("Packet %lld is accepted"), SequenceNumber), ReceivePacket(SequenceNumber));
+	}
+	TestFalse(TEXT("The late packet 4 is dropped"), ReceivePacket(4));
+	TestEqual(TEXT("The lost packet 4 is filled in"), DecodedPCMData.Num(), 10 * NumOfFramesPerPacket);
+
+	// Packets 10 and 11 are lost at the end of the stream. Packet 10 is concealed as packet 11 is missing too, and packet 11 is recovered from the FEC data of packet 12
+	TestTrue(TEXT("Packet 12 is accepted"), ReceivePacket(12));
+	TestEqual(TEXT("The missing packets are waited for before flushing"), DecodedPCMData.Num(), 10 * NumOfFramesPerPacket);
+	JitterBuffer.PopFrames(DecodedPCMData, true);
+	TestEqual(TEXT("The decoded audio data has no gaps"), DecodedPCMData.Num(), NumOfTestPackets * NumOfFramesPerPacket);
+	TestEqual(TEXT("No packets are held after flushing"), JitterBuffer.GetNumOfPendingPackets(), 0);
+
+	const FOPUS_RuntimeJitterBufferStats& Stats = JitterBuffer.GetStats();
+	TestEqual(TEXT("Number of received packets"), Stats.NumOfReceivedPackets, static_cast<int64>(12));
+	TestEqual(TEXT("Number of reordered packets"), Stats.NumOfReorderedPackets, static_cast<int64>(1));
+	TestEqual(TEXT("Number of late packets"), Stats.NumOfLatePackets, static_cast<int64>(1));
+	TestEqual(TEXT("Number of duplicate packets"), Stats.NumOfDuplicatePackets, static_cast<int64>(1));
+	TestEqual(TEXT("Number of decoded packets"), Stats.NumOfDecodedPackets, static_cast<int64>(10));
+	TestEqual(TEXT("Number of recovered packets"), Stats.NumOfRecoveredPackets, static_cast<int64>(2));
+	TestEqual(TEXT("Number of concealed packets"), Stats.NumOfConcealedPackets, static_cast<int64>(1));
+
+	double SumOfSquares = 0;
+	for (const float Sample : DecodedPCMData)
+	{
+		SumOfSquares += Sample * Sample;
+	}
+	TestTrue(TEXT("The decoded audio data is not silent"), FMath::Sqrt(SumOfSquares / DecodedPCMData.Num()) > 0.1);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,83 @@
+// Georgy Treshchev 2024.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "RuntimeAudioImporterTestFlags.h"
+#include "Sound/StreamingSoundWave.h"
+#include "Sound/ImportedSoundWavePCMReadLease.h"
+
+namespace
+{
+	constexpr uint32 TestSampleRate = 48000;
+	constexpr int32 NumOfFramesPerBlock = 480;
+
+	/**
+	 * Make a block of mono audio data with every sample set to the specified value
+	 */
+	FDecodedAudioStruct MakeConstantDecodedAudio(float Value)
+	{
+		TArray<float> PCMData;
+		PCMData.Init(Value, NumOfFramesPerBlock);
+
+		FDecodedAudioStruct DecodedAudioInfo;
+		DecodedAudioInfo.PCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(PCMData);
+		DecodedAudioInfo.PCMInfo.PCMNumOfFrames = NumOfFramesPerBlock;
+		DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels = 1;
+		DecodedAudioInfo.SoundWaveBasicInfo.SampleRate = TestSampleRate;
+		DecodedAudioInfo.SoundWaveBasicInfo.Duration = static_cast<float>(NumOfFramesPerBlock) / TestSampleRate;
+		return DecodedAudioInfo;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPCMReadLeaseAppendTest, "RuntimeAudioImporter.SoundWave.PCMReadLease.Append", RUNTIMEAUDIOIMPORTER_TEST_FLAGS)
+
+bool FPCMReadLeaseAppendTest::RunTest(const FString& Parameters)
+{
+	UStreamingSoundWave* SoundWave = UStreamingSoundWave::CreateStreamingSoundWave();
+	if (!TestNotNull(TEXT("The streaming sound wave is created"), SoundWave))
+	{
+		return false;
+	}
+
+	// The second append grows the buffer with spare capacity for the next appends
+	SoundWave->PopulateAudioDataFromDecodedInfo(MakeConstantDecodedAudio(0.25f));
+	SoundWave->PopulateAudioDataFromDecodedInfo(MakeConstantDecodedAudio(-0.5f));
+
+	FImportedSoundWavePCMReadLease Lease = SoundWave->AcquirePCMReadLease();
+	if (!TestTrue(TEXT("The lease is acquired"), Lease.IsValid()))
+	{
+		return false;
+	}
+
+	// Acquiring the lease does not copy the PCM data, and neither does appending while it is held
+	const float* const LeasedPCMData = Lease.GetFloatPCMData().GetData();
+	TestEqual(TEXT("The lease references the PCM data of the sound wave"), LeasedPCMData, SoundWave->GetPCMBuffer().PCMData.GetView().GetData());
+
+	SoundWave->PopulateAudioDataFromDecodedInfo(MakeConstantDecodedAudio(0.75f));
+	TestEqual(TEXT("Appending while the lease is held does not copy the PCM data"), SoundWave->GetPCMBuffer().PCMData.GetView().GetData(), LeasedPCMData);
+
+	TestEqual(TEXT("The lease keeps its number of frames"), Lease.GetNumOfFrames(), static_cast<int64>(NumOfFramesPerBlock * 2));
+	TestEqual(TEXT("The lease still references the same PCM data"), Lease.GetFloatPCMData().GetData(), LeasedPCMData);
+
+	TArray<float> ReadPCMData;
+	ReadPCMData.SetNumZeroed(NumOfFramesPerBlock * 3);
+	TestEqual(TEXT("The lease reads only the pinned frames"), Lease.ReadFrames(0, NumOfFramesPerBlock * 3, ReadPCMData.GetData()), static_cast<int64>(NumOfFramesPerBlock * 2));
+	TestEqual(TEXT("The first leased sample"), ReadPCMData[0], 0.25f);
+	TestEqual(TEXT("The last leased sample"), ReadPCMData[NumOfFramesPerBlock * 2 - 1], -0.5f);
+
+	const TArray<float> PCMData = SoundWave->GetPCMBufferCopy();
+	if (TestEqual(TEXT("Number of samples after appending"), PCMData.Num(), NumOfFramesPerBlock * 3))
+	{
+		TestEqual(TEXT("The appended sample"), PCMData.Last(), 0.75f);
+	}
+
+	// A lease acquired after the append sees all of the audio data
+	const FImportedSoundWavePCMReadLease NewLease = SoundWave->AcquirePCMReadLease();
+	TestEqual(TEXT("The new lease includes the appended frames"), NewLease.GetNumOfFrames(), static_cast<int64>(NumOfFramesPerBlock * 3));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,198 @@
+// Georgy Treshchev 2024.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "RuntimeAudioImporterTestFlags.h"
+#include "Sound/StreamingSoundWave.h"
+#include "Sound/ImportedSoundWavePlaybackInstance.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+
+namespace
+{
+	constexpr uint32 TestSampleRate = 48000;
+	constexpr int32 NumOfFramesPerBlock = 480;
+
+	/**
+	 * Make a block of mono audio data with every sample set to the specified value
+	 */
+	FDecodedAudioStruct MakeConstantDecodedAudio(float Value)
+	{
+		TArray<float> PCMData;
+		PCMData.Init(Value, NumOfFramesPerBlock);
+
+		FDecodedAudioStruct DecodedAudioInfo;
+		DecodedAudioInfo.PCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(PCMData);
+		DecodedAudioInfo.PCMInfo.PCMNumOfFrames = NumOfFramesPerBlock;
+		DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels = 1;
+		DecodedAudioInfo.SoundWaveBasicInfo.SampleRate = TestSampleRate;
+		DecodedAudioInfo.SoundWaveBasicInfo.Duration = static_cast<float>(NumOfFramesPerBlock) / TestSampleRate;
+		return DecodedAudioInfo;
+	}
+
+	/**
+	 * Duplicate the sound wave and wait for the result, since the duplication is performed in the background
+	 */
+	UImportedSoundWave* DuplicateAndWait(UImportedSoundWave* SoundWave, bool bUseSharedAudioBuffer)
+	{
+		FEvent* DuplicatedEvent = FPlatformProcess::GetSynchEventFromPool();
+		UImportedSoundWave* DuplicatedSoundWave = nullptr;
+		SoundWave->DuplicateSoundWave(bUseSharedAudioBuffer, FOnDuplicateSoundWaveNative::CreateLambda([DuplicatedEvent, &DuplicatedSoundWave](bool bSucceeded, UImportedSoundWave* InDuplicatedSoundWave)
+		{
+			DuplicatedSoundWave = bSucceeded ? InDuplicatedSoundWave : nullptr;
+			DuplicatedEvent->Trigger();
+		}));
+		const bool bDuplicated = DuplicatedEvent->Wait(FTimespan::FromSeconds(10));
+		FPlatformProcess::ReturnSynchEventToPool(DuplicatedEvent);
+		return bDuplicated ? DuplicatedSoundWave : nullptr;
+	}
+
+	/**
+	 * Get the address of the PCM data of the sound wave, to check whether it has been copied
+	 */
+	const float* GetPCMDataAddress(const UImportedSoundWave* SoundWave)
+	{
+		return SoundWave->GetPCMBuffer().PCMData.GetView().GetData();
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPCMSnapshotIsolationTest, "RuntimeAudioImporter.SoundWave.PCMSnapshot.Isolation", RUNTIMEAUDIOIMPORTER_TEST_FLAGS)
+
+bool FPCMSnapshotIsolationTest::RunTest(const FString& Parameters)
+{
+	UStreamingSoundWave* SoundWave = UStreamingSoundWave::CreateStreamingSoundWave();
+	if (!TestNotNull(TEXT("The streaming sound wave is created"), SoundWave))
+	{
+		return false;
+	}
+
+	SoundWave->PopulateAudioDataFromDecodedInfo(MakeConstantDecodedAudio(0.25f));
+
+	// The playback instance references a snapshot of the PCM data, which the appends below must not write into
+	TSharedPtr<FImportedSoundWavePlaybackInstance, ESPMode::ThreadSafe> PlaybackInstance = SoundWave->CreatePlaybackInstance();
+	if (!TestTrue(TEXT("The playback instance is created"), PlaybackInstance.IsValid()))
+	{
+		return false;
+	}
+
+	SoundWave->PopulateAudioDataFromDecodedInfo(MakeConstantDecodedAudio(-0.5f));
+	SoundWave->PopulateAudioDataFromDecodedInfo(MakeConstantDecodedAudio(0.75f));
+
+	TArray<float> RenderedPCMData;
+	RenderedPCMData.SetNumZeroed(NumOfFramesPerBlock * 2);
+	PlaybackInstance->Render(RenderedPCMData.GetData(), RenderedPCMData.Num());
+
+	TestEqual(TEXT("The snapshot keeps its duration"), PlaybackInstance->GetDuration(), static_cast<float>(NumOfFramesPerBlock) / TestSampleRate);
+	TestTrue(TEXT("The snapshot playback has finished"), PlaybackInstance->IsFinished());
+	TestEqual(TEXT("The first snapshot sample"), RenderedPCMData[0], 0.25f);
+	TestEqual(TEXT("The last snapshot sample"), RenderedPCMData[NumOfFramesPerBlock - 1], 0.25f);
+	TestEqual(TEXT("The appended audio data is not rendered from the snapshot"), RenderedPCMData[NumOfFramesPerBlock], 0.f);
+
+	const TArray<float> PCMData = SoundWave->GetPCMBufferCopy();
+	if (!TestEqual(TEXT("Number of samples after appending"), PCMData.Num(), NumOfFramesPerBlock * 3))
+	{
+		return false;
+	}
+	TestEqual(TEXT("The populated sample"), PCMData[NumOfFramesPerBlock - 1], 0.25f);
+	TestEqual(TEXT("The first appended sample"), PCMData[NumOfFramesPerBlock], -0.5f);
+	TestEqual(TEXT("The second appended sample"), PCMData[NumOfFramesPerBlock * 2], 0.75f);
+
+	// A snapshot taken after the appends sees all of the audio data
+	TSharedPtr<FImportedSoundWavePlaybackInstance, ESPMode::ThreadSafe> NewPlaybackInstance = SoundWave->CreatePlaybackInstance();
+	if (TestTrue(TEXT("The second playback instance is created"), NewPlaybackInstance.IsValid()))
+	{
+		TestEqual(TEXT("The new snapshot includes the appended audio data"), NewPlaybackInstance->GetDuration(), static_cast<float>(NumOfFramesPerBlock * 3) / TestSampleRate);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPCMSnapshotDuplicateTest, "RuntimeAudioImporter.SoundWave.PCMSnapshot.Duplicate", RUNTIMEAUDIOIMPORTER_TEST_FLAGS)
+
+bool FPCMSnapshotDuplicateTest::RunTest(const FString& Parameters)
+{
+	UStreamingSoundWave* SoundWave = UStreamingSoundWave::CreateStreamingSoundWave();
+	if (!TestNotNull(TEXT("The streaming sound wave is created"), SoundWave))
+	{
+		return false;
+	}
+	SoundWave->PopulateAudioDataFromDecodedInfo(MakeConstantDecodedAudio(0.25f));
+
+	UImportedSoundWave* FirstDuplicate = DuplicateAndWait(SoundWave, true);
+	UImportedSoundWave* SecondDuplicate = DuplicateAndWait(SoundWave, true);
+	if (!TestNotNull(TEXT("The first duplicate is created"), FirstDuplicate) || !TestNotNull(TEXT("The second duplicate is created"), SecondDuplicate))
+	{
+		return false;
+	}
+
+	// Nothing has been written yet, so all of them reference the same memory
+	const float* const SharedPCMData = GetPCMDataAddress(SoundWave);
+	TestEqual(TEXT("The first duplicate shares the PCM data"), GetPCMDataAddress(FirstDuplicate), SharedPCMData);
+	TestEqual(TEXT("The second duplicate shares the PCM data"), GetPCMDataAddress(SecondDuplicate), SharedPCMData);
+
+	// Changing the PCM data of one duplicate detaches only that duplicate
+	TestTrue(TEXT("The first duplicate is resampled"), FirstDuplicate->ResampleSoundWave(TestSampleRate / 2));
+	TestNotEqual(TEXT("The changed duplicate no longer shares the PCM data"), GetPCMDataAddress(FirstDuplicate), SharedPCMData);
+	TestEqual(TEXT("The other duplicate still shares the PCM data"), GetPCMDataAddress(SecondDuplicate), SharedPCMData);
+	TestEqual(TEXT("The original sound wave still shares the PCM data"), GetPCMDataAddress(SoundWave), SharedPCMData);
+
+	SoundWave->PopulateAudioDataFromDecodedInfo(MakeConstantDecodedAudio(-0.5f));
+
+	const TArray<float> DuplicatePCMData = SecondDuplicate->GetPCMBufferCopy();
+	if (TestEqual(TEXT("The duplicate is not affected by appending to the original sound wave"), DuplicatePCMData.Num(), NumOfFramesPerBlock))
+	{
+		TestEqual(TEXT("The last duplicated sample"), DuplicatePCMData.Last(), 0.25f);
+	}
+
+	const TArray<float> PCMData = SoundWave->GetPCMBufferCopy();
+	if (TestEqual(TEXT("Number of samples of the original sound wave after appending"), PCMData.Num(), NumOfFramesPerBlock * 2))
+	{
+		TestEqual(TEXT("The populated sample"), PCMData[0], 0.25f);
+		TestEqual(TEXT("The appended sample"), PCMData.Last(), -0.5f);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPCMSnapshotAppendWithoutCopyTest, "RuntimeAudioImporter.SoundWave.PCMSnapshot.AppendWithoutCopy", RUNTIMEAUDIOIMPORTER_TEST_FLAGS)
+
+bool FPCMSnapshotAppendWithoutCopyTest::RunTest(const FString& Parameters)
+{
+	UStreamingSoundWave* SoundWave = UStreamingSoundWave::CreateStreamingSoundWave();
+	if (!TestNotNull(TEXT("The streaming sound wave is created"), SoundWave))
+	{
+		return false;
+	}
+
+	// The second append grows the buffer with spare capacity for the next appends
+	SoundWave->PopulateAudioDataFromDecodedInfo(MakeConstantDecodedAudio(0.25f));
+	SoundWave->PopulateAudioDataFromDecodedInfo(MakeConstantDecodedAudio(-0.5f));
+
+	TSharedPtr<FImportedSoundWavePlaybackInstance, ESPMode::ThreadSafe> PlaybackInstance = SoundWave->CreatePlaybackInstance();
+	if (!TestTrue(TEXT("The playback instance is created"), PlaybackInstance.IsValid()))
+	{
+		return false;
+	}
+
+	const float* const PCMDataBeforeAppend = GetPCMDataAddress(SoundWave);
+	SoundWave->PopulateAudioDataFromDecodedInfo(MakeConstantDecodedAudio(0.75f));
+	TestEqual(TEXT("Appending after taking a snapshot does not copy the existing PCM data"), GetPCMDataAddress(SoundWave), PCMDataBeforeAppend);
+
+	TArray<float> RenderedPCMData;
+	RenderedPCMData.SetNumZeroed(NumOfFramesPerBlock * 3);
+	PlaybackInstance->Render(RenderedPCMData.GetData(), RenderedPCMData.Num());
+	TestEqual(TEXT("The last snapshot sample"), RenderedPCMData[NumOfFramesPerBlock * 2 - 1], -0.5f);
+	TestEqual(TEXT("The appended audio data is not rendered from the snapshot"), RenderedPCMData[NumOfFramesPerBlock * 2], 0.f);
+
+	const TArray<float> PCMData = SoundWave->GetPCMBufferCopy();
+	if (TestEqual(TEXT("Number of samples after appending"), PCMData.Num(), NumOfFramesPerBlock * 3))
+	{
+		TestEqual(TEXT("The appended sample"), PCMData.Last(), 0.75f);
+	}
+
+	return true;
+}
+
+#endif
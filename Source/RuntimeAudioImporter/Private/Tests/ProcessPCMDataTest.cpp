@@ -0,0 +1,87 @@
+// Georgy Treshchev 2024.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "RuntimeAudioImporterTestFlags.h"
+#include "Sound/StreamingSoundWave.h"
+#include "Async/Async.h"
+
+namespace
+{
+	constexpr uint32 TestSampleRate = 48000;
+
+	/**
+	 * Make mono audio data with every sample set to the specified value
+	 */
+	FDecodedAudioStruct MakeConstantDecodedAudio(float Value, int32 NumOfFrames)
+	{
+		TArray<float> PCMData;
+		PCMData.Init(Value, NumOfFrames);
+
+		FDecodedAudioStruct DecodedAudioInfo;
+		DecodedAudioInfo.PCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(PCMData);
+		DecodedAudioInfo.PCMInfo.PCMNumOfFrames = NumOfFrames;
+		DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels = 1;
+		DecodedAudioInfo.SoundWaveBasicInfo.SampleRate = TestSampleRate;
+		DecodedAudioInfo.SoundWaveBasicInfo.Duration = static_cast<float>(NumOfFrames) / TestSampleRate;
+		return DecodedAudioInfo;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProcessPCMDataAppendTest, "RuntimeAudioImporter.SoundWave.ProcessPCMData.AppendDuringResampling", RUNTIMEAUDIOIMPORTER_TEST_FLAGS)
+
+bool FProcessPCMDataAppendTest::RunTest(const FString& Parameters)
+{
+	UStreamingSoundWave* SoundWave = UStreamingSoundWave::CreateStreamingSoundWave();
+	if (!TestNotNull(TEXT("The streaming sound wave is created"), SoundWave))
+	{
+		return false;
+	}
+
+	// Long enough for the appends below to happen while resampling
+	constexpr int32 NumOfPopulatedFrames = TestSampleRate * 30;
+	constexpr int32 NumOfFramesPerAppend = 480;
+	constexpr int32 MaxNumOfAppends = 1000;
+	SoundWave->PopulateAudioDataFromDecodedInfo(MakeConstantDecodedAudio(0.5f, NumOfPopulatedFrames));
+
+	constexpr uint32 NewSampleRate = TestSampleRate / 2;
+	TFuture<bool> ResampleResult = Async(EAsyncExecution::ThreadPool, [SoundWave, NewSampleRate]()
+	{
+		return SoundWave->ResampleSoundWave(NewSampleRate);
+	});
+
+	// Appending the way a stream would, regardless of whether the resampling has finished, since the appended frames must not be lost either way
+	int32 NumOfAppends = 0;
+	int32 NumOfAppendsDuringResampling = 0;
+	while (NumOfAppends < MaxNumOfAppends && (!ResampleResult.IsReady() || NumOfAppends < 10))
+	{
+		NumOfAppendsDuringResampling += ResampleResult.IsReady() ? 0 : 1;
+		SoundWave->PopulateAudioDataFromDecodedInfo(MakeConstantDecodedAudio(0.5f, NumOfFramesPerAppend));
+		++NumOfAppends;
+	}
+
+	if (!TestTrue(TEXT("The resampling succeeds despite the appends"), ResampleResult.Get()))
+	{
+		return false;
+	}
+	AddInfo(FString::Printf(TEXT("%d of %d appends happened during resampling"), NumOfAppendsDuringResampling, NumOfAppends));
+
+	TestEqual(TEXT("The sample rate after resampling"), SoundWave->GetSampleRate(), static_cast<int32>(NewSampleRate));
+
+	// Every block is resampled separately, which may add or drop a frame at its boundaries
+	const int64 ExpectedNumOfFrames = (static_cast<int64>(NumOfPopulatedFrames) + static_cast<int64>(NumOfAppends) * NumOfFramesPerAppend) * NewSampleRate / TestSampleRate;
+	const TArray<float> PCMData = SoundWave->GetPCMBufferCopy();
+	TestTrue(FString::Printf(TEXT("No appended frames are lost (expected about %lld frames, got %d)"), ExpectedNumOfFrames, PCMData.Num()), FMath::Abs(PCMData.Num() - ExpectedNumOfFrames) <= NumOfAppends + 4);
+	TestTrue(TEXT("The duration includes the appended frames"), FMath::IsNearlyEqual(SoundWave->GetDurationConst(), static_cast<float>(ExpectedNumOfFrames) / NewSampleRate, 0.01f));
+
+	if (PCMData.Num() > 0)
+	{
+		TestTrue(TEXT("The appended frames are resampled"), FMath::IsNearlyEqual(PCMData[PCMData.Num() - NumOfFramesPerAppend / 4], 0.5f, 0.05f));
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,45 @@
+// Georgy Treshchev 2024.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "RuntimeAudioImporterTestFlags.h"
+#include "Codecs/RAW_RuntimeCodec.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FReverseFramesScalarReferenceTest, "RuntimeAudioImporter.RAW.ReverseFrames", RUNTIMEAUDIOIMPORTER_TEST_FLAGS)
+
+bool FReverseFramesScalarReferenceTest::RunTest(const FString& Parameters)
+{
+	// Mono and stereo are reversed four samples at a time, the other channel counts one sample at a time. Every number of frames covers both the vectorized part and the middle
+	for (const uint32 NumOfChannels : {1u, 2u, 3u})
+	{
+		for (int64 NumOfFrames = 0; NumOfFrames <= 21; ++NumOfFrames)
+		{
+			TArray<float> PCMData;
+			PCMData.SetNumUninitialized(NumOfFrames * NumOfChannels);
+			for (int32 SampleIndex = 0; SampleIndex < PCMData.Num(); ++SampleIndex)
+			{
+				PCMData[SampleIndex] = static_cast<float>(SampleIndex);
+			}
+
+			FRAW_RuntimeCodec::ReverseFrames(PCMData.GetData(), NumOfFrames, NumOfChannels);
+
+			// Frame by frame reference, the channels of every frame keep their order
+			bool bMatches = true;
+			for (int64 FrameIndex = 0; FrameIndex < NumOfFrames && bMatches; ++FrameIndex)
+			{
+				for (uint32 ChannelIndex = 0; ChannelIndex < NumOfChannels; ++ChannelIndex)
+				{
+					const float Expected = static_cast<float>((NumOfFrames - 1 - FrameIndex) * NumOfChannels + ChannelIndex);
+					bMatches &= PCMData[FrameIndex * NumOfChannels + ChannelIndex] == Expected;
+				}
+			}
+			TestTrue(*FString::Printf(TEXT("%lld frames of %u channels are reversed"), NumOfFrames, NumOfChannels), bMatches);
+		}
+	}
+
+	return true;
+}
+
+#endif
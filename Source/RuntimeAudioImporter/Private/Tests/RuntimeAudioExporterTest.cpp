@@ -0,0 +1,125 @@
+// Georgy Treshchev 2024.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "RuntimeAudioImporterTestFlags.h"
+#include "RuntimeAudioExporter.h"
+#include "Sound/StreamingSoundWave.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	constexpr uint32 TestSampleRate = 48000;
+	constexpr uint32 TestNumOfChannels = 2;
+	constexpr int32 NumOfFramesPerBlock = 48000;
+
+	/**
+	 * Make a block of stereo audio data with every sample set to the specified value
+	 */
+	FDecodedAudioStruct MakeConstantDecodedAudio(float Value)
+	{
+		TArray<float> PCMData;
+		PCMData.Init(Value, NumOfFramesPerBlock * TestNumOfChannels);
+
+		FDecodedAudioStruct DecodedAudioInfo;
+		DecodedAudioInfo.PCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(PCMData);
+		DecodedAudioInfo.PCMInfo.PCMNumOfFrames = NumOfFramesPerBlock;
+		DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels = TestNumOfChannels;
+		DecodedAudioInfo.SoundWaveBasicInfo.SampleRate = TestSampleRate;
+		DecodedAudioInfo.SoundWaveBasicInfo.Duration = static_cast<float>(NumOfFramesPerBlock) / TestSampleRate;
+		return DecodedAudioInfo;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeAudioExporterPeakMemoryTest, "RuntimeAudioImporter.Exporter.PeakMemory", RUNTIMEAUDIOIMPORTER_TEST_FLAGS)
+
+bool FRuntimeAudioExporterPeakMemoryTest::RunTest(const FString& Parameters)
+{
+	UStreamingSoundWave* SoundWave = UStreamingSoundWave::CreateStreamingSoundWave();
+	if (!TestNotNull(TEXT("The streaming sound wave is created"), SoundWave))
+	{
+		return false;
+	}
+
+	SoundWave->PopulateAudioDataFromDecodedInfo(MakeConstantDecodedAudio(0.5f));
+	const float* const PCMData = SoundWave->GetPCMBuffer().PCMData.GetView().GetData();
+
+	// Exporting in the format of the sound wave references its PCM data instead of copying it
+	FDecodedAudioStruct DecodedAudioInfo;
+	if (!TestTrue(TEXT("The audio data is retrieved without overriding"), URuntimeAudioExporter::GetDecodedAudioForExport(SoundWave, FRuntimeAudioExportOverrideOptions(), DecodedAudioInfo)))
+	{
+		return false;
+	}
+	TestEqual(TEXT("The exported audio data references the PCM data of the sound wave"), DecodedAudioInfo.PCMInfo.PCMData.GetView().GetData(), PCMData);
+	TestEqual(TEXT("The exported audio data has all the frames"), DecodedAudioInfo.PCMInfo.PCMNumOfFrames, static_cast<uint32>(NumOfFramesPerBlock));
+
+	// Appending while the exported audio data is referenced does not affect it
+	SoundWave->PopulateAudioDataFromDecodedInfo(MakeConstantDecodedAudio(-0.5f));
+	TestEqual(TEXT("The exported audio data is not affected by appending"), DecodedAudioInfo.PCMInfo.PCMData.GetView().Num(), static_cast<int64>(NumOfFramesPerBlock * TestNumOfChannels));
+
+	// Overriding the format allocates only the converted PCM data, a quarter of the size for half the sample rate and a single channel
+	FRuntimeAudioExportOverrideOptions OverrideOptions;
+	OverrideOptions.SampleRate = TestSampleRate / 2;
+	OverrideOptions.NumOfChannels = 1;
+
+	const float* const PCMDataBeforeConversion = SoundWave->GetPCMBuffer().PCMData.GetView().GetData();
+	FDecodedAudioStruct ConvertedAudioInfo;
+	if (!TestTrue(TEXT("The audio data is retrieved with overriding"), URuntimeAudioExporter::GetDecodedAudioForExport(SoundWave, OverrideOptions, ConvertedAudioInfo)))
+	{
+		return false;
+	}
+
+	const int64 ExpectedNumOfSamples = SoundWave->GetPCMBuffer().PCMData.GetView().Num() / 4;
+	TestEqual(TEXT("The converted audio data has the overriden sample rate"), ConvertedAudioInfo.SoundWaveBasicInfo.SampleRate, static_cast<uint32>(OverrideOptions.SampleRate));
+	TestEqual(TEXT("The converted audio data has the overriden number of channels"), ConvertedAudioInfo.SoundWaveBasicInfo.NumOfChannels, static_cast<uint32>(OverrideOptions.NumOfChannels));
+	TestTrue(TEXT("The converted audio data is sized for the overriden format"), FMath::Abs(ConvertedAudioInfo.PCMInfo.PCMData.GetView().Num() - ExpectedNumOfSamples) <= 256);
+	TestEqual(TEXT("Converting does not copy the PCM data of the sound wave"), SoundWave->GetPCMBuffer().PCMData.GetView().GetData(), PCMDataBeforeConversion);
+
+	return true;
+}
+
+#if WITH_RUNTIMEAUDIOIMPORTER_FILEOPERATION_SUPPORT
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeAudioExporterFailedExportTest, "RuntimeAudioImporter.Exporter.FailedExportDeletesFile", RUNTIMEAUDIOIMPORTER_TEST_FLAGS)
+
+bool FRuntimeAudioExporterFailedExportTest::RunTest(const FString& Parameters)
+{
+	// The sound wave has no PCM data, so the export fails once the file has been opened
+	UStreamingSoundWave* SoundWave = UStreamingSoundWave::CreateStreamingSoundWave();
+	if (!TestNotNull(TEXT("The streaming sound wave is created"), SoundWave))
+	{
+		return false;
+	}
+
+	AddExpectedError(TEXT("PCM data"), EAutomationExpectedErrorFlags::Contains, 0);
+
+	const FString SavePath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("RuntimeAudioExporterFailedExport.wav"));
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.DeleteFile(*SavePath);
+
+	FEvent* ExportedEvent = FPlatformProcess::GetSynchEventFromPool();
+	bool bExportSucceeded = true;
+	URuntimeAudioExporter::ExportSoundWaveToFile(TWeakObjectPtr<UImportedSoundWave>(SoundWave), SavePath, ERuntimeAudioFormat::Wav, 100, FRuntimeAudioExportOverrideOptions(), FOnAudioExportToFileResultNative::CreateLambda([ExportedEvent, &bExportSucceeded](bool bSucceeded)
+	{
+		bExportSucceeded = bSucceeded;
+		ExportedEvent->Trigger();
+	}));
+	const bool bExported = ExportedEvent->Wait(FTimespan::FromSeconds(10));
+	FPlatformProcess::ReturnSynchEventToPool(ExportedEvent);
+
+	if (!TestTrue(TEXT("The export finishes"), bExported))
+	{
+		return false;
+	}
+	TestFalse(TEXT("The export fails"), bExportSucceeded);
+	TestFalse(TEXT("The truncated file is deleted"), PlatformFile.FileExists(*SavePath));
+
+	return true;
+}
+#endif
+
+#endif
@@ -0,0 +1,13 @@
+// Georgy Treshchev 2024.
+
+#pragma once
+
+#include "Misc/AutomationTest.h"
+#include "Misc/EngineVersionComparison.h"
+
+/** The flags of the plugin's automation tests. They do not need an audio device, so they run in any application context */
+#if UE_VERSION_OLDER_THAN(5, 5, 0)
+#define RUNTIMEAUDIOIMPORTER_TEST_FLAGS (EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+#else
+#define RUNTIMEAUDIOIMPORTER_TEST_FLAGS (EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+#endif
@@ -0,0 +1,145 @@
+// Georgy Treshchev 2024.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "RuntimeAudioImporterTestFlags.h"
+#include "RuntimeAudioImporterLibrary.h"
+#include "Codecs/RAW_RuntimeCodec.h"
+
+namespace
+{
+	constexpr uint32 TestSampleRate = 48000;
+
+	/**
+	 * Make audio data of silence with a loud section in the middle
+	 */
+	FDecodedAudioStruct MakeDecodedAudioWithLoudSection(uint32 NumOfChannels, int64 NumOfFrames, int64 LoudStartFrame, int64 LoudEndFrame, float LoudValue)
+	{
+		TArray<float> PCMData;
+		PCMData.Init(0.f, NumOfFrames * NumOfChannels);
+		for (int64 FrameIndex = LoudStartFrame; FrameIndex < LoudEndFrame; ++FrameIndex)
+		{
+			PCMData[FrameIndex * NumOfChannels] = LoudValue;
+		}
+
+		FDecodedAudioStruct DecodedAudioInfo;
+		DecodedAudioInfo.PCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(PCMData);
+		DecodedAudioInfo.PCMInfo.PCMNumOfFrames = NumOfFrames;
+		DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels = NumOfChannels;
+		DecodedAudioInfo.SoundWaveBasicInfo.SampleRate = TestSampleRate;
+		DecodedAudioInfo.SoundWaveBasicInfo.Duration = static_cast<float>(NumOfFrames) / TestSampleRate;
+		return DecodedAudioInfo;
+	}
+
+	/**
+	 * Find the first loud frame one sample at a time, as a reference for the vectorized scan
+	 */
+	int64 FindFirstLoudFrameScalar(const TArray<float>& PCMData, uint32 NumOfChannels, float Threshold)
+	{
+		for (int32 SampleIndex = 0; SampleIndex < PCMData.Num(); ++SampleIndex)
+		{
+			if (FMath::Abs(PCMData[SampleIndex]) > Threshold)
+			{
+				return SampleIndex / NumOfChannels;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	/**
+	 * Find the last loud frame one sample at a time, as a reference for the vectorized scan
+	 */
+	int64 FindLastLoudFrameScalar(const TArray<float>& PCMData, uint32 NumOfChannels, float Threshold)
+	{
+		for (int32 SampleIndex = PCMData.Num() - 1; SampleIndex >= 0; --SampleIndex)
+		{
+			if (FMath::Abs(PCMData[SampleIndex]) > Threshold)
+			{
+				return SampleIndex / NumOfChannels;
+			}
+		}
+		return INDEX_NONE;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSilenceTrimBoundariesTest, "RuntimeAudioImporter.SilenceTrim.Boundaries", RUNTIMEAUDIOIMPORTER_TEST_FLAGS)
+
+bool FSilenceTrimBoundariesTest::RunTest(const FString& Parameters)
+{
+	// Stereo with the loud section only in the first channel, and boundaries that do not fall on a multiple of four samples
+	constexpr uint32 NumOfChannels = 2;
+	constexpr int64 NumOfFrames = 3001;
+	constexpr int64 LoudStartFrame = 1001;
+	constexpr int64 LoudEndFrame = 1503;
+	constexpr float PaddingSeconds = 48.f / TestSampleRate;
+	constexpr int64 NumOfPaddingFrames = 48;
+
+	FDecodedAudioStruct DecodedAudioInfo = MakeDecodedAudioWithLoudSection(NumOfChannels, NumOfFrames, LoudStartFrame, LoudEndFrame, -0.5f);
+	if (!TestTrue(TEXT("The silence is trimmed"), URuntimeAudioImporterLibrary::TrimSilenceInDecodedInfo(DecodedAudioInfo, -40.f, PaddingSeconds)))
+	{
+		return false;
+	}
+
+	const int64 ExpectedStartFrame = LoudStartFrame - NumOfPaddingFrames;
+	const int64 ExpectedEndFrame = LoudEndFrame + NumOfPaddingFrames;
+	const TArrayView<const float> PCMData(DecodedAudioInfo.PCMInfo.PCMData.GetView().GetData(), DecodedAudioInfo.PCMInfo.PCMData.GetView().Num());
+
+	TestEqual(TEXT("The number of frames is the loud section plus the padding"), static_cast<int64>(DecodedAudioInfo.PCMInfo.PCMNumOfFrames), ExpectedEndFrame - ExpectedStartFrame);
+	TestEqual(TEXT("The number of samples matches the number of frames"), static_cast<int64>(PCMData.Num()), (ExpectedEndFrame - ExpectedStartFrame) * NumOfChannels);
+	TestEqual(TEXT("The leading padding is kept silent"), PCMData[(NumOfPaddingFrames - 1) * NumOfChannels], 0.f);
+	TestEqual(TEXT("The loud section starts right after the leading padding"), PCMData[NumOfPaddingFrames * NumOfChannels], -0.5f);
+	TestEqual(TEXT("The loud section ends right before the trailing padding"), PCMData[(LoudEndFrame - 1 - ExpectedStartFrame) * NumOfChannels], -0.5f);
+	TestEqual(TEXT("The trailing padding is kept silent"), PCMData[(LoudEndFrame - ExpectedStartFrame) * NumOfChannels], 0.f);
+
+	const FSoundWaveBasicStruct& SoundWaveBasicInfo = DecodedAudioInfo.SoundWaveBasicInfo;
+	TestEqual(TEXT("The trimmed leading duration is reported"), SoundWaveBasicInfo.TrimmedLeadingDuration, static_cast<float>(ExpectedStartFrame) / TestSampleRate, KINDA_SMALL_NUMBER);
+	TestEqual(TEXT("The trimmed trailing duration is reported"), SoundWaveBasicInfo.TrimmedTrailingDuration, static_cast<float>(NumOfFrames - ExpectedEndFrame) / TestSampleRate, KINDA_SMALL_NUMBER);
+	TestEqual(TEXT("The duration is updated"), SoundWaveBasicInfo.Duration, static_cast<float>(ExpectedEndFrame - ExpectedStartFrame) / TestSampleRate, KINDA_SMALL_NUMBER);
+
+	// The padding is clamped to the audio data
+	FDecodedAudioStruct ShortDecodedAudioInfo = MakeDecodedAudioWithLoudSection(1, 100, 10, 90, 0.5f);
+	URuntimeAudioImporterLibrary::TrimSilenceInDecodedInfo(ShortDecodedAudioInfo, -40.f, 1.f);
+	TestEqual(TEXT("Padding longer than the silence keeps all frames"), ShortDecodedAudioInfo.PCMInfo.PCMNumOfFrames, 100u);
+
+	// Audio data below the threshold is left untouched
+	FDecodedAudioStruct SilentDecodedAudioInfo = MakeDecodedAudioWithLoudSection(1, 100, 10, 90, 0.001f);
+	TestTrue(TEXT("Silent audio data is accepted"), URuntimeAudioImporterLibrary::TrimSilenceInDecodedInfo(SilentDecodedAudioInfo, -40.f, 0.f));
+	TestEqual(TEXT("Silent audio data is not trimmed"), SilentDecodedAudioInfo.PCMInfo.PCMNumOfFrames, 100u);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSilenceTrimScanTest, "RuntimeAudioImporter.SilenceTrim.Scan", RUNTIMEAUDIOIMPORTER_TEST_FLAGS)
+
+bool FSilenceTrimScanTest::RunTest(const FString& Parameters)
+{
+	// Every position of a single loud sample, covering both the vectorized part and the remainder of the scan
+	constexpr float Threshold = 0.1f;
+	for (const uint32 NumOfChannels : {1u, 2u, 3u})
+	{
+		for (int32 NumOfSamples = NumOfChannels; NumOfSamples <= 27; NumOfSamples += NumOfChannels)
+		{
+			for (int32 LoudSampleIndex = 0; LoudSampleIndex < NumOfSamples; ++LoudSampleIndex)
+			{
+				TArray<float> PCMData;
+				PCMData.Init(0.05f, NumOfSamples);
+				PCMData[LoudSampleIndex] = LoudSampleIndex % 2 == 0 ? 0.2f : -0.2f;
+
+				const int64 NumOfFrames = NumOfSamples / NumOfChannels;
+				const FString Context = FString::Printf(TEXT("%u channels, %d samples, loud sample %d"), NumOfChannels, NumOfSamples, LoudSampleIndex);
+				TestEqual(*FString::Printf(TEXT("First loud frame (%s)"), *Context), FRAW_RuntimeCodec::FindFirstLoudFrame(PCMData.GetData(), NumOfFrames, NumOfChannels, Threshold), FindFirstLoudFrameScalar(PCMData, NumOfChannels, Threshold));
+				TestEqual(*FString::Printf(TEXT("Last loud frame (%s)"), *Context), FRAW_RuntimeCodec::FindLastLoudFrame(PCMData.GetData(), NumOfFrames, NumOfChannels, Threshold), FindLastLoudFrameScalar(PCMData, NumOfChannels, Threshold));
+			}
+		}
+	}
+
+	TArray<float> SilentPCMData;
+	SilentPCMData.Init(-0.1f, 16);
+	TestEqual(TEXT("Samples equal to the threshold are not loud"), FRAW_RuntimeCodec::FindFirstLoudFrame(SilentPCMData.GetData(), 16, 1, Threshold), static_cast<int64>(INDEX_NONE));
+
+	return true;
+}
+
+#endif
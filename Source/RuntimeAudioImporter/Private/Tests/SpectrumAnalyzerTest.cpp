@@ -0,0 +1,120 @@
+// Georgy Treshchev 2024.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "RuntimeAudioImporterTestFlags.h"
+#include "RuntimeAudioSpectrumAnalyzer.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	constexpr uint32 TestSampleRate = 48000;
+	constexpr int32 TestFFTSize = 1024;
+
+	/** The sine completes a whole number of periods in every window, so its frequency falls exactly on a bin */
+	constexpr int32 SineBinIndex = 64;
+	constexpr float SineAmplitude = 0.5f;
+
+	/**
+	 * Make stereo frames of the sine in both channels
+	 */
+	TArray<float> MakeStereoSine(int32 NumOfFrames)
+	{
+		TArray<float> PCMData;
+		PCMData.SetNumUninitialized(NumOfFrames * 2);
+		for (int32 FrameIndex = 0; FrameIndex < NumOfFrames; ++FrameIndex)
+		{
+			const float Sample = SineAmplitude * FMath::Sin(2.f * PI * SineBinIndex * FrameIndex / TestFFTSize);
+			PCMData[FrameIndex * 2] = Sample;
+			PCMData[FrameIndex * 2 + 1] = Sample;
+		}
+		return PCMData;
+	}
+
+	/**
+	 * Compute the magnitude of a bin of the Hann-windowed frames with a direct DFT, normalized the same way as the analyzer, as a reference for the FFT
+	 */
+	float ComputeMagnitudeScalar(const TArray<float>& PCMData, int32 WindowStartFrame, int32 BinIndex)
+	{
+		double Real = 0;
+		double Imag = 0;
+		for (int32 FrameIndex = 0; FrameIndex < TestFFTSize; ++FrameIndex)
+		{
+			const double Window = 0.5 * (1. - FMath::Cos(2. * PI * FrameIndex / TestFFTSize));
+			const double Sample = PCMData[(WindowStartFrame + FrameIndex) * 2] * Window;
+			const double Angle = 2. * PI * BinIndex * FrameIndex / TestFFTSize;
+			Real += Sample * FMath::Cos(Angle);
+			Imag -= Sample * FMath::Sin(Angle);
+		}
+		return static_cast<float>(FMath::Sqrt(Real * Real + Imag * Imag) * 4. / TestFFTSize);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpectrumAnalyzerSineTest, "RuntimeAudioImporter.SpectrumAnalyzer.Sine", RUNTIMEAUDIOIMPORTER_TEST_FLAGS)
+
+bool FSpectrumAnalyzerSineTest::RunTest(const FString& Parameters)
+{
+	FRuntimeAudioSpectrumSettings Settings;
+	Settings.FFTSize = TestFFTSize;
+	Settings.HopSize = TestFFTSize;
+
+	FRuntimeAudioSpectrumAnalyzer Analyzer(Settings);
+
+	constexpr int32 NumOfFrames = TestFFTSize * 4;
+	const TArray<float> PCMData = MakeStereoSine(NumOfFrames);
+	Analyzer.PushFrames(PCMData.GetData(), NumOfFrames, 2, TestSampleRate);
+	TestEqual(TEXT("No frames are dropped"), Analyzer.GetNumOfDroppedFrames(), 0ll);
+
+	// Waiting for the worker to analyze all the pushed frames
+	FRuntimeAudioSpectrum Spectrum;
+	const double StartTime = FPlatformTime::Seconds();
+	while (!Analyzer.GetLatestSpectrum(Spectrum) || Spectrum.NumOfAnalyzedFrames < NumOfFrames)
+	{
+		if (FPlatformTime::Seconds() - StartTime > 10)
+		{
+			AddError(TEXT("The spectrum of all the pushed frames was not published in time"));
+			return false;
+		}
+		FPlatformProcess::Sleep(0.001f);
+	}
+
+	TestEqual(TEXT("The sample rate is reported"), Spectrum.SampleRate, static_cast<int32>(TestSampleRate));
+	if (!TestEqual(TEXT("There is a magnitude for every bin"), Spectrum.Magnitudes.Num(), TestFFTSize / 2 + 1))
+	{
+		return false;
+	}
+
+	int32 LoudestBinIndex = 0;
+	for (int32 BinIndex = 1; BinIndex < Spectrum.Magnitudes.Num(); ++BinIndex)
+	{
+		if (Spectrum.Magnitudes[BinIndex] > Spectrum.Magnitudes[LoudestBinIndex])
+		{
+			LoudestBinIndex = BinIndex;
+		}
+	}
+	TestEqual(TEXT("The loudest bin is the frequency of the sine"), LoudestBinIndex, SineBinIndex);
+	TestEqual(TEXT("The magnitude of the sine is its amplitude"), Spectrum.Magnitudes[SineBinIndex], SineAmplitude, 0.01f);
+
+	// Every bin matches the direct DFT of the last analyzed window
+	const int32 WindowStartFrame = static_cast<int32>(Spectrum.NumOfAnalyzedFrames) - TestFFTSize;
+	for (int32 BinIndex = 0; BinIndex < Spectrum.Magnitudes.Num(); ++BinIndex)
+	{
+		TestEqual(*FString::Printf(TEXT("The magnitude of bin %d"), BinIndex), Spectrum.Magnitudes[BinIndex], ComputeMagnitudeScalar(PCMData, WindowStartFrame, BinIndex), 1.e-3f);
+	}
+
+	// The Hann window spreads the sine over its bin (full amplitude) and the two neighboring ones (half amplitude)
+	const float SineFrequency = static_cast<float>(SineBinIndex) * TestSampleRate / TestFFTSize;
+	float TotalEnergy = 0;
+	for (const float BandEnergy : Spectrum.BandEnergies)
+	{
+		TotalEnergy += BandEnergy;
+	}
+	TestTrue(*FString::Printf(TEXT("The band energies add up to the energy of the windowed sine at %f Hz"), SineFrequency), FMath::IsNearlyEqual(TotalEnergy, 1.5f * SineAmplitude * SineAmplitude, 0.01f));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,100 @@
+// Georgy Treshchev 2024.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "RuntimeAudioImporterTestFlags.h"
+#include "RuntimeAudioWaveformPyramid.h"
+#include "Math/RandomStream.h"
+
+namespace
+{
+	constexpr int64 NumOfFramesPerBin = FRuntimeAudioWaveformPyramid::NumOfFramesPerBin;
+
+	/**
+	 * Summarize the frames within the specified range one sample at a time, as a reference for the pyramid
+	 */
+	FRuntimeAudioWaveformPeak ComputePeakScalar(const TArray<float>& PCMData, uint32 NumOfChannels, int64 StartFrame, int64 EndFrame)
+	{
+		float Min = TNumericLimits<float>::Max();
+		float Max = TNumericLimits<float>::Lowest();
+		double SumOfSquares = 0;
+		for (int64 SampleIndex = StartFrame * NumOfChannels; SampleIndex < EndFrame * NumOfChannels; ++SampleIndex)
+		{
+			Min = FMath::Min(Min, PCMData[SampleIndex]);
+			Max = FMath::Max(Max, PCMData[SampleIndex]);
+			SumOfSquares += static_cast<double>(PCMData[SampleIndex]) * PCMData[SampleIndex];
+		}
+
+		FRuntimeAudioWaveformPeak Peak;
+		Peak.Min = Min;
+		Peak.Max = Max;
+		Peak.RMS = static_cast<float>(FMath::Sqrt(SumOfSquares / ((EndFrame - StartFrame) * NumOfChannels)));
+		return Peak;
+	}
+
+	/**
+	 * Compare the peaks of the pyramid over the range split into equal parts against the scalar reference
+	 */
+	void TestPeaks(FAutomationTestBase& Test, const FRuntimeAudioWaveformPyramid& Pyramid, const TArray<float>& PCMData, int64 StartFrame, int64 EndFrame, int32 NumOfPeaks)
+	{
+		TArray<FRuntimeAudioWaveformPeak> Peaks;
+		Pyramid.GetPeaks(StartFrame, EndFrame, NumOfPeaks, Peaks);
+		if (!Test.TestEqual(*FString::Printf(TEXT("The number of peaks of [%lld, %lld)"), StartFrame, EndFrame), Peaks.Num(), NumOfPeaks))
+		{
+			return;
+		}
+
+		const int64 NumOfFramesPerPeak = (EndFrame - StartFrame) / NumOfPeaks;
+		for (int32 PeakIndex = 0; PeakIndex < NumOfPeaks; ++PeakIndex)
+		{
+			const int64 PeakStartFrame = StartFrame + PeakIndex * NumOfFramesPerPeak;
+			const int64 PeakEndFrame = PeakIndex == NumOfPeaks - 1 ? EndFrame : PeakStartFrame + NumOfFramesPerPeak;
+			const FRuntimeAudioWaveformPeak Expected = ComputePeakScalar(PCMData, Pyramid.GetNumOfChannels(), PeakStartFrame, PeakEndFrame);
+
+			const FString Context = FString::Printf(TEXT("of [%lld, %lld)"), PeakStartFrame, PeakEndFrame);
+			Test.TestEqual(*FString::Printf(TEXT("Min %s"), *Context), Peaks[PeakIndex].Min, Expected.Min);
+			Test.TestEqual(*FString::Printf(TEXT("Max %s"), *Context), Peaks[PeakIndex].Max, Expected.Max);
+			Test.TestEqual(*FString::Printf(TEXT("RMS %s"), *Context), Peaks[PeakIndex].RMS, Expected.RMS, 1.e-4f);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWaveformPyramidScalarReferenceTest, "RuntimeAudioImporter.WaveformPyramid.ScalarReference", RUNTIMEAUDIOIMPORTER_TEST_FLAGS)
+
+bool FWaveformPyramidScalarReferenceTest::RunTest(const FString& Parameters)
+{
+	// Odd numbers of channels and frames, so that the vectorized reduction also has a remainder
+	for (const uint32 NumOfChannels : {1u, 3u})
+	{
+		constexpr int64 NumOfFrames = NumOfFramesPerBin * 100 + 37;
+
+		FRandomStream RandomStream(1234);
+		TArray<float> PCMData;
+		PCMData.SetNumUninitialized(NumOfFrames * NumOfChannels);
+		for (float& Sample : PCMData)
+		{
+			Sample = RandomStream.FRandRange(-1.f, 1.f);
+		}
+
+		// Appended in pieces that do not line up with the bins, as populated audio data is
+		FRuntimeAudioWaveformPyramid Pyramid;
+		Pyramid.Reset(NumOfChannels);
+		for (int64 FrameIndex = 0; FrameIndex < NumOfFrames; FrameIndex += 333)
+		{
+			Pyramid.AppendFrames(PCMData.GetData() + FrameIndex * NumOfChannels, FMath::Min<int64>(333, NumOfFrames - FrameIndex));
+		}
+		TestEqual(TEXT("All frames are appended"), Pyramid.GetNumOfFrames(), NumOfFrames);
+
+		// Every peak covers exactly one bin of the finest level, of a coarser level, and the frames not yet forming a bin
+		TestPeaks(*this, Pyramid, PCMData, NumOfFramesPerBin * 5, NumOfFramesPerBin * 9, 4);
+		TestPeaks(*this, Pyramid, PCMData, 0, NumOfFramesPerBin * 64, 8);
+		TestPeaks(*this, Pyramid, PCMData, NumOfFramesPerBin * 8, NumOfFramesPerBin * 24, 4);
+		TestPeaks(*this, Pyramid, PCMData, NumOfFramesPerBin * 100, NumOfFrames, 1);
+	}
+
+	return true;
+}
+
+#endif
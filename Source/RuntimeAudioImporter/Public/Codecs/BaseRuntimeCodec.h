@@ -5,6 +5,9 @@
 #include "CoreMinimal.h"
 #include "Features/IModularFeature.h"
 #include "RuntimeAudioImporterTypes.h"
+#include "RuntimeEncoderSession.h"
+#include "RuntimeDecoderSession.h"
+#include "RuntimePCMFormatConverter.h"
 
 /**
  * Base runtime codec
@@ -32,11 +35,39 @@ public:
 	 * Encode uncompressed PCM data into a compressed format
 	 */
 	virtual bool Encode(FDecodedAudioStruct DecodedData, FEncodedAudioStruct& EncodedData, uint8 Quality) PURE_VIRTUAL(FBaseRuntimeCodec::Encode, return false;)
+
+	/**
+	 * Create a session for encoding PCM data incrementally, as it arrives
+	 *
+	 * @return The created encoder session, or nullptr if the codec does not support incremental encoding
+	 */
+	virtual TUniquePtr<FBaseRuntimeEncoderSession> CreateEncoderSession() { return nullptr; }
+
+	/**
+	 * Create a session for decoding an encoded stream incrementally, as it arrives in slices cut at arbitrary bytes
+	 *
+	 * @return The created decoder session, or nullptr if the codec does not support incremental decoding
+	 */
+	virtual TUniquePtr<FBaseRuntimeDecoderSession> CreateDecoderSession() { return nullptr; }
+
 	/**
 	 * Decode compressed audio data into PCM format
 	 */
 	virtual bool Decode(FEncodedAudioStruct EncodedData, FDecodedAudioStruct& DecodedData) PURE_VIRTUAL(FBaseRuntimeCodec::Decode, return false;)
 
+	/**
+	 * Decode compressed audio data into PCM format with the specified sample rate and number of channels
+	 * Codecs that are able to decode block by block should override this to convert each block as it is decoded (see FRuntimePCMFormatConverter), so that the whole PCM data is never held in the source format
+	 * By default, the audio data is fully decoded and then converted
+	 *
+	 * @param TargetSampleRate The sample rate to decode to. Zero to keep the source sample rate
+	 * @param TargetNumOfChannels The number of channels to decode to. Zero to keep the source number of channels
+	 */
+	virtual bool DecodeToFormat(FEncodedAudioStruct EncodedData, FDecodedAudioStruct& DecodedData, uint32 TargetSampleRate, uint32 TargetNumOfChannels)
+	{
+		return Decode(MoveTemp(EncodedData), DecodedData) && FRuntimePCMFormatConverter::ConvertDecodedAudio(DecodedData, TargetSampleRate, TargetNumOfChannels);
+	}
+
 	/**
 	 * Retrieve the format applicable to this codec
 	 */
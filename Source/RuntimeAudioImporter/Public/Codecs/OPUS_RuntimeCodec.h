@@ -12,6 +12,8 @@ public:
 	virtual bool CheckAudioFormat(const FRuntimeBulkDataBuffer<uint8>& AudioData) override;
 	virtual bool GetHeaderInfo(FEncodedAudioStruct EncodedData, FRuntimeAudioHeaderInfo& HeaderInfo) override;
 	virtual bool Encode(FDecodedAudioStruct DecodedData, FEncodedAudioStruct& EncodedData, uint8 Quality) override;
+	virtual TUniquePtr<FBaseRuntimeEncoderSession> CreateEncoderSession() override;
+	virtual TUniquePtr<FBaseRuntimeDecoderSession> CreateDecoderSession() override;
 	virtual bool Decode(FEncodedAudioStruct EncodedData, FDecodedAudioStruct& DecodedData) override;
 	virtual ERuntimeAudioFormat GetAudioFormat() const override { return ERuntimeAudioFormat::OggOpus; }
 	virtual bool IsExtensionSupported(const FString& Extension) const override
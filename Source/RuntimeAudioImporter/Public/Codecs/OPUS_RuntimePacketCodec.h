@@ -0,0 +1,255 @@
+﻿// Georgy Treshchev 2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Map.h"
+
+struct OpusEncoder;
+struct OpusDecoder;
+
+/**
+ * Encoder of raw Opus packets (no Ogg framing), e.g. for sending captured audio data over the network in real time
+ * The PCM data is pushed in blocks of any size and every complete 20ms frame is encoded into a packet of its own
+ *
+ * @note The encoder is not thread-safe, the caller is responsible for serializing the calls
+ */
+class RUNTIMEAUDIOIMPORTER_API FOPUS_RuntimePacketEncoder
+{
+public:
+	FOPUS_RuntimePacketEncoder();
+	~FOPUS_RuntimePacketEncoder();
+
+	FOPUS_RuntimePacketEncoder(const FOPUS_RuntimePacketEncoder&) = delete;
+	FOPUS_RuntimePacketEncoder& operator=(const FOPUS_RuntimePacketEncoder&) = delete;
+
+	/**
+	 * Initialize the encoder
+	 *
+	 * @param InSampleRate The sample rate of the PCM data that will be pushed. Must be 8000, 12000, 16000, 24000 or 48000
+	 * @param InNumOfChannels The number of channels of the PCM data that will be pushed. Must be 1 or 2
+	 * @param Bitrate The target bitrate, in bits per second
+	 * @param ExpectedPacketLossPercentage The expected packet loss, 0-100%. If non-zero, in-band FEC (forward error correction) data is added to the packets so that the decoder can recover a lost packet from the next one
+	 * @return Whether the encoder was successfully initialized or not
+	 */
+	bool Initialize(uint32 InSampleRate, uint32 InNumOfChannels, int32 Bitrate = 32000, int32 ExpectedPacketLossPercentage = 10);
+
+	/**
+	 * Encode the specified interleaved 32-bit float PCM frames. The frames not forming a complete packet are kept for the next push
+	 *
+	 * @param PCMData Interleaved PCM data in the format specified in Initialize
+	 * @param NumOfFrames The number of frames in PCMData
+	 * @param OutPackets The encoded packets are appended to this array
+	 * @return Whether the frames were successfully encoded or not
+	 */
+	bool PushFrames(const float* PCMData, int64 NumOfFrames, TArray<TArray<uint8>>& OutPackets);
+
+	/**
+	 * Encode the frames kept from the previous pushes as the last packet, padding it with silence
+	 *
+	 * @param OutPackets The encoded packet is appended to this array, if there were frames kept
+	 * @return Whether the frames were successfully encoded or not
+	 */
+	bool Flush(TArray<TArray<uint8>>& OutPackets);
+
+	/**
+	 * Get the number of frames encoded into a single packet (20ms)
+	 */
+	int32 GetNumOfFramesPerPacket() const { return NumOfFramesPerPacket; }
+
+	/**
+	 * Whether the encoder has been successfully initialized or not
+	 */
+	bool IsInitialized() const { return Encoder != nullptr; }
+
+private:
+	/**
+	 * Encode a single packet from the pending buffer
+	 */
+	bool EncodePacket(TArray<TArray<uint8>>& OutPackets);
+
+	void Release();
+
+	OpusEncoder* Encoder;
+	uint32 NumOfChannels;
+	int32 NumOfFramesPerPacket;
+
+	/** Frames not yet forming a complete packet. Allocated once, for a single packet */
+	TArray<float> PendingPCMData;
+
+	/** The number of frames in PendingPCMData */
+	int32 NumOfPendingFrames;
+};
+
+/**
+ * Decoder of raw Opus packets (no Ogg framing), with packet loss concealment and recovery of lost packets from the FEC data of the next ones
+ *
+ * @note The decoder is not thread-safe, the caller is responsible for serializing the calls
+ */
+class RUNTIMEAUDIOIMPORTER_API FOPUS_RuntimePacketDecoder
+{
+public:
+	FOPUS_RuntimePacketDecoder();
+	~FOPUS_RuntimePacketDecoder();
+
+	FOPUS_RuntimePacketDecoder(const FOPUS_RuntimePacketDecoder&) = delete;
+	FOPUS_RuntimePacketDecoder& operator=(const FOPUS_RuntimePacketDecoder&) = delete;
+
+	/**
+	 * Initialize the decoder
+	 *
+	 * @param InSampleRate The sample rate to decode to. Must be 8000, 12000, 16000, 24000 or 48000. Does not have to match the sample rate the packets were encoded at
+	 * @param InNumOfChannels The number of channels to decode to. Must be 1 or 2
+	 * @return Whether the decoder was successfully initialized or not
+	 */
+	bool Initialize(uint32 InSampleRate, uint32 InNumOfChannels);
+
+	/**
+	 * Decode the packet
+	 *
+	 * @param PacketData The packet
+	 * @param PacketSize The size of the packet, in bytes
+	 * @param OutPCMData The decoded interleaved 32-bit float PCM frames are appended to this array
+	 * @return The number of decoded frames, or -1 if decoding failed
+	 */
+	int32 DecodePacket(const uint8* PacketData, int32 PacketSize, TArray<float>& OutPCMData);
+
+	/**
+	 * Recover a lost packet from the FEC data of the packet following it. Falls back to concealment if the packet has no FEC data
+	 *
+	 * @param NextPacketData The packet following the lost one
+	 * @param NextPacketSize The size of the packet following the lost one, in bytes
+	 * @param OutPCMData The recovered interleaved 32-bit float PCM frames are appended to this array
+	 * @return The number of recovered frames, or -1 if recovering failed
+	 */
+	int32 RecoverLostPacket(const uint8* NextPacketData, int32 NextPacketSize, TArray<float>& OutPCMData);
+
+	/**
+	 * Conceal a lost packet, extrapolating it from the previously decoded audio data (PLC)
+	 *
+	 * @param OutPCMData The concealed interleaved 32-bit float PCM frames are appended to this array
+	 * @return The number of concealed frames, or -1 if concealing failed
+	 */
+	int32 ConcealLostPacket(TArray<float>& OutPCMData);
+
+	/**
+	 * Whether the decoder has been successfully initialized or not
+	 */
+	bool IsInitialized() const { return Decoder != nullptr; }
+
+	uint32 GetSampleRate() const { return SampleRate; }
+	uint32 GetNumOfChannels() const { return NumOfChannels; }
+
+private:
+	/**
+	 * Decode into the end of the specified array, growing it by at most MaxNumOfFrames frames
+	 */
+	int32 Decode(const uint8* PacketData, int32 PacketSize, int32 MaxNumOfFrames, bool bDecodeFEC, TArray<float>& OutPCMData);
+
+	void Release();
+
+	OpusDecoder* Decoder;
+	uint32 SampleRate;
+	uint32 NumOfChannels;
+
+	/** The number of frames of the last decoded packet, used as the duration of lost packets */
+	int32 NumOfFramesPerPacket;
+};
+
+/** Statistics of a jitter buffer */
+struct RUNTIMEAUDIOIMPORTER_API FOPUS_RuntimeJitterBufferStats
+{
+	/** The number of packets pushed, including the dropped ones */
+	int64 NumOfReceivedPackets = 0;
+
+	/** The number of packets received out of order but in time to be decoded in order */
+	int64 NumOfReorderedPackets = 0;
+
+	/** The number of packets dropped as they arrived after their turn to be decoded had passed */
+	int64 NumOfLatePackets = 0;
+
+	/** The number of packets dropped as they had already been received */
+	int64 NumOfDuplicatePackets = 0;
+
+	/** The number of packets decoded */
+	int64 NumOfDecodedPackets = 0;
+
+	/** The number of lost packets recovered from the FEC data of the next packet */
+	int64 NumOfRecoveredPackets = 0;
+
+	/** The number of lost packets concealed (PLC) */
+	int64 NumOfConcealedPackets = 0;
+};
+
+/**
+ * Reorder/jitter buffer of raw Opus packets, numbered by the sender
+ * Packets are held until their turn to be decoded. A missing packet is declared lost once a packet Depth sequence numbers newer has arrived (or when flushing),
+ * and is then recovered from the FEC data of the next packet if it has arrived, or concealed otherwise, so that the decoded audio data has no gaps
+ *
+ * @note The jitter buffer is not thread-safe, the caller is responsible for serializing the calls
+ */
+class RUNTIMEAUDIOIMPORTER_API FOPUS_RuntimeJitterBuffer
+{
+public:
+	/**
+	 * @param InDepth The number of packets to wait for a missing packet before declaring it lost. Higher values handle more reordering at the cost of latency
+	 */
+	explicit FOPUS_RuntimeJitterBuffer(int32 InDepth = 3);
+
+	/**
+	 * Initialize the decoder the packets are decoded with
+	 *
+	 * @param InSampleRate The sample rate to decode to. Must be 8000, 12000, 16000, 24000 or 48000
+	 * @param InNumOfChannels The number of channels to decode to. Must be 1 or 2
+	 * @return Whether the jitter buffer was successfully initialized or not
+	 */
+	bool Initialize(uint32 InSampleRate, uint32 InNumOfChannels);
+
+	/**
+	 * Push a received packet
+	 *
+	 * @param SequenceNumber The number of the packet, incremented by one per packet by the sender
+	 * @param Packet The packet
+	 * @return Whether the packet was accepted or not (dropped as late or duplicate)
+	 */
+	bool PushPacket(int64 SequenceNumber, TArray<uint8>&& Packet);
+
+	/**
+	 * Decode the packets whose turn has come, in order, recovering or concealing the lost ones
+	 *
+	 * @param OutPCMData The decoded interleaved 32-bit float PCM frames are appended to this array
+	 * @param bFlush Whether to decode all held packets without waiting for the missing ones (e.g. at the end of the stream)
+	 * @return The number of decoded frames
+	 */
+	int64 PopFrames(TArray<float>& OutPCMData, bool bFlush = false);
+
+	/**
+	 * Get the statistics of the jitter buffer
+	 */
+	const FOPUS_RuntimeJitterBufferStats& GetStats() const { return Stats; }
+
+	/**
+	 * Get the number of packets held
+	 */
+	int32 GetNumOfPendingPackets() const { return PendingPackets.Num(); }
+
+	const FOPUS_RuntimePacketDecoder& GetDecoder() const { return Decoder; }
+
+private:
+	/** The longest run of lost packets that is concealed. Longer gaps (e.g. the sender has restarted) are skipped */
+	static constexpr int64 MaxNumOfConcealedPackets = 50;
+
+	const int32 Depth;
+	FOPUS_RuntimePacketDecoder Decoder;
+
+	/** The received packets waiting for their turn, by sequence number */
+	TMap<int64, TArray<uint8>> PendingPackets;
+
+	/** The sequence number of the next packet to decode. INDEX_NONE until the first packet is decoded */
+	int64 NextSequenceNumber;
+
+	/** The highest sequence number received */
+	int64 HighestSequenceNumber;
+
+	FOPUS_RuntimeJitterBufferStats Stats;
+};
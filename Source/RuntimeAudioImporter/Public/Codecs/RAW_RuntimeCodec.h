@@ -6,8 +6,12 @@
 #include "Math/UnrealMathUtility.h"
 #include "HAL/UnrealMemory.h"
 #include "RuntimeAudioImporterDefines.h"
+#include "RuntimeAudioImporterTypes.h"
 #include "SampleBuffer.h"
 #include "AudioResampler.h"
+#if !UE_VERSION_OLDER_THAN(5, 1, 0)
+#include "DSP/FloatArrayMath.h"
+#endif
 #include <type_traits>
 #include <limits>
 
@@ -113,6 +117,266 @@ public:
 		       static_cast<uint64>(sizeof(IntegralTypeFrom)), MinAndMaxValuesFrom.Key, MinAndMaxValuesFrom.Value, static_cast<uint64>(sizeof(IntegralTypeTo)), MinAndMaxValuesTo.Key, MinAndMaxValuesTo.Value);
 	}
 
+	/**
+	 * Converting 32-bit float PCM data to 16-bit integer PCM data. Vectorized on Unreal Engine version >= 5.1
+	 *
+	 * @param PCMDataFrom Pointer to memory location of the 32-bit float PCM data
+	 * @param PCMDataTo Pointer to memory location of the 16-bit integer PCM data. Must have space for NumOfSamples samples
+	 * @param NumOfSamples Number of samples to convert
+	 */
+	static void ConvertFloatToInt16(const float* PCMDataFrom, int16* PCMDataTo, int64 NumOfSamples)
+	{
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+		for (int64 SampleIndex = 0; SampleIndex < NumOfSamples; ++SampleIndex)
+		{
+			PCMDataTo[SampleIndex] = static_cast<int16>(FMath::Clamp(PCMDataFrom[SampleIndex], -1.f, 1.f) * MAX_int16);
+		}
+#else
+		// Array views are limited to int32 elements, so converting in chunks
+		for (int64 SampleIndex = 0; SampleIndex < NumOfSamples; SampleIndex += MAX_int32)
+		{
+			const int32 NumOfChunkSamples = static_cast<int32>(FMath::Min<int64>(NumOfSamples - SampleIndex, MAX_int32));
+			Audio::ArrayFloatToPcm16(TArrayView<const float>(PCMDataFrom + SampleIndex, NumOfChunkSamples), TArrayView<int16>(PCMDataTo + SampleIndex, NumOfChunkSamples));
+		}
+#endif
+	}
+
+	/**
+	 * Converting 16-bit integer PCM data to 32-bit float PCM data. Vectorized on Unreal Engine version >= 5.1
+	 *
+	 * @param PCMDataFrom Pointer to memory location of the 16-bit integer PCM data
+	 * @param PCMDataTo Pointer to memory location of the 32-bit float PCM data. Must have space for NumOfSamples samples
+	 * @param NumOfSamples Number of samples to convert
+	 */
+	static void ConvertInt16ToFloat(const int16* PCMDataFrom, float* PCMDataTo, int64 NumOfSamples)
+	{
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+		for (int64 SampleIndex = 0; SampleIndex < NumOfSamples; ++SampleIndex)
+		{
+			PCMDataTo[SampleIndex] = static_cast<float>(PCMDataFrom[SampleIndex]) / MAX_int16;
+		}
+#else
+		for (int64 SampleIndex = 0; SampleIndex < NumOfSamples; SampleIndex += MAX_int32)
+		{
+			const int32 NumOfChunkSamples = static_cast<int32>(FMath::Min<int64>(NumOfSamples - SampleIndex, MAX_int32));
+			Audio::ArrayPcm16ToFloat(TArrayView<const int16>(PCMDataFrom + SampleIndex, NumOfChunkSamples), TArrayView<float>(PCMDataTo + SampleIndex, NumOfChunkSamples));
+		}
+#endif
+	}
+
+	/**
+	 * Copying a range of the PCM data as 32-bit float, regardless of the format it is stored in
+	 *
+	 * @param PCMInfo The PCM data to copy from
+	 * @param SampleIndex Index of the first sample to copy
+	 * @param NumOfSamples Number of samples to copy
+	 * @param OutPCMData Pointer to memory location of the 32-bit float PCM data. Must have space for NumOfSamples samples
+	 */
+	static void CopyPCMDataAsFloat(const FPCMStruct& PCMInfo, int64 SampleIndex, int64 NumOfSamples, float* OutPCMData)
+	{
+		if (PCMInfo.GetStorageFormat() == ERuntimePCMStorageFormat::Int16)
+		{
+			ConvertInt16ToFloat(PCMInfo.PCMDataInt16.GetView().GetData() + SampleIndex, OutPCMData, NumOfSamples);
+		}
+		else
+		{
+			FMemory::Memcpy(OutPCMData, PCMInfo.PCMData.GetView().GetData() + SampleIndex, NumOfSamples * sizeof(float));
+		}
+	}
+
+	/**
+	 * Copying a range of the PCM data as 16-bit integer, regardless of the format it is stored in
+	 *
+	 * @param PCMInfo The PCM data to copy from
+	 * @param SampleIndex Index of the first sample to copy
+	 * @param NumOfSamples Number of samples to copy
+	 * @param OutPCMData Pointer to memory location of the 16-bit integer PCM data. Must have space for NumOfSamples samples
+	 */
+	static void CopyPCMDataAsInt16(const FPCMStruct& PCMInfo, int64 SampleIndex, int64 NumOfSamples, int16* OutPCMData)
+	{
+		if (PCMInfo.GetStorageFormat() == ERuntimePCMStorageFormat::Int16)
+		{
+			FMemory::Memcpy(OutPCMData, PCMInfo.PCMDataInt16.GetView().GetData() + SampleIndex, NumOfSamples * sizeof(int16));
+		}
+		else
+		{
+			ConvertFloatToInt16(PCMInfo.PCMData.GetView().GetData() + SampleIndex, OutPCMData, NumOfSamples);
+		}
+	}
+
+	/**
+	 * Copying a range of frames of the PCM data, either all channels interleaved or a single channel, converting them to the output format
+	 * The range must be within the PCM data
+	 *
+	 * @param PCMInfo The PCM data to copy from
+	 * @param NumOfChannels Number of channels in the PCM data
+	 * @param StartFrame Index of the first frame to copy
+	 * @param NumOfFrames Number of frames to copy
+	 * @param ChannelIndex Index of the channel to copy, or INDEX_NONE to copy all channels interleaved
+	 * @param OutPCMData Pointer to memory location of the PCM data. Must have space for NumOfFrames frames of the copied channels
+	 */
+	template <typename SampleType>
+	static void CopyPCMFrames(const FPCMStruct& PCMInfo, uint32 NumOfChannels, int64 StartFrame, int64 NumOfFrames, int32 ChannelIndex, SampleType* OutPCMData)
+	{
+		if (ChannelIndex == INDEX_NONE)
+		{
+			CopyPCMDataAs(PCMInfo, StartFrame * NumOfChannels, NumOfFrames * NumOfChannels, OutPCMData);
+		}
+		else if (PCMInfo.GetStorageFormat() == ERuntimePCMStorageFormat::Int16)
+		{
+			CopyChannelSamples(PCMInfo.PCMDataInt16.GetView().GetData() + StartFrame * NumOfChannels + ChannelIndex, NumOfChannels, NumOfFrames, OutPCMData);
+		}
+		else
+		{
+			CopyChannelSamples(PCMInfo.PCMData.GetView().GetData() + StartFrame * NumOfChannels + ChannelIndex, NumOfChannels, NumOfFrames, OutPCMData);
+		}
+	}
+
+	/**
+	 * Finding the first frame with a sample louder than the threshold in any channel, four samples at a time
+	 *
+	 * @param PCMData Interleaved 32-bit float PCM data
+	 * @param NumOfFrames The number of frames in the PCM data
+	 * @param NumOfChannels The number of channels in the PCM data
+	 * @param Threshold The absolute sample value a sample must exceed to be considered loud
+	 * @return Index of the first loud frame, or INDEX_NONE if there is none
+	 */
+	static int64 FindFirstLoudFrame(const float* PCMData, int64 NumOfFrames, uint32 NumOfChannels, float Threshold)
+	{
+		const int64 NumOfSamples = NumOfFrames * NumOfChannels;
+		const int64 NumOfVectorizedSamples = NumOfSamples & ~static_cast<int64>(3);
+		const FRAIVectorRegister ThresholdVector = VectorSetFloat1(Threshold);
+
+		for (int64 SampleIndex = 0; SampleIndex < NumOfVectorizedSamples; SampleIndex += 4)
+		{
+			const uint32 LoudMask = static_cast<uint32>(VectorMaskBits(VectorCompareGT(VectorAbs(VectorLoad(PCMData + SampleIndex)), ThresholdVector)));
+			if (LoudMask != 0)
+			{
+				return (SampleIndex + FMath::CountTrailingZeros(LoudMask)) / NumOfChannels;
+			}
+		}
+
+		for (int64 SampleIndex = NumOfVectorizedSamples; SampleIndex < NumOfSamples; ++SampleIndex)
+		{
+			if (FMath::Abs(PCMData[SampleIndex]) > Threshold)
+			{
+				return SampleIndex / NumOfChannels;
+			}
+		}
+
+		return INDEX_NONE;
+	}
+
+	/**
+	 * Finding the last frame with a sample louder than the threshold in any channel, four samples at a time
+	 *
+	 * @param PCMData Interleaved 32-bit float PCM data
+	 * @param NumOfFrames The number of frames in the PCM data
+	 * @param NumOfChannels The number of channels in the PCM data
+	 * @param Threshold The absolute sample value a sample must exceed to be considered loud
+	 * @return Index of the last loud frame, or INDEX_NONE if there is none
+	 */
+	static int64 FindLastLoudFrame(const float* PCMData, int64 NumOfFrames, uint32 NumOfChannels, float Threshold)
+	{
+		const int64 NumOfSamples = NumOfFrames * NumOfChannels;
+		const int64 NumOfVectorizedSamples = NumOfSamples & ~static_cast<int64>(3);
+		const FRAIVectorRegister ThresholdVector = VectorSetFloat1(Threshold);
+
+		for (int64 SampleIndex = NumOfSamples - 1; SampleIndex >= NumOfVectorizedSamples; --SampleIndex)
+		{
+			if (FMath::Abs(PCMData[SampleIndex]) > Threshold)
+			{
+				return SampleIndex / NumOfChannels;
+			}
+		}
+
+		for (int64 SampleIndex = NumOfVectorizedSamples - 4; SampleIndex >= 0; SampleIndex -= 4)
+		{
+			const uint32 LoudMask = static_cast<uint32>(VectorMaskBits(VectorCompareGT(VectorAbs(VectorLoad(PCMData + SampleIndex)), ThresholdVector)));
+			if (LoudMask != 0)
+			{
+				return (SampleIndex + FMath::FloorLog2(LoudMask)) / NumOfChannels;
+			}
+		}
+
+		return INDEX_NONE;
+	}
+
+	/**
+	 * Finding the first frame with a sample louder than the threshold in any channel
+	 *
+	 * @param PCMData Interleaved 16-bit integer PCM data
+	 * @param NumOfFrames The number of frames in the PCM data
+	 * @param NumOfChannels The number of channels in the PCM data
+	 * @param Threshold The absolute sample value, relative to full scale, a sample must exceed to be considered loud
+	 * @return Index of the first loud frame, or INDEX_NONE if there is none
+	 */
+	static int64 FindFirstLoudFrame(const int16* PCMData, int64 NumOfFrames, uint32 NumOfChannels, float Threshold)
+	{
+		const int32 IntegerThreshold = FMath::FloorToInt(FMath::Clamp(Threshold, 0.f, 1.f) * MAX_int16);
+		const int64 NumOfSamples = NumOfFrames * NumOfChannels;
+		for (int64 SampleIndex = 0; SampleIndex < NumOfSamples; ++SampleIndex)
+		{
+			if (FMath::Abs(static_cast<int32>(PCMData[SampleIndex])) > IntegerThreshold)
+			{
+				return SampleIndex / NumOfChannels;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	/**
+	 * Finding the last frame with a sample louder than the threshold in any channel
+	 *
+	 * @param PCMData Interleaved 16-bit integer PCM data
+	 * @param NumOfFrames The number of frames in the PCM data
+	 * @param NumOfChannels The number of channels in the PCM data
+	 * @param Threshold The absolute sample value, relative to full scale, a sample must exceed to be considered loud
+	 * @return Index of the last loud frame, or INDEX_NONE if there is none
+	 */
+	static int64 FindLastLoudFrame(const int16* PCMData, int64 NumOfFrames, uint32 NumOfChannels, float Threshold)
+	{
+		const int32 IntegerThreshold = FMath::FloorToInt(FMath::Clamp(Threshold, 0.f, 1.f) * MAX_int16);
+		for (int64 SampleIndex = NumOfFrames * NumOfChannels - 1; SampleIndex >= 0; --SampleIndex)
+		{
+			if (FMath::Abs(static_cast<int32>(PCMData[SampleIndex])) > IntegerThreshold)
+			{
+				return SampleIndex / NumOfChannels;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	/**
+	 * Converting the PCM data to the specified storage format. The PCM data in the previous format is released
+	 *
+	 * @param PCMInfo The PCM data to convert
+	 * @param StorageFormat The storage format to convert to
+	 */
+	static void ConvertPCMStorageFormat(FPCMStruct& PCMInfo, ERuntimePCMStorageFormat StorageFormat)
+	{
+		if (PCMInfo.GetStorageFormat() == StorageFormat || PCMInfo.GetNumOfSamples() <= 0)
+		{
+			return;
+		}
+
+		const int64 NumOfSamples = PCMInfo.GetNumOfSamples();
+		if (StorageFormat == ERuntimePCMStorageFormat::Int16)
+		{
+			int16* Int16PCMData = static_cast<int16*>(FMemory::Malloc(NumOfSamples * sizeof(int16)));
+			ConvertFloatToInt16(PCMInfo.PCMData.GetView().GetData(), Int16PCMData, NumOfSamples);
+			PCMInfo.PCMDataInt16 = FRuntimeBulkDataBuffer<int16>(Int16PCMData, NumOfSamples);
+			PCMInfo.PCMData.Empty();
+		}
+		else
+		{
+			float* FloatPCMData = static_cast<float*>(FMemory::Malloc(NumOfSamples * sizeof(float)));
+			ConvertInt16ToFloat(PCMInfo.PCMDataInt16.GetView().GetData(), FloatPCMData, NumOfSamples);
+			PCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(FloatPCMData, NumOfSamples);
+			PCMInfo.PCMDataInt16.Empty();
+		}
+	}
+
 	/**
 	 * Resampling RAW Data to a different sample rate
 	 *
@@ -214,16 +478,132 @@ public:
 
 	/**
 	 * Reversing RAW Data
-	 * 
+	 *
 	 * @param RAWData RAW data for reversing
+	 * @param NumOfChannels The number of channels in the RAW data. The order of the channels within each frame is preserved
 	 */
-	static void ReverseRAWData(Audio::FAlignedFloatBuffer& RAWData)
+	static void ReverseRAWData(Audio::FAlignedFloatBuffer& RAWData, uint32 NumOfChannels = 1)
 	{
 		if (RAWData.Num() <= 1)
 		{
 			UE_LOG(LogRuntimeAudioImporter, Warning, TEXT("Skipping audio data reversal because the number of samples is less than or equal to 1"));
 		}
 
-		Algo::Reverse(RAWData);
+		ReverseFrames(RAWData.GetData(), RAWData.Num() / FMath::Max<int64>(NumOfChannels, 1), FMath::Max<uint32>(NumOfChannels, 1));
+	}
+
+	/**
+	 * Reverse the order of the frames of interleaved PCM data in place, preserving the order of the channels within each frame
+	 * Mono and stereo data is reversed four samples at a time using vector instructions
+	 *
+	 * @param PCMData Interleaved PCM data to reverse
+	 * @param NumOfFrames The number of frames in the PCM data
+	 * @param NumOfChannels The number of channels in the PCM data
+	 */
+	static void ReverseFrames(float* PCMData, int64 NumOfFrames, uint32 NumOfChannels)
+	{
+		if (NumOfChannels == 1 || NumOfChannels == 2)
+		{
+			// Swapping blocks of four samples from both ends. A block contains four mono frames or two stereo frames, which are reversed with a single shuffle
+			float* Front = PCMData;
+			float* Back = PCMData + NumOfFrames * NumOfChannels;
+			while (Back - Front >= 8)
+			{
+				Back -= 4;
+				const FRAIVectorRegister FrontBlock = VectorLoad(Front);
+				const FRAIVectorRegister BackBlock = VectorLoad(Back);
+				if (NumOfChannels == 1)
+				{
+					VectorStore(VectorSwizzle(BackBlock, 3, 2, 1, 0), Front);
+					VectorStore(VectorSwizzle(FrontBlock, 3, 2, 1, 0), Back);
+				}
+				else
+				{
+					VectorStore(VectorSwizzle(BackBlock, 2, 3, 0, 1), Front);
+					VectorStore(VectorSwizzle(FrontBlock, 2, 3, 0, 1), Back);
+				}
+				Front += 4;
+			}
+
+			// The remaining frames in the middle
+			ReverseFramesScalar(Front, (Back - Front) / NumOfChannels, NumOfChannels);
+			return;
+		}
+
+		ReverseFramesScalar(PCMData, NumOfFrames, NumOfChannels);
+	}
+
+	/**
+	 * Reverse the order of the frames of interleaved PCM data in place, preserving the order of the channels within each frame
+	 *
+	 * @param PCMData Interleaved PCM data to reverse
+	 * @param NumOfFrames The number of frames in the PCM data
+	 * @param NumOfChannels The number of channels in the PCM data
+	 */
+	static void ReverseFrames(int16* PCMData, int64 NumOfFrames, uint32 NumOfChannels)
+	{
+		ReverseFramesScalar(PCMData, NumOfFrames, NumOfChannels);
+	}
+
+private:
+	template <typename SampleType>
+	static void ReverseFramesScalar(SampleType* PCMData, int64 NumOfFrames, uint32 NumOfChannels)
+	{
+		for (int64 FrontFrame = 0, BackFrame = NumOfFrames - 1; FrontFrame < BackFrame; ++FrontFrame, --BackFrame)
+		{
+			for (uint32 ChannelIndex = 0; ChannelIndex < NumOfChannels; ++ChannelIndex)
+			{
+				Swap(PCMData[FrontFrame * NumOfChannels + ChannelIndex], PCMData[BackFrame * NumOfChannels + ChannelIndex]);
+			}
+		}
+	}
+
+	static void CopyPCMDataAs(const FPCMStruct& PCMInfo, int64 SampleIndex, int64 NumOfSamples, float* OutPCMData)
+	{
+		CopyPCMDataAsFloat(PCMInfo, SampleIndex, NumOfSamples, OutPCMData);
+	}
+
+	static void CopyPCMDataAs(const FPCMStruct& PCMInfo, int64 SampleIndex, int64 NumOfSamples, int16* OutPCMData)
+	{
+		CopyPCMDataAsInt16(PCMInfo, SampleIndex, NumOfSamples, OutPCMData);
+	}
+
+	static void ConvertSamples(const float* PCMDataFrom, float* PCMDataTo, int64 NumOfSamples)
+	{
+		FMemory::Memcpy(PCMDataTo, PCMDataFrom, NumOfSamples * sizeof(float));
+	}
+
+	static void ConvertSamples(const int16* PCMDataFrom, int16* PCMDataTo, int64 NumOfSamples)
+	{
+		FMemory::Memcpy(PCMDataTo, PCMDataFrom, NumOfSamples * sizeof(int16));
+	}
+
+	static void ConvertSamples(const float* PCMDataFrom, int16* PCMDataTo, int64 NumOfSamples)
+	{
+		ConvertFloatToInt16(PCMDataFrom, PCMDataTo, NumOfSamples);
+	}
+
+	static void ConvertSamples(const int16* PCMDataFrom, float* PCMDataTo, int64 NumOfSamples)
+	{
+		ConvertInt16ToFloat(PCMDataFrom, PCMDataTo, NumOfSamples);
+	}
+
+	/**
+	 * Copy every NumOfChannels-th sample starting at the specified one, gathering them block by block so that the format conversion stays vectorized
+	 */
+	template <typename SourceSampleType, typename SampleType>
+	static void CopyChannelSamples(const SourceSampleType* PCMDataFrom, uint32 NumOfChannels, int64 NumOfFrames, SampleType* PCMDataTo)
+	{
+		constexpr int64 NumOfFramesPerBlock = 1024;
+		SourceSampleType Block[NumOfFramesPerBlock];
+		for (int64 FrameIndex = 0; FrameIndex < NumOfFrames; FrameIndex += NumOfFramesPerBlock)
+		{
+			const int64 NumOfBlockFrames = FMath::Min(NumOfFrames - FrameIndex, NumOfFramesPerBlock);
+			for (int64 BlockFrameIndex = 0; BlockFrameIndex < NumOfBlockFrames; ++BlockFrameIndex)
+			{
+				Block[BlockFrameIndex] = PCMDataFrom[(FrameIndex + BlockFrameIndex) * NumOfChannels];
+			}
+			ConvertSamples(Block, PCMDataTo + FrameIndex, NumOfBlockFrames);
+		}
 	}
 };
@@ -0,0 +1,157 @@
+﻿// Georgy Treshchev 2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RuntimeAudioImporterTypes.h"
+#include "Templates/UniquePtr.h"
+#include "RuntimePCMFormatConverter.h"
+
+/**
+ * Base incremental decoder session
+ * Decodes an encoded stream pushed in slices cut at arbitrary bytes (PushData -> ... -> PushData -> Finish), e.g. as it is read from a file or a pipe
+ * The decoder state (e.g. the MP3 bit reservoir or the Ogg page and packet state) is kept between pushes, and incomplete data is held until the next push,
+ * so each push only costs decoding the frames it completes
+ * Sessions are created by codecs supporting incremental decoding (see FBaseRuntimeCodec::CreateDecoderSession)
+ *
+ * @note The session is not thread-safe, the caller is responsible for serializing the calls
+ */
+class RUNTIMEAUDIOIMPORTER_API FBaseRuntimeDecoderSession
+{
+public:
+	FBaseRuntimeDecoderSession();
+	virtual ~FBaseRuntimeDecoderSession();
+
+	/**
+	 * Set the sample rate and the number of channels to convert the decoded audio data to. The conversion is streamed, so there are no discontinuities between pushes
+	 * Must be called before the first push
+	 *
+	 * @param InTargetSampleRate The sample rate to convert to. Zero to keep the sample rate of the stream
+	 * @param InTargetNumOfChannels The number of channels to convert to. Zero to keep the number of channels of the stream
+	 */
+	void SetTargetFormat(uint32 InTargetSampleRate, uint32 InTargetNumOfChannels);
+
+	/**
+	 * Decode the specified slice of the encoded stream
+	 *
+	 * @param Data The slice of the encoded stream. May end in the middle of a frame or a page
+	 * @param Size The size of the slice, in bytes
+	 * @param OutDecodedAudioInfo The audio data decoded from the frames completed by this slice. The PCM data is empty if no frame was completed
+	 * @return Whether the slice was successfully decoded or not
+	 */
+	bool PushData(const uint8* Data, int64 Size, FDecodedAudioStruct& OutDecodedAudioInfo);
+
+	/**
+	 * Finish the session. Decodes whatever is left of the stream and releases the decoder
+	 *
+	 * @param OutDecodedAudioInfo The remaining decoded audio data. The PCM data is empty if there was none
+	 * @return Whether the session was successfully finished or not
+	 */
+	bool Finish(FDecodedAudioStruct& OutDecodedAudioInfo);
+
+	/**
+	 * Whether the session has been finished, either explicitly or because of a decoding error
+	 */
+	bool IsFinished() const { return bFinished; }
+
+	/**
+	 * Get the sample rate of the stream. Zero until the stream headers have been decoded
+	 */
+	uint32 GetSampleRate() const { return SampleRate; }
+
+	/**
+	 * Get the number of channels of the stream. Zero until the stream headers have been decoded
+	 */
+	uint32 GetNumOfChannels() const { return NumOfChannels; }
+
+	/**
+	 * Get the number of encoded bytes pushed since the session was created
+	 */
+	int64 GetNumOfBytesPushed() const { return NumOfBytesPushed; }
+
+	/**
+	 * Get the number of PCM frames decoded since the session was created, in the sample rate of the stream
+	 */
+	int64 GetNumOfFramesDecoded() const { return NumOfFramesDecoded; }
+
+	/**
+	 * Retrieve the format decoded by this session
+	 */
+	virtual ERuntimeAudioFormat GetAudioFormat() const = 0;
+
+protected:
+	/**
+	 * Decode as much of the pending data as possible, consuming the decoded bytes (see ConsumePendingData) and emitting the decoded frames (see EmitFrames)
+	 *
+	 * @param bEndOfStream Whether no more data will be pushed, so that the data held back for the next push must be decoded or discarded
+	 */
+	virtual bool Decode_Internal(bool bEndOfStream) = 0;
+
+	/** Release the decoder resources. Called once the session is finished or abandoned */
+	virtual void Release_Internal() {}
+
+	/**
+	 * Get the pushed data that has not been consumed yet
+	 */
+	const uint8* GetPendingData() const { return PendingData.GetData() + PendingDataOffset; }
+
+	/**
+	 * Get the number of pushed bytes that have not been consumed yet
+	 */
+	int64 GetNumOfPendingBytes() const { return PendingData.Num() - PendingDataOffset; }
+
+	/**
+	 * Mark the specified number of pending bytes as consumed
+	 */
+	void ConsumePendingData(int64 NumOfBytes);
+
+	/**
+	 * Set the format of the stream once it is known from the stream headers. Changing the format in the middle of the stream is not supported
+	 *
+	 * @return Whether the format was set or not
+	 */
+	bool SetFormat(uint32 InSampleRate, uint32 InNumOfChannels);
+
+	/**
+	 * Emit the decoded interleaved 32-bit float PCM frames, in the format set with SetFormat
+	 *
+	 * @return Whether the frames were successfully emitted or not
+	 */
+	bool EmitFrames(const float* PCMData, int64 NumOfFrames);
+
+private:
+	/**
+	 * Move the frames emitted so far into the decoded audio info
+	 */
+	void ReleaseDecodedAudio(FDecodedAudioStruct& OutDecodedAudioInfo);
+
+	/** The pushed data, including the already consumed bytes until it is compacted at the end of the push */
+	TArray64<uint8> PendingData;
+
+	/** The number of consumed bytes at the beginning of PendingData */
+	int64 PendingDataOffset;
+
+	/** Converts the emitted frames to the target format and accumulates them until they are released. Valid once the format of the stream is known */
+	TUniquePtr<FRuntimePCMFormatConverter> Converter;
+
+	/** The sample rate of the stream */
+	uint32 SampleRate;
+
+	/** The number of channels of the stream */
+	uint32 NumOfChannels;
+
+	/** The sample rate to convert the decoded audio data to. Zero to keep the sample rate of the stream */
+	uint32 TargetSampleRate;
+
+	/** The number of channels to convert the decoded audio data to. Zero to keep the number of channels of the stream */
+	uint32 TargetNumOfChannels;
+
+	/** Whether the session has been finished */
+	bool bFinished;
+
+	/** The number of encoded bytes pushed since the session was created */
+	int64 NumOfBytesPushed;
+
+	/** The number of PCM frames decoded since the session was created */
+	int64 NumOfFramesDecoded;
+};
@@ -0,0 +1,118 @@
+﻿// Georgy Treshchev 2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+#include "Tasks/Task.h"
+
+class IFileHandle;
+class FArchive;
+
+/**
+ * Base sink for encoded audio data
+ * Encoder sessions write the encoded data through a sink as soon as it is produced, so the encoded data never has to be accumulated in memory
+ *
+ * @note The sink is not thread-safe, the caller is responsible for serializing the calls
+ */
+class RUNTIMEAUDIOIMPORTER_API FBaseRuntimeEncodedAudioSink
+{
+public:
+	virtual ~FBaseRuntimeEncodedAudioSink() = default;
+
+	/**
+	 * Write the encoded data at the current position
+	 */
+	virtual bool Write(const uint8* Data, int64 Size) = 0;
+
+	/**
+	 * Move the current position (e.g. to patch the stream header once the encoding is finished)
+	 */
+	virtual bool Seek(int64 Position) = 0;
+
+	/**
+	 * Get the current position
+	 */
+	virtual int64 Tell() const = 0;
+
+	/**
+	 * Make sure all written data has reached the destination
+	 */
+	virtual bool Flush() = 0;
+};
+
+/**
+ * Sink writing the encoded data to a file handle
+ * Can optionally write asynchronously using two buffers, so that encoding into one buffer overlaps with writing the other one to the disk
+ */
+class RUNTIMEAUDIOIMPORTER_API FRuntimeFileHandleAudioSink : public FBaseRuntimeEncodedAudioSink
+{
+public:
+	/**
+	 * @param InFileHandle The file handle to write the encoded data to. The sink takes ownership of it
+	 * @param InAsyncWriteBufferSize The size of each of the two buffers used for asynchronous writes, in bytes. Set to 0 to write synchronously
+	 */
+	explicit FRuntimeFileHandleAudioSink(TUniquePtr<IFileHandle> InFileHandle, int64 InAsyncWriteBufferSize = 0);
+	virtual ~FRuntimeFileHandleAudioSink() override;
+
+	//~ Begin FBaseRuntimeEncodedAudioSink Interface
+	virtual bool Write(const uint8* Data, int64 Size) override;
+	virtual bool Seek(int64 Position) override;
+	virtual int64 Tell() const override;
+	virtual bool Flush() override;
+	//~ End FBaseRuntimeEncodedAudioSink Interface
+
+	/** The default size of each buffer used for asynchronous writes */
+	static constexpr int64 DefaultAsyncWriteBufferSize = 1024 * 1024;
+
+private:
+	/**
+	 * Start writing the filled buffer asynchronously, waiting for the previous write to complete first
+	 */
+	bool SubmitActiveBuffer();
+
+	/**
+	 * Wait for the asynchronous write in progress, if any
+	 *
+	 * @return Whether the write succeeded or not
+	 */
+	bool WaitForPendingWrite();
+
+	/** The file handle the encoded data is written to */
+	TUniquePtr<IFileHandle> FileHandle;
+
+	/** The size of each buffer used for asynchronous writes. Writes are synchronous if 0 */
+	int64 AsyncWriteBufferSize;
+
+	/** The buffer being filled with the encoded data */
+	TArray64<uint8> ActiveBuffer;
+
+	/** The buffer being written to the file asynchronously */
+	TArray64<uint8> WritingBuffer;
+
+	/** The asynchronous write in progress */
+	UE::Tasks::TTask<bool> PendingWrite;
+
+	/** The current position, including the data not yet written to the file */
+	int64 Position;
+};
+
+/**
+ * Sink writing the encoded data to an archive (e.g. a memory writer or a file writer). The archive must outlive the sink
+ */
+class RUNTIMEAUDIOIMPORTER_API FRuntimeArchiveAudioSink : public FBaseRuntimeEncodedAudioSink
+{
+public:
+	explicit FRuntimeArchiveAudioSink(FArchive& InArchive);
+
+	//~ Begin FBaseRuntimeEncodedAudioSink Interface
+	virtual bool Write(const uint8* Data, int64 Size) override;
+	virtual bool Seek(int64 Position) override;
+	virtual int64 Tell() const override;
+	virtual bool Flush() override;
+	//~ End FBaseRuntimeEncodedAudioSink Interface
+
+private:
+	/** The archive the encoded data is written to */
+	FArchive& Archive;
+};
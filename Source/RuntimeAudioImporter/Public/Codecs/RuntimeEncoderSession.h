@@ -0,0 +1,120 @@
+﻿// Georgy Treshchev 2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RuntimeAudioImporterTypes.h"
+#include "Templates/UniquePtr.h"
+#include "RuntimeEncodedAudioSink.h"
+
+/**
+ * Base incremental encoder session
+ * Encodes PCM data as it arrives (Begin -> PushFrames -> ... -> PushFrames -> Finish) and writes the encoded data to a sink (e.g. a file handle) as soon as it is produced,
+ * so the memory usage stays flat regardless of the duration and the output is complete the moment the session is finished
+ * Sessions are created by codecs supporting incremental encoding (see FBaseRuntimeCodec::CreateEncoderSession)
+ *
+ * @note The session is not thread-safe, the caller is responsible for serializing the calls
+ */
+class RUNTIMEAUDIOIMPORTER_API FBaseRuntimeEncoderSession
+{
+public:
+	FBaseRuntimeEncoderSession();
+	virtual ~FBaseRuntimeEncoderSession();
+
+	/**
+	 * Begin the session. Writes the stream headers, if any
+	 *
+	 * @param InSink The sink to write the encoded data to (see FRuntimeFileHandleAudioSink and FRuntimeArchiveAudioSink). The session takes ownership of it
+	 * @param InSampleRate The sample rate of the PCM data that will be pushed
+	 * @param InNumOfChannels The number of channels of the PCM data that will be pushed
+	 * @param InQuality The quality of the encoded audio data. From 0 to 100
+	 * @return Whether the session was successfully started or not
+	 */
+	bool Begin(TUniquePtr<FBaseRuntimeEncodedAudioSink> InSink, uint32 InSampleRate, uint32 InNumOfChannels, uint8 InQuality);
+
+	/**
+	 * Encode the specified interleaved 32-bit float PCM frames and write the produced data
+	 *
+	 * @param PCMData Interleaved PCM data in the format specified in Begin
+	 * @param NumOfFrames The number of frames in PCMData
+	 * @return Whether the frames were successfully encoded or not
+	 */
+	bool PushFrames(const float* PCMData, int64 NumOfFrames);
+
+	/**
+	 * Finish the session. Flushes the remaining data, finalizes the stream and releases the sink
+	 *
+	 * @return Whether the session was successfully finished or not
+	 */
+	bool Finish();
+
+	/**
+	 * Whether the session has been started and not yet finished
+	 */
+	bool IsActive() const { return bActive; }
+
+	/**
+	 * Get the number of PCM frames pushed since the session started
+	 */
+	int64 GetNumOfFramesPushed() const { return NumOfFramesPushed; }
+
+	/**
+	 * Get the number of encoded bytes written since the session started
+	 */
+	int64 GetNumOfBytesWritten() const { return NumOfBytesWritten; }
+
+	/**
+	 * Retrieve the format produced by this session
+	 */
+	virtual ERuntimeAudioFormat GetAudioFormat() const = 0;
+
+protected:
+	/** Initialize the encoder and write the stream headers. The format is available in SampleRate, NumOfChannels and Quality */
+	virtual bool Begin_Internal() = 0;
+
+	/** Encode the specified PCM frames */
+	virtual bool PushFrames_Internal(const float* PCMData, int64 NumOfFrames) = 0;
+
+	/** Flush the remaining data and finalize the stream */
+	virtual bool Finish_Internal() = 0;
+
+	/** Release the encoder resources. Called once the session is finished or abandoned */
+	virtual void Release_Internal() {}
+
+	/**
+	 * Write the encoded data to the sink
+	 */
+	bool Write(const void* Data, int64 Size);
+
+	/**
+	 * Move the write position of the sink (e.g. to patch the stream header on finish)
+	 */
+	bool Seek(int64 Position);
+
+	/**
+	 * Get the current write position of the sink
+	 */
+	int64 Tell() const;
+
+	/** The sample rate of the pushed PCM data */
+	uint32 SampleRate;
+
+	/** The number of channels of the pushed PCM data */
+	uint32 NumOfChannels;
+
+	/** The quality of the encoded audio data */
+	uint8 Quality;
+
+private:
+	/** The sink the encoded data is written to */
+	TUniquePtr<FBaseRuntimeEncodedAudioSink> Sink;
+
+	/** Whether the session has been started and not yet finished */
+	bool bActive;
+
+	/** The number of PCM frames pushed since the session started */
+	int64 NumOfFramesPushed;
+
+	/** The number of encoded bytes written since the session started */
+	int64 NumOfBytesWritten;
+};
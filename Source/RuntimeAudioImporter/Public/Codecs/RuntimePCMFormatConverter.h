@@ -0,0 +1,172 @@
+﻿// Georgy Treshchev 2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RuntimeAudioImporterTypes.h"
+#include "Templates/UniquePtr.h"
+#include "Templates/Function.h"
+
+namespace Audio
+{
+	class FResampler;
+}
+
+/**
+ * Incremental converter of interleaved 32-bit float PCM data to a different sample rate and/or number of channels
+ * The PCM data is pushed block by block (PushFrames -> ... -> PushFrames -> Finish), e.g. as it is decoded, and the converted frames are written into a single buffer sized for the target format,
+ * so the whole PCM data is never held in the source format
+ *
+ * @note The converter is not thread-safe, the caller is responsible for serializing the calls
+ */
+class RUNTIMEAUDIOIMPORTER_API FRuntimePCMFormatConverter
+{
+public:
+	/**
+	 * @param InSourceSampleRate The sample rate of the PCM data that will be pushed
+	 * @param InSourceNumOfChannels The number of channels of the PCM data that will be pushed
+	 * @param InTargetSampleRate The sample rate to convert to. Zero to keep the source sample rate
+	 * @param InTargetNumOfChannels The number of channels to convert to. Zero to keep the source number of channels
+	 */
+	FRuntimePCMFormatConverter(uint32 InSourceSampleRate, uint32 InSourceNumOfChannels, uint32 InTargetSampleRate, uint32 InTargetNumOfChannels);
+	~FRuntimePCMFormatConverter();
+
+	FRuntimePCMFormatConverter(const FRuntimePCMFormatConverter&) = delete;
+	FRuntimePCMFormatConverter& operator=(const FRuntimePCMFormatConverter&) = delete;
+
+	/**
+	 * Whether the source and target formats are valid or not
+	 */
+	bool IsValid() const;
+
+	/**
+	 * Whether the source format is the same as the target format, in which case the pushed frames are only copied
+	 */
+	bool IsPassthrough() const;
+
+	/**
+	 * Pre-allocate the converted PCM data for the expected number of source frames, so that it is allocated only once
+	 *
+	 * @param NumOfSourceFrames The number of source frames that are expected to be pushed
+	 */
+	void Reserve(int64 NumOfSourceFrames);
+
+	/**
+	 * Convert the specified interleaved PCM frames and append them to the converted PCM data
+	 *
+	 * @param PCMData Interleaved PCM data in the source format
+	 * @param NumOfFrames The number of frames in PCMData
+	 * @return Whether the frames were successfully converted or not
+	 */
+	bool PushFrames(const float* PCMData, int64 NumOfFrames);
+
+	/**
+	 * Read frames block by block from the specified source (e.g. a decoder) and convert them, until the source runs out of frames
+	 *
+	 * @param ReadFrames Reads at most the given number of interleaved frames in the source format into the given buffer and returns the number of frames read, zero if there are no more frames
+	 * @return Whether all the read frames were successfully converted or not
+	 */
+	bool PushFramesFrom(TFunctionRef<int64(float* OutPCMData, int64 MaxNumOfFrames)> ReadFrames);
+
+	/**
+	 * Collect the frames still held by the resampler. Must be called once after the last frames have been pushed
+	 *
+	 * @return Whether the converter was successfully finished or not
+	 */
+	bool Finish();
+
+	/**
+	 * Move the converted PCM data out of the converter
+	 *
+	 * @param OutPCMInfo The converted PCM data
+	 */
+	void ReleasePCMData(FPCMStruct& OutPCMInfo);
+
+	/**
+	 * Move the converted PCM data out of the converter into the decoded audio info, along with the target format and the resulting duration
+	 *
+	 * @param OutDecodedAudioInfo The decoded audio info to fill in. The audio format is left untouched
+	 */
+	void ReleaseDecodedAudio(FDecodedAudioStruct& OutDecodedAudioInfo);
+
+	/**
+	 * Get the sample rate of the converted PCM data
+	 */
+	uint32 GetTargetSampleRate() const { return TargetSampleRate; }
+
+	/**
+	 * Get the number of channels of the converted PCM data
+	 */
+	uint32 GetTargetNumOfChannels() const { return TargetNumOfChannels; }
+
+	/**
+	 * Get the number of converted frames so far
+	 */
+	int64 GetNumOfFrames() const { return NumOfSamples / FMath::Max<uint32>(TargetNumOfChannels, 1); }
+
+	/**
+	 * Convert the PCM data of the decoded audio info block by block, replacing it with the converted one
+	 *
+	 * @param DecodedAudioInfo The decoded audio info to convert
+	 * @param TargetSampleRate The sample rate to convert to. Zero to keep the current sample rate
+	 * @param TargetNumOfChannels The number of channels to convert to. Zero to keep the current number of channels
+	 * @return Whether the PCM data was successfully converted or not
+	 */
+	static bool ConvertDecodedAudio(FDecodedAudioStruct& DecodedAudioInfo, uint32 TargetSampleRate, uint32 TargetNumOfChannels);
+
+	/**
+	 * Convert the PCM data block by block, reporting the progress
+	 *
+	 * @param PCMInfo The PCM data to convert, stored in any format
+	 * @param OnProgress Called with the progress, 0-100%, every time it changes
+	 * @param OutPCMInfo The converted PCM data, stored as 32-bit float
+	 * @return Whether the PCM data was successfully converted or not
+	 */
+	bool ConvertPCMData(const FPCMStruct& PCMInfo, TFunctionRef<void(int32)> OnProgress, FPCMStruct& OutPCMInfo);
+
+	/** The number of frames converted at a time */
+	static constexpr int64 NumOfFramesPerBlock = 65536;
+
+private:
+	/**
+	 * Convert a block of at most NumOfFramesPerBlock frames
+	 */
+	bool PushBlock(const float* PCMData, int32 NumOfFrames);
+
+	/**
+	 * Resample the specified frames in the intermediate format and append them to the converted PCM data
+	 */
+	bool Resample(const float* PCMData, int32 NumOfFrames, bool bEndOfInput);
+
+	/**
+	 * Append the specified samples in the target format to the converted PCM data, growing it if necessary
+	 */
+	bool AppendSamples(const float* Samples, int64 InNumOfSamples);
+
+	/** Sample rate of the pushed PCM data */
+	const uint32 SourceSampleRate;
+
+	/** Number of channels of the pushed PCM data */
+	const uint32 SourceNumOfChannels;
+
+	/** Sample rate of the converted PCM data */
+	const uint32 TargetSampleRate;
+
+	/** Number of channels of the converted PCM data */
+	const uint32 TargetNumOfChannels;
+
+	/** Whether the channels are mixed before resampling (so that the resampler processes fewer channels) or after */
+	const bool bMixBeforeResampling;
+
+	/** Resampler used if the sample rates differ */
+	TUniquePtr<Audio::FResampler> Resampler;
+
+	/** The converted PCM data */
+	float* ConvertedPCMData;
+
+	/** The number of converted samples */
+	int64 NumOfSamples;
+
+	/** The number of samples allocated for the converted PCM data */
+	int64 Capacity;
+};
@@ -9,6 +9,8 @@
 #include "IAudioProxyInitializer.h"
 #include "Sound/SoundWave.h"
 
+struct FImportedSoundWavePCMSource;
+
 namespace RuntimeAudioImporter
 {
 #if UE_VERSION_OLDER_THAN(5, 2, 0)
@@ -20,6 +22,23 @@ namespace RuntimeAudioImporter
 	extern const FString RUNTIMEAUDIOIMPORTER_API PluginAuthor;
 	extern const FText RUNTIMEAUDIOIMPORTER_API PluginNodeMissingPrompt;
 
+	/**
+	 * Associate the sound wave proxy with the PCM source of the imported sound wave it was created from
+	 * This allows FImportedWave to read the PCM data directly, without the compressed audio resource
+	 *
+	 * @param SoundWaveProxy The sound wave proxy created from the imported sound wave
+	 * @param PCMSource The PCM source of the imported sound wave
+	 */
+	RUNTIMEAUDIOIMPORTER_API void RegisterPCMSource(FSoundWaveProxy& SoundWaveProxy, const TSharedPtr<FImportedSoundWavePCMSource>& PCMSource);
+
+	/**
+	 * Find the PCM source of the imported sound wave from which the sound wave proxy was created
+	 *
+	 * @param SoundWaveProxy The sound wave proxy
+	 * @return The PCM source, or nullptr if the proxy was not created from an imported sound wave or the sound wave no longer exists
+	 */
+	RUNTIMEAUDIOIMPORTER_API TSharedPtr<FImportedSoundWavePCMSource> FindPCMSource(FSoundWaveProxy& SoundWaveProxy);
+
 	/**
 	 * FImportedWave is an alternative to FWaveAsset to hold proxy data obtained from UImportedSoundWave
 	 */
@@ -27,6 +46,9 @@ namespace RuntimeAudioImporter
 	{
 		FSoundWaveProxyPtr SoundWaveProxy;
 
+		/** PCM data of the imported sound wave, used to play it back directly without encoding */
+		TSharedPtr<FImportedSoundWavePCMSource> PCMSource;
+
 	public:
 		FImportedWave() = default;
 		FImportedWave(const FImportedWave&) = default;
@@ -44,6 +66,16 @@ namespace RuntimeAudioImporter
 			return SoundWaveProxy;
 		}
 
+		bool IsPCMSourceValid() const
+		{
+			return PCMSource.IsValid();
+		}
+
+		const TSharedPtr<FImportedSoundWavePCMSource>& GetPCMSource() const
+		{
+			return PCMSource;
+		}
+
 		const FSoundWaveProxy* operator->() const
 		{
 			return SoundWaveProxy.Get();
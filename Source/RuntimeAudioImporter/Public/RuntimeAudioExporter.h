@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "RuntimeAudioImporterLibrary.h"
+#include "Codecs/RuntimeEncodedAudioSink.h"
 #include "UObject/Object.h"
 #include "RuntimeAudioExporter.generated.h"
 
@@ -55,6 +56,20 @@ public:
 	 */
 	static void ExportSoundWaveToFile(TWeakObjectPtr<UImportedSoundWave> ImportedSoundWavePtr, const FString& SavePath, ERuntimeAudioFormat AudioFormat, uint8 Quality, const FRuntimeAudioExportOverrideOptions& OverrideOptions, const FOnAudioExportToFileResultNative& Result);
 
+	/**
+	 * Export the imported sound wave through a sink (e.g. directly to a file handle or an archive). Suitable for use in C++
+	 * The audio data is encoded incrementally and written through the sink as soon as it is produced, without accumulating the encoded data in memory
+	 *
+	 * @note Only the formats supporting incremental encoding can be exported this way (see FBaseRuntimeCodec::CreateEncoderSession)
+	 * @param ImportedSoundWavePtr Imported sound wave to be exported
+	 * @param Sink The sink to write the encoded audio data to (e.g. FRuntimeFileHandleAudioSink with asynchronous writes, or FRuntimeArchiveAudioSink)
+	 * @param AudioFormat The desired audio format
+	 * @param Quality The quality of the encoded audio data, from 0 to 100
+	 * @param OverrideOptions Override options for the export
+	 * @param Result Delegate broadcasting the result
+	 */
+	static void ExportSoundWaveToSink(TWeakObjectPtr<UImportedSoundWave> ImportedSoundWavePtr, TUniquePtr<FBaseRuntimeEncodedAudioSink> Sink, ERuntimeAudioFormat AudioFormat, uint8 Quality, const FRuntimeAudioExportOverrideOptions& OverrideOptions, const FOnAudioExportToFileResultNative& Result);
+
 	/**
 	 * Export the imported sound wave into a buffer
 	 *
@@ -121,4 +136,24 @@ public:
 	 * @param Result Delegate broadcasting the result
 	 */
 	static void ExportSoundWaveToRAWBuffer(TWeakObjectPtr<UImportedSoundWave> ImportedSoundWavePtr, ERuntimeRAWAudioFormat RAWFormat, const FRuntimeAudioExportOverrideOptions& OverrideOptions, const FOnAudioExportToBufferResultNative& Result);
+
+	/**
+	 * Retrieve the PCM data of the imported sound wave, resampled and mixed according to the override options
+	 * The PCM data is not copied if it does not need to be converted: it references the PCM data of the sound wave, stored in its storage format, and keeps it alive on its own
+	 * Otherwise it is converted block by block, so only the PCM data in the overriden format is allocated
+	 *
+	 * @param ImportedSoundWavePtr Imported sound wave to retrieve the PCM data from
+	 * @param OverrideOptions Override options for the export
+	 * @param DecodedAudioInfo Retrieved decoded audio data
+	 * @return Whether the retrieval was successful or not
+	 */
+	static bool GetDecodedAudioForExport(TWeakObjectPtr<UImportedSoundWave> ImportedSoundWavePtr, const FRuntimeAudioExportOverrideOptions& OverrideOptions, FDecodedAudioStruct& DecodedAudioInfo);
+
+private:
+	/**
+	 * Delete the file left behind by a failed export, so that a truncated file is never mistaken for a valid one
+	 *
+	 * @param SavePath The path of the exported file
+	 */
+	static void DeletePartiallyExportedFile(const FString& SavePath);
 };
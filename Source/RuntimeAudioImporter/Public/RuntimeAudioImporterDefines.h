@@ -13,6 +13,9 @@
 
 DECLARE_LOG_CATEGORY_EXTERN(LogRuntimeAudioImporter, Log, All);
 
+template <typename DataType>
+class FRuntimeBulkDataBuffer;
+
 namespace RuntimeAudioImporter
 {
 #if WITH_RUNTIMEAUDIOIMPORTER_FILEOPERATION_SUPPORT
@@ -27,6 +30,12 @@ namespace RuntimeAudioImporter
 	 */
 	RUNTIMEAUDIOIMPORTER_API bool LoadAudioFileToArray(TArray64<uint8>& AudioData, const FString& FilePath);
 
+	/**
+	 * Map audio file into memory without reading it. The returned buffer references the mapped file region, which stays mapped as long as the buffer (or any buffer sharing its owner) is alive
+	 * Falls back to loading the file into memory if memory mapping is not supported by the platform
+	 */
+	RUNTIMEAUDIOIMPORTER_API bool MapAudioFile(FRuntimeBulkDataBuffer<uint8>& AudioData, const FString& FilePath);
+
 	/**
 	 * Save audio file from array (Perfect forwarding to FFileHelper::SaveArrayToFile)
 	 */
@@ -37,4 +46,14 @@ namespace RuntimeAudioImporter
 		return FFileHelper::SaveArrayToFile(Forward<T>(AudioData), *FilePath);
 	}
 #endif
+
+	/**
+	 * Delete the least recently used files (by modification time) until their total size fits within the specified size. Used to keep the disk caches within their budget
+	 *
+	 * @param FilePaths The files to consider
+	 * @param MaxSize The maximum total size of the files, in bytes. Set to 0 to delete all files
+	 * @param OutRemainingSize The total size of the files left
+	 * @return The number of deleted files
+	 */
+	RUNTIMEAUDIOIMPORTER_API int32 DeleteLeastRecentlyUsedFiles(const TArray<FString>& FilePaths, int64 MaxSize, int64& OutRemainingSize);
 }
\ No newline at end of file
@@ -52,6 +52,27 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Runtime Audio Importer|Delegates")
 	FOnAudioImporterResult OnResult;
 
+	/**
+	 * Set the sample rate and number of channels the audio data imported by this importer is converted to
+	 * The conversion happens while decoding, block by block, so the decoded audio data is never fully held in its source format (e.g. importing a 48 kHz 5.1 file as 16 kHz mono)
+	 *
+	 * @param SampleRate The desired sample rate. Zero to keep the sample rate of the audio data
+	 * @param NumOfChannels The desired number of channels. Zero to keep the number of channels of the audio data
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Runtime Audio Importer|Import")
+	void SetDesiredOutputFormat(int32 SampleRate = 0, int32 NumOfChannels = 0);
+
+	/**
+	 * Set whether the leading and trailing silence of the audio data imported by this importer is trimmed after decoding
+	 * The PCM data is trimmed in place, so the silence is neither stored nor played. The trimmed durations are reported in FSoundWaveBasicStruct
+	 *
+	 * @param bEnable Whether to trim the silence or not
+	 * @param ThresholdDb Samples quieter than this level (in dBFS) in all channels are considered silent
+	 * @param PaddingSeconds Seconds of silence to keep before the first and after the last non-silent sample, so that soft attacks and decays are not cut
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Runtime Audio Importer|Import")
+	void SetSilenceTrimming(bool bEnable, float ThresholdDb = -60.f, float PaddingSeconds = 0.05f);
+
 	/**
 	 * Tries to retrieve audio data from a given regular sound wave
 	 * 
@@ -78,6 +99,16 @@ public:
 	UFUNCTION(BlueprintCallable, meta = (Keywords = "Importer, Transcoder, Converter, Runtime, MP3, FLAC, WAV, OGG, Vorbis"), Category = "Runtime Audio Importer|Import")
 	void ImportAudioFromFile(const FString& FilePath, ERuntimeAudioFormat AudioFormat);
 
+	/**
+	 * Import audio from a file mapped into memory instead of being read, which avoids holding an extra copy of large files (especially WAV, FLAC and RAW) in memory
+	 * 32-bit float WAV data is referenced directly from the mapped file without being decoded, so the file must not be modified while the imported sound wave is alive
+	 *
+	 * @param FilePath Path to the audio file to import. Must be on a local disk
+	 * @param AudioFormat Audio format
+	 */
+	UFUNCTION(BlueprintCallable, meta = (Keywords = "Importer, Transcoder, Converter, Runtime, MP3, FLAC, WAV, OGG, Vorbis, Mapped"), Category = "Runtime Audio Importer|Import")
+	void ImportAudioFromMappedFile(const FString& FilePath, ERuntimeAudioFormat AudioFormat);
+
 	/**
 	 * Import audio from a pre-imported sound asset
 	 *
@@ -103,6 +134,14 @@ public:
 	 */
 	void ImportAudioFromBuffer(TArray64<uint8> AudioData, ERuntimeAudioFormat AudioFormat);
 
+	/**
+	 * Import audio from a bulk buffer without copying it. The buffer may reference externally owned data (e.g. a memory-mapped file, see RuntimeAudioImporter::MapAudioFile)
+	 *
+	 * @param AudioData Audio data buffer
+	 * @param AudioFormat Audio format
+	 */
+	void ImportAudioFromBuffer(FRuntimeBulkDataBuffer<uint8>&& AudioData, ERuntimeAudioFormat AudioFormat);
+
 	/**
 	 * Import audio from a RAW file. The audio data must not have headers and must be uncompressed
 	 *
@@ -114,6 +153,18 @@ public:
 	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Import Audio From RAW File", Keywords = "PCM, RAW"), Category = "Runtime Audio Importer|Import")
 	void ImportAudioFromRAWFile(const FString& FilePath, UPARAM(DisplayName = "RAW Format") ERuntimeRAWAudioFormat RAWFormat, int32 SampleRate = 44100, int32 NumOfChannels = 1);
 
+	/**
+	 * Import audio from a RAW file mapped into memory instead of being read. The audio data must not have headers and must be uncompressed
+	 * 32-bit float data is referenced directly from the mapped file without being copied, so the file must not be modified while the imported sound wave is alive
+	 *
+	 * @param FilePath Path to the audio file to import. Must be on a local disk
+	 * @param RAWFormat RAW audio format
+	 * @param SampleRate The number of samples per second
+	 * @param NumOfChannels The number of channels (1 for mono, 2 for stereo, etc)
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Import Audio From Mapped RAW File", Keywords = "PCM, RAW, Mapped"), Category = "Runtime Audio Importer|Import")
+	void ImportAudioFromMappedRAWFile(const FString& FilePath, UPARAM(DisplayName = "RAW Format") ERuntimeRAWAudioFormat RAWFormat, int32 SampleRate = 44100, int32 NumOfChannels = 1);
+
 	/**
 	 * Import audio from a RAW buffer. The audio data must not have headers and must be uncompressed
 	 *
@@ -135,6 +186,17 @@ public:
 	 */
 	void ImportAudioFromRAWBuffer(TArray64<uint8> RAWBuffer, ERuntimeRAWAudioFormat RAWFormat, int32 SampleRate = 44100, int32 NumOfChannels = 1);
 
+	/**
+	 * Import audio from a RAW bulk buffer. The audio data must not have headers and must be uncompressed
+	 * If the buffer references externally owned data (e.g. a memory-mapped file) in the 32-bit float format, the data is referenced directly without being copied
+	 *
+	 * @param RAWBuffer The RAW audio buffer
+	 * @param RAWFormat RAW audio format
+	 * @param SampleRate The number of samples per second
+	 * @param NumOfChannels The number of channels (1 for mono, 2 for stereo, etc)
+	 */
+	void ImportAudioFromRAWBuffer(FRuntimeBulkDataBuffer<uint8>&& RAWBuffer, ERuntimeRAWAudioFormat RAWFormat, int32 SampleRate = 44100, int32 NumOfChannels = 1);
+
 	/**
 	 * Converts a regular SoundWave to an inherited sound wave of type ImportedSoundWave used in RuntimeAudioImporter
 	 * Experimental feature, use with caution
@@ -161,9 +223,11 @@ public:
 	 *
 	 * @param EncodedAudioInfo The encoded audio data
 	 * @param DecodedAudioInfo The decoded audio data
+	 * @param TargetSampleRate The sample rate to decode to, converting block by block while decoding. Zero to keep the sample rate of the audio data
+	 * @param TargetNumOfChannels The number of channels to decode to, converting block by block while decoding. Zero to keep the number of channels of the audio data
 	 * @return Whether the decoding was successful or not
 	 */
-	static bool DecodeAudioData(FEncodedAudioStruct&& EncodedAudioInfo, FDecodedAudioStruct& DecodedAudioInfo);
+	static bool DecodeAudioData(FEncodedAudioStruct&& EncodedAudioInfo, FDecodedAudioStruct& DecodedAudioInfo, uint32 TargetSampleRate = 0, uint32 TargetNumOfChannels = 0);
 
 	/**
 	 * Encode uncompressed audio data to compressed.
@@ -201,7 +265,99 @@ public:
 	 */
 	static bool ResampleAndMixChannelsInDecodedInfo(FDecodedAudioStruct& DecodedAudioInfo, uint32 NewSampleRate, uint32 NewNumOfChannels);
 
+	/**
+	 * Trim the leading and trailing silence in decoded audio info in place, without allocating a new buffer
+	 * Fully silent audio data is left untouched
+	 *
+	 * @param DecodedAudioInfo Decoded audio data. The trimmed durations are added to its basic info
+	 * @param ThresholdDb Samples quieter than this level (in dBFS) in all channels are considered silent
+	 * @param PaddingSeconds Seconds of silence to keep before the first and after the last non-silent sample
+	 * @return True if the silence was trimmed or there was nothing to trim
+	 */
+	static bool TrimSilenceInDecodedInfo(FDecodedAudioStruct& DecodedAudioInfo, float ThresholdDb, float PaddingSeconds);
+
+	/**
+	 * Set the memory budget of the process-wide decoded audio cache. Importing the same file or buffer again then reuses the already decoded audio data without decoding it
+	 * The least recently used audio data is evicted once the budget is exceeded. The cache is disabled by default
+	 *
+	 * @param MemoryBudget The maximum size of the cached PCM data, in bytes. Set to 0 to disable the cache
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Runtime Audio Importer|Cache")
+	static void SetDecodedAudioCacheMemoryBudget(int64 MemoryBudget);
+
+	/**
+	 * Remove all audio data from the decoded audio cache. Imported sound waves keep the audio data they use
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Runtime Audio Importer|Cache")
+	static void EmptyDecodedAudioCache();
+
+	/**
+	 * Set whether the decoded audio data should also be stored on disk, so that importing an unchanged file or buffer in a later session skips decoding
+	 * Uses the same keys as the decoded audio cache. Disabled by default
+	 *
+	 * @param bEnabled Whether the disk cache is enabled or not
+	 * @param bStoreAsInt16 Whether to store the PCM data as 16-bit integer (half the size) instead of 32-bit float (referenced directly from the mapped file when loaded)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Runtime Audio Importer|Cache")
+	static void SetDecodedAudioDiskCacheEnabled(bool bEnabled, bool bStoreAsInt16 = false);
+
+	/**
+	 * Get the total size of the files in the decoded audio disk cache, in bytes
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Runtime Audio Importer|Cache")
+	static int64 GetDecodedAudioDiskCacheSize();
+
+	/**
+	 * Delete the least recently used files in the decoded audio disk cache until it fits within the specified size
+	 *
+	 * @param MaxSize The maximum total size of the cached files, in bytes. Set to 0 to delete all cached files
+	 * @return The number of deleted files
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Runtime Audio Importer|Cache")
+	static int32 TrimDecodedAudioDiskCache(int64 MaxSize);
+
+	/**
+	 * Verify the headers and the PCM data of all files in the decoded audio disk cache
+	 *
+	 * @param bDeleteInvalid Whether to delete the invalid files or not
+	 * @return The number of invalid files
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Runtime Audio Importer|Cache")
+	static int32 ValidateDecodedAudioDiskCache(bool bDeleteInvalid = true);
+
 protected:
+	/**
+	 * Import audio from the decoded audio cache
+	 *
+	 * @param CacheKey The key of the decoded audio data. Nothing is imported if empty
+	 * @return True if the audio data was found in the cache and is being imported
+	 */
+	bool ImportAudioFromDecodedAudioCache_Internal(const FString& CacheKey);
+
+	/**
+	 * Decode the encoded audio data and finish importing
+	 *
+	 * @param EncodedAudioInfo The encoded audio data
+	 * @param CacheKey The key to store the decoded audio data in the decoded audio cache with. Not stored if empty
+	 */
+	void ImportAudioFromEncodedInfo_Internal(FEncodedAudioStruct&& EncodedAudioInfo, const FString& CacheKey);
+
+	/**
+	 * Append the desired output format to the decoded audio cache key, so that the audio data converted to different formats is cached separately
+	 *
+	 * @param CacheKey The key of the decoded audio data
+	 * @return The key including the desired output format, or the key unchanged if it is empty or no output format is desired
+	 */
+	FString AppendDesiredOutputFormat_Internal(const FString& CacheKey) const;
+
+	/**
+	 * Trim the leading and trailing silence of the audio data to import, if enabled (see SetSilenceTrimming)
+	 * Called on the decoding thread, after the decoded audio data is cached, so that the cache keeps the untrimmed audio data and the game thread only creates the sound wave
+	 *
+	 * @param DecodedAudioInfo The decoded audio data, or a view of the cached one
+	 */
+	void TrimSilence_Internal(FDecodedAudioStruct& DecodedAudioInfo) const;
+
 	/**
 	 * Audio transcoding progress callback
 	 * 
@@ -216,4 +372,19 @@ protected:
 	 * @param Status Importing status
 	 */
 	void OnResult_Internal(UImportedSoundWave* ImportedSoundWave, ERuntimeImportStatus Status);
+
+	/** The sample rate the imported audio data is converted to. Zero to keep the sample rate of the audio data (see SetDesiredOutputFormat) */
+	uint32 DesiredSampleRate = 0;
+
+	/** The number of channels the imported audio data is converted to. Zero to keep the number of channels of the audio data (see SetDesiredOutputFormat) */
+	uint32 DesiredNumOfChannels = 0;
+
+	/** Whether the leading and trailing silence of the imported audio data is trimmed (see SetSilenceTrimming) */
+	bool bTrimSilence = false;
+
+	/** The level below which samples are considered silent, in dBFS (see SetSilenceTrimming) */
+	float SilenceThresholdDb = -60.f;
+
+	/** Seconds of silence kept around the non-silent audio data when trimming (see SetSilenceTrimming) */
+	float SilencePaddingSeconds = 0.05f;
 };
@@ -59,6 +59,13 @@ namespace FRAIMemory
 using FRAIMemory = FMemory;
 #endif
 
+/** VectorRegister is double precision with large world coordinates in UE >= 5.0, so float PCM data is processed with VectorRegister4Float there */
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+using FRAIVectorRegister = VectorRegister;
+#else
+using FRAIVectorRegister = VectorRegister4Float;
+#endif
+
 /** FPipe isn't supported in UE earlier than 5.0.0, so the task will be launched via async task */
 #if UE_VERSION_OLDER_THAN(5, 0, 0)
 namespace UE
@@ -190,6 +197,14 @@ enum class ERuntimeRAWAudioFormat : uint8
 	Float32 UMETA(DisplayName = "Floating point 32-bit")
 };
 
+/** Possible formats of the PCM data stored in imported sound waves */
+UENUM(BlueprintType, Category = "Runtime Audio Importer")
+enum class ERuntimePCMStorageFormat : uint8
+{
+	Float32 UMETA(DisplayName = "Floating point 32-bit", ToolTip = "Full precision"),
+	Int16 UMETA(DisplayName = "Signed 16-bit integer", ToolTip = "Half the memory of 32-bit float. Streamed to the audio mixer without conversion")
+};
+
 /** Possible VAD (Voice Activity Detection) modes */
 UENUM(BlueprintType, Category = "Runtime Audio Importer")
 enum class ERuntimeVADMode : uint8
@@ -227,6 +242,9 @@ namespace VoiceActivityDetector
 
 /**
  * An alternative to FBulkDataBuffer with consistent data types
+ * The data is either owned by the buffer or by an external owner (e.g. a memory-mapped file region), in which case it is read-only and is never freed by the buffer
+ * Copying a buffer with externally owned data shares the data and its owner instead of copying it, since the data is immutable
+ * Owned data can be shared the same way (see Share), in which case the buffer keeps appending to the reserved capacity after the shared data without copying it
  */
 template <typename DataType>
 class FRuntimeBulkDataBuffer
@@ -308,7 +326,11 @@ public:
 		// Not enough reserved capacity or no reserved capacity, reallocate entire buffer
 		else
 		{
-			int64 NewCapacity = View.Num() + InNumberOfElements;
+			const int64 NewNumOfElements = View.Num() + InNumberOfElements;
+
+			// Growing geometrically once the buffer is appended to repeatedly (e.g. streaming), so that the existing data is copied an amortized constant number of times
+			const int64 NewReservedCapacity = View.Num() > 0 ? View.Num() / 2 : 0;
+			const int64 NewCapacity = NewNumOfElements + NewReservedCapacity;
 			DataType* NewBuffer = static_cast<DataType*>(FMemory::Malloc(NewCapacity * sizeof(DataType)));
 			if (!NewBuffer)
 			{
@@ -323,7 +345,8 @@ public:
 			FMemory::Memcpy(NewBuffer + View.Num(), InBuffer, InNumberOfElements * sizeof(DataType));
 
 			FreeBuffer();
-			View = ViewType(NewBuffer, NewCapacity);
+			View = ViewType(NewBuffer, NewNumOfElements);
+			ReservedCapacity = NewReservedCapacity;
 			UE_LOG(LogRuntimeAudioImporter, Log, TEXT("Reallocating buffer to append data (new capacity: %lld)"), NewCapacity);
 		}
 	}
@@ -339,6 +362,7 @@ public:
 		Other.View = ViewType();
 		ReservedCapacity = Other.ReservedCapacity;
 		Other.ReservedCapacity = 0;
+		ExternalOwner = MoveTemp(Other.ExternalOwner);
 	}
 
 	FRuntimeBulkDataBuffer(DataType* InBuffer, int64 InNumberOfElements)
@@ -349,6 +373,22 @@ public:
 #endif
 	}
 
+	/**
+	 * Reference the data owned externally without copying it
+	 *
+	 * @param InBuffer The externally owned data. Must remain valid as long as the owner is alive and must not be written to
+	 * @param InNumberOfElements Number of elements in the data
+	 * @param InExternalOwner The owner keeping the data alive (e.g. a memory-mapped file region)
+	 */
+	FRuntimeBulkDataBuffer(DataType* InBuffer, int64 InNumberOfElements, TSharedPtr<void, ESPMode::ThreadSafe> InExternalOwner)
+		: View(InBuffer, InNumberOfElements)
+	  , ExternalOwner(MoveTemp(InExternalOwner))
+	{
+#if UE_VERSION_OLDER_THAN(4, 27, 0)
+		check(InNumberOfElements <= TNumericLimits<int32>::Max())
+#endif
+	}
+
 	template <typename Allocator>
 	explicit FRuntimeBulkDataBuffer(const TArray<DataType, Allocator>& Other)
 	{
@@ -376,12 +416,26 @@ public:
 		{
 			FreeBuffer();
 
+			// The externally owned data is never written to, so it is shared along with its owner (e.g. to keep a memory-mapped file zero-copy)
+			// The reserved capacity after the shared data stays with the original buffer, which is the only one appending to it
+			if (Other.IsExternallyOwned())
+			{
+				View = Other.View;
+				ExternalOwner = Other.ExternalOwner;
+				return *this;
+			}
+
+			if (Other.View.GetData() == nullptr)
+			{
+				return *this;
+			}
+
 			const int64 BufferSize = Other.View.Num() + Other.ReservedCapacity;
 
 			DataType* BufferCopy = static_cast<DataType*>(FMemory::Malloc(BufferSize * sizeof(DataType)));
-			FMemory::Memcpy(BufferCopy, Other.View.GetData(), BufferSize * sizeof(DataType));
+			FMemory::Memcpy(BufferCopy, Other.View.GetData(), Other.View.Num() * sizeof(DataType));
 
-			View = ViewType(BufferCopy, BufferSize);
+			View = ViewType(BufferCopy, Other.View.Num());
 			ReservedCapacity = Other.ReservedCapacity;
 		}
 
@@ -397,6 +451,7 @@ public:
 			Other.View = ViewType();
 			ReservedCapacity = Other.ReservedCapacity;
 			Other.ReservedCapacity = 0;
+			ExternalOwner = MoveTemp(Other.ExternalOwner);
 		}
 
 		return *this;
@@ -423,19 +478,185 @@ public:
 		return View;
 	}
 
+	/**
+	 * Whether the data is owned externally (e.g. by a memory-mapped file region) and therefore must not be written to
+	 */
+	bool IsExternallyOwned() const
+	{
+		return ExternalOwner.IsValid();
+	}
+
+	/**
+	 * Get the owner keeping the externally owned data alive. Invalid if the data is owned by the buffer
+	 */
+	const TSharedPtr<void, ESPMode::ThreadSafe>& GetExternalOwner() const
+	{
+		return ExternalOwner;
+	}
+
+	/**
+	 * Share the data with another buffer without copying it, e.g. to take an immutable snapshot of the data
+	 * Owned data is handed over to a shared allocation first, after which the buffer no longer writes to the shared elements: further appends go to the reserved capacity after them,
+	 * or to a new allocation once it runs out, so neither the shared data nor appending to the buffer ever requires copying the shared data
+	 *
+	 * @return A buffer referencing the data as externally owned. Empty if there is no data
+	 */
+	FRuntimeBulkDataBuffer Share()
+	{
+		if (View.GetData() == nullptr || View.Num() <= 0)
+		{
+			return FRuntimeBulkDataBuffer();
+		}
+
+		if (!IsExternallyOwned())
+		{
+			ExternalOwner = MakeShared<FSharedAllocation, ESPMode::ThreadSafe>(View.GetData());
+		}
+
+		return FRuntimeBulkDataBuffer(View.GetData(), View.Num(), ExternalOwner);
+	}
+
+	/**
+	 * Copy the externally owned data into memory owned by the buffer, so that the data can be written to
+	 * Does nothing if the data is already owned by the buffer
+	 *
+	 * @param SlackCapacity Capacity to reserve after the copied data for further appends
+	 * @return True if the data is owned by the buffer after the call, false if the allocation failed
+	 */
+	bool MakeOwned(int64 SlackCapacity = 0)
+	{
+		if (!IsExternallyOwned())
+		{
+			return true;
+		}
+
+		const int64 NumOfElements = View.Num();
+		SlackCapacity = SlackCapacity > 0 ? SlackCapacity : 0;
+		DataType* OwnedBuffer = static_cast<DataType*>(FMemory::Malloc((NumOfElements + SlackCapacity) * sizeof(DataType)));
+		if (!OwnedBuffer)
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Failed to allocate buffer to copy externally owned data (%lld bytes)"), NumOfElements * sizeof(DataType));
+			return false;
+		}
+
+		FMemory::Memcpy(OwnedBuffer, View.GetData(), NumOfElements * sizeof(DataType));
+		FreeBuffer();
+		View = ViewType(OwnedBuffer, NumOfElements);
+		ReservedCapacity = SlackCapacity;
+		return true;
+	}
+
+	/**
+	 * Get the capacity reserved after the data for further appends (see Reserve)
+	 */
+	int64 GetReservedCapacity() const
+	{
+		return ReservedCapacity;
+	}
+
+	/**
+	 * Release the reserved capacity, shrinking the allocation to the data. Should not be called while the data is referenced elsewhere, since the data may be moved
+	 */
+	void Shrink()
+	{
+		if (ReservedCapacity <= 0 || IsExternallyOwned() || View.Num() <= 0)
+		{
+			return;
+		}
+
+		DataType* ShrunkData = static_cast<DataType*>(FMemory::Realloc(View.GetData(), View.Num() * sizeof(DataType)));
+		View = ViewType(ShrunkData ? ShrunkData : View.GetData(), View.Num());
+		ReservedCapacity = 0;
+	}
+
+	/**
+	 * Narrow the buffer down to the specified range of elements without allocating a new buffer
+	 * Externally owned data is only re-referenced. Owned data is moved to the start of its allocation (unless the range already starts there) and the allocation is shrunk
+	 *
+	 * @param StartIndex Index of the first element to keep
+	 * @param NumOfElements Number of elements to keep
+	 * @return True if the buffer was narrowed down, false if the range is out of bounds
+	 */
+	bool Trim(int64 StartIndex, int64 NumOfElements)
+	{
+		if (StartIndex < 0 || NumOfElements < 0 || StartIndex + NumOfElements > View.Num())
+		{
+			UE_LOG(LogRuntimeAudioImporter, Error, TEXT("Unable to trim buffer because the range is out of bounds (start index: %lld, number of elements: %lld, buffer size: %lld)"), StartIndex, NumOfElements, static_cast<int64>(View.Num()));
+			return false;
+		}
+
+		if (StartIndex == 0 && NumOfElements == View.Num())
+		{
+			return true;
+		}
+
+		if (NumOfElements == 0)
+		{
+			Empty();
+			return true;
+		}
+
+		if (IsExternallyOwned())
+		{
+			// The elements after the narrowed down data may still be referenced elsewhere, so they can no longer be appended to
+			View = ViewType(View.GetData() + StartIndex, NumOfElements);
+			ReservedCapacity = 0;
+			return true;
+		}
+
+		DataType* Data = View.GetData();
+		if (StartIndex > 0)
+		{
+			FMemory::Memmove(Data, Data + StartIndex, NumOfElements * sizeof(DataType));
+		}
+
+		// Shrinking generally happens in place, and the data is still valid if it fails
+		DataType* ShrunkData = static_cast<DataType*>(FMemory::Realloc(Data, NumOfElements * sizeof(DataType)));
+		View = ViewType(ShrunkData ? ShrunkData : Data, NumOfElements);
+		ReservedCapacity = 0;
+		return true;
+	}
+
 protected:
+	/**
+	 * Allocation made by the buffer that has been shared (see Share) and is freed once it is no longer referenced
+	 */
+	struct FSharedAllocation
+	{
+		explicit FSharedAllocation(DataType* InData)
+			: Data(InData)
+		{}
+
+		~FSharedAllocation()
+		{
+			FMemory::Free(Data);
+		}
+
+		FSharedAllocation(const FSharedAllocation&) = delete;
+		FSharedAllocation& operator=(const FSharedAllocation&) = delete;
+
+		DataType* Data;
+	};
+
 	void FreeBuffer()
 	{
 		if (View.GetData() != nullptr)
 		{
-			FMemory::Free(View.GetData());
+			if (!IsExternallyOwned())
+			{
+				FMemory::Free(View.GetData());
+			}
 			View = ViewType();
 			ReservedCapacity = 0;
 		}
+		ExternalOwner.Reset();
 	}
 
 	ViewType View;
 	int64 ReservedCapacity = 0;
+
+	/** The owner keeping the externally owned data alive. Invalid if the data is owned by the buffer. Reserved capacity with an external owner is the unshared tail of a shared allocation (see Share) */
+	TSharedPtr<void, ESPMode::ThreadSafe> ExternalOwner;
 };
 
 /** Basic sound wave data */
@@ -446,6 +667,8 @@ struct FSoundWaveBasicStruct
 	  , SampleRate(0)
 	  , Duration(0)
 	  , AudioFormat(ERuntimeAudioFormat::Invalid)
+	  , TrimmedLeadingDuration(0)
+	  , TrimmedTrailingDuration(0)
 	{}
 
 	/** Number of channels */
@@ -460,6 +683,12 @@ struct FSoundWaveBasicStruct
 	/** Audio format if the original audio data was encoded */
 	ERuntimeAudioFormat AudioFormat;
 
+	/** Duration of the silence trimmed from the start of the audio data, sec (see URuntimeAudioImporterLibrary::SetSilenceTrimming) */
+	float TrimmedLeadingDuration;
+
+	/** Duration of the silence trimmed from the end of the audio data, sec (see URuntimeAudioImporterLibrary::SetSilenceTrimming) */
+	float TrimmedTrailingDuration;
+
 	/**
 	 * Whether the sound wave data appear to be valid or not
 	 */
@@ -475,7 +704,7 @@ struct FSoundWaveBasicStruct
 	 */
 	FString ToString() const
 	{
-		return FString::Printf(TEXT("Number of channels: %d, sample rate: %d, duration: %f"), NumOfChannels, SampleRate, Duration);
+		return FString::Printf(TEXT("Number of channels: %d, sample rate: %d, duration: %f, trimmed leading duration: %f, trimmed trailing duration: %f"), NumOfChannels, SampleRate, Duration, TrimmedLeadingDuration, TrimmedTrailingDuration);
 	}
 };
 
@@ -491,9 +720,39 @@ struct FPCMStruct
 	 */
 	bool IsValid() const
 	{
+		if (GetStorageFormat() == ERuntimePCMStorageFormat::Int16)
+		{
+			return PCMDataInt16.GetView().GetData() && PCMNumOfFrames > 0;
+		}
 		return PCMData.GetView().GetData() && PCMNumOfFrames > 0 && PCMData.GetView().Num() > 0;
 	}
 
+	/**
+	 * Get the format the PCM data is currently stored in
+	 */
+	ERuntimePCMStorageFormat GetStorageFormat() const
+	{
+		return PCMDataInt16.GetView().Num() > 0 ? ERuntimePCMStorageFormat::Int16 : ERuntimePCMStorageFormat::Float32;
+	}
+
+	/**
+	 * Get the number of samples of the PCM data, regardless of the format it is stored in
+	 */
+	int64 GetNumOfSamples() const
+	{
+		return GetStorageFormat() == ERuntimePCMStorageFormat::Int16 ? PCMDataInt16.GetView().Num() : PCMData.GetView().Num();
+	}
+
+	/**
+	 * Release the PCM data in all formats
+	 */
+	void Empty()
+	{
+		PCMData.Empty();
+		PCMDataInt16.Empty();
+		PCMNumOfFrames = 0;
+	}
+
 	/**
 	 * Converts PCM struct to a readable format
 	 *
@@ -501,13 +760,16 @@ struct FPCMStruct
 	 */
 	FString ToString() const
 	{
-		return FString::Printf(TEXT("Validity of PCM data in memory: %s, number of PCM frames: %d, PCM data size: %lld"),
-			PCMData.GetView().IsValidIndex(0) ? TEXT("Valid") : TEXT("Invalid"), PCMNumOfFrames, static_cast<int64>(PCMData.GetView().Num()));
+		return FString::Printf(TEXT("Validity of PCM data in memory: %s, number of PCM frames: %d, PCM data size: %lld, storage format: %s"),
+			IsValid() ? TEXT("Valid") : TEXT("Invalid"), PCMNumOfFrames, GetNumOfSamples(), GetStorageFormat() == ERuntimePCMStorageFormat::Int16 ? TEXT("16-bit integer") : TEXT("32-bit float"));
 	}
 
-	/** 32-bit float PCM data */
+	/** 32-bit float PCM data. Empty if the PCM data is stored as 16-bit integer */
 	FRuntimeBulkDataBuffer<float> PCMData;
 
+	/** 16-bit integer PCM data. Used instead of PCMData to halve the memory usage (see UImportedSoundWave::SetPCMStorageFormat) */
+	FRuntimeBulkDataBuffer<int16> PCMDataInt16;
+
 	/** Number of PCM frames */
 	uint32 PCMNumOfFrames;
 };
@@ -626,6 +888,94 @@ struct FEditableSubtitleCue
 	float Time;
 };
 
+/** Summary of the audio data within a time range, e.g. a single pixel column of a waveform */
+USTRUCT(BlueprintType, Category = "Runtime Audio Importer")
+struct FRuntimeAudioWaveformPeak
+{
+	GENERATED_BODY()
+
+	FRuntimeAudioWaveformPeak()
+		: Min(0)
+	  , Max(0)
+	  , RMS(0)
+	{}
+
+	/** The lowest sample value, across all channels */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Runtime Audio Importer")
+	float Min;
+
+	/** The highest sample value, across all channels */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Runtime Audio Importer")
+	float Max;
+
+	/** The root mean square of the sample values, across all channels */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Runtime Audio Importer")
+	float RMS;
+};
+
+/** Settings of the spectrum analysis of the played audio data */
+USTRUCT(BlueprintType, Category = "Runtime Audio Importer")
+struct FRuntimeAudioSpectrumSettings
+{
+	GENERATED_BODY()
+
+	FRuntimeAudioSpectrumSettings()
+		: FFTSize(1024)
+	  , HopSize(512)
+	  , NumOfBands(16)
+	  , MinFrequency(20)
+	  , MaxFrequency(0)
+	{}
+
+	/** The number of frames in every analysis window. Rounded up to a power of two, between 64 and 16384 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Runtime Audio Importer")
+	int32 FFTSize;
+
+	/** The number of frames between the starts of consecutive analysis windows. Smaller values update the spectrum more often at a higher cost */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Runtime Audio Importer")
+	int32 HopSize;
+
+	/** The number of logarithmically spaced frequency bands to compute the energies of */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Runtime Audio Importer")
+	int32 NumOfBands;
+
+	/** The lowest frequency of the bands, in Hz */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Runtime Audio Importer")
+	float MinFrequency;
+
+	/** The highest frequency of the bands, in Hz. Zero or less for the Nyquist frequency */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Runtime Audio Importer")
+	float MaxFrequency;
+};
+
+/** Spectrum of the most recently analyzed window of the played audio data */
+USTRUCT(BlueprintType, Category = "Runtime Audio Importer")
+struct FRuntimeAudioSpectrum
+{
+	GENERATED_BODY()
+
+	FRuntimeAudioSpectrum()
+		: SampleRate(0)
+	  , NumOfAnalyzedFrames(0)
+	{}
+
+	/** The magnitudes of the frequency bins, from 0 Hz to the Nyquist frequency (FFTSize / 2 + 1 bins), of the Hann-windowed frames of all channels mixed down to mono */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Runtime Audio Importer")
+	TArray<float> Magnitudes;
+
+	/** The energies (sums of the squared magnitudes) of the frequency bands, from the lowest to the highest */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Runtime Audio Importer")
+	TArray<float> BandEnergies;
+
+	/** The sample rate of the analyzed audio data. The frequency of the bin at index I is I * SampleRate / FFTSize */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Runtime Audio Importer")
+	int32 SampleRate;
+
+	/** The number of played frames analyzed up to the end of the window, increasing with every new spectrum */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Runtime Audio Importer")
+	int64 NumOfAnalyzedFrames;
+};
+
 /** Platform audio input device info */
 USTRUCT(BlueprintType, Category = "Runtime Audio Importer")
 struct FRuntimeAudioInputDeviceInfo
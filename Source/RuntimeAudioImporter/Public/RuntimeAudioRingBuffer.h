@@ -0,0 +1,69 @@
+// Georgy Treshchev 2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Fixed-capacity lock-free ring of 32-bit float samples for a single producer thread and a single consumer thread
+ * The memory is allocated once, so pushing and popping never allocate
+ */
+class RUNTIMEAUDIOIMPORTER_API FRuntimeAudioRingBuffer
+{
+public:
+	/**
+	 * @param InCapacity The maximum number of samples the ring can hold. Rounded up to a power of two
+	 */
+	explicit FRuntimeAudioRingBuffer(int32 InCapacity);
+	~FRuntimeAudioRingBuffer();
+
+	FRuntimeAudioRingBuffer(const FRuntimeAudioRingBuffer&) = delete;
+	FRuntimeAudioRingBuffer& operator=(const FRuntimeAudioRingBuffer&) = delete;
+
+	/**
+	 * Push as many of the specified samples as there is room for. Must only be called from the producer thread
+	 *
+	 * @param InSamples The samples to push
+	 * @param NumOfSamples The number of samples to push
+	 * @return The number of samples pushed
+	 */
+	int32 Push(const float* InSamples, int32 NumOfSamples);
+
+	/**
+	 * Pop at most the specified number of the oldest samples. Must only be called from the consumer thread
+	 *
+	 * @param OutSamples Pointer to memory location to pop to. Must have space for MaxNumOfSamples samples
+	 * @param MaxNumOfSamples The maximum number of samples to pop
+	 * @return The number of samples popped
+	 */
+	int32 Pop(float* OutSamples, int32 MaxNumOfSamples);
+
+	/**
+	 * Get the number of samples that can be popped. Exact on the consumer thread, a lower bound on others
+	 */
+	int32 Num() const;
+
+	/**
+	 * Get the number of samples that can be pushed. Exact on the producer thread, a lower bound on others
+	 */
+	int32 GetRemainder() const;
+
+	/**
+	 * Get the maximum number of samples the ring can hold
+	 */
+	int32 GetCapacity() const { return static_cast<int32>(Mask + 1); }
+
+private:
+	/** The samples. The number of samples is a power of two */
+	float* Samples;
+
+	/** The number of samples minus one */
+	const uint32 Mask;
+
+	/** The total number of samples pushed. Only written by the producer */
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> WriteIndex;
+
+	/** The total number of samples popped. Only written by the consumer */
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> ReadIndex;
+};
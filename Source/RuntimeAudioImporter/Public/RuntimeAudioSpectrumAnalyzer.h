@@ -0,0 +1,188 @@
+// Georgy Treshchev 2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RuntimeAudioImporterTypes.h"
+#include "RuntimeAudioRingBuffer.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Templates/Function.h"
+#include "Misc/EngineVersionComparison.h"
+#include <atomic>
+
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+namespace Audio
+{
+	class IFFTAlgorithm;
+}
+#endif
+
+/**
+ * Spectrum analyzer of rendered audio data, running on its own worker thread
+ * The render thread taps the rendered frames into a lock-free ring (mixed down to mono, without allocating), and the worker computes the windowed FFT magnitudes and band energies every hop
+ * The results are published through a triple buffer, so any thread can read the latest spectrum without locking and without ever blocking the worker
+ *
+ * @note PushFrames must only be called from one thread at a time
+ */
+class RUNTIMEAUDIOIMPORTER_API FRuntimeAudioSpectrumAnalyzer : public FRunnable
+{
+public:
+	/**
+	 * @param InSettings The analysis settings. Sanitized, see GetSettings
+	 */
+	explicit FRuntimeAudioSpectrumAnalyzer(const FRuntimeAudioSpectrumSettings& InSettings);
+	virtual ~FRuntimeAudioSpectrumAnalyzer() override;
+
+	//~ Begin FRunnable Interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	//~ End FRunnable Interface
+
+	/**
+	 * Stop analyzing and wait for the worker thread to exit. The last published spectrum can still be read
+	 */
+	void StopAndWait();
+
+	/**
+	 * Tap the rendered frames. Frames that do not fit into the ring because the worker has fallen behind are dropped
+	 *
+	 * @param PCMData Interleaved 32-bit float PCM data
+	 * @param NumOfFrames The number of frames in PCMData
+	 * @param NumOfChannels The number of channels in PCMData
+	 * @param InSampleRate The sample rate of PCMData
+	 */
+	void PushFrames(const float* PCMData, int64 NumOfFrames, uint32 NumOfChannels, uint32 InSampleRate);
+
+	/**
+	 * Tap the rendered frames. Frames that do not fit into the ring because the worker has fallen behind are dropped
+	 *
+	 * @param PCMData Interleaved 16-bit integer PCM data
+	 * @param NumOfFrames The number of frames in PCMData
+	 * @param NumOfChannels The number of channels in PCMData
+	 * @param InSampleRate The sample rate of PCMData
+	 */
+	void PushFrames(const int16* PCMData, int64 NumOfFrames, uint32 NumOfChannels, uint32 InSampleRate);
+
+	/**
+	 * Copy the latest published spectrum. Lock-free, can be called from any thread
+	 *
+	 * @param OutSpectrum The latest spectrum
+	 * @return Whether a spectrum has been published yet or not
+	 */
+	bool GetLatestSpectrum(FRuntimeAudioSpectrum& OutSpectrum) const;
+
+	/**
+	 * Read the latest published spectrum in place, without copying it. Lock-free, can be called from any thread
+	 * The spectrum is pinned while the visitor runs, so the visitor should return quickly to not make the worker skip publishing
+	 *
+	 * @param Visitor Called with the latest spectrum
+	 * @return Whether a spectrum has been published yet (and the visitor was called) or not
+	 */
+	bool ReadLatestSpectrum(TFunctionRef<void(const FRuntimeAudioSpectrum&)> Visitor) const;
+
+	/**
+	 * Get the sanitized analysis settings
+	 */
+	const FRuntimeAudioSpectrumSettings& GetSettings() const { return Settings; }
+
+	/**
+	 * Get the number of tapped frames dropped because the worker has fallen behind
+	 */
+	int64 GetNumOfDroppedFrames() const { return NumOfDroppedFrames.load(std::memory_order_relaxed); }
+
+private:
+	/**
+	 * Mix the frames down to mono block by block and push them into the ring
+	 */
+	template <typename SampleType>
+	void PushMonoFrames(const SampleType* PCMData, int64 NumOfFrames, uint32 NumOfChannels, uint32 InSampleRate);
+
+	/**
+	 * Analyze the current window and publish the spectrum
+	 */
+	void AnalyzeWindow();
+
+	/**
+	 * Compute the power of every frequency bin of the windowed frames held in FFTInput into PowerSpectrum
+	 * Uses the engine's FFT, or an in-place radix-2 FFT on engine versions that do not provide one
+	 *
+	 * @return Whether the power spectrum was computed or not
+	 */
+	bool ComputePowerSpectrum();
+
+	/**
+	 * Pin the latest published slot for reading. Returns INDEX_NONE if nothing has been published yet
+	 */
+	int32 PinLatestSlot() const;
+
+	/** The sanitized analysis settings */
+	FRuntimeAudioSpectrumSettings Settings;
+
+	/** The number of frequency bins (FFTSize / 2 + 1) */
+	int32 NumOfBins;
+
+	/** The tapped mono frames, pushed by the render thread and popped by the worker */
+	FRuntimeAudioRingBuffer Ring;
+
+	/** The last FFTSize mono frames, the oldest first */
+	TArray<float> Window;
+
+	/** The Hann window coefficients */
+	TArray<float> WindowCoefficients;
+
+	/** The windowed frames the FFT is computed from */
+	TArray<float> FFTInput;
+
+	/** The power of every frequency bin */
+	TArray<float> PowerSpectrum;
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	/** Bit-reversed index of every FFT input index */
+	TArray<int32> BitReversedIndices;
+
+	/** Twiddle factors of every FFT stage, stored contiguously per stage (stage of half-size H at offset H - 1) so that the butterflies can be vectorized */
+	TArray<float> TwiddleCos;
+	TArray<float> TwiddleSin;
+
+	/** The FFT working buffers, as split real and imaginary parts */
+	TArray<float> FFTReal;
+	TArray<float> FFTImag;
+#else
+	/** The engine's FFT for the FFT size. Invalid if the engine does not support the FFT size */
+	TUniquePtr<Audio::IFFTAlgorithm> FFTAlgorithm;
+
+	/** The FFT output, as interleaved real and imaginary parts of every frequency bin */
+	TArray<float> FFTOutput;
+
+	/** The factor the power of every bin is multiplied by to undo the scaling applied by the engine's FFT */
+	float FFTPowerScale;
+#endif
+
+	/** The number of slots the spectra are published through */
+	static constexpr int32 NumOfSlots = 3;
+
+	/** The published spectra. The worker writes into a slot that is neither the latest nor pinned by a reader */
+	FRuntimeAudioSpectrum Slots[NumOfSlots];
+
+	/** The number of readers pinning every slot */
+	mutable std::atomic<int32> NumOfSlotReaders[NumOfSlots];
+
+	/** The index of the latest published slot, or INDEX_NONE */
+	std::atomic<int32> LatestSlotIndex;
+
+	/** The sample rate of the tapped frames */
+	std::atomic<uint32> SampleRate;
+
+	/** The number of mono frames popped from the ring by the worker */
+	int64 NumOfAnalyzedFrames;
+
+	std::atomic<bool> bStopping;
+	std::atomic<int64> NumOfDroppedFrames;
+
+	/** Signaled by the render thread once a hop worth of frames is tapped */
+	FEvent* FramesAvailableEvent;
+
+	/** The thread the worker runs on. Joined in the destructor */
+	TUniquePtr<FRunnableThread> Thread;
+};
@@ -0,0 +1,100 @@
+// Georgy Treshchev 2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RuntimeAudioImporterTypes.h"
+
+/**
+ * Multi-resolution min/max/RMS pyramid of interleaved 32-bit float PCM data, for drawing waveforms without touching the PCM data
+ * The finest level summarizes every NumOfFramesPerBin frames, and every next level summarizes pairs of bins of the previous one. The pyramid is extended as frames are appended,
+ * so appending only reduces the new frames, and any time range can be summarized at any width in time proportional to the width
+ *
+ * @note The pyramid is not thread-safe, the caller is responsible for serializing the calls
+ */
+class RUNTIMEAUDIOIMPORTER_API FRuntimeAudioWaveformPyramid
+{
+public:
+	FRuntimeAudioWaveformPyramid();
+
+	/**
+	 * Clear the pyramid
+	 *
+	 * @param InNumOfChannels The number of channels of the PCM data that will be appended
+	 */
+	void Reset(uint32 InNumOfChannels);
+
+	/**
+	 * Summarize the specified frames and append them to the pyramid
+	 *
+	 * @param PCMData Interleaved PCM data with the number of channels specified in Reset
+	 * @param NumOfFrames The number of frames in PCMData
+	 */
+	void AppendFrames(const float* PCMData, int64 NumOfFrames);
+
+	/**
+	 * Summarize the frames within the specified range, split into the specified number of equal parts
+	 *
+	 * @param StartFrame The first frame of the range
+	 * @param EndFrame The frame following the last frame of the range. Clamped to the number of frames appended
+	 * @param NumOfPeaks The number of parts to split the range into, e.g. the width of the waveform in pixels
+	 * @param OutPeaks The summaries of the parts. Parts finer than NumOfFramesPerBin frames are summarized at that resolution
+	 */
+	void GetPeaks(int64 StartFrame, int64 EndFrame, int32 NumOfPeaks, TArray<FRuntimeAudioWaveformPeak>& OutPeaks) const;
+
+	/**
+	 * Get the number of frames appended
+	 */
+	int64 GetNumOfFrames() const { return NumOfFrames; }
+
+	/**
+	 * Get the number of channels of the appended frames
+	 */
+	uint32 GetNumOfChannels() const { return NumOfChannels; }
+
+	/** The number of frames summarized by a bin of the finest level */
+	static constexpr int64 NumOfFramesPerBin = 128;
+
+private:
+	/** Summary of a power-of-two number of bins of the finest level */
+	struct FBin
+	{
+		float Min;
+		float Max;
+		float MeanSquare;
+	};
+
+	/** Summary being accumulated from bins and the frames not yet forming a bin */
+	struct FAccumulator
+	{
+		float Min = TNumericLimits<float>::Max();
+		float Max = TNumericLimits<float>::Lowest();
+		double SumOfMeanSquares = 0;
+		int32 NumOfBins = 0;
+
+		void Add(float InMin, float InMax, float InMeanSquare);
+		FRuntimeAudioWaveformPeak ToPeak() const;
+	};
+
+	/**
+	 * Add the bins (of the specified level, or of finer levels where the level is not complete yet) within the specified range to the accumulator
+	 */
+	void AccumulateRange(int64 RangeStartFrame, int64 RangeEndFrame, int32 Level, FAccumulator& Accumulator) const;
+
+	/**
+	 * Append a complete bin to the finest level, merging it into the coarser levels
+	 */
+	void AppendBin(const FBin& Bin);
+
+	uint32 NumOfChannels;
+	int64 NumOfFrames;
+
+	/** The bins of every level, from the finest to the coarsest */
+	TArray<TArray<FBin>> Levels;
+
+	/** Summary of the frames not yet forming a bin of the finest level */
+	float PendingMin;
+	float PendingMax;
+	double PendingSumOfSquares;
+	int64 NumOfPendingFrames;
+};
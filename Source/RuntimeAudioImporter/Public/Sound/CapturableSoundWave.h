@@ -12,6 +12,8 @@
 #endif
 #endif
 #include "StreamingSoundWave.h"
+#include "RuntimeAudioRingBuffer.h"
+#include <atomic>
 #include "CapturableSoundWave.generated.h"
 
 /** Static delegate broadcasting available audio input devices */
@@ -33,6 +35,7 @@ public:
 
 	//~ Begin UImportedSoundWave Interface
 	virtual void BeginDestroy() override;
+	virtual int32 OnGeneratePCMAudio(TArray<uint8>& OutAudio, int32 NumSamples) override;
 	//~ End UImportedSoundWave Interface
 
 	/**
@@ -58,6 +61,40 @@ public:
 	 */
 	static void GetAvailableAudioInputDevices(const FOnGetAvailableAudioInputDevicesResultNative& Result);
 
+	/**
+	 * Set the number of frames the audio input device delivers per capture callback. Smaller buffers lower the latency at the cost of more frequent callbacks
+	 * Takes effect on the next StartCapture
+	 *
+	 * @param NumOfFrames The number of frames per capture callback. 1024 by default
+	 * @return Whether the number of frames was successfully set or not
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Capturable Sound Wave|Capture")
+	bool SetCaptureBufferSize(int32 NumOfFrames = 1024);
+
+	/**
+	 * Set whether the captured audio data is passed to the sound wave through a lock-free ring instead of being queued for appending as RAW data. False by default
+	 * The capture callback then copies the float frames into a ring preallocated on StartCapture instead of into a new array. The ring is drained on the audio task pipe, and the callback queues a drain task
+	 * (which allocates the task and briefly locks the pipe) only if none is queued yet, so buffers captured while a drain is pending cost a copy only. Also enables measuring the capture latency (see GetCaptureLatencyStatistics)
+	 * Takes effect on the next StartCapture
+	 *
+	 * @param bEnable Whether to enable the low-latency capture or not
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Capturable Sound Wave|Capture")
+	void SetLowLatencyCapture(bool bEnable);
+
+	/**
+	 * Get the measured end-to-end latency from capturing audio data to rendering it for playback, up to the audio mixer (the output device latency is not included)
+	 * Measured only with the low-latency capture (see SetLowLatencyCapture) while the sound wave is playing, and reset on StartCapture
+	 *
+	 * @param LatencySeconds Smoothed capture-to-render latency, in seconds
+	 * @param JitterSeconds Smoothed variation of the latency between rendered blocks, in seconds
+	 * @param MaxLatencySeconds The highest latency measured, in seconds
+	 * @param NumOfDroppedFrames The number of captured frames dropped because the ring was not drained in time
+	 * @return Whether the latency has been measured or not
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Capturable Sound Wave|Info")
+	bool GetCaptureLatencyStatistics(float& LatencySeconds, float& JitterSeconds, float& MaxLatencySeconds, int64& NumOfDroppedFrames) const;
+
 	/**
 	 * Start the capture process
 	 *
@@ -118,4 +155,63 @@ protected:
 	/** The last device index used for capture */
 	int32 LastDeviceIndex = -1;
 #endif
+
+protected:
+	/**
+	 * Pop the captured audio data from the ring and append it, remembering where it has been placed. Runs on the audio task pipe
+	 */
+	void DrainCaptureRing(FRuntimeAudioRingBuffer& Ring, uint32 InSampleRate, uint32 NumOfChannels);
+
+	/**
+	 * Update the capture latency statistics with the frames just rendered. Called on the audio render thread
+	 *
+	 * @param NumOfPlayedFrames The number of frames played after rendering
+	 */
+	void UpdateCaptureLatency(int64 NumOfPlayedFrames);
+
+	/** The number of frames per capture callback */
+	int32 NumOfFramesPerCaptureCallback = 1024;
+
+	/** Whether the captured audio data is passed through the capture ring or not */
+	bool bLowLatencyCapture = false;
+
+	/** The ring the capture callback pushes the captured audio data into. Is valid only while capturing with the low-latency capture */
+	TSharedPtr<FRuntimeAudioRingBuffer, ESPMode::ThreadSafe> CaptureRing;
+
+	/** Whether a task draining the capture ring is queued and has not started yet */
+	std::atomic<bool> bCaptureDrainQueued{ false };
+
+	/** The number of frames pushed into the capture ring. Written by the capture thread */
+	std::atomic<int64> NumOfCapturedFrames{ 0 };
+
+	/** The number of frames popped from the capture ring. Written on the audio task pipe */
+	std::atomic<int64> NumOfDrainedCaptureFrames{ 0 };
+
+	/** The number of captured frames dropped because the capture ring was full */
+	std::atomic<int64> NumOfDroppedCaptureFrames{ 0 };
+
+	/** The sample rate of the captured audio data */
+	std::atomic<uint32> CaptureSampleRate{ 0 };
+
+	/** The number of channels of the captured audio data */
+	std::atomic<uint32> CaptureNumOfChannels{ 0 };
+
+	/** The estimated time (FPlatformTime::Seconds) the first frame pushed into the capture ring was captured at. Refined on every capture callback */
+	std::atomic<double> CaptureStartTime{ 0 };
+
+	/** The index of a frame of the sound wave minus the index of the same captured frame. Updated on every drain, as not all drained frames may end up in the sound wave (e.g. due to VAD) */
+	std::atomic<int64> CaptureFrameOffset{ 0 };
+
+	/** Whether the capture frame offset has been set since the capture started or not */
+	std::atomic<bool> bHasCaptureFrameOffset{ false };
+
+	/** Data guard (mutex) for the capture latency statistics */
+	mutable FCriticalSection CaptureLatencyGuard;
+
+	/** Capture latency statistics. See GetCaptureLatencyStatistics */
+	double CaptureLatency = 0;
+	double LastCaptureLatency = 0;
+	double CaptureJitter = 0;
+	double MaxCaptureLatency = 0;
+	int64 NumOfCaptureLatencyMeasurements = 0;
 };
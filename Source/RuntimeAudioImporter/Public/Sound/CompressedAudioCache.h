@@ -0,0 +1,124 @@
+// Georgy Treshchev 2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RuntimeAudioImporterTypes.h"
+#include "Templates/SharedPointer.h"
+#include <atomic>
+
+/** Immutable compressed audio data, shared between the cache and its consumers without copying */
+using FRuntimeCompressedAudioDataPtr = TSharedPtr<const TArray64<uint8>, ESPMode::ThreadSafe>;
+
+/**
+ * Cache of the compressed (Ogg Vorbis) representation of the PCM data of an imported sound wave
+ * Used to initialize the audio resource (e.g. for MetaSounds) without re-encoding the whole PCM data every time
+ * A duplicated sound wave shares the cache of the original one until the PCM data of either changes, so the compressed data is never encoded twice (see UImportedSoundWave::DuplicateSoundWave)
+ */
+class RUNTIMEAUDIOIMPORTER_API FRuntimeCompressedAudioCache
+{
+public:
+	FRuntimeCompressedAudioCache();
+
+	/**
+	 * Invalidate the cached compressed data. Must be called every time the PCM data changes
+	 */
+	void Invalidate();
+
+	/**
+	 * Get the current revision of the PCM data tracked by the cache. Changes every time the cache is invalidated and is unique across all caches
+	 */
+	uint64 GetRevision() const;
+
+	/**
+	 * Retrieve the compressed data if it has already been produced for the specified revision
+	 *
+	 * @param Revision The revision of the PCM data
+	 * @return The compressed data, or nullptr if it is not available for this revision
+	 */
+	FRuntimeCompressedAudioDataPtr GetCompressedData(uint64 Revision) const;
+
+	/**
+	 * Retrieve the compressed data for the specified revision, encoding (or loading from the disk cache) if necessary
+	 * Concurrent callers wait for a single encode instead of encoding the same data in parallel
+	 *
+	 * @param Revision The revision of the PCM data from which DecodedAudioInfo was taken
+	 * @param DecodedAudioInfo The decoded audio data to encode if the compressed data is not yet available
+	 * @return The compressed data, or nullptr if encoding failed
+	 */
+	FRuntimeCompressedAudioDataPtr GetOrEncodeCompressedData(uint64 Revision, FDecodedAudioStruct&& DecodedAudioInfo);
+
+	/**
+	 * Set whether the compressed data should also be stored on disk, keyed by the hash of the PCM data. Disabled by default
+	 * This allows the same audio to skip encoding across sessions
+	 *
+	 * @param bEnabled Whether the disk cache is enabled or not
+	 */
+	static void SetDiskCacheEnabled(bool bEnabled);
+
+	/**
+	 * Whether the compressed data is also stored on disk or not
+	 */
+	static bool IsDiskCacheEnabled();
+
+	/**
+	 * Get the directory where the compressed data is stored if the disk cache is enabled
+	 */
+	static FString GetDiskCacheDirectory();
+
+	/**
+	 * Set the maximum total size of the compressed data stored on disk. The least recently used files are deleted once newly compressed data makes the disk cache exceed it
+	 *
+	 * @param MaxSize The maximum total size, in bytes. Set to 0 to not limit the size of the disk cache
+	 */
+	static void SetDiskCacheMaxSize(int64 MaxSize);
+
+	/**
+	 * Get the maximum total size of the compressed data stored on disk, in bytes. 0 if the size is not limited
+	 */
+	static int64 GetDiskCacheMaxSize();
+
+	/**
+	 * Delete the least recently used compressed data files until the total size fits within the specified size
+	 *
+	 * @param MaxSize The maximum total size of the files, in bytes. Set to 0 to delete all files
+	 * @return The number of deleted files
+	 */
+	static int32 TrimDiskCache(int64 MaxSize);
+
+	/** Vorbis quality used to produce the compressed data */
+	static constexpr uint8 CompressionQuality = 100;
+
+	/** The default maximum total size of the compressed data stored on disk (1 GB) */
+	static constexpr int64 DefaultDiskCacheMaxSize = 1024ll * 1024 * 1024;
+
+private:
+	/**
+	 * Compute the hash of the decoded audio data to be used as the disk cache key
+	 */
+	static FString ComputeContentHash(const FDecodedAudioStruct& DecodedAudioInfo);
+
+	/** Data guard (mutex) for the revision and the compressed data */
+	mutable FCriticalSection DataGuard;
+
+	/** Guard (mutex) ensuring only one encode is performed at a time for this cache */
+	FCriticalSection EncodeGuard;
+
+	/** Current revision of the PCM data */
+	uint64 Revision;
+
+	/** Revision of the PCM data from which CompressedData was produced */
+	uint64 CompressedDataRevision;
+
+	/** Compressed (Ogg Vorbis) data */
+	FRuntimeCompressedAudioDataPtr CompressedData;
+
+	/** Whether the disk cache is enabled or not */
+	static std::atomic<bool> bDiskCacheEnabled;
+
+	/** The maximum total size of the disk cache, in bytes, or 0 if not limited */
+	static std::atomic<int64> DiskCacheMaxSize;
+
+	/** The next revision to be assigned, shared by all caches so that a sound wave switching to another cache never sees the same revision twice */
+	static std::atomic<uint64> NextRevision;
+};
@@ -0,0 +1,177 @@
+// Georgy Treshchev 2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RuntimeAudioImporterTypes.h"
+#include "Templates/SharedPointer.h"
+
+/** Immutable decoded audio data, shared between the cache and the imported sound waves referencing it */
+using FRuntimeDecodedAudioPtr = TSharedPtr<const FDecodedAudioStruct, ESPMode::ThreadSafe>;
+
+/**
+ * Statistics of the decoded audio cache
+ */
+struct RUNTIMEAUDIOIMPORTER_API FRuntimeDecodedAudioCacheStats
+{
+	FRuntimeDecodedAudioCacheStats()
+		: NumOfHits(0)
+	  , NumOfMisses(0)
+	  , NumOfEvictions(0)
+	  , NumOfEntries(0)
+	  , UsedBytes(0)
+	  , MemoryBudget(0)
+	{}
+
+	/** The number of lookups that found the decoded audio data */
+	int64 NumOfHits;
+
+	/** The number of lookups that did not find the decoded audio data */
+	int64 NumOfMisses;
+
+	/** The number of entries evicted to stay within the memory budget */
+	int64 NumOfEvictions;
+
+	/** The number of entries currently cached */
+	int32 NumOfEntries;
+
+	/** The size of the PCM data currently cached, in bytes */
+	int64 UsedBytes;
+
+	/** The maximum size of the PCM data to cache, in bytes */
+	int64 MemoryBudget;
+
+	/**
+	 * Converts the stats to a readable format
+	 */
+	FString ToString() const
+	{
+		return FString::Printf(TEXT("Hits: %lld, misses: %lld, evictions: %lld, entries: %d, used: %lld bytes, budget: %lld bytes"),
+			NumOfHits, NumOfMisses, NumOfEvictions, NumOfEntries, UsedBytes, MemoryBudget);
+	}
+};
+
+/**
+ * Process-wide cache of decoded audio data, keyed by the source file (path, modification time and size) or by the hash of the encoded data
+ * Importing the same audio again reuses the already decoded PCM data without decoding or copying it. The least recently used entries are evicted to stay within the memory budget
+ * The cache is disabled by default (the memory budget is 0)
+ *
+ * @note The cached data is immutable. Imported sound waves reference it through their own FPCMStruct, so modifying a sound wave (e.g. resampling it) never affects the cache or other sound waves
+ */
+class RUNTIMEAUDIOIMPORTER_API FRuntimeDecodedAudioCache
+{
+public:
+	FRuntimeDecodedAudioCache();
+
+	/**
+	 * Get the process-wide decoded audio cache
+	 */
+	static FRuntimeDecodedAudioCache& Get();
+
+	/**
+	 * Whether the cache is enabled (the memory budget is greater than 0) or not
+	 */
+	bool IsEnabled() const;
+
+	/**
+	 * Set the maximum size of the PCM data to cache. Evicts the least recently used entries if the cache exceeds the new budget
+	 *
+	 * @param InMemoryBudget The memory budget, in bytes. Set to 0 to disable the cache
+	 */
+	void SetMemoryBudget(int64 InMemoryBudget);
+
+	/**
+	 * Get the maximum size of the PCM data to cache, in bytes
+	 */
+	int64 GetMemoryBudget() const;
+
+	/**
+	 * Find the decoded audio data and mark it as the most recently used
+	 *
+	 * @param Key The key of the decoded audio data (see MakeFileKey and MakeContentKey)
+	 * @return The decoded audio data, or nullptr if it is not cached
+	 */
+	FRuntimeDecodedAudioPtr Find(const FString& Key);
+
+	/**
+	 * Add the decoded audio data to the cache, evicting the least recently used entries if necessary
+	 *
+	 * @param Key The key of the decoded audio data (see MakeFileKey and MakeContentKey)
+	 * @param DecodedAudioInfo The decoded audio data to cache
+	 * @return The shared decoded audio data. Valid even if the data was too large to be cached
+	 */
+	FRuntimeDecodedAudioPtr Add(const FString& Key, FDecodedAudioStruct&& DecodedAudioInfo);
+
+	/**
+	 * Remove all entries. The decoded audio data still referenced by imported sound waves stays alive until they release it
+	 */
+	void Empty();
+
+	/**
+	 * Get the cache statistics
+	 */
+	FRuntimeDecodedAudioCacheStats GetStats() const;
+
+	/**
+	 * Create the decoded audio info referencing the shared decoded audio data without copying it
+	 *
+	 * @param SharedDecodedAudioInfo The shared decoded audio data
+	 * @return The decoded audio info keeping the shared decoded audio data alive
+	 */
+	static FDecodedAudioStruct MakeDecodedAudioView(const FRuntimeDecodedAudioPtr& SharedDecodedAudioInfo);
+
+	/**
+	 * Make the key identifying the decoded audio data of a file by its path, modification time and size
+	 *
+	 * @param FilePath The path to the audio file
+	 * @param AudioFormat The audio format used to decode the file
+	 * @return The key, or an empty string if the file does not exist
+	 */
+	static FString MakeFileKey(const FString& FilePath, ERuntimeAudioFormat AudioFormat);
+
+	/**
+	 * Make the key identifying the decoded audio data by the hash of the encoded audio data
+	 *
+	 * @param AudioData The encoded audio data
+	 * @param AudioFormat The audio format used to decode the data
+	 * @return The key
+	 */
+	static FString MakeContentKey(const FRuntimeBulkDataBuffer<uint8>& AudioData, ERuntimeAudioFormat AudioFormat);
+
+private:
+	/**
+	 * Evict the least recently used entries until the cache fits within the memory budget. Assumes the data guard is locked
+	 *
+	 * @param BytesToFit The number of bytes that must fit within the memory budget in addition to the cached entries
+	 */
+	void EvictToFit_Internal(int64 BytesToFit);
+
+	/**
+	 * Get the size of the PCM data of the decoded audio data, in bytes
+	 */
+	static int64 GetEntrySize(const FDecodedAudioStruct& DecodedAudioInfo);
+
+	struct FEntry
+	{
+		/** The shared decoded audio data */
+		FRuntimeDecodedAudioPtr DecodedAudioInfo;
+
+		/** The size of the PCM data, in bytes */
+		int64 Size;
+
+		/** The value of the access counter the last time the entry was used */
+		uint64 LastAccess;
+	};
+
+	/** Data guard (mutex) for the entries and the stats */
+	mutable FCriticalSection DataGuard;
+
+	/** Cached entries by their keys */
+	TMap<FString, FEntry> Entries;
+
+	/** Counter incremented on every access, used to find the least recently used entry */
+	uint64 AccessCounter;
+
+	/** The cache statistics */
+	FRuntimeDecodedAudioCacheStats Stats;
+};
@@ -0,0 +1,116 @@
+// Georgy Treshchev 2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RuntimeAudioImporterTypes.h"
+#include <atomic>
+
+/**
+ * Information about the decoded audio disk cache
+ */
+struct RUNTIMEAUDIOIMPORTER_API FRuntimeDecodedAudioDiskCacheInfo
+{
+	FRuntimeDecodedAudioDiskCacheInfo()
+		: NumOfFiles(0)
+	  , TotalSize(0)
+	{}
+
+	/** The number of cached files */
+	int32 NumOfFiles;
+
+	/** The total size of the cached files, in bytes */
+	int64 TotalSize;
+};
+
+/**
+ * Persistent cache of decoded audio data stored on disk, keyed by the same keys as the decoded audio cache (see FRuntimeDecodedAudioCache::MakeFileKey and MakeContentKey)
+ * Each entry is a single file containing a small header followed by the interleaved PCM data, so that importing an unchanged file again is a header check and a memory mapping with no decoding
+ * The PCM data can be stored as 32-bit float (referenced directly from the mapped file when loaded) or as 16-bit integer (half the size, converted when loaded)
+ * The cache is disabled by default
+ */
+class RUNTIMEAUDIOIMPORTER_API FRuntimeDecodedAudioDiskCache
+{
+public:
+	/**
+	 * Set whether the decoded audio data should be stored on disk and reused across sessions
+	 *
+	 * @param bInEnabled Whether the disk cache is enabled or not
+	 * @param bInStoreAsInt16 Whether to store the PCM data as 16-bit integer instead of 32-bit float. Applies to newly cached entries only
+	 */
+	static void SetEnabled(bool bInEnabled, bool bInStoreAsInt16 = false);
+
+	/**
+	 * Whether the decoded audio data is stored on disk or not
+	 */
+	static bool IsEnabled();
+
+	/**
+	 * Load the decoded audio data from the disk cache
+	 *
+	 * @param Key The key of the decoded audio data
+	 * @param OutDecodedAudioInfo The decoded audio data. Populated only if the function returns true
+	 * @return True if the decoded audio data was found and is valid
+	 */
+	static bool Load(const FString& Key, FDecodedAudioStruct& OutDecodedAudioInfo);
+
+	/**
+	 * Store the decoded audio data in the disk cache
+	 *
+	 * @param Key The key of the decoded audio data
+	 * @param DecodedAudioInfo The decoded audio data to store
+	 * @return True if the decoded audio data was successfully stored
+	 */
+	static bool Save(const FString& Key, const FDecodedAudioStruct& DecodedAudioInfo);
+
+	/**
+	 * Delete the cached file for the specified key, if any
+	 *
+	 * @param Key The key of the decoded audio data
+	 * @return True if the cached file was deleted
+	 */
+	static bool Remove(const FString& Key);
+
+	/**
+	 * Get the directory where the decoded audio data is stored
+	 */
+	static FString GetDirectory();
+
+	/**
+	 * Get the number and the total size of the cached files
+	 */
+	static FRuntimeDecodedAudioDiskCacheInfo GetInfo();
+
+	/**
+	 * Delete the least recently used cached files until the total size fits within the specified size
+	 *
+	 * @param MaxSize The maximum total size of the cached files, in bytes. Set to 0 to delete all cached files
+	 * @return The number of deleted files
+	 */
+	static int32 Trim(int64 MaxSize);
+
+	/**
+	 * Verify the headers and the PCM data of all cached files
+	 *
+	 * @param bDeleteInvalid Whether to delete the invalid files or not
+	 * @return The number of invalid files
+	 */
+	static int32 Validate(bool bDeleteInvalid);
+
+private:
+	/**
+	 * Get the path of the cached file for the specified key
+	 */
+	static FString GetFilePath(const FString& Key);
+
+	/**
+	 * Get the paths of all cached files
+	 */
+	static TArray<FString> GetFilePaths();
+
+	/** Whether the disk cache is enabled or not */
+	static std::atomic<bool> bEnabled;
+
+	/** Whether newly cached PCM data is stored as 16-bit integer or not */
+	static std::atomic<bool> bStoreAsInt16;
+};
@@ -3,8 +3,15 @@
 #pragma once
 
 #include "RuntimeAudioImporterTypes.h"
+#include "Sound/CompressedAudioCache.h"
+#include "Sound/ImportedSoundWavePlaybackInstance.h"
+#include "Sound/ImportedSoundWaveAudioSubscription.h"
+#include "Sound/ImportedSoundWavePCMReadLease.h"
+#include "RuntimeAudioWaveformPyramid.h"
+#include "RuntimeAudioSpectrumAnalyzer.h"
 #include "Sound/SoundWaveProcedural.h"
 #include "Misc/Optional.h"
+#include <atomic>
 #include "ImportedSoundWave.generated.h"
 
 class UImportedSoundWave;
@@ -71,10 +78,58 @@ DECLARE_DELEGATE_OneParam(FOnReverseAudioDataNative, bool);
 /** Dynamic delegate broadcast the result of reversing the audio data */
 DECLARE_DYNAMIC_DELEGATE_OneParam(FOnReverseAudioData, bool, bSucceeded);
 
+
+/** Static delegate broadcast the progress of processing (resampling or mixing) the audio data in the background */
+DECLARE_DELEGATE_OneParam(FOnProcessAudioDataProgressNative, int32);
+
+/** Dynamic delegate broadcast the progress of processing (resampling or mixing) the audio data in the background */
+DECLARE_DYNAMIC_DELEGATE_OneParam(FOnProcessAudioDataProgress, int32, Percentage);
+
+
+/** Static delegate broadcast the result of processing (resampling or mixing) the audio data in the background */
+DECLARE_DELEGATE_OneParam(FOnProcessAudioDataResultNative, bool);
+
+/** Dynamic delegate broadcast the result of processing (resampling or mixing) the audio data in the background */
+DECLARE_DYNAMIC_DELEGATE_OneParam(FOnProcessAudioDataResult, bool, bSucceeded);
+
+/**
+ * PCM data of an imported sound wave along with its format, shared with consumers reading the audio data directly outside of the sound wave (e.g. MetaSounds)
+ * Keeps the PCM buffer alive even if the sound wave is destroyed. Lock DataGuard before accessing any of the members except Revision
+ */
+struct FImportedSoundWavePCMSource
+{
+	FImportedSoundWavePCMSource(const TSharedPtr<FCriticalSection>& InDataGuard, const TSharedPtr<FPCMStruct>& InPCMBufferInfo)
+		: DataGuard(InDataGuard)
+	  , PCMBufferInfo(InPCMBufferInfo)
+	  , SampleRate(0)
+	  , NumOfChannels(0)
+	  , bReversePlayback(false)
+	  , Revision(0)
+	{}
+
+	/** Data guard (mutex) of the sound wave */
+	const TSharedPtr<FCriticalSection> DataGuard;
+
+	/** PCM data of the sound wave */
+	const TSharedPtr<FPCMStruct> PCMBufferInfo;
+
+	/** Sample rate of the PCM data */
+	uint32 SampleRate;
+
+	/** Number of channels of the PCM data */
+	uint32 NumOfChannels;
+
+	/** Whether the sound wave is played in reverse or not (see UImportedSoundWave::SetReversePlayback) */
+	bool bReversePlayback;
+
+	/** Incremented under DataGuard whenever any of the other members change, so that the consumers can keep reading their own snapshot of the PCM data without locking until it does */
+	std::atomic<uint64> Revision;
+};
+
 /**
  * Imported sound wave. Assumed to be dynamically populated once from the decoded audio data.
- * Accumulates audio data in 32-bit interleaved floating-point format.
- * Only a single playback is supported at a time (see DuplicateSoundWave for parallel playback)
+ * Accumulates audio data in 32-bit interleaved floating-point format, or in 16-bit interleaved integer format (see SetPCMStorageFormat).
+ * Only a single playback is supported at a time (see SetPlaybackInstancing and DuplicateSoundWave for parallel playback)
  * Audio data preparation takes place in the Runtime Audio Importer library
  */
 UCLASS(BlueprintType, Category = "Imported Sound Wave")
@@ -96,6 +151,12 @@ public:
 	virtual void BeginDestroy() override;
 	virtual void Parse(class FAudioDevice* AudioDevice, const UPTRINT NodeWaveInstanceHash, FActiveSound& ActiveSound, const FSoundParseParameters& ParseParams, TArray<FWaveInstance*>& WaveInstances) override;
 	virtual Audio::EAudioMixerStreamDataFormat::Type GetGeneratedPCMDataFormat() const override;
+	virtual void OnBeginGenerate() override;
+	virtual void OnEndGenerate() override;
+#if WITH_RUNTIMEAUDIOIMPORTER_PLAYBACK_INSTANCE_GENERATOR_SUPPORT
+	virtual ISoundGeneratorPtr CreateSoundGenerator(const FSoundGeneratorInitParams& InParams) override;
+	virtual void OnEndGenerate(ISoundGeneratorPtr Generator) override;
+#endif
 #if WITH_RUNTIMEAUDIOIMPORTER_METASOUND_SUPPORT
 	virtual TSharedPtr<Audio::IProxyData> CreateProxyData(const Audio::FProxyDataInitParams& InitParams) override;
 	virtual bool InitAudioResource(FName Format) override;
@@ -110,7 +171,7 @@ public:
 	/**
 	 * Duplicate the sound wave to be able to play it in parallel
 	 * 
-	 * @param bUseSharedAudioBuffer Whether to use the same audio buffer for the duplicated sound wave or not
+	 * @param bUseSharedAudioBuffer Whether to share the audio buffer with the duplicated sound wave until either of them changes its audio data (copy-on-write) instead of copying it
 	 * @param Result Delegate broadcasting the result
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Imported Sound Wave|Main")
@@ -119,11 +180,112 @@ public:
 	/**
 	 * Duplicate the sound wave to be able to play it in parallel. Suitable for use in C++
 	 * 
-	 * @param bUseSharedAudioBuffer Whether to use the same audio buffer for the duplicated sound wave or not
+	 * @param bUseSharedAudioBuffer Whether to share the audio buffer with the duplicated sound wave until either of them changes its audio data (copy-on-write) instead of copying it
 	 * @param Result Delegate broadcasting the result
 	 */
 	virtual void DuplicateSoundWave(bool bUseSharedAudioBuffer, const FOnDuplicateSoundWaveNative& Result);
 
+	/**
+	 * Set whether every playback of the sound wave (e.g. by multiple audio components) should get its own lightweight playback instance
+	 * This allows playing the same sound wave many times in parallel without duplicating it. Each playback has its own position, looping and finish state over the same PCM data
+	 *
+	 * @param bEnable Whether to enable playback instancing or not
+	 * @return Whether playback instancing was set or not
+	 * @note The playback state of the sound wave itself (e.g. RewindPlaybackTime, GetPlaybackTime, OnGeneratePCMData and OnAudioPlaybackFinished) does not apply to the instanced playbacks
+	 * @warning This works only on Unreal Engine version >= 5.0
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Imported Sound Wave|Main")
+	bool SetPlaybackInstancing(bool bEnable);
+
+	/**
+	 * Whether every playback of the sound wave gets its own playback instance or not (see SetPlaybackInstancing)
+	 */
+	UFUNCTION(BlueprintPure, Category = "Imported Sound Wave|Info")
+	bool IsPlaybackInstancingEnabled() const;
+
+	/**
+	 * Set whether the sound wave should be played in reverse (backwards) without changing the audio buffer (PCM data)
+	 * Can be toggled during playback, in which case the playback continues from the same position in the opposite direction. If the playback has not started yet, it starts from the end of the audio data
+	 * The playback time, percentage and the number of played frames always refer to the position in the audio data, so they decrease when playing in reverse, and rewinding to a time continues the playback backwards from that time
+	 *
+	 * @param bReverse Whether to play the sound wave in reverse or not
+	 * @note Unlike ReverseAudioBuffer, this neither copies the PCM data nor invalidates the compressed audio data. Also applies to the Imported Wave Player MetaSound node and to playback instances created afterwards
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Imported Sound Wave|Main")
+	void SetReversePlayback(bool bReverse);
+
+	/**
+	 * Whether the sound wave is played in reverse or not (see SetReversePlayback)
+	 */
+	UFUNCTION(BlueprintPure, Category = "Imported Sound Wave|Info")
+	bool IsReversePlayback() const;
+
+	/**
+	 * Create a lightweight playback instance with its own playhead over the current PCM data of the sound wave. Can be called from any thread
+	 * The PCM data is shared with the sound wave and other instances without copying. Changes made to the sound wave afterwards (e.g. resampling or appending audio data) do not affect the created instance
+	 *
+	 * @param bLoop Whether to loop the playback or not
+	 * @return The playback instance, or nullptr if the sound wave has no PCM data
+	 */
+	TSharedPtr<FImportedSoundWavePlaybackInstance, ESPMode::ThreadSafe> CreatePlaybackInstance(bool bLoop = false);
+
+	/**
+	 * Subscribe to the audio data populated into or generated by the sound wave. Suitable for use in C++
+	 * Unlike OnPopulateAudioData and OnGeneratePCMData, every chunk is made once and shared by all subscribers as an immutable ref-counted handle, without a task or a copy per subscriber
+	 * The chunks are pushed into a bounded lock-free ring of the subscription and read by the subscriber at its own pace (see FImportedSoundWaveAudioSubscription::Read)
+	 *
+	 * @param Source The audio data to receive
+	 * @param Capacity The maximum number of unread chunks. Rounded up to a power of two
+	 * @param OverflowPolicy What happens to a new chunk if the subscriber has fallen behind by Capacity chunks
+	 * @return The subscription. It ends when UnsubscribeFromAudio is called or the last reference to it is released
+	 */
+	TSharedRef<FImportedSoundWaveAudioSubscription, ESPMode::ThreadSafe> SubscribeToAudio(ERuntimeAudioSubscriptionSource Source, int32 Capacity = 64, ERuntimeAudioSubscriptionOverflowPolicy OverflowPolicy = ERuntimeAudioSubscriptionOverflowPolicy::DropOldest);
+
+	/**
+	 * End the audio subscription made with SubscribeToAudio. The unread chunks can still be read
+	 *
+	 * @param Subscription The subscription to end
+	 */
+	void UnsubscribeFromAudio(const TSharedPtr<FImportedSoundWaveAudioSubscription, ESPMode::ThreadSafe>& Subscription);
+
+	/**
+	 * Enable the spectrum analysis of the played audio data, e.g. for visualizers or lip-sync, replacing the previous analysis if any
+	 * The rendered frames are tapped into a lock-free ring without copying them per block to a task, and analyzed on a dedicated worker thread every hop. See GetSpectrum for the results
+	 *
+	 * @param Settings The analysis settings
+	 * @return Whether the spectrum analysis was enabled or not
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Imported Sound Wave|Analysis")
+	bool EnableSpectrumAnalysis(const FRuntimeAudioSpectrumSettings& Settings);
+
+	/**
+	 * Disable the spectrum analysis enabled with EnableSpectrumAnalysis, stopping its worker thread
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Imported Sound Wave|Analysis")
+	void DisableSpectrumAnalysis();
+
+	/**
+	 * Whether the spectrum analysis is enabled or not (see EnableSpectrumAnalysis)
+	 */
+	UFUNCTION(BlueprintPure, Category = "Imported Sound Wave|Analysis")
+	bool IsSpectrumAnalysisEnabled() const;
+
+	/**
+	 * Get the spectrum of the most recently analyzed window of the played audio data. Can be called from any thread
+	 *
+	 * @param OutSpectrum The latest spectrum
+	 * @return Whether the spectrum analysis is enabled and has analyzed a window yet or not
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Imported Sound Wave|Analysis")
+	bool GetSpectrum(FRuntimeAudioSpectrum& OutSpectrum) const;
+
+	/**
+	 * Get the spectrum analyzer, e.g. to read the latest spectrum in place without copying it (see FRuntimeAudioSpectrumAnalyzer::ReadLatestSpectrum). Suitable for use in C++
+	 *
+	 * @return The spectrum analyzer, or nullptr if the spectrum analysis is not enabled
+	 */
+	TSharedPtr<FRuntimeAudioSpectrumAnalyzer, ESPMode::ThreadSafe> GetSpectrumAnalyzer() const;
+
 	/**
 	 * Populate audio data from decoded info
 	 *
@@ -135,6 +297,7 @@ public:
 	 * Prepare this sound wave to be able to set wave parameter for MetaSounds
 	 * 
 	 * @param Result Delegate broadcasting the result. Set the wave parameter only after it has been broadcast
+	 * @note Not required when playing the sound wave with the Imported Wave Player node, which reads the PCM data directly
 	 * @warning This works if bEnableMetaSoundSupport is enabled in RuntimeAudioImporter.Build.cs/RuntimeAudioImporterEditor.Build.cs and only on Unreal Engine version >= 5.2
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Imported Sound Wave|MetaSounds")
@@ -144,10 +307,33 @@ public:
 	 * Prepare this sound wave to be able to set wave parameter for MetaSounds. Suitable for use in C++
 	 * 
 	 * @param Result Delegate broadcasting the result. Set the wave parameter only after it has been broadcast
+	 * @note Not required when playing the sound wave with the Imported Wave Player node, which reads the PCM data directly
 	 * @warning This works if bEnableMetaSoundSupport is enabled in RuntimeAudioImporter.Build.cs/RuntimeAudioImporterEditor.Build.cs and only on Unreal Engine version >= 5.2
 	 */
 	void PrepareSoundWaveForMetaSounds(const FOnPrepareSoundWaveForMetaSoundsResultNative& Result);
 
+	/**
+	 * Set whether the compressed audio data required for MetaSounds should be produced in the background ahead of time, every time the PCM data changes
+	 * This makes PrepareSoundWaveForMetaSounds (and the engine's audio resource initialization) return almost immediately
+	 *
+	 * @param bPrecache Whether to precache the compressed audio data or not
+	 * @return Whether the precaching mode was set or not
+	 * @note Best suited for sound waves whose audio data is populated once, since every change of the PCM data requires a new encode. Appended audio data (e.g. streaming or capture) is only precached once no frames have been appended for a short while
+	 * @warning This works if bEnableMetaSoundSupport is enabled in RuntimeAudioImporter.Build.cs/RuntimeAudioImporterEditor.Build.cs and only on Unreal Engine version >= 5.2
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Imported Sound Wave|MetaSounds")
+	bool SetPrecacheCompressedAudio(bool bPrecache);
+
+	/**
+	 * Set whether the compressed audio data required for MetaSounds should also be stored on disk, keyed by the hash of the PCM data
+	 * Allows skipping the encode for the same audio data across sessions. Applies to all imported sound waves
+	 *
+	 * @param bEnabled Whether the disk cache is enabled or not
+	 * @param MaxSizeInMegabytes The maximum total size of the disk cache. The least recently used files are deleted once it is exceeded. Set to 0 to not limit the size
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Imported Sound Wave|MetaSounds")
+	static void SetCompressedAudioDiskCacheEnabled(bool bEnabled, int64 MaxSizeInMegabytes = 1024);
+
 	/**
 	 * Release sound wave data. Call it manually only if you are sure of it
 	 */
@@ -231,30 +417,87 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Imported Sound Wave|Main")
 	bool SetInitialDesiredNumOfChannels(int32 DesiredNumOfChannels);
 
+	/**
+	 * Set the format in which the sound wave stores its PCM data
+	 * 16-bit integer storage halves the memory usage and is streamed to the audio mixer without conversion. Everything reading the PCM data as 32-bit float (e.g. delegates, export, MetaSounds) converts it on the fly
+	 *
+	 * @note The already populated PCM data is converted to the new format. This should be called before the sound wave is played, since the audio mixer queries the format when the playback starts
+	 * @param StorageFormat The storage format
+	 * @return Whether the storage format was set or not
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Imported Sound Wave|Main")
+	bool SetPCMStorageFormat(ERuntimePCMStorageFormat StorageFormat);
+
+	/**
+	 * Get the format in which the sound wave stores its PCM data
+	 */
+	UFUNCTION(BlueprintPure, Category = "Imported Sound Wave|Info")
+	ERuntimePCMStorageFormat GetPCMStorageFormat() const;
+
 public:
 
-	// TODO: Make this async
 	/**
-	 * Resample the sound wave to the specified sample rate
+	 * Resample the sound wave to the specified sample rate, blocking the calling thread (see ResampleSoundWaveAsync)
+	 * The playback is not blocked, since the current PCM data is resampled without locking and replaced only when done. The playback continues from the same time position
 	 *
-	 * @note This is not thread-safe at the moment
 	 * @param NewSampleRate The new sample rate
 	 * @return Whether the sound wave was resampled or not
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Imported Sound Wave|Main")
 	bool ResampleSoundWave(int32 NewSampleRate);
 
-	// TODO: Make this async
 	/**
-	 * Change the number of channels of the sound wave
+	 * Resample the sound wave to the specified sample rate in the background
+	 * The playback continues from the current PCM data until the resampled PCM data replaces it, between two rendered blocks and from the same time position
+	 *
+	 * @param NewSampleRate The new sample rate
+	 * @param Progress Delegate broadcasting the progress, 0-100%. Broadcast on the game thread
+	 * @param Result Delegate broadcasting the result. Fails if the PCM data was changed by something else during resampling. Broadcast on the game thread
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Imported Sound Wave|Main")
+	void ResampleSoundWaveAsync(int32 NewSampleRate, const FOnProcessAudioDataProgress& Progress, const FOnProcessAudioDataResult& Result);
+
+	/**
+	 * Resample the sound wave to the specified sample rate in the background. Suitable for use in C++
+	 * The playback continues from the current PCM data until the resampled PCM data replaces it, between two rendered blocks and from the same time position
+	 *
+	 * @param NewSampleRate The new sample rate
+	 * @param Progress Delegate broadcasting the progress, 0-100%. Broadcast on the game thread
+	 * @param Result Delegate broadcasting the result. Fails if the PCM data was changed by something else during resampling. Broadcast on the game thread
+	 */
+	void ResampleSoundWaveAsync(int32 NewSampleRate, const FOnProcessAudioDataProgressNative& Progress, const FOnProcessAudioDataResultNative& Result);
+
+	/**
+	 * Change the number of channels of the sound wave, blocking the calling thread (see MixSoundWaveChannelsAsync)
+	 * The playback is not blocked, since the current PCM data is mixed without locking and replaced only when done
 	 *
-	 * @note This is not thread-safe at the moment
 	 * @param NewNumOfChannels The new number of channels
 	 * @return Whether the sound wave was mixed or not
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Imported Sound Wave|Main")
 	bool MixSoundWaveChannels(int32 NewNumOfChannels);
 
+	/**
+	 * Change the number of channels of the sound wave in the background
+	 * The playback continues from the current PCM data until the mixed PCM data replaces it, between two rendered blocks
+	 *
+	 * @param NewNumOfChannels The new number of channels
+	 * @param Progress Delegate broadcasting the progress, 0-100%. Broadcast on the game thread
+	 * @param Result Delegate broadcasting the result. Fails if the PCM data was changed by something else during mixing. Broadcast on the game thread
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Imported Sound Wave|Main")
+	void MixSoundWaveChannelsAsync(int32 NewNumOfChannels, const FOnProcessAudioDataProgress& Progress, const FOnProcessAudioDataResult& Result);
+
+	/**
+	 * Change the number of channels of the sound wave in the background. Suitable for use in C++
+	 * The playback continues from the current PCM data until the mixed PCM data replaces it, between two rendered blocks
+	 *
+	 * @param NewNumOfChannels The new number of channels
+	 * @param Progress Delegate broadcasting the progress, 0-100%. Broadcast on the game thread
+	 * @param Result Delegate broadcasting the result. Fails if the PCM data was changed by something else during mixing. Broadcast on the game thread
+	 */
+	void MixSoundWaveChannelsAsync(int32 NewNumOfChannels, const FOnProcessAudioDataProgressNative& Progress, const FOnProcessAudioDataResultNative& Result);
+
 	/**
 	 * Stop the sound wave playback
 	 * 
@@ -276,6 +519,7 @@ public:
 
 	/**
 	 * Reverse the audio buffer (PCM data) so that when played back, it will be played in reverse (backwards)
+	 * See SetReversePlayback to play in reverse without changing the audio buffer
 	 * 
 	 * @param Result Delegate broadcasting the result
 	 */
@@ -383,10 +627,18 @@ public:
 
 	/**
 	 * Check if the sound wave is currently playing by the audio device or not
+	 * Does not block and can be called from any thread, since the number of active playbacks is tracked as the audio mixer starts and stops generating audio for the sound wave
+	 * Playbacks are counted across all audio devices
+	 *
 	 * @return Whether the sound wave is playing or not
 	 */
-	UFUNCTION(BlueprintCallable, Category = "Imported Sound Wave|Info", meta = (WorldContext = "WorldContextObject"))
-	bool IsPlaying(const UObject* WorldContextObject) const;
+	UFUNCTION(BlueprintCallable, Category = "Imported Sound Wave|Info")
+	bool IsPlaying() const;
+
+	/**
+	 * Get the number of sources the audio mixer is currently generating audio for from this sound wave (see IsPlaying)
+	 */
+	int32 GetNumOfActivePlaybacks() const;
 
 	/**
 	 * Thread-unsafe equivalent of IsPlaybackFinished
@@ -394,6 +646,76 @@ public:
 	 */
 	bool IsPlaybackFinished_Internal() const;
 
+protected:
+	/**
+	 * Update the PCM source format and the waveform, invalidate the cached compressed audio data and precache it again if necessary (see SetPrecacheCompressedAudio)
+	 * Must be called every time the PCM data changes. Should only be used if DataGuard is locked
+	 *
+	 * @param bAppended Whether frames have only been appended to the end of the PCM data, in which case only they are added to the waveform
+	 */
+	void OnPCMDataChanged_Internal(bool bAppended = false);
+
+	/**
+	 * Add the frames of the PCM data missing from the waveform to it, rebuilding it first unless frames have only been appended. Should only be used if DataGuard is locked
+	 */
+	void UpdateWaveform_Internal(bool bAppended);
+
+	/**
+	 * Produce the compressed audio data in the background for the current PCM data if it is not yet cached
+	 */
+	void PrecacheCompressedAudio();
+
+	/**
+	 * Precache the compressed audio data once no frames have been appended for PrecacheAppendSettleTime seconds. Should only be used if DataGuard is locked
+	 */
+	void SchedulePrecacheCompressedAudio_Internal();
+
+	/**
+	 * Whether there are audio subscriptions (see SubscribeToAudio) or not. Lock-free
+	 */
+	bool HasAudioSubscriptions() const;
+
+	/**
+	 * Deliver the audio chunk to the audio subscriptions receiving the specified audio data
+	 *
+	 * @param Source The audio data the chunk belongs to
+	 * @param Chunk The chunk to deliver
+	 */
+	void DeliverAudioChunk(ERuntimeAudioSubscriptionSource Source, const FImportedSoundWaveAudioChunkPtr& Chunk);
+
+	/**
+	 * Broadcast the audio chunk to OnPopulateAudioData delegates asynchronously, if bound
+	 */
+	void BroadcastPopulatedAudioChunk(const FImportedSoundWaveAudioChunkPtr& Chunk);
+
+	/**
+	 * Get the immutable PCM data shared with the playback instances and duplicated sound waves, making it from the current PCM data if necessary
+	 * The snapshot shares the allocation of the PCM data (see FRuntimeBulkDataBuffer::Share), so no copy is made, neither now nor on the next append. Should only be used if DataGuard is locked
+	 */
+	FImportedSoundWavePCMSnapshotPtr GetPCMSnapshot_Internal();
+
+	/**
+	 * Replace the PCM data with the processed (resampled or mixed) one, keeping the playhead at the same time position. Should only be used if DataGuard is locked
+	 *
+	 * @param NewPCMInfo The processed PCM data
+	 * @param NewSampleRate The sample rate of the processed PCM data
+	 * @param NewNumOfChannels The number of channels of the processed PCM data
+	 */
+	void ReplaceProcessedPCMData_Internal(FPCMStruct&& NewPCMInfo, uint32 NewSampleRate, uint32 NewNumOfChannels);
+
+	/**
+	 * Resample and/or mix the PCM data on the calling thread without blocking the playback, then replace it (see ReplaceProcessedPCMData_Internal)
+	 * Frames appended during processing (e.g. by a streaming sound wave) are processed as well, while any other change to the PCM data restarts the processing
+	 *
+	 * @param NewSampleRate The sample rate to resample to
+	 * @param NewNumOfChannels The number of channels to mix to
+	 * @param Progress Delegate broadcasting the progress, 0-100%. Broadcast on the game thread
+	 * @return Whether the PCM data was processed and replaced or not
+	 */
+	bool ProcessPCMData(uint32 NewSampleRate, uint32 NewNumOfChannels, const FOnProcessAudioDataProgressNative& Progress);
+
+public:
+
 	/**
 	 * Retrieve audio header (metadata) information. Needed primarily for consistency with the RuntimeAudioImporterLibrary
 	 *
@@ -457,13 +779,77 @@ public:
 	TArray<float> GetPCMBufferCopy();
 
 	/**
-	 * Get immutable PCM buffer. Use DataGuard to make it thread safe
-	 * Use PopulateAudioDataFromDecodedInfo to populate it
+	 * Get the min/max/RMS summary of the audio data within the specified time range, e.g. to draw a waveform of the specified width in pixels
+	 * The summary is taken from a multi-resolution waveform kept up to date as the audio data is populated, so the PCM data is not read and the cost depends only on the number of peaks
 	 *
-	 * @return PCM buffer in 32-bit float format
+	 * @param StartTime The start of the time range, in seconds
+	 * @param EndTime The end of the time range, in seconds. Zero or less for the end of the audio data
+	 * @param NumOfPeaks The number of equal parts to split the time range into
+	 * @param OutPeaks The summaries of the parts
+	 * @return Whether the summary was retrieved or not
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Imported Sound Wave|Info")
+	bool GetWaveformPeaks(float StartTime, float EndTime, int32 NumOfPeaks, TArray<FRuntimeAudioWaveformPeak>& OutPeaks) const;
+
+	/**
+	 * Retrieve a range of frames of the PCM buffer, completely thread-safe. Only the requested range is copied. Suitable for use in Blueprints
+	 *
+	 * @param StartFrame Index of the first frame to retrieve
+	 * @param NumOfFrames The maximum number of frames to retrieve. Clamped to the end of the PCM buffer
+	 * @param ChannelIndex Index of the channel to retrieve, or -1 to retrieve all channels interleaved
+	 * @return PCM data in 32-bit float format. Empty if the range or the channel is out of bounds
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Imported Sound Wave|Info", meta = (DisplayName = "Get PCM Buffer Range"))
+	TArray<float> GetPCMBufferRange(int64 StartFrame, int64 NumOfFrames, int32 ChannelIndex = -1);
+
+	/**
+	 * Copy a range of frames of the PCM buffer into the caller-provided memory, converting them to 32-bit float if necessary. Completely thread-safe
+	 * The data guard is only held while copying the requested range
+	 *
+	 * @param StartFrame Index of the first frame to read
+	 * @param NumOfFrames The maximum number of frames to read. Clamped to the end of the PCM buffer
+	 * @param OutPCMData Pointer to memory location to read to. Must have space for NumOfFrames frames of the read channels
+	 * @param ChannelIndex Index of the channel to read, or INDEX_NONE to read all channels interleaved
+	 * @return The number of frames read, or -1 if the range or the channel is out of bounds
+	 */
+	int64 ReadPCMFrames(int64 StartFrame, int64 NumOfFrames, float* OutPCMData, int32 ChannelIndex = INDEX_NONE) const;
+
+	/**
+	 * Copy a range of frames of the PCM buffer into the caller-provided memory, converting them to 16-bit integer if necessary. Completely thread-safe
+	 * The data guard is only held while copying the requested range
+	 *
+	 * @param StartFrame Index of the first frame to read
+	 * @param NumOfFrames The maximum number of frames to read. Clamped to the end of the PCM buffer
+	 * @param OutPCMData Pointer to memory location to read to. Must have space for NumOfFrames frames of the read channels
+	 * @param ChannelIndex Index of the channel to read, or INDEX_NONE to read all channels interleaved
+	 * @return The number of frames read, or -1 if the range or the channel is out of bounds
+	 */
+	int64 ReadPCMFrames(int64 StartFrame, int64 NumOfFrames, int16* OutPCMData, int32 ChannelIndex = INDEX_NONE) const;
+
+	/**
+	 * Acquire a read lease on the PCM buffer, which gives zero-copy access to the PCM data without holding the data guard for as long as the lease is kept
+	 * The lease pins the PCM data as it is now. The PCM data is not copied, neither to acquire the lease nor to append to the sound wave while the lease is alive
+	 *
+	 * @return The read lease. Invalid if there is no PCM data
+	 */
+	FImportedSoundWavePCMReadLease AcquirePCMReadLease();
+
+	/**
+	 * Get immutable PCM buffer. Use DataGuard to make it thread safe, and do not keep the reference after unlocking it
+	 * Use PopulateAudioDataFromDecodedInfo to populate it. Prefer ReadPCMFrames or AcquirePCMReadLease, which do not require locking the data guard
+	 *
+	 * @return PCM buffer in the storage format of the sound wave (see SetPCMStorageFormat)
 	 */
 	const FPCMStruct& GetPCMBuffer() const;
 
+	/**
+	 * Get the PCM source, which allows reading the PCM data directly from any thread without copying it
+	 * The PCM source stays valid (and keeps the PCM data alive) even after the sound wave is destroyed
+	 *
+	 * @return The PCM source shared with the sound wave
+	 */
+	TSharedPtr<FImportedSoundWavePCMSource> GetPCMSource() const;
+
 	/**
 	 * Get audio format of the audio imported into the sound wave
 	 * @return Audio format
@@ -481,9 +867,20 @@ protected:
 	/** The number of frames played. Increments during playback, should not be > PCMBufferInfo.PCMNumOfFrames */
 	uint32 PlayedNumOfFrames;
 
+	/** The number of sources the audio mixer is generating audio for from this sound wave. Updated from the audio render threads without locking */
+	std::atomic<int32> NumOfActivePlaybacks;
+
+	/**
+	 * Decrement the number of active playbacks once the audio mixer stops generating audio for a source, never going below zero
+	 */
+	void EndActivePlayback();
+
 	/** Contains PCM data for sound wave playback */
 	TSharedPtr<FPCMStruct> PCMBufferInfo;
 
+	/** PCM data along with its format for reading outside of the sound wave (see GetPCMSource) */
+	TSharedPtr<FImportedSoundWavePCMSource> PCMSource;
+
 	/** Whether to stop the sound at the end of playback or not. Sound wave will not be garbage collected if playback was completed while this parameter is set to false */
 	bool bStopSoundOnPlaybackFinish;
 
@@ -495,4 +892,55 @@ protected:
 
 	/** Initial desired number of channels of the sound wave (see SetInitialDesiredNumChannels) */
 	TOptional<uint32> InitialDesiredNumOfChannels;
+
+	/** Cache of the compressed audio data used to initialize the audio resource. Shared with the duplicated sound waves until the PCM data of either changes (see DuplicateSoundWave) */
+	TSharedPtr<FRuntimeCompressedAudioCache, ESPMode::ThreadSafe> CompressedAudioCache;
+
+	/** Revision of the compressed audio cache from which the audio resource was initialized. Zero if the audio resource has not been initialized */
+	uint64 AudioResourceRevision;
+
+	/** Whether to precache the compressed audio data in the background every time the PCM data changes (see SetPrecacheCompressedAudio) */
+	bool bPrecacheCompressedAudio;
+
+	/** Whether precaching of the compressed audio data is postponed until frames stop being appended (see SchedulePrecacheCompressedAudio_Internal) */
+	bool bPrecacheScheduled;
+
+	/** Time of the last append of frames while precaching is enabled, sec */
+	double LastPCMAppendTime;
+
+	/** How long no frames must be appended before the postponed precaching of the compressed audio data starts, sec */
+	static constexpr float PrecacheAppendSettleTime = 0.5f;
+
+	/** The format in which the PCM data is stored (see SetPCMStorageFormat) */
+	ERuntimePCMStorageFormat PCMStorageFormat;
+
+	/** Whether every playback of the sound wave gets its own playback instance or not (see SetPlaybackInstancing) */
+	bool bPlaybackInstancing;
+
+	/** Whether the sound wave is played in reverse or not (see SetReversePlayback) */
+	bool bReversePlayback;
+
+	/** The immutable PCM data shared with the playback instances and duplicated sound waves. Reset every time the PCM data changes */
+	FImportedSoundWavePCMSnapshotPtr PCMSnapshot;
+
+	/** Incremented every time the PCM data changes other than by appending to it, so that processing can tell appended frames apart from replaced ones (see ProcessPCMData) */
+	uint64 PCMDataGeneration;
+
+	/** Multi-resolution min/max/RMS summary of the PCM data (see GetWaveformPeaks). Guarded by DataGuard */
+	FRuntimeAudioWaveformPyramid WaveformPyramid;
+
+	/** Data guard (mutex) for the audio subscriptions. Only held while pushing the chunk handles, never while the subscribers run */
+	mutable FCriticalSection AudioSubscriptions_DataGuard;
+
+	/** The audio subscriptions made with SubscribeToAudio. Expired ones are removed on the next delivery */
+	TArray<TWeakPtr<FImportedSoundWaveAudioSubscription, ESPMode::ThreadSafe>> AudioSubscriptions;
+
+	/** The number of audio subscriptions, to skip making the chunks without locking if there are none */
+	std::atomic<int32> NumOfAudioSubscriptions;
+
+	/** Data guard (mutex) for reading the spectrum analyzer outside of rendering. Only held while copying the pointer. The analyzer is changed with both this and DataGuard locked */
+	mutable FCriticalSection SpectrumAnalyzer_DataGuard;
+
+	/** The spectrum analyzer the rendered frames are tapped into (see EnableSpectrumAnalysis). Read under DataGuard when rendering */
+	TSharedPtr<FRuntimeAudioSpectrumAnalyzer, ESPMode::ThreadSafe> SpectrumAnalyzer;
 };
@@ -0,0 +1,205 @@
+// Georgy Treshchev 2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RuntimeAudioImporterTypes.h"
+#include "Templates/SharedPointer.h"
+#include "Templates/UniquePtr.h"
+#include <atomic>
+
+/** Immutable chunk of interleaved 32-bit float PCM data, shared by the subscribers it is delivered to (and the delegates) without copying */
+struct RUNTIMEAUDIOIMPORTER_API FImportedSoundWaveAudioChunk
+{
+	FImportedSoundWaveAudioChunk(FRuntimeBulkDataBuffer<float>&& InPCMData, uint32 InSampleRate, uint32 InNumOfChannels, int64 InStartFrame)
+		: PCMData(MoveTemp(InPCMData))
+	  , SampleRate(InSampleRate)
+	  , NumOfChannels(InNumOfChannels)
+	  , StartFrame(InStartFrame)
+	{
+	}
+
+	/**
+	 * Get the number of frames in the chunk
+	 */
+	int64 GetNumOfFrames() const
+	{
+		return NumOfChannels > 0 ? PCMData.GetView().Num() / NumOfChannels : 0;
+	}
+
+	/** Interleaved 32-bit float PCM data */
+	const FRuntimeBulkDataBuffer<float> PCMData;
+
+	/** Sample rate of the PCM data */
+	const uint32 SampleRate;
+
+	/** Number of channels of the PCM data */
+	const uint32 NumOfChannels;
+
+	/** Position of the first frame of the chunk: the number of frames populated (or played, for generated chunks) before it */
+	const int64 StartFrame;
+};
+
+/** Ref-counted handle to an immutable audio chunk */
+using FImportedSoundWaveAudioChunkPtr = TSharedPtr<const FImportedSoundWaveAudioChunk, ESPMode::ThreadSafe>;
+
+/** The audio data an audio subscription receives */
+enum class ERuntimeAudioSubscriptionSource : uint8
+{
+	/** The audio data populated into the sound wave, the same as OnPopulateAudioData */
+	Populated,
+
+	/** The audio data generated for playback, the same as OnGeneratePCMData */
+	Generated
+};
+
+/** What happens to a new chunk delivered to an audio subscription whose ring is full */
+enum class ERuntimeAudioSubscriptionOverflowPolicy : uint8
+{
+	/** Drop the oldest unread chunk to make room for the new one. Suitable for visualizers, which only need the latest audio data */
+	DropOldest,
+
+	/** Drop the new chunk. Suitable for consumers that need contiguous audio data and can detect the gap from the dropped chunks counter */
+	DropNewest
+};
+
+/** Lag metrics of an audio subscription */
+struct RUNTIMEAUDIOIMPORTER_API FImportedSoundWaveAudioSubscriptionStats
+{
+	/** The number of chunks delivered to the subscription, including the dropped ones */
+	int64 NumOfDeliveredChunks = 0;
+
+	/** The number of chunks read by the subscriber */
+	int64 NumOfReadChunks = 0;
+
+	/** The number of chunks dropped because the ring was full */
+	int64 NumOfDroppedChunks = 0;
+
+	/** The number of frames in the dropped chunks */
+	int64 NumOfDroppedFrames = 0;
+
+	/** The number of chunks waiting to be read */
+	int32 NumOfPendingChunks = 0;
+
+	/** The highest number of chunks that have been waiting to be read at once */
+	int32 MaxNumOfPendingChunks = 0;
+
+	/** The number of frames waiting to be read */
+	int64 NumOfPendingFrames = 0;
+
+	/** How far the subscriber is behind the sound wave, in seconds: the duration of the frames waiting to be read */
+	float LagSeconds = 0;
+};
+
+/**
+ * Subscription to the audio data of an imported sound wave, an alternative to OnPopulateAudioData and OnGeneratePCMData that does not copy or allocate per subscriber
+ * Every chunk is made once, as an immutable ref-counted handle, and pushed into a bounded lock-free ring of each subscription. The subscriber reads the chunks whenever it suits it
+ * Created by UImportedSoundWave::SubscribeToAudio. The subscription ends when UImportedSoundWave::UnsubscribeFromAudio is called or the last reference to it is released
+ *
+ * @note Delivering and reading can happen on any threads concurrently
+ */
+class RUNTIMEAUDIOIMPORTER_API FImportedSoundWaveAudioSubscription
+{
+public:
+	/**
+	 * @param InSource The audio data to receive
+	 * @param InCapacity The maximum number of unread chunks. Rounded up to a power of two
+	 * @param InOverflowPolicy What happens to a new chunk if the ring is full
+	 */
+	FImportedSoundWaveAudioSubscription(ERuntimeAudioSubscriptionSource InSource, int32 InCapacity, ERuntimeAudioSubscriptionOverflowPolicy InOverflowPolicy);
+	~FImportedSoundWaveAudioSubscription();
+
+	FImportedSoundWaveAudioSubscription(const FImportedSoundWaveAudioSubscription&) = delete;
+	FImportedSoundWaveAudioSubscription& operator=(const FImportedSoundWaveAudioSubscription&) = delete;
+
+	/**
+	 * Read the oldest unread chunk
+	 *
+	 * @param OutChunk The chunk read
+	 * @return Whether there was a chunk to read or not
+	 */
+	bool Read(FImportedSoundWaveAudioChunkPtr& OutChunk);
+
+	/**
+	 * Read all unread chunks, oldest first
+	 *
+	 * @param OutChunks The chunks read are appended to this array
+	 * @return The number of chunks read
+	 */
+	int32 ReadAll(TArray<FImportedSoundWaveAudioChunkPtr>& OutChunks);
+
+	/**
+	 * Deliver the chunk to the subscriber, dropping a chunk according to the overflow policy if the ring is full
+	 */
+	void Deliver(const FImportedSoundWaveAudioChunkPtr& Chunk);
+
+	/**
+	 * Get the lag metrics of the subscription
+	 */
+	FImportedSoundWaveAudioSubscriptionStats GetStats() const;
+
+	/**
+	 * Get the audio data the subscription receives
+	 */
+	ERuntimeAudioSubscriptionSource GetSource() const { return Source; }
+
+	/**
+	 * Get the maximum number of unread chunks
+	 */
+	int32 GetCapacity() const { return static_cast<int32>(Mask + 1); }
+
+	/**
+	 * Whether the subscription has been ended by the sound wave (see UImportedSoundWave::UnsubscribeFromAudio) or not. No more chunks are delivered to an ended subscription
+	 */
+	bool IsActive() const { return bActive.load(std::memory_order_relaxed); }
+
+	/**
+	 * End the subscription. The unread chunks can still be read
+	 */
+	void Deactivate() { bActive.store(false, std::memory_order_relaxed); }
+
+private:
+	/** A slot of the ring. The sequence tells whether the slot is ready to be written or read at a given position (bounded MPMC queue by Dmitry Vyukov) */
+	struct FSlot
+	{
+		std::atomic<uint64> Sequence;
+		FImportedSoundWaveAudioChunkPtr Chunk;
+	};
+
+	/**
+	 * Push the chunk into the ring. Fails if the ring is full
+	 */
+	bool TryPush(const FImportedSoundWaveAudioChunkPtr& Chunk);
+
+	/**
+	 * Pop the oldest chunk from the ring. Fails if the ring is empty
+	 * Both the subscriber and the delivering thread (to drop the oldest chunk) may pop, so popping is safe from multiple threads
+	 */
+	bool TryPop(FImportedSoundWaveAudioChunkPtr& OutChunk);
+
+	const ERuntimeAudioSubscriptionSource Source;
+	const ERuntimeAudioSubscriptionOverflowPolicy OverflowPolicy;
+
+	/** The slots of the ring. The number of slots is a power of two */
+	TUniquePtr<FSlot[]> Slots;
+
+	/** The number of slots minus one */
+	const uint64 Mask;
+
+	/** The position of the next chunk to push */
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> PushPosition;
+
+	/** The position of the next chunk to pop */
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> PopPosition;
+
+	std::atomic<bool> bActive;
+
+	/** Lag metrics */
+	std::atomic<int64> NumOfDeliveredChunks;
+	std::atomic<int64> NumOfReadChunks;
+	std::atomic<int64> NumOfDroppedChunks;
+	std::atomic<int64> NumOfDroppedFrames;
+	std::atomic<int64> NumOfPendingFrames;
+	std::atomic<int32> MaxNumOfPendingChunks;
+	std::atomic<uint32> LastSampleRate;
+};
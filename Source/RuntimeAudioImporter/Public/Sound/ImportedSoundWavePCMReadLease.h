@@ -0,0 +1,121 @@
+// Georgy Treshchev 2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RuntimeAudioImporterTypes.h"
+#include "Sound/ImportedSoundWavePlaybackInstance.h"
+
+/**
+ * Read lease on the PCM data of an imported sound wave, giving zero-copy access to it without holding the data guard
+ * The lease pins the immutable PCM data the sound wave had when the lease was acquired: populating, appending or processing the audio data later does not affect it, and the PCM data is only freed once both the sound wave and all leases are done with it
+ * Acquired by UImportedSoundWave::AcquirePCMReadLease. Cheap to copy and move, and safe to use on any thread
+ */
+class RUNTIMEAUDIOIMPORTER_API FImportedSoundWavePCMReadLease
+{
+public:
+	/** Constructs an invalid lease */
+	FImportedSoundWavePCMReadLease();
+
+	/**
+	 * @param InPCMSnapshot The immutable PCM data to pin
+	 * @param InSampleRate The sample rate of the PCM data
+	 * @param InNumOfChannels The number of channels of the PCM data
+	 */
+	FImportedSoundWavePCMReadLease(FImportedSoundWavePCMSnapshotPtr InPCMSnapshot, uint32 InSampleRate, uint32 InNumOfChannels);
+
+	/**
+	 * Whether the lease pins any PCM data or not
+	 */
+	bool IsValid() const;
+
+	/**
+	 * Release the pinned PCM data early, making the lease invalid
+	 */
+	void Release();
+
+	/**
+	 * Get the format the pinned PCM data is stored in
+	 */
+	ERuntimePCMStorageFormat GetStorageFormat() const;
+
+	/**
+	 * Get the pinned PCM data if it is stored as 32-bit float, without copying
+	 *
+	 * @return Interleaved 32-bit float PCM data, or an empty view if it is stored in a different format
+	 */
+	TArrayView<const float> GetFloatPCMData() const;
+
+	/**
+	 * Get the pinned PCM data if it is stored as 16-bit integer, without copying
+	 *
+	 * @return Interleaved 16-bit integer PCM data, or an empty view if it is stored in a different format
+	 */
+	TArrayView<const int16> GetInt16PCMData() const;
+
+	/**
+	 * Reference the pinned PCM data without copying it, e.g. to pass it to a codec. The returned PCM data keeps the pinned PCM data alive on its own
+	 *
+	 * @return The PCM data referenced as externally owned, in the format it is stored in. Empty if the lease is invalid
+	 */
+	FPCMStruct SharePCMData() const;
+
+	/**
+	 * Copy a range of frames of the pinned PCM data into the caller-provided memory, converting them to 32-bit float if necessary
+	 *
+	 * @param StartFrame Index of the first frame to read
+	 * @param NumOfFrames The maximum number of frames to read. Clamped to the end of the PCM data
+	 * @param OutPCMData Pointer to memory location to read to. Must have space for NumOfFrames frames of the read channels
+	 * @param ChannelIndex Index of the channel to read, or INDEX_NONE to read all channels interleaved
+	 * @return The number of frames read, or -1 if the lease is invalid or the range or the channel is out of bounds
+	 */
+	int64 ReadFrames(int64 StartFrame, int64 NumOfFrames, float* OutPCMData, int32 ChannelIndex = INDEX_NONE) const;
+
+	/**
+	 * Copy a range of frames of the pinned PCM data into the caller-provided memory, converting them to 16-bit integer if necessary
+	 *
+	 * @param StartFrame Index of the first frame to read
+	 * @param NumOfFrames The maximum number of frames to read. Clamped to the end of the PCM data
+	 * @param OutPCMData Pointer to memory location to read to. Must have space for NumOfFrames frames of the read channels
+	 * @param ChannelIndex Index of the channel to read, or INDEX_NONE to read all channels interleaved
+	 * @return The number of frames read, or -1 if the lease is invalid or the range or the channel is out of bounds
+	 */
+	int64 ReadFrames(int64 StartFrame, int64 NumOfFrames, int16* OutPCMData, int32 ChannelIndex = INDEX_NONE) const;
+
+	/**
+	 * Get the number of frames of the pinned PCM data
+	 */
+	int64 GetNumOfFrames() const;
+
+	/**
+	 * Get the sample rate of the pinned PCM data
+	 */
+	uint32 GetSampleRate() const { return SampleRate; }
+
+	/**
+	 * Get the number of channels of the pinned PCM data
+	 */
+	uint32 GetNumOfChannels() const { return NumOfChannels; }
+
+	/**
+	 * Clamp a range of frames to the specified PCM data, validating the channel
+	 *
+	 * @param PCMInfo The PCM data to read from
+	 * @param NumOfChannels The number of channels of the PCM data
+	 * @param StartFrame Index of the first frame to read
+	 * @param NumOfFrames The maximum number of frames to read
+	 * @param ChannelIndex Index of the channel to read, or INDEX_NONE for all channels
+	 * @return The number of frames that can be read, or -1 if the range or the channel is out of bounds
+	 */
+	static int64 ClampFrameRange(const FPCMStruct& PCMInfo, uint32 NumOfChannels, int64 StartFrame, int64 NumOfFrames, int32 ChannelIndex);
+
+private:
+	/** The pinned PCM data */
+	FImportedSoundWavePCMSnapshotPtr PCMSnapshot;
+
+	/** Sample rate of the PCM data */
+	uint32 SampleRate;
+
+	/** Number of channels of the PCM data */
+	uint32 NumOfChannels;
+};
@@ -0,0 +1,145 @@
+// Georgy Treshchev 2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RuntimeAudioImporterTypes.h"
+#include "Templates/SharedPointer.h"
+#include <atomic>
+
+// Sound generator support is only available in UE 5.0 and later
+#define WITH_RUNTIMEAUDIOIMPORTER_PLAYBACK_INSTANCE_GENERATOR_SUPPORT !UE_VERSION_OLDER_THAN(5, 0, 0)
+
+#if WITH_RUNTIMEAUDIOIMPORTER_PLAYBACK_INSTANCE_GENERATOR_SUPPORT
+#include "Sound/SoundGenerator.h"
+#endif
+
+/** Immutable PCM data shared between the playback instances of an imported sound wave */
+using FImportedSoundWavePCMSnapshotPtr = TSharedPtr<const FPCMStruct, ESPMode::ThreadSafe>;
+
+/**
+ * Lightweight playback instance of an imported sound wave: an independent playhead (position, looping and finish state) over the immutable PCM data shared with the sound wave and all other instances
+ * Creating and destroying an instance only allocates the instance itself, and it can be done on any thread. Rendering does not take any locks
+ * Created by UImportedSoundWave::CreatePlaybackInstance, or by the audio mixer for every playback of a sound wave with playback instancing enabled (see UImportedSoundWave::SetPlaybackInstancing)
+ *
+ * @note Rendering must happen on a single thread at a time (e.g. the audio render thread). The playback state can be queried and changed from any thread
+ */
+class RUNTIMEAUDIOIMPORTER_API FImportedSoundWavePlaybackInstance
+#if WITH_RUNTIMEAUDIOIMPORTER_PLAYBACK_INSTANCE_GENERATOR_SUPPORT
+	: public ISoundGenerator
+#endif
+{
+public:
+	/**
+	 * @param InPCMSnapshot The immutable PCM data to play back
+	 * @param InSampleRate The sample rate of the PCM data
+	 * @param InNumOfChannels The number of channels of the PCM data
+	 * @param bInLoop Whether to loop the playback or not
+	 * @param bInReverse Whether to play the PCM data in reverse or not. A reverse playback starts from the end of the PCM data
+	 */
+	FImportedSoundWavePlaybackInstance(FImportedSoundWavePCMSnapshotPtr InPCMSnapshot, uint32 InSampleRate, uint32 InNumOfChannels, bool bInLoop, bool bInReverse = false);
+
+#if WITH_RUNTIMEAUDIOIMPORTER_PLAYBACK_INSTANCE_GENERATOR_SUPPORT
+	//~ Begin ISoundGenerator Interface
+	virtual int32 OnGenerateAudio(float* OutAudio, int32 NumSamples) override;
+	//~ End ISoundGenerator Interface
+#endif
+
+	/**
+	 * Render the next interleaved 32-bit float PCM samples and advance the playhead. The samples past the end of a non-looping playback are filled with silence
+	 *
+	 * @param OutAudio Pointer to memory location to render to. Must have space for NumSamples samples
+	 * @param NumSamples Number of samples to render (number of frames multiplied by the number of channels)
+	 * @return Number of samples rendered, including the silence
+	 */
+	int32 Render(float* OutAudio, int32 NumSamples);
+
+	/**
+	 * Whether the playback has reached the end (never true for a looping playback) or has been stopped
+	 */
+	virtual bool IsFinished() const
+#if WITH_RUNTIMEAUDIOIMPORTER_PLAYBACK_INSTANCE_GENERATOR_SUPPORT
+	override
+#endif
+	;
+
+	/**
+	 * Stop the playback. A stopped instance renders silence until it is rewound
+	 */
+	void Stop();
+
+	/**
+	 * Set whether to loop the playback or not
+	 */
+	void SetLooping(bool bInLoop);
+
+	/**
+	 * Whether the playback is looped or not
+	 */
+	bool IsLooping() const;
+
+	/**
+	 * Set whether to play the PCM data in reverse or not. The playback continues from the same position in the opposite direction
+	 */
+	void SetReverse(bool bInReverse);
+
+	/**
+	 * Whether the PCM data is played in reverse or not
+	 */
+	bool IsReverse() const;
+
+	/**
+	 * Move the playhead to the specified time and resume the playback if it has finished
+	 *
+	 * @param PlaybackTime The time to continue playing from (backwards if playing in reverse), in seconds
+	 * @return Whether the playhead was moved or not
+	 */
+	bool RewindPlaybackTime(float PlaybackTime);
+
+	/**
+	 * Get the current playback time, in seconds
+	 */
+	float GetPlaybackTime() const;
+
+	/**
+	 * Get the position of the playhead in the PCM data, in frames. Decreases when playing in reverse
+	 */
+	uint32 GetNumOfPlayedFrames() const;
+
+	/**
+	 * Get the length of the PCM data, in seconds
+	 */
+	float GetDuration() const;
+
+	/**
+	 * Get the sample rate of the PCM data
+	 */
+	uint32 GetSampleRate() const;
+
+	/**
+	 * Get the number of channels of the PCM data
+	 */
+	uint32 GetNumOfChannels() const;
+
+private:
+	/** The immutable PCM data shared with the sound wave and other instances */
+	const FImportedSoundWavePCMSnapshotPtr PCMSnapshot;
+
+	/** Sample rate of the PCM data */
+	const uint32 SampleRate;
+
+	/** Number of channels of the PCM data */
+	const uint32 NumOfChannels;
+
+	/** The position of the playhead in the PCM data, in frames */
+	std::atomic<uint32> PlayedNumOfFrames;
+
+	/** Whether to loop the playback or not */
+	std::atomic<bool> bLoop;
+
+	/** Whether to play the PCM data in reverse or not */
+	std::atomic<bool> bReverse;
+
+	/** Whether the playback has finished or not */
+	std::atomic<bool> bFinished;
+};
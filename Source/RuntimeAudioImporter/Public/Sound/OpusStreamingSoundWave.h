@@ -0,0 +1,83 @@
+﻿// Georgy Treshchev 2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StreamingSoundWave.h"
+#include "Codecs/OPUS_RuntimePacketCodec.h"
+#include "OpusStreamingSoundWave.generated.h"
+
+/**
+ * Streaming sound wave fed with raw Opus packets (no Ogg framing) received in real time, e.g. voice sent over the network with FOPUS_RuntimePacketEncoder
+ * The packets pass through a reorder/jitter buffer, so that they are decoded in order, and lost packets are recovered from the FEC data of the next packets or concealed
+ */
+UCLASS(BlueprintType, Category = "Opus Streaming Sound Wave")
+class RUNTIMEAUDIOIMPORTER_API UOpusStreamingSoundWave : public UStreamingSoundWave
+{
+	GENERATED_BODY()
+
+public:
+	UOpusStreamingSoundWave(const FObjectInitializer& ObjectInitializer);
+
+	/**
+	 * Create a new instance of the Opus streaming sound wave
+	 *
+	 * @return Created Opus streaming sound wave
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Opus Streaming Sound Wave|Main")
+	static UOpusStreamingSoundWave* CreateOpusStreamingSoundWave();
+
+	/**
+	 * Start a new stream of Opus packets, discarding the packets held from the previous one
+	 *
+	 * @param InSampleRate The sample rate to decode to. Must be 8000, 12000, 16000, 24000 or 48000
+	 * @param NumOfChannels The number of channels to decode to. Must be 1 or 2
+	 * @param JitterBufferDepth The number of packets to wait for a missing packet before declaring it lost. Each packet adds its duration (usually 20ms) of latency
+	 * @return Whether the stream was successfully started or not
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Opus Streaming Sound Wave|Append")
+	bool StartOpusStream(int32 InSampleRate = 48000, int32 NumOfChannels = 1, int32 JitterBufferDepth = 3);
+
+	/**
+	 * Append a received Opus packet. The packets may arrive out of order, lost or duplicated
+	 *
+	 * @param SequenceNumber The number of the packet, incremented by one per packet by the sender
+	 * @param Packet The packet
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Opus Streaming Sound Wave|Append")
+	void AppendOpusPacket(int64 SequenceNumber, TArray<uint8> Packet);
+
+	/**
+	 * Finish the stream of Opus packets, decoding the packets held without waiting for the missing ones
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Opus Streaming Sound Wave|Append")
+	void FinishOpusStream();
+
+	/**
+	 * Get the statistics of the stream of Opus packets
+	 *
+	 * @param NumOfReceivedPackets The number of packets appended
+	 * @param NumOfLatePackets The number of packets dropped as they arrived after their turn to be decoded had passed
+	 * @param NumOfRecoveredPackets The number of lost packets recovered from the FEC data of the next packet
+	 * @param NumOfConcealedPackets The number of lost packets concealed
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Opus Streaming Sound Wave|Info")
+	void GetOpusStreamStatistics(int64& NumOfReceivedPackets, int64& NumOfLatePackets, int64& NumOfRecoveredPackets, int64& NumOfConcealedPackets) const;
+
+	/**
+	 * Get all the statistics of the jitter buffer. Suitable for use in C++
+	 */
+	FOPUS_RuntimeJitterBufferStats GetJitterBufferStats() const;
+
+protected:
+	/**
+	 * Decode the packets whose turn has come and append them. Runs on the audio task pipe
+	 */
+	void PopulateAudioDataFromJitterBuffer(bool bFlush);
+
+	/** Data guard (mutex) for the jitter buffer */
+	mutable FCriticalSection JitterBufferGuard;
+
+	/** The jitter buffer the packets are held in until decoded. Is valid only after the stream is started */
+	TUniquePtr<FOPUS_RuntimeJitterBuffer> JitterBuffer;
+};
@@ -6,9 +6,14 @@
 #include "ImportedSoundWave.h"
 #include "Delegates/Delegate.h"
 #include "Containers/Queue.h"
+#include "Async/Future.h"
+#include "Codecs/RuntimeEncoderSession.h"
+#include "Codecs/RuntimeDecoderSession.h"
+#include <atomic>
 #include "StreamingSoundWave.generated.h"
 
 class URuntimeVoiceActivityDetector;
+class FRuntimeAudioRingBuffer;
 
 /** Static delegate broadcast the result of audio data pre-allocation */
 DECLARE_DELEGATE_OneParam(FOnPreAllocateAudioDataResultNative, bool);
@@ -16,6 +21,12 @@ DECLARE_DELEGATE_OneParam(FOnPreAllocateAudioDataResultNative, bool);
 /** Dynamic delegate broadcast the result of audio data pre-allocation */
 DECLARE_DYNAMIC_DELEGATE_OneParam(FOnPreAllocateAudioDataResult, bool, bSucceeded);
 
+/** Static delegate broadcast the result of finishing encoding to a file */
+DECLARE_DELEGATE_OneParam(FOnStopEncodingToFileResultNative, bool);
+
+/** Dynamic delegate broadcast the result of finishing encoding to a file */
+DECLARE_DYNAMIC_DELEGATE_OneParam(FOnStopEncodingToFileResult, bool, bSucceeded);
+
 /** Static delegate broadcast when the VAD detects the start of speech */
 DECLARE_MULTICAST_DELEGATE(FOnStreamingSpeechStartedNative);
 
@@ -28,6 +39,32 @@ DECLARE_MULTICAST_DELEGATE(FOnStreamingSpeechEndedNative);
 /** Dynamic delegate broadcast when the VAD detects the end of speech */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnStreamingSpeechEnded);
 
+/**
+ * Audio data queued for appending to a streaming sound wave (see UStreamingSoundWave::AppendAudioDataFromEncoded and UStreamingSoundWave::AppendAudioDataFromRAW)
+ */
+struct FStreamingSoundWaveAppendRequest
+{
+	FStreamingSoundWaveAppendRequest()
+		: bEncoded(false)
+	  , AudioFormat(ERuntimeAudioFormat::Auto)
+	  , RAWFormat(ERuntimeRAWAudioFormat::Float32)
+	  , SampleRate(0)
+	  , NumOfChannels(0)
+	{
+	}
+
+	/** Encoded or RAW audio data */
+	TArray<uint8> AudioData;
+
+	/** Whether the audio data is encoded (AudioFormat) or RAW (RAWFormat, SampleRate and NumOfChannels) */
+	bool bEncoded;
+
+	ERuntimeAudioFormat AudioFormat;
+	ERuntimeRAWAudioFormat RAWFormat;
+	int32 SampleRate;
+	int32 NumOfChannels;
+};
+
 /**
  * Streaming sound wave. Can append audio data dynamically, including during playback.
  * It will live indefinitely, even if the sound wave has finished playing, until SetStopSoundOnPlaybackFinish is called.
@@ -41,6 +78,11 @@ class RUNTIMEAUDIOIMPORTER_API UStreamingSoundWave : public UImportedSoundWave
 public:
 	UStreamingSoundWave(const FObjectInitializer& ObjectInitializer);
 
+	//~ Begin UObject Interface
+	virtual void BeginDestroy() override;
+	virtual bool IsReadyForFinishDestroy() override;
+	//~ End UObject Interface
+
 	/**
 	 * Create a new instance of the streaming sound wave
 	 *
@@ -75,6 +117,23 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Streaming Sound Wave|Append")
 	void AppendAudioDataFromEncoded(TArray<uint8> AudioData, ERuntimeAudioFormat AudioFormat);
 
+	/**
+	 * Append a slice of an encoded stream to the end of existing data, e.g. as it is downloaded or read from a pipe
+	 * Unlike AppendAudioDataFromEncoded, the slices may be cut at arbitrary bytes: the decoder state is kept between appends, and incomplete frames or pages are held until the next slice,
+	 * so each append only decodes the frames it completes. Supported for MP3, OGG Vorbis and OGG Opus streams. Call FinishEncodedStream once the stream has ended
+	 *
+	 * @param AudioData The slice of the encoded stream
+	 * @param AudioFormat Audio format of the stream. Only taken into account for the first slice. If Auto, it is detected from the first slice
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Streaming Sound Wave|Append")
+	void AppendAudioDataFromEncodedStream(TArray<uint8> AudioData, ERuntimeAudioFormat AudioFormat);
+
+	/**
+	 * Finish the encoded stream appended with AppendAudioDataFromEncodedStream, appending whatever is left of it. The next appended slice starts a new stream
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Streaming Sound Wave|Append")
+	void FinishEncodedStream();
+
 	/**
 	 * Append audio data to the end of existing data from RAW audio data
 	 *
@@ -86,6 +145,16 @@ public:
 	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Append Audio Data From RAW"), Category = "Streaming Sound Wave|Append")
 	void AppendAudioDataFromRAW(UPARAM(DisplayName = "RAW Data") TArray<uint8> RAWData, UPARAM(DisplayName = "RAW Format") ERuntimeRAWAudioFormat RAWFormat, UPARAM(DisplayName = "Sample Rate") int32 InSampleRate = 44100, int32 NumOfChannels = 1);
 
+	/**
+	 * Get the number of audio tasks launched and the number of audio data chunks appended so far
+	 * Appends made while a previous append is still queued are drained together by a single task, so the first number is normally much lower than the second one
+	 *
+	 * @param NumOfTasksLaunched The number of tasks launched on the audio task pipe
+	 * @param NumOfChunksAppended The number of AppendAudioDataFromEncoded and AppendAudioDataFromRAW calls processed
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Streaming Sound Wave|Info")
+	void GetAppendStatistics(int64& NumOfTasksLaunched, int64& NumOfChunksAppended) const;
+
 	/**
 	 * Set whether the sound should stop after playback is complete or not (play "blank sound"). False by default
 	 * Setting it to True also makes the sound wave eligible for garbage collection after it has finished playing
@@ -93,6 +162,50 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Streaming Sound Wave|Import")
 	void SetStopSoundOnPlaybackFinish(bool bStop);
 
+	/**
+	 * Start encoding the audio data appended from now on directly to a file, as it arrives (e.g. while capturing)
+	 * The encoded data is written as soon as it is produced, so the memory usage does not grow with the duration and the file is ready once StopEncodingToFile finishes
+	 *
+	 * @param FilePath Path to the file to write the encoded audio data to
+	 * @param AudioFormat The format to encode the audio data to. Must not be Auto, Mp3, Flac or Custom
+	 * @param Quality The quality of the encoded audio data. From 0 to 100
+	 * @return Whether encoding was successfully started or not
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Streaming Sound Wave|Export")
+	bool StartEncodingToFile(const FString& FilePath, ERuntimeAudioFormat AudioFormat, uint8 Quality = 100);
+
+	/**
+	 * Start encoding the audio data appended from now on using the specified encoder session. Suitable for use in C++
+	 * The session is begun with the sample rate and the number of channels of the sound wave once the first audio data is appended
+	 *
+	 * @param Session The encoder session that has not been begun yet
+	 * @param Sink The sink to write the encoded audio data to (e.g. FRuntimeFileHandleAudioSink)
+	 * @param Quality The quality of the encoded audio data. From 0 to 100
+	 * @return Whether encoding was successfully started or not
+	 */
+	bool StartEncoding(TUniquePtr<FBaseRuntimeEncoderSession> Session, TUniquePtr<FBaseRuntimeEncodedAudioSink> Sink, uint8 Quality);
+
+	/**
+	 * Finish encoding to the file started with StartEncodingToFile. The audio data queued for appending before this call is still encoded
+	 *
+	 * @param Result Delegate broadcasting the result
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Streaming Sound Wave|Export")
+	void StopEncodingToFile(const FOnStopEncodingToFileResult& Result);
+
+	/**
+	 * Finish encoding to the file started with StartEncodingToFile. The audio data queued for appending before this call is still encoded. Suitable for use in C++
+	 *
+	 * @param Result Delegate broadcasting the result
+	 */
+	void StopEncodingToFile(const FOnStopEncodingToFileResultNative& Result);
+
+	/**
+	 * Whether the appended audio data is being encoded to a file or not
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Streaming Sound Wave|Export")
+	bool IsEncodingToFile() const;
+
 	/**
 	 * Toggles whether the audio capture should be filtered by VAD (Voice Activity Detection)
 	 * If VAD is enabled, only audio data with voice activity will be captured
@@ -160,6 +273,117 @@ public:
 	//~ End UImportedSoundWave Interface
 
 protected:
+	/**
+	 * Launch a task on the audio task pipe. The appends queued afterwards are drained after this task
+	 */
+	void LaunchAudioTask(TUniqueFunction<void()>&& Task, UE::Tasks::ETaskPriority Priority = UE::Tasks::ETaskPriority::BackgroundHigh);
+
+	/**
+	 * Queue the audio data for appending on the audio task pipe. It joins the batch of the drain task that has not started yet, if any, instead of launching a task of its own
+	 * Used for the appends from any thread, so that they are coalesced and appended in the order they were made
+	 */
+	void QueueAppendRequest(FStreamingSoundWaveAppendRequest&& Request);
+
+	/**
+	 * Decode the queued audio data and append it as a single block, so that it is converted, locked and broadcast once per batch
+	 * VAD is still processed per queued chunk, so that the silent chunks of the batch are skipped without skipping the voiced ones
+	 */
+	void ProcessAppendRequests(TArray<FStreamingSoundWaveAppendRequest>&& Requests);
+
+	/**
+	 * Process VAD on the audio data if VAD is enabled
+	 *
+	 * @return Whether the audio data should be appended, i.e. whether VAD is disabled or voice has been detected
+	 */
+	bool ProcessVADForAppend(const FDecodedAudioStruct& DecodedAudioInfo);
+
+	/**
+	 * Append the decoded audio data without processing VAD. The audio data is resampled and mixed to the format of the previously populated audio data before locking the data guard
+	 */
+	void AppendDecodedAudio(FDecodedAudioStruct&& DecodedAudioInfo);
+
+	/**
+	 * Get the format the appended audio data is brought to: the format of the previously populated audio data, or the initial desired one if nothing has been populated yet
+	 * Should only be used if DataGuard is locked
+	 *
+	 * @param OutSampleRate The sample rate, or 0 to keep the sample rate of the appended audio data
+	 * @param OutNumOfChannels The number of channels, or 0 to keep the number of channels of the appended audio data
+	 */
+	void GetAppendFormat_Internal(uint32& OutSampleRate, uint32& OutNumOfChannels) const;
+
+	/**
+	 * Pop the whole frames held by the ring and append them as a single block. Must be called on the audio task pipe, which serializes the popping
+	 *
+	 * @param Ring The ring of interleaved 32-bit float samples to pop from
+	 * @param InSampleRate The sample rate of the samples in the ring
+	 * @param NumOfChannels The number of channels of the samples in the ring
+	 * @return The number of frames popped
+	 */
+	int64 PopulateAudioDataFromRing(FRuntimeAudioRingBuffer& Ring, uint32 InSampleRate, uint32 NumOfChannels);
+
+	/**
+	 * Encode the appended audio data if encoding to a file has been started, beginning the encoder session if necessary
+	 */
+	void PushToEncoderSession(const FDecodedAudioStruct& DecodedAudioInfo);
+
+	/**
+	 * Finish the encoder session, if any
+	 *
+	 * @return Whether the session was successfully finished or not
+	 */
+	bool FinishEncoderSession();
+
+	/**
+	 * Finish the specified encoder session, which has already been detached from the sound wave. Can be called from any thread
+	 *
+	 * @param Session The encoder session to finish
+	 * @param SoundWaveName The name of the sound wave the session was encoding, for logging
+	 * @return Whether the session was successfully finished or not
+	 */
+	static bool FinishEncoderSession(TUniquePtr<FBaseRuntimeEncoderSession> Session, const FString& SoundWaveName);
+
+	/**
+	 * Create the decoder session for the encoded stream appended with AppendAudioDataFromEncodedStream
+	 *
+	 * @param AudioData The first slice of the stream, used to detect the format if necessary
+	 * @param AudioFormat Audio format of the stream
+	 * @return Whether the session was successfully created or not
+	 */
+	bool CreateDecoderSession_Internal(const TArray<uint8>& AudioData, ERuntimeAudioFormat AudioFormat);
+
+	/** Data guard (mutex) for the decoder session */
+	mutable FCriticalSection DecoderSessionGuard;
+
+	/** The decoder session the encoded stream is decoded with. Is valid only while an encoded stream is being appended */
+	TUniquePtr<FBaseRuntimeDecoderSession> DecoderSession;
+
+	/** Data guard (mutex) for the encoder session */
+	mutable FCriticalSection EncoderSessionGuard;
+
+	/** The encoder session the appended audio data is encoded with. Is valid only if encoding to a file has been started */
+	TUniquePtr<FBaseRuntimeEncoderSession> EncoderSession;
+
+	/** The sink the encoder session will write to once it is begun */
+	TUniquePtr<FBaseRuntimeEncodedAudioSink> PendingEncoderSink;
+
+	/** The quality the encoder session will be begun with */
+	uint8 EncoderQuality;
+
+	/** The result of finishing the encoder session in the background when the sound wave is destroyed while encoding. Destruction is not finished until it is ready */
+	TFuture<bool> DestroyEncoderFinishFuture;
+
+	/** Data guard (mutex) for the open append batch */
+	FCriticalSection AppendBatchGuard;
+
+	/** The audio data queued for the drain task that has not started yet. Is valid only if there is such a task */
+	TSharedPtr<TArray<FStreamingSoundWaveAppendRequest>, ESPMode::ThreadSafe> OpenAppendBatch;
+
+	/** The number of tasks launched on the audio task pipe */
+	std::atomic<int64> NumOfAudioTasksLaunched;
+
+	/** The number of audio data chunks appended */
+	std::atomic<int64> NumOfAppendedChunks;
+
 	/** The audio task pipe (enforces sequential asynchronous execution of audio tasks as opposed to parallel which is possible with the default async task graph) */
 	TUniquePtr<UE::Tasks::FPipe> AudioTaskPipe;
 
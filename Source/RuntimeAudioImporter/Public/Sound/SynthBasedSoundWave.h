@@ -8,6 +8,9 @@
 #include "Containers/Queue.h"
 #include "Components/SynthComponent.h"
 #include "Tickable.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "RuntimeAudioRingBuffer.h"
 #include <atomic>
 
 #include "SynthBasedSoundWave.generated.h"
@@ -15,6 +18,75 @@
 // Sound generator support is only available in UE 5.0 and later
 #define WITH_RUNTIMEAUDIOIMPORTER_SYNTH_SOUND_GENERATOR_SUPPORT !UE_VERSION_OLDER_THAN(5, 0, 0)
 
+#if WITH_RUNTIMEAUDIOIMPORTER_SYNTH_SOUND_GENERATOR_SUPPORT
+/**
+ * Worker pulling a sound generator at audio rate on its own thread, independently of the game tick
+ * Every block is generated into a preallocated buffer and pushed into a preallocated ring, so generating does not allocate
+ */
+class FSynthBasedSoundWaveRenderWorker : public FRunnable
+{
+public:
+	/**
+	 * @param InSoundGenerator The sound generator to pull
+	 * @param InSampleRate The sample rate of the generated audio data
+	 * @param InNumOfChannels The number of channels of the generated audio data
+	 * @param InNumOfFramesPerBlock The number of frames to generate at a time
+	 * @param InOnBlockGenerated Called on the worker thread after every block pushed into the ring, with the number of samples in the ring
+	 */
+	FSynthBasedSoundWaveRenderWorker(ISoundGeneratorPtr InSoundGenerator, int32 InSampleRate, int32 InNumOfChannels, int32 InNumOfFramesPerBlock, TFunction<void(int32)> InOnBlockGenerated);
+	virtual ~FSynthBasedSoundWaveRenderWorker() override;
+
+	//~ Begin FRunnable Interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	//~ End FRunnable Interface
+
+	/**
+	 * Stop generating and wait for the worker thread to exit. The ring can still be popped afterwards
+	 */
+	void StopAndWait();
+
+	/**
+	 * Get the sample rate of the generated audio data
+	 */
+	int32 GetSampleRate() const { return SampleRate; }
+
+	/**
+	 * Get the number of channels of the generated audio data
+	 */
+	int32 GetNumOfChannels() const { return NumOfChannels; }
+
+	/**
+	 * Get the ring the generated audio data is pushed into. Popped by the consumer
+	 */
+	FRuntimeAudioRingBuffer& GetRing() { return Ring; }
+
+	/**
+	 * Get the number of samples dropped because the consumer has not popped the ring in time
+	 */
+	int64 GetNumOfDroppedSamples() const { return NumOfDroppedSamples.load(std::memory_order_relaxed); }
+
+private:
+	ISoundGeneratorPtr SoundGenerator;
+	const int32 SampleRate;
+	const int32 NumOfChannels;
+	const int32 NumOfFramesPerBlock;
+	TFunction<void(int32)> OnBlockGenerated;
+
+	/** The buffer every block is generated into */
+	TArray<float> BlockBuffer;
+
+	/** The ring holding the generated audio data until it is appended to the sound wave */
+	FRuntimeAudioRingBuffer Ring;
+
+	std::atomic<bool> bStopping;
+	std::atomic<int64> NumOfDroppedSamples;
+
+	/** The thread the worker runs on. Joined in the destructor */
+	TUniquePtr<FRunnableThread> Thread;
+};
+#endif
+
 
 /**
  * Sound wave that captures audio data using a synth component.
@@ -37,6 +109,22 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Synth Based Sound Wave|Main")
 	static USynthBasedSoundWave* CreateSynthBasedSoundWave(USynthComponent* InSynthComponent);
 
+	//~ Begin UObject Interface
+	virtual void BeginDestroy() override;
+	//~ End UObject Interface
+
+	/**
+	 * Set whether the sound generator should be pulled at audio rate on a dedicated worker thread instead of on every game tick
+	 * The generated audio data no longer depends on the frame rate and hitches, and generating it does not allocate. Takes effect on the next StartCapture
+	 *
+	 * @param bEnable Whether to enable render-rate generation or not
+	 * @param NumOfFramesPerBlock The number of frames to generate at a time. Smaller blocks lower the latency at the cost of more wake-ups
+	 * @return Whether render-rate generation was set or not
+	 * @warning This works only on Unreal Engine version >= 5.0 and with synth components providing a sound generator
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Synth Based Sound Wave|Main")
+	bool SetRenderRateGeneration(bool bEnable, int32 NumOfFramesPerBlock = 1024);
+
 protected:
 	//~ Begin UCapturableSoundWave Interface
 	virtual bool StartCapture_Implementation(int32 DeviceId) override;
@@ -88,6 +176,40 @@ protected:
 	 */
 	TFuture<bool> StopSynthSound();
 
+	/**
+	 * Start pulling the sound generator on the render worker, if render-rate generation is enabled
+	 *
+	 * @return Whether the render worker was started or not
+	 */
+	bool StartRenderWorker();
+
+	/**
+	 * Stop the render worker, if any, and queue appending what it has generated
+	 */
+	void StopRenderWorker();
+
+	/**
+	 * Append the audio data generated by the render worker so far. Runs on the audio task pipe
+	 */
+	void DrainRenderWorker(FSynthBasedSoundWaveRenderWorker& Worker);
+
+	/** Whether render-rate generation is enabled or not (see SetRenderRateGeneration) */
+	bool bRenderRateGeneration = false;
+
+	/** The number of frames the render worker generates at a time */
+	int32 NumOfFramesPerRenderBlock = 1024;
+
+#if WITH_RUNTIMEAUDIOIMPORTER_SYNTH_SOUND_GENERATOR_SUPPORT
+	/** The worker pulling the sound generator. Is valid only while capturing with render-rate generation */
+	TSharedPtr<FSynthBasedSoundWaveRenderWorker, ESPMode::ThreadSafe> RenderWorker;
+#endif
+
+	/** Data guard (mutex) for the render worker */
+	FCriticalSection RenderWorkerGuard;
+
+	/** Whether a drain of the render worker is queued on the audio task pipe or not */
+	std::atomic<bool> bRenderDrainQueued{ false };
+
 	/** Whether the sound wave is currently capturing audio */
 	std::atomic<bool> bCapturing{ false };
 };
@@ -79,7 +79,8 @@ public class RuntimeAudioImporter : ModuleRules
 			}
 		);
 
-		if (Target.Version.MajorVersion >= 5 && Target.Version.MinorVersion >= 1)
+		// SignalProcessing also provides the FFT used for spectrum analysis
+		if (Target.Version.MajorVersion >= 5)
 		{
 			PrivateDependencyModuleNames.AddRange(
 				new string[]
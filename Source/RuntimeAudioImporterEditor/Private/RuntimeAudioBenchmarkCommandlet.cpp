@@ -0,0 +1,490 @@
+// Georgy Treshchev 2024.
+
+#include "RuntimeAudioBenchmarkCommandlet.h"
+#include "RuntimeAudioImporterEditor.h"
+#include "RuntimeAudioImporterDefines.h"
+#include "RuntimeAudioImporterLibrary.h"
+#include "Codecs/BaseRuntimeCodec.h"
+#include "Codecs/RuntimeCodecFactory.h"
+#include "Sound/DecodedAudioDiskCache.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+#include <atomic>
+
+namespace
+{
+	/** Per-file result of the benchmark */
+	struct FRuntimeAudioBenchmarkResult
+	{
+		FRuntimeAudioBenchmarkResult()
+			: bSucceeded(false)
+		  , InputSize(0)
+		  , OutputSize(0)
+		  , AudioDuration(0)
+		  , DecodeTime(0)
+		  , EncodeTime(0)
+		  , DiskCacheStoreTime(0)
+		  , DiskCacheLoadTime(0)
+		{
+		}
+
+		FString FilePath;
+		bool bSucceeded;
+
+		/** Size of the input file, in bytes */
+		int64 InputSize;
+
+		/** Size of the encoded audio data, in bytes */
+		int64 OutputSize;
+
+		/** Duration of the decoded audio data, sec */
+		double AudioDuration;
+
+		/** Total time spent decoding over all iterations, sec */
+		double DecodeTime;
+
+		/** Total time spent encoding over all iterations, sec */
+		double EncodeTime;
+
+		/** Total time spent storing the decoded audio data in the disk cache over all iterations, sec. A cold import is decoding plus storing */
+		double DiskCacheStoreTime;
+
+		/** Total time spent loading the decoded audio data from the disk cache over all iterations, sec. A warm import is loading only */
+		double DiskCacheLoadTime;
+	};
+
+	/** Benchmark options parsed from the command line */
+	struct FRuntimeAudioBenchmarkOptions
+	{
+		FString InputPath;
+		FString OutputDirectory;
+		ERuntimeAudioFormat OutputFormat = ERuntimeAudioFormat::Invalid;
+		uint8 Quality = 100;
+		uint32 SampleRate = 0;
+		uint32 NumOfChannels = 0;
+		int32 NumOfWorkers = 1;
+		int32 NumOfIterations = 1;
+		bool bRecursive = false;
+
+		/** Whether to benchmark cold (decode and store) and warm (load) imports through the decoded audio disk cache */
+		bool bDiskCache = false;
+
+		/** Unique per run, so that the disk cache entries of the benchmark never collide with the existing ones */
+		FString DiskCacheKeyPrefix;
+	};
+
+	constexpr double BytesInMegabyte = 1024. * 1024.;
+
+	/**
+	 * Check whether any of the registered codecs recognizes the file by its extension
+	 * Does not use FRuntimeCodecFactory::GetCodecs(FilePath) to not log a warning for every unrelated file in the input directory
+	 */
+	bool IsAudioFileSupported(const FString& FilePath)
+	{
+		const FString Extension = FPaths::GetExtension(FilePath, false);
+		FRuntimeCodecFactory CodecFactory;
+		for (const FBaseRuntimeCodec* Codec : CodecFactory.GetCodecs())
+		{
+			if (Codec->IsExtensionSupported(Extension))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * Gather the audio files to process, sorted by path so that the output is stable between runs
+	 */
+	TArray<FString> GatherAudioFiles(const FRuntimeAudioBenchmarkOptions& Options)
+	{
+		TArray<FString> FilePaths;
+		IFileManager& FileManager = IFileManager::Get();
+
+		if (FileManager.FileExists(*Options.InputPath))
+		{
+			FilePaths.Add(Options.InputPath);
+			return FilePaths;
+		}
+
+		if (Options.bRecursive)
+		{
+			FileManager.FindFilesRecursive(FilePaths, *Options.InputPath, TEXT("*"), true, false);
+		}
+		else
+		{
+			FileManager.FindFiles(FilePaths, *(Options.InputPath / TEXT("*")), true, false);
+			for (FString& FilePath : FilePaths)
+			{
+				FilePath = Options.InputPath / FilePath;
+			}
+		}
+
+		FilePaths.RemoveAll([](const FString& FilePath)
+		{
+			return !IsAudioFileSupported(FilePath);
+		});
+		FilePaths.Sort();
+		return FilePaths;
+	}
+
+	/**
+	 * Decode, and optionally encode and export, a single audio file
+	 */
+	FRuntimeAudioBenchmarkResult ProcessAudioFile(const FString& FilePath, const FRuntimeAudioBenchmarkOptions& Options)
+	{
+		FRuntimeAudioBenchmarkResult Result;
+		Result.FilePath = FilePath;
+
+		TArray64<uint8> AudioData;
+		if (!RuntimeAudioImporter::LoadAudioFileToArray(AudioData, FilePath))
+		{
+			UE_LOG(LogRuntimeAudioImporterEditor, Error, TEXT("Unable to load the audio file '%s'"), *FilePath);
+			return Result;
+		}
+		Result.InputSize = AudioData.Num();
+
+		const bool bEncode = Options.OutputFormat != ERuntimeAudioFormat::Invalid;
+
+		for (int32 IterationIndex = 0; IterationIndex < Options.NumOfIterations; ++IterationIndex)
+		{
+			// The encoded audio data is consumed by decoding, so it is copied for every iteration outside of the timed section
+			FEncodedAudioStruct EncodedAudioInfo(FRuntimeBulkDataBuffer<uint8>(AudioData), ERuntimeAudioFormat::Auto);
+			FDecodedAudioStruct DecodedAudioInfo;
+
+			const double DecodeStartTime = FPlatformTime::Seconds();
+			if (!URuntimeAudioImporterLibrary::DecodeAudioData(MoveTemp(EncodedAudioInfo), DecodedAudioInfo, Options.SampleRate, Options.NumOfChannels))
+			{
+				UE_LOG(LogRuntimeAudioImporterEditor, Error, TEXT("Unable to decode the audio file '%s'"), *FilePath);
+				return Result;
+			}
+			Result.DecodeTime += FPlatformTime::Seconds() - DecodeStartTime;
+			Result.AudioDuration = DecodedAudioInfo.SoundWaveBasicInfo.Duration;
+
+			if (Options.bDiskCache)
+			{
+				const FString DiskCacheKey = Options.DiskCacheKeyPrefix + FilePath;
+
+				// Cold: the entry is stored after decoding, as the first import of a file does
+				FRuntimeDecodedAudioDiskCache::Remove(DiskCacheKey);
+				const double StoreStartTime = FPlatformTime::Seconds();
+				if (!FRuntimeDecodedAudioDiskCache::Save(DiskCacheKey, DecodedAudioInfo))
+				{
+					UE_LOG(LogRuntimeAudioImporterEditor, Error, TEXT("Unable to store the decoded audio file '%s' in the disk cache"), *FilePath);
+					return Result;
+				}
+				Result.DiskCacheStoreTime += FPlatformTime::Seconds() - StoreStartTime;
+
+				// Warm: the entry is loaded instead of decoding, as the subsequent imports of the file do
+				{
+					FDecodedAudioStruct CachedDecodedAudioInfo;
+					const double LoadStartTime = FPlatformTime::Seconds();
+					const bool bLoaded = FRuntimeDecodedAudioDiskCache::Load(DiskCacheKey, CachedDecodedAudioInfo);
+					Result.DiskCacheLoadTime += FPlatformTime::Seconds() - LoadStartTime;
+
+					if (!bLoaded || CachedDecodedAudioInfo.PCMInfo.PCMNumOfFrames != DecodedAudioInfo.PCMInfo.PCMNumOfFrames)
+					{
+						UE_LOG(LogRuntimeAudioImporterEditor, Error, TEXT("Unable to load the decoded audio file '%s' from the disk cache"), *FilePath);
+						FRuntimeDecodedAudioDiskCache::Remove(DiskCacheKey);
+						return Result;
+					}
+				}
+
+				FRuntimeDecodedAudioDiskCache::Remove(DiskCacheKey);
+			}
+
+			if (!bEncode)
+			{
+				continue;
+			}
+
+			FEncodedAudioStruct TranscodedAudioInfo;
+			TranscodedAudioInfo.AudioFormat = Options.OutputFormat;
+
+			const double EncodeStartTime = FPlatformTime::Seconds();
+			if (!URuntimeAudioImporterLibrary::EncodeAudioData(MoveTemp(DecodedAudioInfo), TranscodedAudioInfo, Options.Quality))
+			{
+				UE_LOG(LogRuntimeAudioImporterEditor, Error, TEXT("Unable to encode the audio file '%s' into the %s format"), *FilePath, *UEnum::GetValueAsString(Options.OutputFormat));
+				return Result;
+			}
+			Result.EncodeTime += FPlatformTime::Seconds() - EncodeStartTime;
+			Result.OutputSize = TranscodedAudioInfo.AudioData.GetView().Num();
+
+			// Export only once, the remaining iterations are for timing only
+			if (IterationIndex == 0 && !Options.OutputDirectory.IsEmpty())
+			{
+				FString RelativePath = FilePath;
+				if (!FPaths::MakePathRelativeTo(RelativePath, *(Options.InputPath / TEXT(""))))
+				{
+					RelativePath = FPaths::GetCleanFilename(FilePath);
+				}
+				const FString OutputFilePath = FPaths::ChangeExtension(Options.OutputDirectory / RelativePath, URuntimeAudioBenchmarkCommandlet::GetExtensionForAudioFormat(Options.OutputFormat));
+
+				const TArrayView64<const uint8> TranscodedAudioData(TranscodedAudioInfo.AudioData.GetView().GetData(), TranscodedAudioInfo.AudioData.GetView().Num());
+				if (!RuntimeAudioImporter::SaveAudioFileFromArray(TranscodedAudioData, OutputFilePath))
+				{
+					UE_LOG(LogRuntimeAudioImporterEditor, Error, TEXT("Unable to export the transcoded audio file to '%s'"), *OutputFilePath);
+					return Result;
+				}
+			}
+		}
+
+		Result.bSucceeded = true;
+		return Result;
+	}
+
+	/**
+	 * Get throughput in megabytes per second. Returns 0 if the time is too small to be measured
+	 */
+	double GetThroughput(double NumOfBytes, double Time)
+	{
+		return Time > SMALL_NUMBER ? NumOfBytes / BytesInMegabyte / Time : 0;
+	}
+}
+
+FString URuntimeAudioBenchmarkCommandlet::GetExtensionForAudioFormat(ERuntimeAudioFormat AudioFormat)
+{
+	switch (AudioFormat)
+	{
+	case ERuntimeAudioFormat::Wav:
+		return TEXT("wav");
+	case ERuntimeAudioFormat::Flac:
+		return TEXT("flac");
+	case ERuntimeAudioFormat::OggVorbis:
+		return TEXT("ogg");
+	case ERuntimeAudioFormat::OggOpus:
+		return TEXT("opus");
+	case ERuntimeAudioFormat::Bink:
+		return TEXT("bink");
+	default:
+		return FString();
+	}
+}
+
+TArray<ERuntimeAudioFormat> URuntimeAudioBenchmarkCommandlet::GetEncodableAudioFormats()
+{
+	return {
+		ERuntimeAudioFormat::Wav,
+		ERuntimeAudioFormat::Flac,
+		ERuntimeAudioFormat::OggVorbis,
+		ERuntimeAudioFormat::OggOpus,
+#if WITH_RUNTIMEAUDIOIMPORTER_BINK_ENCODE_SUPPORT
+		ERuntimeAudioFormat::Bink,
+#endif
+	};
+}
+
+URuntimeAudioBenchmarkCommandlet::URuntimeAudioBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+	HelpDescription = TEXT("Batch decode, transcode and export audio files using the RuntimeAudioImporter codecs and print the throughput");
+	HelpUsage = TEXT("-run=RuntimeAudioBenchmark -Input=<Directory or file> [-Output=<Directory>] [-Format=<Wav|Flac|OggVorbis|OggOpus|Bink>] [-Quality=<0-100>] [-SampleRate=<Hz>] [-NumOfChannels=<Count>] [-Workers=<Count>] [-Iterations=<Count>] [-Recursive] [-DiskCache]");
+}
+
+int32 URuntimeAudioBenchmarkCommandlet::Main(const FString& Params)
+{
+#if WITH_RUNTIMEAUDIOIMPORTER_FILEOPERATION_SUPPORT
+	const TCHAR* CommandLine = *Params;
+	FRuntimeAudioBenchmarkOptions Options;
+
+	if (!FParse::Value(CommandLine, TEXT("Input="), Options.InputPath) || Options.InputPath.IsEmpty())
+	{
+		UE_LOG(LogRuntimeAudioImporterEditor, Error, TEXT("The input directory is not specified. Usage: %s"), *HelpUsage);
+		return 1;
+	}
+	Options.InputPath = FPaths::ConvertRelativePathToFull(Options.InputPath);
+
+	if (FParse::Value(CommandLine, TEXT("Output="), Options.OutputDirectory) && !Options.OutputDirectory.IsEmpty())
+	{
+		Options.OutputDirectory = FPaths::ConvertRelativePathToFull(Options.OutputDirectory);
+	}
+
+	FString FormatString;
+	if (FParse::Value(CommandLine, TEXT("Format="), FormatString))
+	{
+		const TArray<ERuntimeAudioFormat> EncodableAudioFormats = GetEncodableAudioFormats();
+		const int64 FormatValue = StaticEnum<ERuntimeAudioFormat>()->GetValueByNameString(FormatString);
+		if (FormatValue == INDEX_NONE || !EncodableAudioFormats.Contains(static_cast<ERuntimeAudioFormat>(FormatValue)))
+		{
+			FString SupportedFormats;
+			for (const ERuntimeAudioFormat EncodableAudioFormat : EncodableAudioFormats)
+			{
+				SupportedFormats += (SupportedFormats.IsEmpty() ? TEXT("") : TEXT(", ")) + StaticEnum<ERuntimeAudioFormat>()->GetNameStringByValue(static_cast<int64>(EncodableAudioFormat));
+			}
+			UE_LOG(LogRuntimeAudioImporterEditor, Error, TEXT("Unsupported output format '%s'. Supported formats: %s"), *FormatString, *SupportedFormats);
+			return 1;
+		}
+		Options.OutputFormat = static_cast<ERuntimeAudioFormat>(FormatValue);
+	}
+
+	if (!Options.OutputDirectory.IsEmpty() && Options.OutputFormat == ERuntimeAudioFormat::Invalid)
+	{
+		UE_LOG(LogRuntimeAudioImporterEditor, Error, TEXT("The output format must be specified with -Format when exporting"));
+		return 1;
+	}
+
+	int32 Quality = Options.Quality;
+	FParse::Value(CommandLine, TEXT("Quality="), Quality);
+	Options.Quality = static_cast<uint8>(FMath::Clamp(Quality, 0, 100));
+
+	FParse::Value(CommandLine, TEXT("SampleRate="), Options.SampleRate);
+	FParse::Value(CommandLine, TEXT("NumOfChannels="), Options.NumOfChannels);
+
+	Options.NumOfWorkers = FPlatformMisc::NumberOfCores();
+	FParse::Value(CommandLine, TEXT("Workers="), Options.NumOfWorkers);
+	Options.NumOfWorkers = FMath::Max(Options.NumOfWorkers, 1);
+
+	FParse::Value(CommandLine, TEXT("Iterations="), Options.NumOfIterations);
+	Options.NumOfIterations = FMath::Max(Options.NumOfIterations, 1);
+
+	Options.bRecursive = FParse::Param(CommandLine, TEXT("Recursive"));
+
+	Options.bDiskCache = FParse::Param(CommandLine, TEXT("DiskCache"));
+	Options.DiskCacheKeyPrefix = FString::Printf(TEXT("RuntimeAudioBenchmark_%s_%u_%u_"), *FGuid::NewGuid().ToString(), Options.SampleRate, Options.NumOfChannels);
+
+	// The disk cache is enabled for the duration of the benchmark only, keeping the storage format configured by the project
+	const bool bDiskCacheWasEnabled = FRuntimeDecodedAudioDiskCache::IsEnabled();
+	if (Options.bDiskCache && !bDiskCacheWasEnabled)
+	{
+		FRuntimeDecodedAudioDiskCache::SetEnabled(true);
+	}
+
+	const TArray<FString> FilePaths = GatherAudioFiles(Options);
+	if (FilePaths.Num() == 0)
+	{
+		UE_LOG(LogRuntimeAudioImporterEditor, Error, TEXT("No supported audio files found in '%s'"), *Options.InputPath);
+		return 1;
+	}
+
+	Options.NumOfWorkers = FMath::Min(Options.NumOfWorkers, FilePaths.Num());
+
+	UE_LOG(LogRuntimeAudioImporterEditor, Display, TEXT("Processing %d audio files from '%s' with %d workers and %d iterations%s"),
+		FilePaths.Num(), *Options.InputPath, Options.NumOfWorkers, Options.NumOfIterations,
+		Options.OutputFormat != ERuntimeAudioFormat::Invalid ? *FString::Printf(TEXT(", transcoding into %s (quality %d)"), *UEnum::GetValueAsString(Options.OutputFormat), Options.Quality) : TEXT(""));
+
+	TArray<FRuntimeAudioBenchmarkResult> Results;
+	Results.SetNum(FilePaths.Num());
+
+	// Workers pull the files from a shared index, so that a few long files do not leave the other workers idle
+	std::atomic<int32> NextFileIndex{0};
+
+	const double StartTime = FPlatformTime::Seconds();
+	{
+		TArray<TFuture<void>> Workers;
+		Workers.Reserve(Options.NumOfWorkers);
+		for (int32 WorkerIndex = 0; WorkerIndex < Options.NumOfWorkers; ++WorkerIndex)
+		{
+			Workers.Add(Async(EAsyncExecution::Thread, [&FilePaths, &Options, &Results, &NextFileIndex]()
+			{
+				for (int32 FileIndex = NextFileIndex.fetch_add(1); FileIndex < FilePaths.Num(); FileIndex = NextFileIndex.fetch_add(1))
+				{
+					Results[FileIndex] = ProcessAudioFile(FilePaths[FileIndex], Options);
+				}
+			}));
+		}
+
+		for (TFuture<void>& Worker : Workers)
+		{
+			Worker.Wait();
+		}
+	}
+	const double WallTime = FPlatformTime::Seconds() - StartTime;
+
+	if (Options.bDiskCache && !bDiskCacheWasEnabled)
+	{
+		FRuntimeDecodedAudioDiskCache::SetEnabled(false);
+	}
+
+	int32 NumOfFailedFiles = 0;
+	double TotalInputSize = 0;
+	double TotalOutputSize = 0;
+	double TotalAudioDuration = 0;
+	double TotalDecodeTime = 0;
+	double TotalEncodeTime = 0;
+	double TotalDiskCacheStoreTime = 0;
+	double TotalDiskCacheLoadTime = 0;
+
+	for (const FRuntimeAudioBenchmarkResult& Result : Results)
+	{
+		if (!Result.bSucceeded)
+		{
+			++NumOfFailedFiles;
+			UE_LOG(LogRuntimeAudioImporterEditor, Display, TEXT("FAILED %s"), *Result.FilePath);
+			continue;
+		}
+
+		const double ProcessedInputSize = static_cast<double>(Result.InputSize) * Options.NumOfIterations;
+		const double ProcessedAudioDuration = Result.AudioDuration * Options.NumOfIterations;
+
+		TotalInputSize += ProcessedInputSize;
+		TotalOutputSize += static_cast<double>(Result.OutputSize) * Options.NumOfIterations;
+		TotalAudioDuration += ProcessedAudioDuration;
+		TotalDecodeTime += Result.DecodeTime;
+		TotalEncodeTime += Result.EncodeTime;
+		TotalDiskCacheStoreTime += Result.DiskCacheStoreTime;
+		TotalDiskCacheLoadTime += Result.DiskCacheLoadTime;
+
+		FString EncodeString;
+		if (Options.OutputFormat != ERuntimeAudioFormat::Invalid)
+		{
+			EncodeString = FString::Printf(TEXT(", encode %.3f s (%.2f MB/s output, %.1fx realtime), output %.2f MB"),
+				Result.EncodeTime, GetThroughput(static_cast<double>(Result.OutputSize) * Options.NumOfIterations, Result.EncodeTime),
+				Result.EncodeTime > SMALL_NUMBER ? ProcessedAudioDuration / Result.EncodeTime : 0,
+				Result.OutputSize / BytesInMegabyte);
+		}
+
+		FString DiskCacheString;
+		if (Options.bDiskCache)
+		{
+			const double ColdImportTime = Result.DecodeTime + Result.DiskCacheStoreTime;
+			DiskCacheString = FString::Printf(TEXT(", disk cache cold %.3f s (decode + store), warm %.3f s (load, %.1fx faster)"),
+				ColdImportTime, Result.DiskCacheLoadTime,
+				Result.DiskCacheLoadTime > SMALL_NUMBER ? ColdImportTime / Result.DiskCacheLoadTime : 0);
+		}
+
+		UE_LOG(LogRuntimeAudioImporterEditor, Display, TEXT("%s: input %.2f MB, audio %.2f s, decode %.3f s (%.2f MB/s, %.1fx realtime)%s%s"),
+			*Result.FilePath, Result.InputSize / BytesInMegabyte, Result.AudioDuration,
+			Result.DecodeTime, GetThroughput(ProcessedInputSize, Result.DecodeTime),
+			Result.DecodeTime > SMALL_NUMBER ? ProcessedAudioDuration / Result.DecodeTime : 0,
+			*EncodeString, *DiskCacheString);
+	}
+
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+
+	UE_LOG(LogRuntimeAudioImporterEditor, Display, TEXT("Processed %d of %d audio files (%d failed) in %.3f s with %d workers"),
+		FilePaths.Num() - NumOfFailedFiles, FilePaths.Num(), NumOfFailedFiles, WallTime, Options.NumOfWorkers);
+	UE_LOG(LogRuntimeAudioImporterEditor, Display, TEXT("Decode: %.2f MB input, %.3f s CPU, %.2f MB/s per worker, %.1fx realtime per worker"),
+		TotalInputSize / BytesInMegabyte, TotalDecodeTime, GetThroughput(TotalInputSize, TotalDecodeTime),
+		TotalDecodeTime > SMALL_NUMBER ? TotalAudioDuration / TotalDecodeTime : 0);
+	if (Options.OutputFormat != ERuntimeAudioFormat::Invalid)
+	{
+		UE_LOG(LogRuntimeAudioImporterEditor, Display, TEXT("Encode: %.2f MB output, %.3f s CPU, %.2f MB/s per worker, %.1fx realtime per worker"),
+			TotalOutputSize / BytesInMegabyte, TotalEncodeTime, GetThroughput(TotalOutputSize, TotalEncodeTime),
+			TotalEncodeTime > SMALL_NUMBER ? TotalAudioDuration / TotalEncodeTime : 0);
+	}
+	if (Options.bDiskCache)
+	{
+		const double TotalColdImportTime = TotalDecodeTime + TotalDiskCacheStoreTime;
+		UE_LOG(LogRuntimeAudioImporterEditor, Display, TEXT("Disk cache: cold imports %.3f s CPU (%.3f s decode + %.3f s store), warm imports %.3f s CPU (%.1fx realtime per worker, %.1fx faster than cold)"),
+			TotalColdImportTime, TotalDecodeTime, TotalDiskCacheStoreTime, TotalDiskCacheLoadTime,
+			TotalDiskCacheLoadTime > SMALL_NUMBER ? TotalAudioDuration / TotalDiskCacheLoadTime : 0,
+			TotalDiskCacheLoadTime > SMALL_NUMBER ? TotalColdImportTime / TotalDiskCacheLoadTime : 0);
+	}
+	UE_LOG(LogRuntimeAudioImporterEditor, Display, TEXT("Aggregate: %.2f MB/s input, %.1fx realtime (%.2f s of audio in %.3f s wall time)"),
+		GetThroughput(TotalInputSize, WallTime), WallTime > SMALL_NUMBER ? TotalAudioDuration / WallTime : 0, TotalAudioDuration, WallTime);
+	UE_LOG(LogRuntimeAudioImporterEditor, Display, TEXT("Peak memory: %.2f MB physical, %.2f MB virtual"),
+		MemoryStats.PeakUsedPhysical / BytesInMegabyte, MemoryStats.PeakUsedVirtual / BytesInMegabyte);
+
+	return NumOfFailedFiles > 0 ? 1 : 0;
+#else
+	UE_LOG(LogRuntimeAudioImporterEditor, Error, TEXT("Unable to run the benchmark because file operations are disabled in RuntimeAudioImporter.Build.cs"));
+	return 1;
+#endif
+}
@@ -0,0 +1,60 @@
+// Georgy Treshchev 2024.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "RuntimeAudioBenchmarkCommandlet.h"
+#include "RuntimeAudioImporterLibrary.h"
+#include "RuntimeAudioUtilities.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRuntimeAudioBenchmarkOutputFormatsTest, "RuntimeAudioImporter.Editor.BenchmarkCommandlet.OutputFormats", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FRuntimeAudioBenchmarkOutputFormatsTest::RunTest(const FString& Parameters)
+{
+	constexpr uint32 SampleRate = 48000;
+	constexpr int32 NumOfFrames = 4800;
+
+	const TArray<ERuntimeAudioFormat> EncodableAudioFormats = URuntimeAudioBenchmarkCommandlet::GetEncodableAudioFormats();
+	TestFalse(TEXT("MP3 cannot be encoded"), EncodableAudioFormats.Contains(ERuntimeAudioFormat::Mp3));
+	TestTrue(TEXT("Auto has no extension"), URuntimeAudioBenchmarkCommandlet::GetExtensionForAudioFormat(ERuntimeAudioFormat::Auto).IsEmpty());
+
+	for (const ERuntimeAudioFormat AudioFormat : EncodableAudioFormats)
+	{
+		const FString FormatName = UEnum::GetValueAsString(AudioFormat);
+
+		// The exported files are recognized as the format they were encoded into when imported back
+		const FString Extension = URuntimeAudioBenchmarkCommandlet::GetExtensionForAudioFormat(AudioFormat);
+		if (!TestFalse(*FString::Printf(TEXT("%s has an extension"), *FormatName), Extension.IsEmpty()))
+		{
+			continue;
+		}
+		TestTrue(*FString::Printf(TEXT("The .%s extension maps back to %s"), *Extension, *FormatName), URuntimeAudioUtilities::GetAudioFormats(FString(TEXT("Exported.")) + Extension).Contains(AudioFormat));
+
+		// Every accepted output format actually has an encoder
+		TArray<float> PCMData;
+		PCMData.SetNumUninitialized(NumOfFrames);
+		for (int32 FrameIndex = 0; FrameIndex < NumOfFrames; ++FrameIndex)
+		{
+			PCMData[FrameIndex] = 0.5f * FMath::Sin(2.f * PI * 440.f * FrameIndex / SampleRate);
+		}
+
+		FDecodedAudioStruct DecodedAudioInfo;
+		DecodedAudioInfo.PCMInfo.PCMData = FRuntimeBulkDataBuffer<float>(PCMData);
+		DecodedAudioInfo.PCMInfo.PCMNumOfFrames = NumOfFrames;
+		DecodedAudioInfo.SoundWaveBasicInfo.NumOfChannels = 1;
+		DecodedAudioInfo.SoundWaveBasicInfo.SampleRate = SampleRate;
+		DecodedAudioInfo.SoundWaveBasicInfo.Duration = static_cast<float>(NumOfFrames) / SampleRate;
+
+		FEncodedAudioStruct EncodedAudioInfo;
+		EncodedAudioInfo.AudioFormat = AudioFormat;
+		if (TestTrue(*FString::Printf(TEXT("%s is encoded"), *FormatName), URuntimeAudioImporterLibrary::EncodeAudioData(MoveTemp(DecodedAudioInfo), EncodedAudioInfo, 100)))
+		{
+			TestTrue(*FString::Printf(TEXT("%s produces encoded data"), *FormatName), EncodedAudioInfo.AudioData.GetView().Num() > 0);
+		}
+	}
+
+	return true;
+}
+
+#endif
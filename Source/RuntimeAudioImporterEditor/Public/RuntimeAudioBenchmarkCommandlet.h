@@ -0,0 +1,53 @@
+// Georgy Treshchev 2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "RuntimeAudioImporterTypes.h"
+#include "RuntimeAudioBenchmarkCommandlet.generated.h"
+
+/**
+ * Commandlet for batch decoding, transcoding and exporting audio files with the plugin's codecs, without a running game
+ * Prints the per-file and aggregate throughput (MB/s and realtime factor) as well as the peak memory usage, so it can be used as a benchmark on build machines
+ *
+ * Usage: UnrealEditor-Cmd <Project>.uproject -run=RuntimeAudioBenchmark -Input=<Directory or file> [-Output=<Directory>] [-Format=<Wav|Flac|OggVorbis|OggOpus|Bink>] [-Quality=<0-100>]
+ *        [-SampleRate=<Hz>] [-NumOfChannels=<Count>] [-Workers=<Count>] [-Iterations=<Count>] [-Recursive] [-DiskCache] -nullrhi
+ *
+ * -Input         The directory to process (or a single audio file). Only files recognized by the plugin's codecs are processed
+ * -Output        The directory to export the transcoded files into, mirroring the input directory structure. Requires -Format
+ * -Format        The format to transcode into. Only formats with an encoder are accepted (Bink only where its encoder is available). Without -Output, the files are encoded but not exported (encoding benchmark only)
+ * -Quality       The encoding quality, 0 to 100. 100 by default
+ * -SampleRate    The sample rate to resample the decoded audio data to. Unchanged by default
+ * -NumOfChannels The number of channels to mix the decoded audio data to. Unchanged by default
+ * -Workers       The number of files processed in parallel. The number of CPU cores by default
+ * -Iterations    The number of times every file is processed, for more stable timings. The files are only exported once. 1 by default
+ * -Recursive     Process the subdirectories of the input directory as well
+ * -DiskCache     Also time cold imports (decoding and storing in the decoded audio disk cache) against warm imports (loading from the disk cache). The entries stored by the benchmark are deleted afterwards
+ *
+ * Returns 0 if all files have been processed successfully, 1 otherwise
+ */
+UCLASS()
+class RUNTIMEAUDIOIMPORTEREDITOR_API URuntimeAudioBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	URuntimeAudioBenchmarkCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+
+	/**
+	 * Get the file extension used when exporting audio data in the specified format
+	 *
+	 * @return The extension without the dot, or an empty string if the format cannot be exported
+	 */
+	static FString GetExtensionForAudioFormat(ERuntimeAudioFormat AudioFormat);
+
+	/**
+	 * Get the formats the audio data can be transcoded into, i.e. those whose codecs implement encoding in this build
+	 */
+	static TArray<ERuntimeAudioFormat> GetEncodableAudioFormats();
+};